@@ -26,6 +26,10 @@
 
 #include "ClockGenerator.h"
 #include "Si5338_register_map.h"
+#include "TimerInterface.h"
+#include "DeviceDiscovery.h"
+#include "DevicePoll.h"
+#include "RegisterMap.h"
 
 //-------------------------------------------------------------------------------------------------
 // Directives, typedefs and constants
@@ -34,139 +38,487 @@
 // Si5338 I2C default device address
 #define CLOCK_GENERATOR_DEVICE_ADDRESS 0x70
 
+// Page select register, and number of registers per page
+#define CLOCK_GENERATOR_REGISTER_ADDRESS_PAGE 255
+#define CLOCK_GENERATOR_PAGE_SIZE 256
+
 // Masks for clock generator configuration
 #define LOS_MASK 0x04
 #define LOCK_MASK 0x15
 
+// Largest number of unchanged registers written as part of a burst of changed registers
+#define CLOCK_GENERATOR_MAX_UNCHANGED_IN_BURST 3
+
+// Frequency of the reference input clock of the clock generator on the Mercury XU5
+#define CLOCK_GENERATOR_DEFAULT_INPUT_FREQUENCY_HZ 24000000
+
+// Register selecting the reference of the phase detector of the PLL in bits 7..5, and the P1 divider in bits 2..0
+#define CLOCK_GENERATOR_REGISTER_ADDRESS_PFD_IN_REF 29
+#define CLOCK_GENERATOR_PFD_IN_REF_MASK 0xE0
+#define CLOCK_GENERATOR_PFD_IN_REF_SHIFT 5
+#define CLOCK_GENERATOR_P1DIV_MASK 0x07
+#define CLOCK_GENERATOR_P1DIV_LOG2_MAX 5
+
+// Phase detector references: the input clock, the input clock divided by P1, and the crystal oscillator
+#define CLOCK_GENERATOR_PFD_IN_REF_REFCLK 0
+#define CLOCK_GENERATOR_PFD_IN_REF_DIVREFCLK 2
+#define CLOCK_GENERATOR_PFD_IN_REF_XOCLK 4
+
+// Number of clock outputs, each with its own MultiSynth divider and R divider
+#define CLOCK_GENERATOR_NUMBER_OF_OUTPUTS 4
+
+// First register of the parameters of each MultiSynth divider, and of the PLL feedback divider MSN
+#define CLOCK_GENERATOR_REGISTER_ADDRESS_MS0 53
+#define CLOCK_GENERATOR_MS_REGISTER_STRIDE 11
+#define CLOCK_GENERATOR_REGISTER_ADDRESS_MSN 97
+
+// Number of registers holding the P1, P2 and P3 parameters of a MultiSynth divider
+#define CLOCK_GENERATOR_MS_PARAMETER_COUNT 10
+
+// Register holding the R divider of output 0 in bits 4..2; the other outputs follow
+#define CLOCK_GENERATOR_REGISTER_ADDRESS_R0DIV 31
+#define CLOCK_GENERATOR_RDIV_MASK 0x1C
+#define CLOCK_GENERATOR_RDIV_SHIFT 2
+#define CLOCK_GENERATOR_RDIV_LOG2_MAX 5
+
+// Range of the fractional MultiSynth divider, and the highest output frequency supported by the planner
+#define CLOCK_GENERATOR_MS_DIVIDER_MIN 8
+#define CLOCK_GENERATOR_MS_DIVIDER_MAX 567
+#define CLOCK_GENERATOR_OUTPUT_FREQUENCY_MAX_HZ 350000000
+
+// Time to wait after initiating the PLL locking with a soft reset, as required by the data sheet
+#define CLOCK_GENERATOR_SOFT_RESET_DELAY_MILLISECONDS 25
+
+// Registers of the first page which the device changes by itself
+#define CLOCK_GENERATOR_REGISTER_ADDRESS_STATUS 218
+#define CLOCK_GENERATOR_REGISTER_ADDRESS_FCAL_FIRST 235
+#define CLOCK_GENERATOR_REGISTER_ADDRESS_FCAL_LAST 237
+#define CLOCK_GENERATOR_REGISTER_ADDRESS_SOFT_RESET 246
+#define CLOCK_GENERATOR_REGISTER_ADDRESS_STICKY_STATUS 247
+
+// Timing of the polls of the status register: the interval starts short and doubles up to the maximum, so that
+// the bus is not saturated while waiting; a missing input clock or a PLL which does not lock ends in a timeout
+#define CLOCK_GENERATOR_POLL_INITIAL_INTERVAL_MICROSECONDS 100
+#define CLOCK_GENERATOR_POLL_MAX_INTERVAL_MICROSECONDS 5000
+#define CLOCK_GENERATOR_INPUT_CLOCK_TIMEOUT_MICROSECONDS 100000
+#define CLOCK_GENERATOR_LOCK_TIMEOUT_MICROSECONDS 100000
+
+//-------------------------------------------------------------------------------------------------
+// Global variable definitions
+//-------------------------------------------------------------------------------------------------
+
+/// Cache policies of the registers of both pages: the status register (218), the frequency calibration results
+/// (235..237), the soft reset (246) and the sticky status (247) change by themselves, and are never cached
+const RegisterMapRange_t g_clockGeneratorRegisterRanges[] = {
+	{ 0, CLOCK_GENERATOR_REGISTER_ADDRESS_STATUS - 1, ERegisterCachePolicy_Cached },
+	{ CLOCK_GENERATOR_REGISTER_ADDRESS_STATUS + 1, CLOCK_GENERATOR_REGISTER_ADDRESS_FCAL_FIRST - 1, ERegisterCachePolicy_Cached },
+	{ CLOCK_GENERATOR_REGISTER_ADDRESS_FCAL_LAST + 1, CLOCK_GENERATOR_REGISTER_ADDRESS_SOFT_RESET - 1, ERegisterCachePolicy_Cached },
+	{ CLOCK_GENERATOR_REGISTER_ADDRESS_STICKY_STATUS + 1, 2 * CLOCK_GENERATOR_PAGE_SIZE - 1, ERegisterCachePolicy_Cached }
+};
+
+/// Registers of the Si5338: two pages, selected with the page register which is present on both of them
+const RegisterMapConfig_t g_clockGeneratorRegisterMapConfig = {
+	CLOCK_GENERATOR_DEVICE_ADDRESS, EI2cSubAddressMode_OneByte, 2 * CLOCK_GENERATOR_PAGE_SIZE, CLOCK_GENERATOR_PAGE_SIZE,
+	CLOCK_GENERATOR_REGISTER_ADDRESS_PAGE, false, g_clockGeneratorRegisterRanges,
+	sizeof(g_clockGeneratorRegisterRanges) / sizeof(g_clockGeneratorRegisterRanges[0])
+};
+
+uint8_t g_clockGeneratorRegisterValues[2 * CLOCK_GENERATOR_PAGE_SIZE];
+uint8_t g_clockGeneratorRegisterFlags[2 * CLOCK_GENERATOR_PAGE_SIZE];
+
+/// Register cache of the Si5338, indexed by page * CLOCK_GENERATOR_PAGE_SIZE + address
+RegisterMap_t g_clockGeneratorRegisterMap = {
+	&g_clockGeneratorRegisterMapConfig, g_clockGeneratorRegisterValues, g_clockGeneratorRegisterFlags,
+	REGISTER_MAP_PAGE_UNKNOWN, false
+};
+
+/// Time from the soft reset to the PLL lock of the last programming procedure
+uint32_t g_clockGeneratorLockTimeMicroseconds = 0;
+
+/// Frequency of the reference input clock, from which the phase detector frequency is derived
+uint32_t g_clockGeneratorInputFrequencyHz = CLOCK_GENERATOR_DEFAULT_INPUT_FREQUENCY_HZ;
+
 //-------------------------------------------------------------------------------------------------
 
 //-------------------------------------------------------------------------------------------------
 // Function definitions
 //-------------------------------------------------------------------------------------------------
 
-// Try to read from register at address 0 to see if the device is present on the specified device address
+void ClkGen_InvalidateCache() {
+	RegisterMap_Invalidate(&g_clockGeneratorRegisterMap);
+}
+
+/**
+ * \brief Select a register page, unless it is selected already.
+ *
+ * @param	page		Page to select, 0 or 1
+ * @return	Result code
+ */
+EN_RESULT ClkGen_SelectRegisterPage(int page) {
+	return RegisterMap_SelectPage(&g_clockGeneratorRegisterMap, page);
+}
+
+/**
+ * \brief Read consecutive registers of one page, through the register cache.
+ *
+ * @param	page					Register page
+ * @param	address					First register address
+ * @param	numberOfRegisters		Number of registers; address + numberOfRegisters must not exceed the page
+ * @param[out]	pBuffer				Buffer receiving the register values
+ * @param	priority				Priority of the read on the bus
+ * @return	Result code
+ */
+EN_RESULT ClkGen_ReadRegisters(int page, uint8_t address, int numberOfRegisters, uint8_t* pBuffer, EI2cPriority_t priority) {
+	return RegisterMap_ReadWithPriority(&g_clockGeneratorRegisterMap,
+			page * CLOCK_GENERATOR_PAGE_SIZE + address,
+			numberOfRegisters,
+			pBuffer,
+			priority);
+}
+
+/**
+ * \brief Write consecutive registers of one page with a single burst write, and update the register cache.
+ *
+ * @param	page					Register page
+ * @param	address					First register address
+ * @param	numberOfRegisters		Number of registers; address + numberOfRegisters must not exceed the page
+ * @param	pBuffer					Register values
+ * @return	Result code
+ */
+EN_RESULT ClkGen_WriteRegisters(int page, uint8_t address, int numberOfRegisters, const uint8_t* pBuffer) {
+	return RegisterMap_Write(&g_clockGeneratorRegisterMap,
+			page * CLOCK_GENERATOR_PAGE_SIZE + address,
+			numberOfRegisters,
+			pBuffer);
+}
+
+/**
+ * \brief Write a single register of the first page.
+ *
+ * @param	address		Register address
+ * @param	value		Register value
+ * @return	Result code
+ */
+EN_RESULT ClkGen_WriteRegister(uint8_t address, uint8_t value) {
+	return ClkGen_WriteRegisters(0, address, 1, &value);
+}
+
+/**
+ * \brief Read a single register of the first page.
+ *
+ * @param	address			Register address
+ * @param[out]	pValue		Register value
+ * @return	Result code
+ */
+EN_RESULT ClkGen_ReadRegister(uint8_t address, uint8_t* pValue) {
+	return ClkGen_ReadRegisters(0, address, 1, pValue, EI2cPriority_Normal);
+}
+
+/**
+ * \brief Change bits of a register of the first page; the register is only written if its value changes.
+ *
+ * @param	address		Register address
+ * @param	mask		Bits to change
+ * @param	value		New value of the bits to change
+ * @return	Result code
+ */
+EN_RESULT ClkGen_UpdateRegisterBits(uint8_t address, uint8_t mask, uint8_t value) {
+	return RegisterMap_UpdateBits(&g_clockGeneratorRegisterMap, address, mask, value, NULL);
+}
+
+// Use the bus discovery to see if the device is present on the specified device address
 EN_RESULT ClkGen_Initialise(bool* pDeviceIsPresent) {
 	if (pDeviceIsPresent == NULL)
 	    {
 	        return EN_ERROR_NULL_POINTER;
 	    }
 
-	uint8_t readBuffer;
-    if (EN_FAILED(
-            I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 0, EI2cSubAddressMode_OneByte, sizeof(readBuffer), (uint8_t*)&readBuffer)))
+	// Nothing is known about the registers of a device which may have been reset
+	ClkGen_InvalidateCache();
+
+	EN_RETURN_IF_FAILED(DeviceDiscovery_IsDevicePresent(CLOCK_GENERATOR_DEVICE_ADDRESS, pDeviceIsPresent));
+    if (!*pDeviceIsPresent)
     {
-        *pDeviceIsPresent = false;
         EN_PRINTF("Device not present at address: 0x%x \n\r", CLOCK_GENERATOR_DEVICE_ADDRESS);
     }
     else
     {
-        *pDeviceIsPresent = true;
         EN_PRINTF("Device present at address: 0x%x \n\r", CLOCK_GENERATOR_DEVICE_ADDRESS);
     }
 
 	return EN_SUCCESS;
 }
 
+/**
+ * \brief Read both register pages of the Si5338, through the register cache.
+ *
+ * Each page is read with at most one burst read, which only covers the registers not in the cache.
+ *
+ * @param[out]	pRegisters		Buffer of 2 * CLOCK_GENERATOR_PAGE_SIZE bytes to receive the registers of the first,
+ *								then the second page
+ * @return	Result code
+ */
+EN_RESULT ClkGen_ReadRegisterPages(uint8_t* pRegisters) {
+	// The register dump is not time-critical, so other transfers may take the bus in between
+	EN_RETURN_IF_FAILED(ClkGen_ReadRegisters(0, 0x00, CLOCK_GENERATOR_PAGE_SIZE, pRegisters, EI2cPriority_Bulk));
+	EN_RETURN_IF_FAILED(ClkGen_ReadRegisters(1, 0x00, CLOCK_GENERATOR_PAGE_SIZE, pRegisters + CLOCK_GENERATOR_PAGE_SIZE, EI2cPriority_Bulk));
+
+	return EN_SUCCESS;
+}
+
 EN_RESULT ClkGen_ReadAllData() {
-	uint8_t readBuffer [511];
-	uint8_t readBuffer1 [255];
-	uint8_t readBuffer2 [255];
-	uint8_t writeBuffer;
+	uint8_t readBuffer [2 * CLOCK_GENERATOR_PAGE_SIZE];
 
 	// There are 352 registers to access in the Si5338
 	int NumberOfBytes = 352;
 
-	// Read first page from 0 to end
-	EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 0x00, EI2cSubAddressMode_OneByte, 256, (uint8_t*)&readBuffer1));
+	EN_RETURN_IF_FAILED(ClkGen_ReadRegisterPages(readBuffer));
 
-	// Set PAGE_SEL to second page
-	SleepMilliseconds(200);
-	writeBuffer = 0x01;
-	EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, 0xFF, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
-	SleepMilliseconds(200);
+	for(int i=0; i<=NumberOfBytes; i++) {
+		EN_PRINTF("Address: %d; Content: %x \n\r", i, readBuffer[i]);
+	}
 
-	// Read second page from 0 to end
-	EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 0x00, EI2cSubAddressMode_OneByte, 256, (uint8_t*)&readBuffer2));
+	return EN_SUCCESS;
+}
 
-	// Set to first stage
-	writeBuffer = 0x00;
-	EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, 0xFF, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
+/**
+ * \brief Get the number of register map entries, from the given one on, which can be written with one burst write.
+ *
+ * A run consists of writable registers (mask other than 0x00) with consecutive addresses. The page register
+ * is always written on its own, as it changes the meaning of the following addresses.
+ *
+ * @param	firstEntry		Index of the first register map entry
+ * @return	The number of entries in the run
+ */
+int ClkGen_GetRegisterRunLength(int firstEntry) {
+	int entry = firstEntry + 1;
+
+	if (Reg_Store[firstEntry].Reg_Addr == CLOCK_GENERATOR_REGISTER_ADDRESS_PAGE) {
+		return 1;
+	}
 
-	// Concatenate the two read pages and print the data
-	memcpy(readBuffer, readBuffer1, sizeof(uint8_t)*256);
-	memcpy(readBuffer + 256, readBuffer2, sizeof(uint8_t)*256);
+	while ((entry < NUM_REGS_MAX) &&
+		   (Reg_Store[entry].Reg_Mask != 0x00) &&
+		   (Reg_Store[entry].Reg_Addr == Reg_Store[entry - 1].Reg_Addr + 1) &&
+		   (Reg_Store[entry].Reg_Addr != CLOCK_GENERATOR_REGISTER_ADDRESS_PAGE)) {
+		entry++;
+	}
 
-	for(int i=0; i<=NumberOfBytes; i++) {
-		EN_PRINTF("Address: %d; Content: %x \n\r", i, readBuffer[i]);
+	return entry - firstEntry;
+}
+
+/**
+ * \brief Write a run of register map entries with consecutive addresses, with a single burst write.
+ *
+ * Registers with a partial mask keep the bits outside of the mask. If the run contains such a register, the
+ * current values of the whole run are read first, with a single burst read.
+ *
+ * @param	page				Page of the entries
+ * @param	firstEntry			Index of the first register map entry
+ * @param	numberOfEntries		The number of entries, as returned by ClkGen_GetRegisterRunLength()
+ * @return	Result code
+ */
+EN_RESULT ClkGen_WriteRegisterRun(int page, int firstEntry, int numberOfEntries) {
+	uint8_t values[CLOCK_GENERATOR_PAGE_SIZE];
+	uint8_t firstAddress = Reg_Store[firstEntry].Reg_Addr;
+	bool readModifyWrite = false;
+	int index;
+
+	for (index = 0; index < numberOfEntries; index++) {
+		readModifyWrite = readModifyWrite || (Reg_Store[firstEntry + index].Reg_Mask != 0xFF);
 	}
 
+	if (readModifyWrite) {
+		EN_RETURN_IF_FAILED(ClkGen_ReadRegisters(page, firstAddress, numberOfEntries, values, EI2cPriority_Normal));
+	}
+
+	for (index = 0; index < numberOfEntries; index++) {
+		const Reg_Data* pEntry = &Reg_Store[firstEntry + index];
+
+		// keep the bits of the current value which are not allowed to be accessed, and take the others from the register map
+		values[index] = (readModifyWrite ? (values[index] & ~pEntry->Reg_Mask) : 0) | (pEntry->Reg_Val & pEntry->Reg_Mask);
+	}
+
+	EN_RETURN_IF_FAILED(ClkGen_WriteRegisters(page, firstAddress, numberOfEntries, values));
+
 	return EN_SUCCESS;
 }
 
-EN_RESULT ClkGen_WriteData() {
-	uint8_t writeBuffer;
-	uint8_t readBuffer;
+/**
+ * \brief Get the bits of a register map entry which the programming procedure takes into account when comparing.
+ *
+ * The frequency calibration results (45[7:0], 46[7:0], 47[1:0]) and FCAL_OVRD_EN (49[7]) are set by the
+ * programming procedure itself, so they never match the register map on a programmed device.
+ *
+ * @param	entry		Index of the register map entry
+ * @param	page		Page of the entry
+ * @return	The mask of the register map, without the bits owned by the programming procedure
+ */
+uint8_t ClkGen_GetCompareMask(int entry, int page) {
+	uint8_t mask = Reg_Store[entry].Reg_Mask;
+
+	if (page == 0) {
+		switch (Reg_Store[entry].Reg_Addr) {
+			case 45:
+			case 46:
+				mask = 0x00;
+				break;
+			case 47:
+				mask &= 0xFC;
+				break;
+			case 49:
+				mask &= 0x7F;
+				break;
+			default:
+				break;
+		}
+	}
 
-	uint8_t currentValue;
-	uint8_t clearCurrentValue;
-	uint8_t clearNewValue;
-	uint8_t newValue;
+	return mask;
+}
 
-	uint8_t temp;
+/**
+ * \brief Get the value a register map entry sets, based on the current register value.
+ *
+ * @param	entry		Index of the register map entry
+ * @param	page		Page of the entry
+ * @param	current		Current register value
+ * @return	The value with the compared bits taken from the register map, and the other bits from the current value
+ */
+uint8_t ClkGen_GetTargetValue(int entry, int page, uint8_t current) {
+	uint8_t mask = ClkGen_GetCompareMask(entry, page);
+	return (current & ~mask) | (Reg_Store[entry].Reg_Val & mask);
+}
+
+/**
+ * \brief Check whether a register map entry changes a register, compared with a snapshot of the registers.
+ *
+ * The page register entries only select the page of the following entries, and are never reported as changed.
+ *
+ * @param	entry			Index of the register map entry
+ * @param	page			Page of the entry
+ * @param	pSnapshot		Registers of both pages, as read by ClkGen_ReadRegisterPages()
+ * @return	True if the register needs to be written
+ */
+bool ClkGen_IsRegisterChanged(int entry, int page, const uint8_t* pSnapshot) {
+	uint8_t address = Reg_Store[entry].Reg_Addr;
+
+	if ((Reg_Store[entry].Reg_Mask == 0x00) || (address == CLOCK_GENERATOR_REGISTER_ADDRESS_PAGE)) {
+		return false;
+	}
+
+	uint8_t current = pSnapshot[page * CLOCK_GENERATOR_PAGE_SIZE + address];
+	return ClkGen_GetTargetValue(entry, page, current) != current;
+}
+
+/**
+ * \brief Write the registers which differ from a snapshot, coalescing them into burst writes.
+ *
+ * A burst spans the changed registers with consecutive addresses of one page. It also spans up to
+ * CLOCK_GENERATOR_MAX_UNCHANGED_IN_BURST unchanged writable registers between two changed ones, as writing their
+ * current value again is cheaper than starting another transfer. The values are computed from the snapshot, so
+ * no register is read.
+ *
+ * @param	pSnapshot		Registers of both pages, as read by ClkGen_ReadRegisterPages()
+ * @return	Result code
+ */
+EN_RESULT ClkGen_WriteChangedRegisters(const uint8_t* pSnapshot) {
+	uint8_t values[CLOCK_GENERATOR_PAGE_SIZE];
+	int page = 0;
+	int counter = 0;
+
+	while (counter < NUM_REGS_MAX) {
+		if (Reg_Store[counter].Reg_Addr == CLOCK_GENERATOR_REGISTER_ADDRESS_PAGE) {
+			page = Reg_Store[counter].Reg_Val;
+			counter++;
+			continue;
+		}
+
+		if (!ClkGen_IsRegisterChanged(counter, page, pSnapshot)) {
+			counter++;
+			continue;
+		}
+
+		// Extend the burst over the following changed registers, and over short gaps of unchanged ones
+		int runLength = ClkGen_GetRegisterRunLength(counter);
+		int burstLength = 1;
+		int index;
+		for (index = 1; index < runLength; index++) {
+			if (ClkGen_IsRegisterChanged(counter + index, page, pSnapshot)) {
+				burstLength = index + 1;
+			}
+			else if (index - burstLength >= CLOCK_GENERATOR_MAX_UNCHANGED_IN_BURST) {
+				break;
+			}
+		}
 
-	uint8_t fcal1;
-	uint8_t fcal2;
+		uint8_t firstAddress = Reg_Store[counter].Reg_Addr;
+		for (index = 0; index < burstLength; index++) {
+			values[index] = ClkGen_GetTargetValue(counter + index, page, pSnapshot[page * CLOCK_GENERATOR_PAGE_SIZE + firstAddress + index]);
+		}
 
-	Reg_Data currentEntry;
+		EN_RETURN_IF_FAILED(ClkGen_WriteRegisters(page, firstAddress, burstLength, values));
+		counter += burstLength;
+	}
+
+	return EN_SUCCESS;
+}
+
+/**
+ * \brief Program the Si5338 following the I2C programming procedure of the data sheet.
+ *
+ * @param	pSnapshot	NULL to write all registers of the register map; otherwise the registers of both pages, as
+ *						read by ClkGen_ReadRegisterPages(), and only the registers which differ are written
+ * @return	Result code
+ */
+EN_RESULT ClkGen_Program(const uint8_t* pSnapshot) {
+	uint8_t writeBuffer;
+	uint8_t readBuffer;
+
+	uint8_t fcalBuffer[3];
 
 	/** Start at the top of the I2C programming procedure figure of the Si5338 data sheet */
 
 	// Disable outputs: OEB_ALL=1; reg230[4]
 	writeBuffer = 0x10;
-	EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, 230, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
+	EN_RETURN_IF_FAILED(ClkGen_WriteRegister(230, writeBuffer));
 
 	// Pause LOL: DIS_LOL=1; reg241[7]
 	writeBuffer = 0xE5;
-	EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, 241, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
+	EN_RETURN_IF_FAILED(ClkGen_WriteRegister(241, writeBuffer));
 
-	/** Write all register values from the generated register map file to the Si5338 */
+	/** Write all register values from the generated register map file to the Si5338.
+	 * Registers with consecutive addresses are written with one burst write, and the registers with a partial mask
+	 * among them are updated with one burst read before it. The programming procedure does not require any delay
+	 * between the register writes.
+	 */
 
 	EN_PRINTF("Get each value and mask and apply it to the Si5338 \n\r");
 
-	// Get each value and mask and apply it to the Si5338
-	for(int counter = 0; counter < NUM_REGS_MAX; counter++) {
-		currentEntry = Reg_Store[counter];
+	if (pSnapshot != NULL) {
+		EN_RETURN_IF_FAILED(ClkGen_WriteChangedRegisters(pSnapshot));
+	}
 
+	int page = 0;
+	int counter = 0;
+	while ((pSnapshot == NULL) && (counter < NUM_REGS_MAX)) {
 		// If a mask is 0x00 all the bits in the register are reserved and can not be changed
+		if (Reg_Store[counter].Reg_Mask == 0x00) {
+			counter++;
+			continue;
+		}
 
-		if(currentEntry.Reg_Mask != 0x00) {
-			if(currentEntry.Reg_Mask == 0xFF) {
-				// do a regular I2C write to the register at the specified address with the value from the generated register map file
-				writeBuffer = currentEntry.Reg_Val;
-				EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, currentEntry.Reg_Addr, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
-				EN_PRINTF("Address: %d; Value: %x \n\r", currentEntry.Reg_Addr, currentEntry.Reg_Val);
-			}
-			else {
-				// do a read-modify-write using I2C and bit-wise operations
-
-				// get the current value from the device at thh register located at the specified address
-				EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, currentEntry.Reg_Addr, EI2cSubAddressMode_OneByte, 1, (uint8_t*)&readBuffer));
-				currentValue = readBuffer;
-
-				// clear the bits that are allowed to be accessed in the current value of the register
-				clearCurrentValue = currentValue & ~currentEntry.Reg_Mask;
-
-				// clear the bits in the desired data that are not allowed to be accessed
-				clearNewValue = currentEntry.Reg_Val & currentEntry.Reg_Mask;
-
-				// combine the cleared values to get the new value to write to the desired register
-				newValue = clearNewValue | clearCurrentValue;
-				writeBuffer = newValue;
-				EN_PRINTF("Address: %d; Value: %x \n\r", currentEntry.Reg_Addr, newValue);
-				EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, currentEntry.Reg_Addr, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
-			}
-			SleepMilliseconds(200);
+		// The page entries of the register map select the page of the following entries
+		if (Reg_Store[counter].Reg_Addr == CLOCK_GENERATOR_REGISTER_ADDRESS_PAGE) {
+			page = Reg_Store[counter].Reg_Val;
+			EN_RETURN_IF_FAILED(ClkGen_SelectRegisterPage(page));
+			counter++;
+			continue;
 		}
+
+		int runLength = ClkGen_GetRegisterRunLength(counter);
+		EN_RETURN_IF_FAILED(ClkGen_WriteRegisterRun(page, counter, runLength));
+		counter += runLength;
 	}
 
 	/** Validate input clock status: input clock are validated with the LOS alarms.
@@ -175,43 +527,45 @@ EN_RESULT ClkGen_WriteData() {
 	 * Change the LOS_MASK if using other inputs.
 	 */
 
-	// Check register 218 responsible for tracking LOL until input clock is valid
-	EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 218, EI2cSubAddressMode_OneByte, 1, (uint8_t*)&readBuffer));
-	temp = readBuffer & LOS_MASK;
-	while(temp != 0) {
-		EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 218, EI2cSubAddressMode_OneByte, 1, (uint8_t*)&readBuffer));
-		temp = readBuffer & LOS_MASK;
+	const DevicePollTiming_t inputClockPollTiming = { CLOCK_GENERATOR_POLL_INITIAL_INTERVAL_MICROSECONDS, CLOCK_GENERATOR_POLL_MAX_INTERVAL_MICROSECONDS, CLOCK_GENERATOR_INPUT_CLOCK_TIMEOUT_MICROSECONDS };
+	const DevicePollTiming_t lockPollTiming = { CLOCK_GENERATOR_POLL_INITIAL_INTERVAL_MICROSECONDS, CLOCK_GENERATOR_POLL_MAX_INTERVAL_MICROSECONDS, CLOCK_GENERATOR_LOCK_TIMEOUT_MICROSECONDS };
+
+	// Check register 218 responsible for tracking LOL until input clock is valid; the status register is on the first page
+	EN_RETURN_IF_FAILED(ClkGen_SelectRegisterPage(0));
+	if (EN_FAILED(DevicePoll_WaitForRegister(CLOCK_GENERATOR_DEVICE_ADDRESS, CLOCK_GENERATOR_REGISTER_ADDRESS_STATUS, EI2cSubAddressMode_OneByte, LOS_MASK, 0x00, &inputClockPollTiming, &readBuffer, NULL))) {
+		EN_PRINTF("Input clock is not valid, status: %x \n\r", readBuffer);
+		return EN_ERROR_TIMEOUT;
 	}
 
 	EN_PRINTF("Input clock is valid \n\r");
 
 	// Configure PLL for locking: FCAL_OVRD_EN=0; reg49[7]
-	EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 49, EI2cSubAddressMode_OneByte, 1, (uint8_t*)&readBuffer));
-	writeBuffer = readBuffer & 0x7F;
-	EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, 49, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
+	EN_RETURN_IF_FAILED(ClkGen_UpdateRegisterBits(49, 0x80, 0x00));
 
 	// Initiate locking of PLL: SOFT_RESET = 1; reg246[1]
 	writeBuffer = 0x02;
-	EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, 246, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
+	EN_RETURN_IF_FAILED(ClkGen_WriteRegister(246, writeBuffer));
 
 	EN_PRINTF("PLL locking initiated \n\r");
 
+	uint64_t softResetTime = GetTimeMicroseconds();
+
 	// Wait at least 25 ms
-	SleepMilliseconds(50);
+	SleepMilliseconds(CLOCK_GENERATOR_SOFT_RESET_DELAY_MILLISECONDS);
 
 	// Restart LOL: DIS_LOL = 0; reg241[7]; set reg241 = 0x65
 	writeBuffer = 0x65;
-	EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, 241, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
+	EN_RETURN_IF_FAILED(ClkGen_WriteRegister(241, writeBuffer));
 
 	// Check if PLL is locked: PLL is locked when PLL_LOL, SYS_CAL and all other alarms are cleared
-	EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 218, EI2cSubAddressMode_OneByte, 1, (uint8_t*)&readBuffer));
-	temp = readBuffer & LOCK_MASK;
-	while(temp != 0) {
-		EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 218, EI2cSubAddressMode_OneByte, 1, (uint8_t*)&readBuffer));
-		temp = readBuffer & LOCK_MASK;
+	EN_RETURN_IF_FAILED(ClkGen_SelectRegisterPage(0));
+	if (EN_FAILED(DevicePoll_WaitForRegister(CLOCK_GENERATOR_DEVICE_ADDRESS, CLOCK_GENERATOR_REGISTER_ADDRESS_STATUS, EI2cSubAddressMode_OneByte, LOCK_MASK, 0x00, &lockPollTiming, &readBuffer, NULL))) {
+		EN_PRINTF("PLL did not lock, status: %x \n\r", readBuffer);
+		return EN_ERROR_TIMEOUT;
 	}
 
-	EN_PRINTF("PLL is locked \n\r");
+	g_clockGeneratorLockTimeMicroseconds = (uint32_t)(GetTimeMicroseconds() - softResetTime);
+	EN_PRINTF("PLL is locked after %u us \n\r", (unsigned int)g_clockGeneratorLockTimeMicroseconds);
 
 	/** Copy FCAL values to active registers as follows:
 	 * 237[1:0] to 47[1:0]
@@ -219,32 +573,205 @@ EN_RESULT ClkGen_WriteData() {
 	 * 235[7:0] to 45[7:0]
 	 * Set 47[7:2] = 000101b
 	 */
-	EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 235, EI2cSubAddressMode_OneByte, 1, (uint8_t*)&readBuffer));
-	EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, 45, EI2cSubAddressMode_OneByte, (uint8_t*)&readBuffer, 1));
-
-	EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 236, EI2cSubAddressMode_OneByte, 1, (uint8_t*)&readBuffer));
-	EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, 46, EI2cSubAddressMode_OneByte, (uint8_t*)&readBuffer, 1));
+	EN_RETURN_IF_FAILED(ClkGen_ReadRegisters(0, 235, sizeof(fcalBuffer), fcalBuffer, EI2cPriority_Normal));
 
 	// clear bits 0 and 1 from 47 and combine with bit 0 and 1 from 237
-	EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 47, EI2cSubAddressMode_OneByte, 1, (uint8_t*)&readBuffer));
-	fcal1 = readBuffer;
-	EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 237, EI2cSubAddressMode_OneByte, 1, (uint8_t*)&readBuffer));
-	fcal2 = readBuffer;
-	writeBuffer = (fcal1 & 0xFC) | (fcal2 & 0x03);
-	EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, 47, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
+	EN_RETURN_IF_FAILED(ClkGen_ReadRegister(47, &readBuffer));
+	fcalBuffer[2] = (readBuffer & 0xFC) | (fcalBuffer[2] & 0x03);
+
+	// 45 to 47 are consecutive, so they are written with one burst write
+	EN_RETURN_IF_FAILED(ClkGen_WriteRegisters(0, 45, sizeof(fcalBuffer), fcalBuffer));
 
 	// Set PLL to use FCAL values: FCAL_OVRD_EN = 1; reg49[7]
-	EN_RETURN_IF_FAILED(I2cRead(CLOCK_GENERATOR_DEVICE_ADDRESS, 49, EI2cSubAddressMode_OneByte, 1, (uint8_t*)&readBuffer));
-	writeBuffer = readBuffer | 0x80;
-	EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, 49, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
+	EN_RETURN_IF_FAILED(ClkGen_UpdateRegisterBits(49, 0x80, 0x80));
 
 	// If using down spread check the I2C programming procedure in the I2C application note or the Si5338 data sheet at this stage to make the necessary adjustment
 
 	// Enable outputs: OEB_ALL = 0; reg230[4]
 	writeBuffer = 0x00;
-	EN_RETURN_IF_FAILED(I2cWrite(CLOCK_GENERATOR_DEVICE_ADDRESS, 230, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
+	EN_RETURN_IF_FAILED(ClkGen_WriteRegister(230, writeBuffer));
 
 	EN_PRINTF("Outputs are enabled \n\r");
 
 	return EN_SUCCESS;
 }
+
+EN_RESULT ClkGen_WriteData() {
+	return ClkGen_Program(NULL);
+}
+
+EN_RESULT ClkGen_WriteChangedData() {
+	uint8_t snapshot[2 * CLOCK_GENERATOR_PAGE_SIZE];
+	EN_RETURN_IF_FAILED(ClkGen_ReadRegisterPages(snapshot));
+
+	int numberOfChangedRegisters = 0;
+	int page = 0;
+	for (int counter = 0; counter < NUM_REGS_MAX; counter++) {
+		if (Reg_Store[counter].Reg_Addr == CLOCK_GENERATOR_REGISTER_ADDRESS_PAGE) {
+			page = Reg_Store[counter].Reg_Val;
+		}
+		else if (ClkGen_IsRegisterChanged(counter, page, snapshot)) {
+			numberOfChangedRegisters++;
+		}
+	}
+
+	EN_PRINTF("%d registers of the Si5338 differ from the register map \n\r", numberOfChangedRegisters);
+
+	// The device already runs with the register map, so the outputs are left undisturbed
+	if (numberOfChangedRegisters == 0) {
+		return EN_SUCCESS;
+	}
+
+	return ClkGen_Program(snapshot);
+}
+
+/**
+ * \brief Get the greatest common divisor of two numbers.
+ *
+ * @param	a		First number
+ * @param	b		Second number
+ * @return	The greatest common divisor
+ */
+uint64_t ClkGen_GetGreatestCommonDivisor(uint64_t a, uint64_t b) {
+	while (b != 0) {
+		uint64_t remainder = a % b;
+		a = b;
+		b = remainder;
+	}
+
+	return a;
+}
+
+/**
+ * \brief Get the frequency at the phase detector of the PLL, from the input frequency and the reference selection
+ * and P1 divider programmed in the device.
+ *
+ * @param[out]	pPfdFrequencyHz		Phase detector frequency
+ * @return	Result code; EN_ERROR_INVALID_ARGUMENT if the PLL is referenced to the feedback clock
+ */
+EN_RESULT ClkGen_ReadPfdFrequency(uint64_t* pPfdFrequencyHz) {
+	uint8_t value;
+	EN_RETURN_IF_FAILED(ClkGen_ReadRegister(CLOCK_GENERATOR_REGISTER_ADDRESS_PFD_IN_REF, &value));
+
+	int reference = (value & CLOCK_GENERATOR_PFD_IN_REF_MASK) >> CLOCK_GENERATOR_PFD_IN_REF_SHIFT;
+	int p1DividerLog2 = value & CLOCK_GENERATOR_P1DIV_MASK;
+
+	if ((reference == CLOCK_GENERATOR_PFD_IN_REF_REFCLK) || (reference == CLOCK_GENERATOR_PFD_IN_REF_XOCLK)) {
+		*pPfdFrequencyHz = g_clockGeneratorInputFrequencyHz;
+	} else if ((reference == CLOCK_GENERATOR_PFD_IN_REF_DIVREFCLK) && (p1DividerLog2 <= CLOCK_GENERATOR_P1DIV_LOG2_MAX)) {
+		*pPfdFrequencyHz = g_clockGeneratorInputFrequencyHz >> p1DividerLog2;
+	} else {
+		return EN_ERROR_INVALID_ARGUMENT;
+	}
+
+	return EN_SUCCESS;
+}
+
+/**
+ * \brief Get the VCO frequency of the PLL from the feedback divider MSN programmed in the device.
+ *
+ * The divider a + b/c is stored as P1 = floor(128 * (a + b/c)) - 512, P2 = (128 * b) mod c and P3 = c, so
+ * 128 * c * (a + b/c) = (P1 + 512) * P3 + P2.
+ *
+ * @param[out]	pVcoFrequencyHz		VCO frequency, rounded to Hz
+ * @return	Result code
+ */
+EN_RESULT ClkGen_ReadVcoFrequency(uint64_t* pVcoFrequencyHz) {
+	uint8_t parameters[CLOCK_GENERATOR_MS_PARAMETER_COUNT];
+	EN_RETURN_IF_FAILED(ClkGen_ReadRegisters(0, CLOCK_GENERATOR_REGISTER_ADDRESS_MSN, sizeof(parameters), parameters, EI2cPriority_Normal));
+
+	uint64_t p1 = parameters[0] | ((uint64_t)parameters[1] << 8) | ((uint64_t)(parameters[2] & 0x03) << 16);
+	uint64_t p2 = (parameters[2] >> 2) | ((uint64_t)parameters[3] << 6) | ((uint64_t)parameters[4] << 14) | ((uint64_t)parameters[5] << 22);
+	uint64_t p3 = parameters[6] | ((uint64_t)parameters[7] << 8) | ((uint64_t)parameters[8] << 16) | ((uint64_t)(parameters[9] & 0x3F) << 24);
+
+	if (p3 == 0) {
+		return EN_ERROR_INVALID_ARGUMENT;
+	}
+
+	uint64_t pfdFrequencyHz;
+	EN_RETURN_IF_FAILED(ClkGen_ReadPfdFrequency(&pfdFrequencyHz));
+
+	// Split off the integer part before multiplying with the PFD frequency, which keeps the products within 64 bits
+	uint64_t numerator = (p1 + 512) * p3 + p2;
+	uint64_t denominator = 128 * p3;
+	*pVcoFrequencyHz = (numerator / denominator) * pfdFrequencyHz +
+		((numerator % denominator) * pfdFrequencyHz + denominator / 2) / denominator;
+
+	return EN_SUCCESS;
+}
+
+EN_RESULT ClkGen_SetOutputFrequency(int output, uint32_t frequencyHz) {
+	if ((output < 0) || (output >= CLOCK_GENERATOR_NUMBER_OF_OUTPUTS) ||
+		(frequencyHz == 0) || (frequencyHz > CLOCK_GENERATOR_OUTPUT_FREQUENCY_MAX_HZ)) {
+		return EN_ERROR_INVALID_ARGUMENT;
+	}
+
+	uint64_t vcoFrequencyHz;
+	EN_RETURN_IF_FAILED(ClkGen_ReadVcoFrequency(&vcoFrequencyHz));
+
+	// Use the smallest R divider which brings the MultiSynth divider into range, as it gives the finest resolution
+	int rDividerLog2 = 0;
+	while ((vcoFrequencyHz / ((uint64_t)frequencyHz << rDividerLog2) > CLOCK_GENERATOR_MS_DIVIDER_MAX) &&
+		   (rDividerLog2 < CLOCK_GENERATOR_RDIV_LOG2_MAX)) {
+		rDividerLog2++;
+	}
+
+	// MultiSynth divider a + b/c, with b/c reduced so that c fits into the 30 bits of P3
+	uint64_t msFrequencyHz = (uint64_t)frequencyHz << rDividerLog2;
+	uint64_t a = vcoFrequencyHz / msFrequencyHz;
+	uint64_t b = vcoFrequencyHz % msFrequencyHz;
+	uint64_t c = msFrequencyHz;
+	uint64_t divisor = ClkGen_GetGreatestCommonDivisor(b, c);
+	b /= divisor;
+	c /= divisor;
+
+	if ((a < CLOCK_GENERATOR_MS_DIVIDER_MIN) || (a > CLOCK_GENERATOR_MS_DIVIDER_MAX) ||
+		((a == CLOCK_GENERATOR_MS_DIVIDER_MAX) && (b != 0))) {
+		return EN_ERROR_INVALID_ARGUMENT;
+	}
+
+	uint64_t p1 = a * 128 + (b * 128) / c - 512;
+	uint64_t p2 = (b * 128) % c;
+	uint64_t p3 = c;
+
+	EN_PRINTF("Output %d: %u Hz = %llu Hz / (%llu + %llu/%llu) / %d \n\r", output, (unsigned int)frequencyHz,
+		(unsigned long long)vcoFrequencyHz, (unsigned long long)a, (unsigned long long)b, (unsigned long long)c, 1 << rDividerLog2);
+
+	// The bits 7..6 of the last parameter register are reserved and are kept
+	uint8_t msAddress = CLOCK_GENERATOR_REGISTER_ADDRESS_MS0 + output * CLOCK_GENERATOR_MS_REGISTER_STRIDE;
+	uint8_t parameters[CLOCK_GENERATOR_MS_PARAMETER_COUNT];
+	EN_RETURN_IF_FAILED(ClkGen_ReadRegister(msAddress + CLOCK_GENERATOR_MS_PARAMETER_COUNT - 1, &parameters[9]));
+
+	parameters[0] = (uint8_t)p1;
+	parameters[1] = (uint8_t)(p1 >> 8);
+	parameters[2] = (uint8_t)(((p1 >> 16) & 0x03) | ((p2 & 0x3F) << 2));
+	parameters[3] = (uint8_t)(p2 >> 6);
+	parameters[4] = (uint8_t)(p2 >> 14);
+	parameters[5] = (uint8_t)(p2 >> 22);
+	parameters[6] = (uint8_t)p3;
+	parameters[7] = (uint8_t)(p3 >> 8);
+	parameters[8] = (uint8_t)(p3 >> 16);
+	parameters[9] = (uint8_t)((parameters[9] & 0xC0) | ((p3 >> 24) & 0x3F));
+
+	/*
+	 * Only the MultiSynth of this output is changed; the PLL keeps running, so the other outputs are not disturbed
+	 * and no soft reset is needed. All parameters are written with one burst in ascending address order, which
+	 * keeps the time in which the divider sees a partially updated set of parameters as short as possible.
+	 */
+	EN_RETURN_IF_FAILED(ClkGen_WriteRegisters(0, msAddress, sizeof(parameters), parameters));
+
+	// The R divider is only written if it changes, as this interrupts the output
+	EN_RETURN_IF_FAILED(ClkGen_UpdateRegisterBits(CLOCK_GENERATOR_REGISTER_ADDRESS_R0DIV + output,
+			CLOCK_GENERATOR_RDIV_MASK,
+			(uint8_t)(rDividerLog2 << CLOCK_GENERATOR_RDIV_SHIFT)));
+
+	return EN_SUCCESS;
+}
+
+uint32_t ClkGen_GetLockTimeMicroseconds() {
+	return g_clockGeneratorLockTimeMicroseconds;
+}
+
+void ClkGen_SetInputFrequency(uint32_t inputFrequencyHz) {
+	g_clockGeneratorInputFrequencyHz = inputFrequencyHz;
+}
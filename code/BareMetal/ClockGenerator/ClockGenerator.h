@@ -46,10 +46,68 @@ EN_RESULT ClkGen_Initialise(bool* pDeviceIsPresent);
  * Configures all registers of the clock generator with the data out of a header file.
  * This header file can be generated using the ClockBuilder Pro software available by SI
  *
- * @return					Result code
+ * @return					Result code; EN_ERROR_TIMEOUT if the input clock is missing or the PLL does not lock
  */
 EN_RESULT ClkGen_WriteData();
 
+/**
+ * \brief Reconfigure the clock generator, writing only the registers which differ from the register map
+ *
+ * Both register pages are read first, and compared with the register map of the header file, taking the masks
+ * into account. The changed registers are written with as few burst writes as possible, within the same
+ * programming procedure as ClkGen_WriteData(). If no register differs, the clock generator is not touched.
+ *
+ * @return					Result code
+ */
+EN_RESULT ClkGen_WriteChangedData();
+
+/**
+ * \brief Set the frequency of a clock output at runtime
+ *
+ * The MultiSynth divider and the R divider of the output are computed from the VCO frequency, which is derived from
+ * the input frequency (see ClkGen_SetInputFrequency()) and the reference selection, P1 divider and PLL feedback
+ * divider of the device, so the device must have been configured with ClkGen_WriteData() before.
+ * Only the MultiSynth parameter registers and, if it changes, the R divider of the output are written. The PLL is
+ * not touched, so the other outputs keep running. The fractional divider is exact as long as the VCO frequency is
+ * an integer number of Hz.
+ *
+ * @param	output			Clock output, 0 to 3
+ * @param	frequencyHz		Output frequency in Hz; the VCO frequency divided by 8 to 567 and by an R divider of
+ *							1 to 32, and at most 350 MHz
+ * @return					Result code
+ */
+EN_RESULT ClkGen_SetOutputFrequency(int output, uint32_t frequencyHz);
+
+/**
+ * \brief Set the frequency of the reference input clock of the clock generator
+ *
+ * The frequency of the input clock is given by the board and cannot be read from the device. It defaults to the
+ * 24 MHz of the Mercury XU5; call this function for a board with a different reference before setting output
+ * frequencies.
+ *
+ * @param	inputFrequencyHz	Input frequency in Hz
+ */
+void ClkGen_SetInputFrequency(uint32_t inputFrequencyHz);
+
+/**
+ * \brief Get the time the PLL needed to lock during the last programming procedure
+ *
+ * The time is measured from the soft reset which initiates the locking, so it includes the 25 ms wait required
+ * by the data sheet.
+ *
+ * @return					Lock time in microseconds, or 0 if the clock generator has not been programmed yet
+ */
+uint32_t ClkGen_GetLockTimeMicroseconds();
+
+/**
+ * \brief Forget the cached register values of the clock generator
+ *
+ * The driver keeps a copy of the configuration registers it has read or written, and the selected register page,
+ * so that they are not read again. Call this function if the device has been reset or reconfigured by someone else,
+ * so that the registers are read from the device again. Status registers are never cached.
+ */
+void ClkGen_InvalidateCache();
+
 /**
  * \brief Read all data from the clock generator
  *
@@ -0,0 +1,651 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "AtmelAtsha204aMac.h"
+#include "AtmelAtsha204a.h"
+
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// Directive, typedefs and constants
+//-------------------------------------------------------------------------------------------------
+
+/// SHA-256 block size
+#define SHA256_BLOCK_SIZE_BYTES (64)
+
+/// Size of the message length appended by the SHA-256 padding
+#define SHA256_LENGTH_SIZE_BYTES (8)
+
+/// Size of the message digested by the Nonce command: RandOut, NumIn, opcode, mode and a zero byte
+#define NONCE_MESSAGE_SIZE_BYTES (32 + 20 + 3)
+
+#define SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+// Vector operations of the batched SHA-256, on SHA256_VECTOR_LANES messages at a time. ANDNOT(x, y) is ~x & y.
+#if defined(__AVX2__)
+#define SHA256_VECTOR_IMPLEMENTATION "AVX2"
+#define SHA256_VECTOR_LANES (8)
+typedef __m256i Sha256Vector_t;
+#define SHA256_VECTOR_LOAD(p) _mm256_loadu_si256((const __m256i*)(p))
+#define SHA256_VECTOR_STORE(p, x) _mm256_storeu_si256((__m256i*)(p), (x))
+#define SHA256_VECTOR_SET(x) _mm256_set1_epi32((int)(x))
+#define SHA256_VECTOR_ADD(x, y) _mm256_add_epi32((x), (y))
+#define SHA256_VECTOR_AND(x, y) _mm256_and_si256((x), (y))
+#define SHA256_VECTOR_ANDNOT(x, y) _mm256_andnot_si256((x), (y))
+#define SHA256_VECTOR_OR(x, y) _mm256_or_si256((x), (y))
+#define SHA256_VECTOR_XOR(x, y) _mm256_xor_si256((x), (y))
+#define SHA256_VECTOR_SHR(x, n) _mm256_srli_epi32((x), (n))
+#define SHA256_VECTOR_SHL(x, n) _mm256_slli_epi32((x), (n))
+#elif defined(__SSE2__)
+#define SHA256_VECTOR_IMPLEMENTATION "SSE2"
+#define SHA256_VECTOR_LANES (4)
+typedef __m128i Sha256Vector_t;
+#define SHA256_VECTOR_LOAD(p) _mm_loadu_si128((const __m128i*)(p))
+#define SHA256_VECTOR_STORE(p, x) _mm_storeu_si128((__m128i*)(p), (x))
+#define SHA256_VECTOR_SET(x) _mm_set1_epi32((int)(x))
+#define SHA256_VECTOR_ADD(x, y) _mm_add_epi32((x), (y))
+#define SHA256_VECTOR_AND(x, y) _mm_and_si128((x), (y))
+#define SHA256_VECTOR_ANDNOT(x, y) _mm_andnot_si128((x), (y))
+#define SHA256_VECTOR_OR(x, y) _mm_or_si128((x), (y))
+#define SHA256_VECTOR_XOR(x, y) _mm_xor_si128((x), (y))
+#define SHA256_VECTOR_SHR(x, n) _mm_srli_epi32((x), (n))
+#define SHA256_VECTOR_SHL(x, n) _mm_slli_epi32((x), (n))
+#elif defined(__ARM_NEON)
+#define SHA256_VECTOR_IMPLEMENTATION "NEON"
+#define SHA256_VECTOR_LANES (4)
+typedef uint32x4_t Sha256Vector_t;
+#define SHA256_VECTOR_LOAD(p) vld1q_u32(p)
+#define SHA256_VECTOR_STORE(p, x) vst1q_u32((p), (x))
+#define SHA256_VECTOR_SET(x) vdupq_n_u32(x)
+#define SHA256_VECTOR_ADD(x, y) vaddq_u32((x), (y))
+#define SHA256_VECTOR_AND(x, y) vandq_u32((x), (y))
+#define SHA256_VECTOR_ANDNOT(x, y) vbicq_u32((y), (x))
+#define SHA256_VECTOR_OR(x, y) vorrq_u32((x), (y))
+#define SHA256_VECTOR_XOR(x, y) veorq_u32((x), (y))
+#define SHA256_VECTOR_SHR(x, n) vshrq_n_u32((x), (n))
+#define SHA256_VECTOR_SHL(x, n) vshlq_n_u32((x), (n))
+#else
+#define SHA256_VECTOR_IMPLEMENTATION "scalar"
+#endif
+
+#if defined(SHA256_VECTOR_LANES)
+#define SHA256_VECTOR_ROTR(x, n) SHA256_VECTOR_OR(SHA256_VECTOR_SHR((x), (n)), SHA256_VECTOR_SHL((x), 32 - (n)))
+#define SHA256_VECTOR_XOR3(x, y, z) SHA256_VECTOR_XOR(SHA256_VECTOR_XOR((x), (y)), (z))
+
+#if (ATMEL_ATSHA204A_MAC_BATCH_SIZE % SHA256_VECTOR_LANES) != 0
+#error "The batch size must be a multiple of the vector width"
+#endif
+#endif
+
+/// SHA-256 round constants
+const uint32_t SHA256_K[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+/// SHA-256 initial hash value
+const uint32_t SHA256_H0[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Get a block of a padded SHA-256 message: the message, a one bit, zeros and the message length in bits.
+ *
+ * @param[in] pData				Message
+ * @param[in] dataLengthBytes	Length of the message
+ * @param[in] blockIndex		Index of the block
+ * @param[out] pBlock			Buffer to receive the SHA256_BLOCK_SIZE_BYTES block bytes
+ */
+void AtmelAtsha204aMac_GetPaddedBlock(const uint8_t* pData,
+                                      uint32_t dataLengthBytes,
+                                      uint32_t blockIndex,
+                                      uint8_t* pBlock)
+{
+    uint32_t blockStart = blockIndex * SHA256_BLOCK_SIZE_BYTES;
+    uint32_t dataBytes = 0;
+
+    if (blockStart < dataLengthBytes)
+    {
+        dataBytes = dataLengthBytes - blockStart;
+        if (dataBytes > SHA256_BLOCK_SIZE_BYTES)
+        {
+            dataBytes = SHA256_BLOCK_SIZE_BYTES;
+        }
+
+        memcpy(pBlock, &pData[blockStart], dataBytes);
+    }
+
+    memset(&pBlock[dataBytes], 0, SHA256_BLOCK_SIZE_BYTES - dataBytes);
+
+    if ((dataLengthBytes >= blockStart) && (dataLengthBytes < blockStart + SHA256_BLOCK_SIZE_BYTES))
+    {
+        pBlock[dataLengthBytes - blockStart] = 0x80;
+    }
+
+    // The length is only stored in the last block, which always has room for it
+    uint32_t numberOfBlocks =
+        (dataLengthBytes + 1 + SHA256_LENGTH_SIZE_BYTES + SHA256_BLOCK_SIZE_BYTES - 1) / SHA256_BLOCK_SIZE_BYTES;
+
+    if (blockIndex == numberOfBlocks - 1)
+    {
+        uint64_t lengthBits = (uint64_t)dataLengthBytes * 8;
+
+        unsigned int byteIndex;
+        for (byteIndex = 0; byteIndex < SHA256_LENGTH_SIZE_BYTES; byteIndex++)
+        {
+            pBlock[SHA256_BLOCK_SIZE_BYTES - 1 - byteIndex] = (uint8_t)(lengthBits >> (byteIndex * 8));
+        }
+    }
+}
+
+
+/**
+ * \brief Process one SHA-256 block of a single message.
+ *
+ * @param[in,out] pState	Hash state
+ * @param[in] pBlock		Block
+ */
+void AtmelAtsha204aMac_Sha256Block(uint32_t* pState, const uint8_t* pBlock)
+{
+    uint32_t w[64];
+    uint32_t a = pState[0], b = pState[1], c = pState[2], d = pState[3];
+    uint32_t e = pState[4], f = pState[5], g = pState[6], h = pState[7];
+
+    unsigned int t;
+    for (t = 0; t < 16; t++)
+    {
+        w[t] = ((uint32_t)pBlock[t * 4] << 24) | ((uint32_t)pBlock[t * 4 + 1] << 16) |
+               ((uint32_t)pBlock[t * 4 + 2] << 8) | pBlock[t * 4 + 3];
+    }
+
+    for (t = 16; t < 64; t++)
+    {
+        uint32_t s0 = SHA256_ROTR(w[t - 15], 7) ^ SHA256_ROTR(w[t - 15], 18) ^ (w[t - 15] >> 3);
+        uint32_t s1 = SHA256_ROTR(w[t - 2], 17) ^ SHA256_ROTR(w[t - 2], 19) ^ (w[t - 2] >> 10);
+        w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+    }
+
+    for (t = 0; t < 64; t++)
+    {
+        uint32_t t1 = h + (SHA256_ROTR(e, 6) ^ SHA256_ROTR(e, 11) ^ SHA256_ROTR(e, 25)) + ((e & f) ^ (~e & g)) +
+                      SHA256_K[t] + w[t];
+        uint32_t t2 = (SHA256_ROTR(a, 2) ^ SHA256_ROTR(a, 13) ^ SHA256_ROTR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    pState[0] += a;
+    pState[1] += b;
+    pState[2] += c;
+    pState[3] += d;
+    pState[4] += e;
+    pState[5] += f;
+    pState[6] += g;
+    pState[7] += h;
+}
+
+
+/**
+ * \brief Process one SHA-256 block of each of ATMEL_ATSHA204A_MAC_BATCH_SIZE messages.
+ *
+ * The state is stored as [word][message]. This version uses the SSE2, AVX2 or NEON intrinsics selected at compile
+ * time, and processes SHA256_VECTOR_LANES messages per instruction; the version below is the scalar fallback.
+ *
+ * @param[in,out] state		Hash state of each message
+ * @param[in] blocks		Block of each message
+ */
+#if defined(SHA256_VECTOR_LANES)
+void AtmelAtsha204aMac_Sha256BlockBatch(uint32_t state[8][ATMEL_ATSHA204A_MAC_BATCH_SIZE],
+                                        const uint8_t blocks[ATMEL_ATSHA204A_MAC_BATCH_SIZE][SHA256_BLOCK_SIZE_BYTES])
+{
+    uint32_t words[16][ATMEL_ATSHA204A_MAC_BATCH_SIZE];
+    Sha256Vector_t w[64];
+
+    unsigned int t, index, first;
+    for (t = 0; t < 16; t++)
+    {
+        for (index = 0; index < ATMEL_ATSHA204A_MAC_BATCH_SIZE; index++)
+        {
+            words[t][index] = ((uint32_t)blocks[index][t * 4] << 24) | ((uint32_t)blocks[index][t * 4 + 1] << 16) |
+                              ((uint32_t)blocks[index][t * 4 + 2] << 8) | blocks[index][t * 4 + 3];
+        }
+    }
+
+    for (first = 0; first < ATMEL_ATSHA204A_MAC_BATCH_SIZE; first += SHA256_VECTOR_LANES)
+    {
+        for (t = 0; t < 16; t++)
+        {
+            w[t] = SHA256_VECTOR_LOAD(&words[t][first]);
+        }
+
+        for (t = 16; t < 64; t++)
+        {
+            Sha256Vector_t s0 = SHA256_VECTOR_XOR3(
+                SHA256_VECTOR_ROTR(w[t - 15], 7), SHA256_VECTOR_ROTR(w[t - 15], 18), SHA256_VECTOR_SHR(w[t - 15], 3));
+            Sha256Vector_t s1 = SHA256_VECTOR_XOR3(
+                SHA256_VECTOR_ROTR(w[t - 2], 17), SHA256_VECTOR_ROTR(w[t - 2], 19), SHA256_VECTOR_SHR(w[t - 2], 10));
+            w[t] = SHA256_VECTOR_ADD(SHA256_VECTOR_ADD(w[t - 16], s0), SHA256_VECTOR_ADD(w[t - 7], s1));
+        }
+
+        Sha256Vector_t a = SHA256_VECTOR_LOAD(&state[0][first]);
+        Sha256Vector_t b = SHA256_VECTOR_LOAD(&state[1][first]);
+        Sha256Vector_t c = SHA256_VECTOR_LOAD(&state[2][first]);
+        Sha256Vector_t d = SHA256_VECTOR_LOAD(&state[3][first]);
+        Sha256Vector_t e = SHA256_VECTOR_LOAD(&state[4][first]);
+        Sha256Vector_t f = SHA256_VECTOR_LOAD(&state[5][first]);
+        Sha256Vector_t g = SHA256_VECTOR_LOAD(&state[6][first]);
+        Sha256Vector_t h = SHA256_VECTOR_LOAD(&state[7][first]);
+
+        for (t = 0; t < 64; t++)
+        {
+            Sha256Vector_t s1 =
+                SHA256_VECTOR_XOR3(SHA256_VECTOR_ROTR(e, 6), SHA256_VECTOR_ROTR(e, 11), SHA256_VECTOR_ROTR(e, 25));
+            Sha256Vector_t ch = SHA256_VECTOR_XOR(SHA256_VECTOR_AND(e, f), SHA256_VECTOR_ANDNOT(e, g));
+            Sha256Vector_t t1 = SHA256_VECTOR_ADD(SHA256_VECTOR_ADD(SHA256_VECTOR_ADD(h, s1), ch),
+                                                  SHA256_VECTOR_ADD(SHA256_VECTOR_SET(SHA256_K[t]), w[t]));
+            Sha256Vector_t s0 =
+                SHA256_VECTOR_XOR3(SHA256_VECTOR_ROTR(a, 2), SHA256_VECTOR_ROTR(a, 13), SHA256_VECTOR_ROTR(a, 22));
+            Sha256Vector_t maj =
+                SHA256_VECTOR_XOR3(SHA256_VECTOR_AND(a, b), SHA256_VECTOR_AND(a, c), SHA256_VECTOR_AND(b, c));
+            Sha256Vector_t t2 = SHA256_VECTOR_ADD(s0, maj);
+
+            h = g;
+            g = f;
+            f = e;
+            e = SHA256_VECTOR_ADD(d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = SHA256_VECTOR_ADD(t1, t2);
+        }
+
+        SHA256_VECTOR_STORE(&state[0][first], SHA256_VECTOR_ADD(SHA256_VECTOR_LOAD(&state[0][first]), a));
+        SHA256_VECTOR_STORE(&state[1][first], SHA256_VECTOR_ADD(SHA256_VECTOR_LOAD(&state[1][first]), b));
+        SHA256_VECTOR_STORE(&state[2][first], SHA256_VECTOR_ADD(SHA256_VECTOR_LOAD(&state[2][first]), c));
+        SHA256_VECTOR_STORE(&state[3][first], SHA256_VECTOR_ADD(SHA256_VECTOR_LOAD(&state[3][first]), d));
+        SHA256_VECTOR_STORE(&state[4][first], SHA256_VECTOR_ADD(SHA256_VECTOR_LOAD(&state[4][first]), e));
+        SHA256_VECTOR_STORE(&state[5][first], SHA256_VECTOR_ADD(SHA256_VECTOR_LOAD(&state[5][first]), f));
+        SHA256_VECTOR_STORE(&state[6][first], SHA256_VECTOR_ADD(SHA256_VECTOR_LOAD(&state[6][first]), g));
+        SHA256_VECTOR_STORE(&state[7][first], SHA256_VECTOR_ADD(SHA256_VECTOR_LOAD(&state[7][first]), h));
+    }
+}
+#else
+// Scalar fallback for targets without SSE2, AVX2 or NEON
+void AtmelAtsha204aMac_Sha256BlockBatch(uint32_t state[8][ATMEL_ATSHA204A_MAC_BATCH_SIZE],
+                                        const uint8_t blocks[ATMEL_ATSHA204A_MAC_BATCH_SIZE][SHA256_BLOCK_SIZE_BYTES])
+{
+    uint32_t w[64][ATMEL_ATSHA204A_MAC_BATCH_SIZE];
+    uint32_t a[ATMEL_ATSHA204A_MAC_BATCH_SIZE], b[ATMEL_ATSHA204A_MAC_BATCH_SIZE], c[ATMEL_ATSHA204A_MAC_BATCH_SIZE];
+    uint32_t d[ATMEL_ATSHA204A_MAC_BATCH_SIZE], e[ATMEL_ATSHA204A_MAC_BATCH_SIZE], f[ATMEL_ATSHA204A_MAC_BATCH_SIZE];
+    uint32_t g[ATMEL_ATSHA204A_MAC_BATCH_SIZE], h[ATMEL_ATSHA204A_MAC_BATCH_SIZE];
+
+    unsigned int t, index;
+    for (t = 0; t < 16; t++)
+    {
+        for (index = 0; index < ATMEL_ATSHA204A_MAC_BATCH_SIZE; index++)
+        {
+            w[t][index] = ((uint32_t)blocks[index][t * 4] << 24) | ((uint32_t)blocks[index][t * 4 + 1] << 16) |
+                          ((uint32_t)blocks[index][t * 4 + 2] << 8) | blocks[index][t * 4 + 3];
+        }
+    }
+
+    for (t = 16; t < 64; t++)
+    {
+        for (index = 0; index < ATMEL_ATSHA204A_MAC_BATCH_SIZE; index++)
+        {
+            uint32_t w15 = w[t - 15][index];
+            uint32_t w2 = w[t - 2][index];
+            w[t][index] = w[t - 16][index] + (SHA256_ROTR(w15, 7) ^ SHA256_ROTR(w15, 18) ^ (w15 >> 3)) +
+                          w[t - 7][index] + (SHA256_ROTR(w2, 17) ^ SHA256_ROTR(w2, 19) ^ (w2 >> 10));
+        }
+    }
+
+    for (index = 0; index < ATMEL_ATSHA204A_MAC_BATCH_SIZE; index++)
+    {
+        a[index] = state[0][index];
+        b[index] = state[1][index];
+        c[index] = state[2][index];
+        d[index] = state[3][index];
+        e[index] = state[4][index];
+        f[index] = state[5][index];
+        g[index] = state[6][index];
+        h[index] = state[7][index];
+    }
+
+    for (t = 0; t < 64; t++)
+    {
+        for (index = 0; index < ATMEL_ATSHA204A_MAC_BATCH_SIZE; index++)
+        {
+            uint32_t t1 = h[index] +
+                          (SHA256_ROTR(e[index], 6) ^ SHA256_ROTR(e[index], 11) ^ SHA256_ROTR(e[index], 25)) +
+                          ((e[index] & f[index]) ^ (~e[index] & g[index])) + SHA256_K[t] + w[t][index];
+            uint32_t t2 = (SHA256_ROTR(a[index], 2) ^ SHA256_ROTR(a[index], 13) ^ SHA256_ROTR(a[index], 22)) +
+                          ((a[index] & b[index]) ^ (a[index] & c[index]) ^ (b[index] & c[index]));
+
+            h[index] = g[index];
+            g[index] = f[index];
+            f[index] = e[index];
+            e[index] = d[index] + t1;
+            d[index] = c[index];
+            c[index] = b[index];
+            b[index] = a[index];
+            a[index] = t1 + t2;
+        }
+    }
+
+    for (index = 0; index < ATMEL_ATSHA204A_MAC_BATCH_SIZE; index++)
+    {
+        state[0][index] += a[index];
+        state[1][index] += b[index];
+        state[2][index] += c[index];
+        state[3][index] += d[index];
+        state[4][index] += e[index];
+        state[5][index] += f[index];
+        state[6][index] += g[index];
+        state[7][index] += h[index];
+    }
+}
+#endif
+
+
+/**
+ * \brief Store a hash state as a digest, most significant byte first.
+ *
+ * @param[in] pState	Hash state
+ * @param[out] pDigest	Buffer to receive the ATMEL_ATSHA204A_MAC_DIGEST_SIZE_BYTES digest bytes
+ */
+void AtmelAtsha204aMac_StoreDigest(const uint32_t* pState, uint8_t* pDigest)
+{
+    unsigned int wordIndex;
+    for (wordIndex = 0; wordIndex < 8; wordIndex++)
+    {
+        pDigest[wordIndex * 4] = (uint8_t)(pState[wordIndex] >> 24);
+        pDigest[wordIndex * 4 + 1] = (uint8_t)(pState[wordIndex] >> 16);
+        pDigest[wordIndex * 4 + 2] = (uint8_t)(pState[wordIndex] >> 8);
+        pDigest[wordIndex * 4 + 3] = (uint8_t)pState[wordIndex];
+    }
+}
+
+
+const char* AtmelAtsha204aMac_GetBatchImplementation()
+{
+    return SHA256_VECTOR_IMPLEMENTATION;
+}
+
+
+void AtmelAtsha204aMac_Sha256(const uint8_t* pData, uint32_t dataLengthBytes, uint8_t* pDigest)
+{
+    if ((pData == NULL) || (pDigest == NULL))
+    {
+        return;
+    }
+
+    uint32_t state[8];
+    uint8_t block[SHA256_BLOCK_SIZE_BYTES];
+    uint32_t numberOfBlocks =
+        (dataLengthBytes + 1 + SHA256_LENGTH_SIZE_BYTES + SHA256_BLOCK_SIZE_BYTES - 1) / SHA256_BLOCK_SIZE_BYTES;
+
+    memcpy(state, SHA256_H0, sizeof(state));
+
+    uint32_t blockIndex;
+    for (blockIndex = 0; blockIndex < numberOfBlocks; blockIndex++)
+    {
+        AtmelAtsha204aMac_GetPaddedBlock(pData, dataLengthBytes, blockIndex, block);
+        AtmelAtsha204aMac_Sha256Block(state, block);
+    }
+
+    AtmelAtsha204aMac_StoreDigest(state, pDigest);
+}
+
+
+void AtmelAtsha204aMac_Sha256Batch(const uint8_t* pMessages,
+                                   uint32_t messageLengthBytes,
+                                   unsigned int numberOfMessages,
+                                   uint8_t* pDigests)
+{
+    if ((pMessages == NULL) || (pDigests == NULL))
+    {
+        return;
+    }
+
+    uint32_t state[8][ATMEL_ATSHA204A_MAC_BATCH_SIZE];
+    uint8_t blocks[ATMEL_ATSHA204A_MAC_BATCH_SIZE][SHA256_BLOCK_SIZE_BYTES];
+    uint32_t numberOfBlocks =
+        (messageLengthBytes + 1 + SHA256_LENGTH_SIZE_BYTES + SHA256_BLOCK_SIZE_BYTES - 1) / SHA256_BLOCK_SIZE_BYTES;
+
+    unsigned int messageIndex = 0;
+    for (; messageIndex + ATMEL_ATSHA204A_MAC_BATCH_SIZE <= numberOfMessages;
+         messageIndex += ATMEL_ATSHA204A_MAC_BATCH_SIZE)
+    {
+        unsigned int wordIndex, index;
+        for (wordIndex = 0; wordIndex < 8; wordIndex++)
+        {
+            for (index = 0; index < ATMEL_ATSHA204A_MAC_BATCH_SIZE; index++)
+            {
+                state[wordIndex][index] = SHA256_H0[wordIndex];
+            }
+        }
+
+        uint32_t blockIndex;
+        for (blockIndex = 0; blockIndex < numberOfBlocks; blockIndex++)
+        {
+            for (index = 0; index < ATMEL_ATSHA204A_MAC_BATCH_SIZE; index++)
+            {
+                AtmelAtsha204aMac_GetPaddedBlock(&pMessages[(messageIndex + index) * messageLengthBytes],
+                                                 messageLengthBytes,
+                                                 blockIndex,
+                                                 blocks[index]);
+            }
+
+            AtmelAtsha204aMac_Sha256BlockBatch(state, (const uint8_t(*)[SHA256_BLOCK_SIZE_BYTES])blocks);
+        }
+
+        for (index = 0; index < ATMEL_ATSHA204A_MAC_BATCH_SIZE; index++)
+        {
+            uint32_t messageState[8];
+            for (wordIndex = 0; wordIndex < 8; wordIndex++)
+            {
+                messageState[wordIndex] = state[wordIndex][index];
+            }
+
+            AtmelAtsha204aMac_StoreDigest(messageState,
+                                          &pDigests[(messageIndex + index) * ATMEL_ATSHA204A_MAC_DIGEST_SIZE_BYTES]);
+        }
+    }
+
+    // The messages which do not fill a whole batch are hashed one by one
+    for (; messageIndex < numberOfMessages; messageIndex++)
+    {
+        AtmelAtsha204aMac_Sha256(&pMessages[messageIndex * messageLengthBytes],
+                                 messageLengthBytes,
+                                 &pDigests[messageIndex * ATMEL_ATSHA204A_MAC_DIGEST_SIZE_BYTES]);
+    }
+}
+
+
+EN_RESULT AtmelAtsha204aMac_CalculateNonceTempKey(const uint8_t* pRandOut,
+                                                  const uint8_t* pNumIn,
+                                                  ENonceMode_t mode,
+                                                  uint8_t* pTempKey)
+{
+    if ((pRandOut == NULL) || (pNumIn == NULL) || (pTempKey == NULL))
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    if ((mode != ENonceMode_UpdateSeed) && (mode != ENonceMode_NoSeedUpdate))
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    // TempKey = SHA-256(RandOut || NumIn || opcode || mode || 0x00)
+    uint8_t message[NONCE_MESSAGE_SIZE_BYTES];
+    memcpy(&message[0], pRandOut, ATMEL_ATSHA204A_RANDOM_SIZE_BYTES);
+    memcpy(&message[ATMEL_ATSHA204A_RANDOM_SIZE_BYTES], pNumIn, ATMEL_ATSHA204A_NONCE_INPUT_SIZE_BYTES);
+    message[52] = ECommand_Nonce;
+    message[53] = (uint8_t)mode;
+    message[54] = 0x00;
+
+    AtmelAtsha204aMac_Sha256(message, sizeof(message), pTempKey);
+
+    return EN_SUCCESS;
+}
+
+
+EN_RESULT AtmelAtsha204aMac_BuildMessage(const AtmelAtsha204aMacCheck_t* pCheck, uint8_t* pMessage)
+{
+    if ((pCheck == NULL) || (pCheck->pDevice == NULL) || (pCheck->pKey == NULL) || (pCheck->pChallenge == NULL) ||
+        (pMessage == NULL))
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    const uint8_t* pSerialNumber = pCheck->pDevice->serialNumber;
+    const uint8_t* pOtp = pCheck->pDevice->otp;
+    bool includeOtp88Bits = (pCheck->mode & EMacMode_IncludeOtp88Bits) != 0;
+    bool includeOtp64Bits = includeOtp88Bits || ((pCheck->mode & EMacMode_IncludeOtp64Bits) != 0);
+    bool includeSerialNumber = (pCheck->mode & EMacMode_IncludeSerialNumber) != 0;
+
+    // Key, challenge, opcode, mode, key ID (lower byte first), OTP[0:7], OTP[8:10], SN[8], SN[4:7], SN[0:1] and
+    // SN[2:3]; the optional parts are zero if they are not included
+    memset(pMessage, 0, ATMEL_ATSHA204A_MAC_MESSAGE_SIZE_BYTES);
+    memcpy(&pMessage[0], pCheck->pKey, 32);
+    memcpy(&pMessage[32], pCheck->pChallenge, 32);
+    pMessage[64] = ECommand_Mac;
+    pMessage[65] = pCheck->mode;
+    pMessage[66] = (uint8_t)pCheck->keyId;
+    pMessage[67] = (uint8_t)(pCheck->keyId >> 8);
+
+    if (includeOtp64Bits)
+    {
+        memcpy(&pMessage[68], &pOtp[0], 8);
+    }
+
+    if (includeOtp88Bits)
+    {
+        memcpy(&pMessage[76], &pOtp[8], 3);
+    }
+
+    pMessage[79] = pSerialNumber[8];
+
+    if (includeSerialNumber)
+    {
+        memcpy(&pMessage[80], &pSerialNumber[4], 4);
+    }
+
+    pMessage[84] = pSerialNumber[0];
+    pMessage[85] = pSerialNumber[1];
+
+    if (includeSerialNumber)
+    {
+        pMessage[86] = pSerialNumber[2];
+        pMessage[87] = pSerialNumber[3];
+    }
+
+    return EN_SUCCESS;
+}
+
+
+EN_RESULT AtmelAtsha204aMac_VerifyBatch(const AtmelAtsha204aMacCheck_t* pChecks,
+                                        unsigned int numberOfChecks,
+                                        bool* pValid)
+{
+    if ((pChecks == NULL) || (pValid == NULL))
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    uint8_t messages[ATMEL_ATSHA204A_MAC_BATCH_SIZE][ATMEL_ATSHA204A_MAC_MESSAGE_SIZE_BYTES];
+    uint8_t digests[ATMEL_ATSHA204A_MAC_BATCH_SIZE][ATMEL_ATSHA204A_MAC_DIGEST_SIZE_BYTES];
+
+    unsigned int checkIndex;
+    for (checkIndex = 0; checkIndex < numberOfChecks; checkIndex += ATMEL_ATSHA204A_MAC_BATCH_SIZE)
+    {
+        unsigned int numberOfMessages = numberOfChecks - checkIndex;
+        if (numberOfMessages > ATMEL_ATSHA204A_MAC_BATCH_SIZE)
+        {
+            numberOfMessages = ATMEL_ATSHA204A_MAC_BATCH_SIZE;
+        }
+
+        unsigned int index;
+        for (index = 0; index < numberOfMessages; index++)
+        {
+            EN_RETURN_IF_FAILED(AtmelAtsha204aMac_BuildMessage(&pChecks[checkIndex + index], messages[index]));
+
+            if (pChecks[checkIndex + index].pResponse == NULL)
+            {
+                return EN_ERROR_NULL_POINTER;
+            }
+        }
+
+        AtmelAtsha204aMac_Sha256Batch(
+            (const uint8_t*)messages, ATMEL_ATSHA204A_MAC_MESSAGE_SIZE_BYTES, numberOfMessages, (uint8_t*)digests);
+
+        for (index = 0; index < numberOfMessages; index++)
+        {
+            const uint8_t* pResponse = pChecks[checkIndex + index].pResponse;
+
+            // Compare all bytes, so that the time taken does not depend on where the first difference is
+            uint8_t difference = 0;
+
+            unsigned int byteIndex;
+            for (byteIndex = 0; byteIndex < ATMEL_ATSHA204A_MAC_DIGEST_SIZE_BYTES; byteIndex++)
+            {
+                difference |= digests[index][byteIndex] ^ pResponse[byteIndex];
+            }
+
+            pValid[checkIndex + index] = (difference == 0);
+        }
+    }
+
+    return EN_SUCCESS;
+}
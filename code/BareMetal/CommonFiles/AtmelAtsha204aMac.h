@@ -0,0 +1,170 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+#pragma once
+
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "AtmelAtsha204aTypes.h"
+#include "StandardIncludes.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+
+/// Size of a SHA-256 digest
+#define ATMEL_ATSHA204A_MAC_DIGEST_SIZE_BYTES (32)
+
+/// Size of the message digested by the MAC command
+#define ATMEL_ATSHA204A_MAC_MESSAGE_SIZE_BYTES (88)
+
+/// Size of the serial number, SN[0:8]
+#define ATMEL_ATSHA204A_MAC_SERIAL_NUMBER_SIZE_BYTES (9)
+
+/// Number of OTP bytes which may be included in the message, OTP[0:10]
+#define ATMEL_ATSHA204A_MAC_OTP_SIZE_BYTES (11)
+
+/// Number of messages which are hashed together by the batched SHA-256. Their hash states are kept interleaved, so
+/// that AVX2 processes all of them, and SSE2 or NEON half of them, with one instruction.
+#define ATMEL_ATSHA204A_MAC_BATCH_SIZE (8)
+
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Data of a device which enters the MAC message: serial number and OTP zone.
+ */
+typedef struct
+{
+    /// Serial number SN[0:8]: configuration zone bytes 0..3 and 8..12
+    uint8_t serialNumber[ATMEL_ATSHA204A_MAC_SERIAL_NUMBER_SIZE_BYTES];
+
+    /// OTP[0:10]: the first bytes of the OTP zone
+    uint8_t otp[ATMEL_ATSHA204A_MAC_OTP_SIZE_BYTES];
+} AtmelAtsha204aMacDevice_t;
+
+
+/**
+ * \brief A MAC response of a device to verify.
+ */
+typedef struct
+{
+    /// Device which computed the MAC
+    const AtmelAtsha204aMacDevice_t* pDevice;
+
+    /// Mode of the MAC command; a combination of EMacMode_t bits
+    uint8_t mode;
+
+    /// Key ID (param 2) of the MAC command
+    uint16_t keyId;
+
+    /// First 32 bytes of the message: the key in the slot, or TempKey if EMacMode_TempKeyKey is set
+    const uint8_t* pKey;
+
+    /// Second 32 bytes of the message: the challenge, or TempKey if EMacMode_TempKeyChallenge is set
+    const uint8_t* pChallenge;
+
+    /// MAC returned by the device
+    const uint8_t* pResponse;
+} AtmelAtsha204aMacCheck_t;
+
+
+//-------------------------------------------------------------------------------------------------
+// Function declarations
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Calculate the SHA-256 digest of a message.
+ *
+ * @param[in] pData				Message
+ * @param[in] dataLengthBytes	The number of bytes
+ * @param[out] pDigest			Buffer to receive the ATMEL_ATSHA204A_MAC_DIGEST_SIZE_BYTES digest bytes
+ */
+void AtmelAtsha204aMac_Sha256(const uint8_t* pData, uint32_t dataLengthBytes, uint8_t* pDigest);
+
+
+/**
+ * \brief Get the instruction set used by the batched SHA-256, selected at compile time.
+ *
+ * @return	"AVX2", "SSE2", "NEON" or "scalar"
+ */
+const char* AtmelAtsha204aMac_GetBatchImplementation();
+
+
+/**
+ * \brief Calculate the SHA-256 digests of messages of the same length.
+ *
+ * The messages are hashed ATMEL_ATSHA204A_MAC_BATCH_SIZE at a time; the remaining ones are hashed one by one.
+ *
+ * @param[in] pMessages				Messages, one after the other
+ * @param[in] messageLengthBytes	Length of each message
+ * @param[in] numberOfMessages		The number of messages
+ * @param[out] pDigests				Buffer to receive the ATMEL_ATSHA204A_MAC_DIGEST_SIZE_BYTES digest bytes of each
+ *									message, one after the other
+ */
+void AtmelAtsha204aMac_Sha256Batch(const uint8_t* pMessages,
+                                   uint32_t messageLengthBytes,
+                                   unsigned int numberOfMessages,
+                                   uint8_t* pDigests);
+
+
+/**
+ * \brief Calculate TempKey as loaded by a Nonce command which combines the input with a random number.
+ *
+ * @param[in] pRandOut		The ATMEL_ATSHA204A_RANDOM_SIZE_BYTES random bytes returned by the Nonce command
+ * @param[in] pNumIn		The ATMEL_ATSHA204A_NONCE_INPUT_SIZE_BYTES input bytes of the Nonce command
+ * @param[in] mode			Nonce mode; ENonceMode_UpdateSeed or ENonceMode_NoSeedUpdate
+ * @param[out] pTempKey		Buffer to receive the ATMEL_ATSHA204A_MAC_DIGEST_SIZE_BYTES TempKey bytes
+ * @return					Result code
+ */
+EN_RESULT AtmelAtsha204aMac_CalculateNonceTempKey(const uint8_t* pRandOut,
+                                                  const uint8_t* pNumIn,
+                                                  ENonceMode_t mode,
+                                                  uint8_t* pTempKey);
+
+
+/**
+ * \brief Build the message digested by the MAC command, as the device does.
+ *
+ * @param[in] pCheck		MAC command parameters; the response is not used
+ * @param[out] pMessage		Buffer to receive the ATMEL_ATSHA204A_MAC_MESSAGE_SIZE_BYTES message bytes
+ * @return					Result code
+ */
+EN_RESULT AtmelAtsha204aMac_BuildMessage(const AtmelAtsha204aMacCheck_t* pCheck, uint8_t* pMessage);
+
+
+/**
+ * \brief Verify MAC responses by computing the expected digests, ATMEL_ATSHA204A_MAC_BATCH_SIZE at a time.
+ *
+ * @param[in] pChecks			MAC responses to verify
+ * @param[in] numberOfChecks	The number of responses
+ * @param[out] pValid			Set to true for each response which matches the expected digest
+ * @return						Result code; EN_SUCCESS even if a response does not match
+ */
+EN_RESULT AtmelAtsha204aMac_VerifyBatch(const AtmelAtsha204aMacCheck_t* pChecks,
+                                        unsigned int numberOfChecks,
+                                        bool* pValid);
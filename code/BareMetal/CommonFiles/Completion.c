@@ -0,0 +1,234 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "Completion.h"
+#include "TimerInterface.h"
+
+#if SYSTEM == LINUX_USERSPACE
+#include <pthread.h>
+#include <time.h>
+#elif defined(__arm__)
+#include "InterruptController.h"
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Macros
+//-------------------------------------------------------------------------------------------------
+
+#if SYSTEM != LINUX_USERSPACE
+#if defined(__aarch64__)
+
+/// Sleep until an event is received. The generic timer event stream (see InitialiseTimer()) guarantees
+/// a periodic wake-up, so the timeout is checked even if the completion is never signalled.
+#define COMPLETION_WAIT_FOR_EVENT() __asm__ volatile("wfe" ::: "memory")
+#define COMPLETION_SEND_EVENT() __asm__ volatile("dsb sy\n\tsev" ::: "memory")
+
+#elif defined(__arm__)
+
+/// Sleep until an interrupt is pending. The completion is signalled from the I2C interrupt, which wakes
+/// the core, and the one-shot wake-up timer armed at the timeout (see StartWakeUpTimer()) guarantees a
+/// wake-up, so the timeout is checked even if the completion is never signalled. No event needs to be sent.
+#define COMPLETION_WAIT_FOR_INTERRUPT() __asm__ volatile("dsb\n\twfi" ::: "memory")
+#define COMPLETION_SEND_EVENT()
+
+#else
+
+#define COMPLETION_WAIT_FOR_EVENT()
+#define COMPLETION_SEND_EVENT()
+
+#endif
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Global variable definitions
+//-------------------------------------------------------------------------------------------------
+
+#if SYSTEM == LINUX_USERSPACE
+/// Guards the one-time initialisation of the condition variable
+static pthread_once_t g_completionOnce = PTHREAD_ONCE_INIT;
+
+/// True if the condition variable was initialised successfully
+static bool g_completionConditionInitialised = false;
+
+/// Mutex protecting the signalled flags of all completions
+static pthread_mutex_t g_completionMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/// Condition variable used to wake the waiting threads of all completions
+static pthread_cond_t g_completionCondition;
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+#if SYSTEM == LINUX_USERSPACE
+/**
+ * \brief Initialise the condition variable shared by all completions. Called once, through pthread_once().
+ */
+static void Completion_InitialiseCondition()
+{
+    pthread_condattr_t conditionAttributes;
+
+    if (pthread_condattr_init(&conditionAttributes) != 0)
+    {
+        return;
+    }
+
+    // Timeouts are measured with the monotonic clock, so that they are not affected by changes to the system time.
+    if ((pthread_condattr_setclock(&conditionAttributes, CLOCK_MONOTONIC) == 0) &&
+        (pthread_cond_init(&g_completionCondition, &conditionAttributes) == 0))
+    {
+        g_completionConditionInitialised = true;
+    }
+
+    pthread_condattr_destroy(&conditionAttributes);
+}
+#endif
+
+EN_RESULT Completion_Initialise(Completion_t* pCompletion)
+{
+    if (pCompletion == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+#if SYSTEM == LINUX_USERSPACE
+    // The synchronisation objects are shared by all completions and created only once, so that initialising a
+    // completion for every transaction neither allocates nor leaks anything. A completion is signalled rarely
+    // and waited for by one thread, so waking all waiters to re-check their own flag costs nothing in practice.
+    pthread_once(&g_completionOnce, Completion_InitialiseCondition);
+    if (!g_completionConditionInitialised)
+    {
+        return EN_ERROR_FAILED_TO_INITIALISE_COMPLETION;
+    }
+#endif
+
+    Completion_Reset(pCompletion);
+
+    return EN_SUCCESS;
+}
+
+void Completion_Reset(Completion_t* pCompletion)
+{
+#if SYSTEM == LINUX_USERSPACE
+    pthread_mutex_lock(&g_completionMutex);
+    pCompletion->signalled = false;
+    pthread_mutex_unlock(&g_completionMutex);
+#else
+    pCompletion->signalled = false;
+#endif
+}
+
+void Completion_Signal(Completion_t* pCompletion)
+{
+#if SYSTEM == LINUX_USERSPACE
+    pthread_mutex_lock(&g_completionMutex);
+    pCompletion->signalled = true;
+    pthread_cond_broadcast(&g_completionCondition);
+    pthread_mutex_unlock(&g_completionMutex);
+#else
+    pCompletion->signalled = true;
+
+    // Wake the waiting code on AArch64. If it has not yet reached its WFE instruction, the event is latched and
+    // the WFE returns immediately, so the signal cannot be lost. On the Cortex-A9, the interrupt which calls
+    // this function has already woken the waiting code.
+    COMPLETION_SEND_EVENT();
+#endif
+}
+
+bool Completion_IsSignalled(Completion_t* pCompletion)
+{
+    return pCompletion->signalled;
+}
+
+EN_RESULT Completion_Wait(Completion_t* pCompletion, uint32_t timeoutMicroseconds)
+{
+#if SYSTEM == LINUX_USERSPACE
+    struct timespec deadline;
+    EN_RESULT result = EN_SUCCESS;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeoutMicroseconds / 1000000;
+    deadline.tv_nsec += (long)(timeoutMicroseconds % 1000000) * 1000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&g_completionMutex);
+    while (!pCompletion->signalled)
+    {
+        if (pthread_cond_timedwait(&g_completionCondition, &g_completionMutex, &deadline) != 0)
+        {
+            // Timed out; the completion may still have been signalled at the last moment.
+            if (!pCompletion->signalled)
+            {
+                result = EN_ERROR_TIMEOUT;
+            }
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_completionMutex);
+
+    return result;
+#else
+    uint64_t startTime = GetTimeMicroseconds();
+    EN_RESULT result = EN_SUCCESS;
+
+    while (!pCompletion->signalled)
+    {
+        uint64_t elapsedTime = GetTimeMicroseconds() - startTime;
+        if (elapsedTime > timeoutMicroseconds)
+        {
+            result = pCompletion->signalled ? EN_SUCCESS : EN_ERROR_TIMEOUT;
+            break;
+        }
+
+#if defined(__arm__)
+        // Interrupts are masked between the check and the WFI instruction, so that an interrupt signalling
+        // the completion in between cannot be lost: a pending interrupt still ends the WFI, and its handler
+        // runs as soon as the interrupts are restored. The wake-up timer is re-armed for the remaining time
+        // on every pass, as the core may have been woken by an unrelated interrupt.
+        uint32_t interruptState = DisableInterrupts();
+        if (!pCompletion->signalled)
+        {
+            StartWakeUpTimer((uint32_t)(timeoutMicroseconds - elapsedTime) + 1);
+            COMPLETION_WAIT_FOR_INTERRUPT();
+        }
+        RestoreInterrupts(interruptState);
+#else
+        COMPLETION_WAIT_FOR_EVENT();
+#endif
+    }
+
+#if defined(__arm__)
+    StopWakeUpTimer();
+#endif
+
+    return result;
+#endif
+}
@@ -64,6 +64,8 @@ typedef u64 uint64_t;
 
 #define true 1
 #define false 0
+#elif SYSTEM == LINUX_USERSPACE
+#include <stdint.h>
 #endif
 
 #ifndef __cplusplus
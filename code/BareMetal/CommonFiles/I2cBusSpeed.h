@@ -0,0 +1,115 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "StandardIncludes.h"
+#include "ErrorCodes.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/// SCL frequency of standard mode
+#define I2C_STANDARD_MODE_CLOCK_SPEED_HZ 100000
+
+/// SCL frequency of fast mode
+#define I2C_FAST_MODE_CLOCK_SPEED_HZ 400000
+
+/// SCL frequency of fast mode plus
+#define I2C_FAST_MODE_PLUS_CLOCK_SPEED_HZ 1000000
+
+/// Number of consecutive failed transfers to a device after which its SCL frequency is lowered
+#define I2C_BUS_SPEED_FALLBACK_ERROR_COUNT 3
+
+/// Multiplexer channel value meaning that no channel is selected, i.e. only the module bus segment is connected
+#define I2C_MUX_CHANNEL_NONE 0xFF
+
+/// Multiplexer channel value of devices whose address is unique, so that they match whatever channel is selected
+#define I2C_MUX_CHANNEL_ANY 0xFE
+
+
+//-------------------------------------------------------------------------------------------------
+// Function declarations
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Initialise the device speed table. Every known device is set to the highest SCL frequency it
+ * supports, limited to the highest frequency of the I2C controller.
+ *
+ * \param	defaultClockSpeedHz		SCL frequency for devices which are not in the table
+ * \param	maxClockSpeedHz			Highest SCL frequency supported by the I2C controller
+ */
+void I2cBusSpeed_Initialise(uint32_t defaultClockSpeedHz, uint32_t maxClockSpeedHz);
+
+
+/**
+ * \brief Get the SCL frequency at which to transfer data to or from a device.
+ *
+ * The device is looked up by its address on the currently selected multiplexer channel (see
+ * I2cBusSpeed_SetMuxChannel()).
+ *
+ * \param	deviceAddress	Device address
+ * \returns					SCL frequency in Hz
+ */
+uint32_t I2cBusSpeed_GetClockSpeed(uint8_t deviceAddress);
+
+
+/**
+ * \brief Report the result of a transfer to a device.
+ *
+ * After I2C_BUS_SPEED_FALLBACK_ERROR_COUNT consecutive NACKs or lost arbitrations, the device falls back
+ * to the next lower SCL frequency, down to standard mode. NACKs are not counted for devices which NACK
+ * their address while busy, as these are expected during acknowledge polling.
+ *
+ * \param	deviceAddress	Device address
+ * \param	result			Result code of the transfer
+ */
+void I2cBusSpeed_ReportResult(uint8_t deviceAddress, EN_RESULT result);
+
+
+/**
+ * \brief Set the SCL frequency of a device, e.g. to restore it after a fall back or to lower it for a
+ * board with a long bus. The frequency is limited to the highest frequency of the device and the controller.
+ *
+ * \param	deviceAddress	Device address; must be in the device speed table for the current multiplexer channel
+ * \param	clockSpeedHz	SCL frequency in Hz
+ * \returns					Result code
+ */
+EN_RESULT I2cBusSpeed_SetClockSpeed(uint8_t deviceAddress, uint32_t clockSpeedHz);
+
+
+/**
+ * \brief Set the multiplexer channel through which the following transfers are made, so that devices behind
+ * the multiplexer are told apart from module devices at the same address.
+ *
+ * Called by the multiplexer driver once the channel is selected. Transfers submitted before the channel
+ * change must have completed.
+ *
+ * \param	muxChannel		Selected channel, or I2C_MUX_CHANNEL_NONE if no channel is selected
+ */
+void I2cBusSpeed_SetMuxChannel(uint8_t muxChannel);
@@ -54,3 +54,22 @@
  * @return Result code
  */
 EN_RESULT SetupInterruptSystem();
+
+
+/**
+ * \brief Disable interrupts, to protect a critical section.
+ *
+ * May be called from interrupt context. Calls may be nested, as long as each call is matched by a
+ * call to RestoreInterrupts() with the returned state.
+ *
+ * @return The previous interrupt state, to be passed to RestoreInterrupts()
+ */
+uint32_t DisableInterrupts();
+
+
+/**
+ * \brief Restore the interrupt state at the end of a critical section.
+ *
+ * @param	previousState	Interrupt state returned by DisableInterrupts()
+ */
+void RestoreInterrupts(uint32_t previousState);
@@ -150,18 +150,64 @@ static inline ProductNumberInfo_t ParseProductNumber(uint32_t productNumber)
     return productNumberInfo;
 }
 
+
+/**
+ * \brief Struct describing the configuration layout of a module family.
+ */
+typedef struct
+{
+    /// Product family code of the module family, as stored in the product number
+    const uint16_t productFamilyCode;
+
+    /// Module name
+    const char* pModuleName;
+
+    /// Array of configuration properties
+    ModuleConfigProperty_t* pConfigProperties;
+
+    /// The number of configuration properties
+    const uint8_t propertyCount;
+
+    /// The number of configuration bytes
+    const uint8_t configPropertiesLengthBytes;
+} ModuleConfigLayout_t;
+
+
+/// The number of module families with a configuration layout
+#define MODULE_CONFIG_LAYOUT_COUNT 21
+
+/// Address of the configuration data, which is the same for all module families
+#define CONFIG_PROPERTIES_START_ADDRESS 0x08
+
+/// The largest number of configuration bytes of all module families
+#define MAX_CONFIG_PROPERTIES_LENGTH_BYTES 7
+
+
+/**
+ * \brief Find the configuration layout of a module family.
+ *
+ * @param productFamilyCode		Product family code
+ * @return						Configuration layout, or NULL if the module family is not known
+ */
+const ModuleConfigLayout_t* ModuleConfig_FindLayout(uint16_t productFamilyCode);
+
 //-------------------------------------------------------------------------------------------------
 // Global variables
 //-------------------------------------------------------------------------------------------------
 
-/// Pointer to array of configuration properties.
+/// Configuration layouts of all module families, sorted by product family code
+extern const ModuleConfigLayout_t MODULE_CONFIG_LAYOUTS[];
+
+/// Configuration layout of the module, selected from its product number; NULL until the product number has been read
+extern const ModuleConfigLayout_t* g_pModuleConfigLayout;
+
+/// Pointer to array of configuration properties of the module; NULL until the product number has been read
 extern ModuleConfigProperty_t* g_pConfigProperties;
 
 //-------------------------------------------------------------------------------------------------
 // Cosmos XZQ10
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == COSMOS_XZQ10
 extern char COSMOS_XZQ10_MODULE_NAME[];
 extern ModuleConfigProperty_t COSMOS_XZQ10_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t COSMOS_XZQ10_SOC_TYPE_VALUE_KEY[];
@@ -194,19 +240,17 @@ extern const ModulePropertyValueKey_t COSMOS_XZQ10_SYSTEM_MONITOR_EQUIPPED_VALUE
 #define COSMOS_XZQ10_CONFIG_PROPERTY_INDEX_EMMC_FLASH_SIZE_GB 11
 #define COSMOS_XZQ10_CONFIG_PROPERTY_INDEX_USB_C_POWER_MODE 12
 #define COSMOS_XZQ10_CONFIG_PROPERTY_INDEX_USB_C_EQUIPPED 13
-#define COSMOS_XZQ10_CONFIG_PROPERTY_INDEX_SFP+_PORTS_EQUIPPED 14
-#define COSMOS_XZQ10_CONFIG_PROPERTY_INDEX_QSFP+_PORT_EQUIPPED 15
+#define COSMOS_XZQ10_CONFIG_PROPERTY_INDEX_SFP_PORTS_EQUIPPED 14
+#define COSMOS_XZQ10_CONFIG_PROPERTY_INDEX_QSFP_PORT_EQUIPPED 15
 #define COSMOS_XZQ10_CONFIG_PROPERTY_INDEX_FMC0_CONNECTOR_EQUIPPED 16
 #define COSMOS_XZQ10_CONFIG_PROPERTY_INDEX_FMC1_CONNECTOR_EQUIPPED 17
 #define COSMOS_XZQ10_CONFIG_PROPERTY_INDEX_MGT_MULTIPLEXERS_EQUIPPED 18
 #define COSMOS_XZQ10_CONFIG_PROPERTY_INDEX_SYSTEM_MONITOR_EQUIPPED 19
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars AX3
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_AX3
 extern char MARS_AX3_MODULE_NAME[];
 extern ModuleConfigProperty_t MARS_AX3_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MARS_AX3_FPGA_TYPE_VALUE_KEY[];
@@ -227,13 +271,11 @@ extern const ModulePropertyValueKey_t MARS_AX3_REAL_TIME_CLOCK_EQUIPPED_VALUE_KE
 #define MARS_AX3_CONFIG_PROPERTY_INDEX_REAL_TIME_CLOCK_EQUIPPED 6
 #define MARS_AX3_CONFIG_PROPERTY_INDEX_DDR3_RAM_SIZE_MB 7
 #define MARS_AX3_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 8
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars MX1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_MX1
 extern char MARS_MX1_MODULE_NAME[];
 extern ModuleConfigProperty_t MARS_MX1_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MARS_MX1_FPGA_TYPE_VALUE_KEY[];
@@ -254,13 +296,11 @@ extern const ModulePropertyValueKey_t MARS_MX1_REAL_TIME_CLOCK_EQUIPPED_VALUE_KE
 #define MARS_MX1_CONFIG_PROPERTY_INDEX_REAL_TIME_CLOCK_EQUIPPED 6
 #define MARS_MX1_CONFIG_PROPERTY_INDEX_DDR2_RAM_SIZE_MB 7
 #define MARS_MX1_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 8
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars MX2
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_MX2
 extern char MARS_MX2_MODULE_NAME[];
 extern ModuleConfigProperty_t MARS_MX2_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MARS_MX2_FPGA_TYPE_VALUE_KEY[];
@@ -281,13 +321,11 @@ extern const ModulePropertyValueKey_t MARS_MX2_REAL_TIME_CLOCK_EQUIPPED_VALUE_KE
 #define MARS_MX2_CONFIG_PROPERTY_INDEX_REAL_TIME_CLOCK_EQUIPPED 6
 #define MARS_MX2_CONFIG_PROPERTY_INDEX_DDR2_RAM_SIZE_MB 7
 #define MARS_MX2_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 8
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars ZX2
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_ZX2
 extern char MARS_ZX2_MODULE_NAME[];
 extern ModuleConfigProperty_t MARS_ZX2_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MARS_ZX2_SOC_TYPE_VALUE_KEY[];
@@ -309,13 +347,11 @@ extern const ModulePropertyValueKey_t MARS_ZX2_REAL_TIME_CLOCK_EQUIPPED_VALUE_KE
 #define MARS_ZX2_CONFIG_PROPERTY_INDEX_USB_2_0_PORT_COUNT 7
 #define MARS_ZX2_CONFIG_PROPERTY_INDEX_DDR3_RAM_SIZE_MB 8
 #define MARS_ZX2_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 9
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars ZX3
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_ZX3
 extern char MARS_ZX3_MODULE_NAME[];
 extern ModuleConfigProperty_t MARS_ZX3_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MARS_ZX3_SOC_TYPE_VALUE_KEY[];
@@ -338,13 +374,11 @@ extern const ModulePropertyValueKey_t MARS_ZX3_REAL_TIME_CLOCK_EQUIPPED_VALUE_KE
 #define MARS_ZX3_CONFIG_PROPERTY_INDEX_DDR3_RAM_SIZE_MB 8
 #define MARS_ZX3_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 9
 #define MARS_ZX3_CONFIG_PROPERTY_INDEX_NAND_FLASH_SIZE_MB 10
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury AA1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_AA1
 extern char MERCURY_AA1_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_AA1_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_AA1_SOC_TYPE_VALUE_KEY[];
@@ -368,13 +402,11 @@ extern const ModulePropertyValueKey_t MERCURY_AA1_REAL_TIME_CLOCK_EQUIPPED_VALUE
 #define MERCURY_AA1_CONFIG_PROPERTY_INDEX_DDR4_ECC_RAM_SIZE_GB 9
 #define MERCURY_AA1_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 10
 #define MERCURY_AA1_CONFIG_PROPERTY_INDEX_EMMC_FLASH_SIZE_GB 11
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury CA1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_CA1
 extern char MERCURY_CA1_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_CA1_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_CA1_FPGA_TYPE_VALUE_KEY[];
@@ -396,13 +428,11 @@ extern const ModulePropertyValueKey_t MERCURY_CA1_REAL_TIME_CLOCK_EQUIPPED_VALUE
 #define MERCURY_CA1_CONFIG_PROPERTY_INDEX_USB_2_0_DEVICE_PORT_COUNT 7
 #define MERCURY_CA1_CONFIG_PROPERTY_INDEX_DDR2_RAM_SIZE_MB 8
 #define MERCURY_CA1_CONFIG_PROPERTY_INDEX_SPI_FLASH_SIZE_MB 9
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury KX1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_KX1
 extern char MERCURY_KX1_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_KX1_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_KX1_FPGA_TYPE_VALUE_KEY[];
@@ -425,13 +455,11 @@ extern const ModulePropertyValueKey_t MERCURY_KX1_REAL_TIME_CLOCK_EQUIPPED_VALUE
 #define MERCURY_KX1_CONFIG_PROPERTY_INDEX_DDR3_RAM_SIZE_MB 8
 #define MERCURY_KX1_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 9
 #define MERCURY_KX1_CONFIG_PROPERTY_INDEX_SECONDARY_DDR3_RAM_SIZE_MB 10
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury KX2
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_KX2
 extern char MERCURY_KX2_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_KX2_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_KX2_FPGA_TYPE_VALUE_KEY[];
@@ -451,13 +479,11 @@ extern const ModulePropertyValueKey_t MERCURY_KX2_REAL_TIME_CLOCK_EQUIPPED_VALUE
 #define MERCURY_KX2_CONFIG_PROPERTY_INDEX_USB_2_0_DEVICE_PORT_COUNT 6
 #define MERCURY_KX2_CONFIG_PROPERTY_INDEX_DDR3_RAM_SIZE_MB 7
 #define MERCURY_KX2_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 8
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU1
 extern char MERCURY_XU1_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_XU1_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_XU1_MPSOC_TYPE_VALUE_KEY[];
@@ -465,10 +491,11 @@ extern const ModulePropertyValueKey_t MERCURY_XU1_TEMPERATURE_GRADE_VALUE_KEY[];
 extern const ModulePropertyValueKey_t MERCURY_XU1_POWER_GRADE_VALUE_KEY[];
 extern const ModulePropertyValueKey_t MERCURY_XU1_REAL_TIME_CLOCK_EQUIPPED_VALUE_KEY[];
 extern const ModulePropertyValueKey_t MERCURY_XU1_EXTENDED_MGT_ROUTING_VALUE_KEY[];
+extern const ModulePropertyValueKey_t MERCURY_XU1_DDR4_ECC_ENABLED_VALUE_KEY[];
 #define MERCURY_XU1_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS 28
 #define MERCURY_XU1_CONFIG_PROPERTIES_LENGTH_BYTES 5
 #define MERCURY_XU1_CONFIG_PROPERTIES_START_ADDRESS 0x00000008
-#define MERCURY_XU1_PROPERTY_COUNT 11
+#define MERCURY_XU1_PROPERTY_COUNT 12
 #define MERCURY_XU1_CONFIG_PROPERTY_INDEX_MPSOC_TYPE 0
 #define MERCURY_XU1_CONFIG_PROPERTY_INDEX_MPSOC_SPEED_GRADE 1
 #define MERCURY_XU1_CONFIG_PROPERTY_INDEX_TEMPERATURE_GRADE 2
@@ -476,17 +503,16 @@ extern const ModulePropertyValueKey_t MERCURY_XU1_EXTENDED_MGT_ROUTING_VALUE_KEY
 #define MERCURY_XU1_CONFIG_PROPERTY_INDEX_GIGABIT_ETHERNET_PORT_COUNT 4
 #define MERCURY_XU1_CONFIG_PROPERTY_INDEX_REAL_TIME_CLOCK_EQUIPPED 5
 #define MERCURY_XU1_CONFIG_PROPERTY_INDEX_EXTENDED_MGT_ROUTING 6
-#define MERCURY_XU1_CONFIG_PROPERTY_INDEX_USB_2_0_PORT_COUNT 7
-#define MERCURY_XU1_CONFIG_PROPERTY_INDEX_DDR4_ECC_RAM_SIZE_GB 8
-#define MERCURY_XU1_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 9
-#define MERCURY_XU1_CONFIG_PROPERTY_INDEX_EMMC_FLASH_SIZE_GB 10
-#endif
+#define MERCURY_XU1_CONFIG_PROPERTY_INDEX_DDR4_ECC_ENABLED 7
+#define MERCURY_XU1_CONFIG_PROPERTY_INDEX_USB_2_0_PORT_COUNT 8
+#define MERCURY_XU1_CONFIG_PROPERTY_INDEX_DDR4_RAM_SIZE_GB 9
+#define MERCURY_XU1_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 10
+#define MERCURY_XU1_CONFIG_PROPERTY_INDEX_EMMC_FLASH_SIZE_GB 11
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU5
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU5
 extern char MERCURY_XU5_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_XU5_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_XU5_MPSOC_TYPE_VALUE_KEY[];
@@ -510,13 +536,11 @@ extern const ModulePropertyValueKey_t MERCURY_XU5_ALTERNATIVE_MGT_ROUTING_VALUE_
 #define MERCURY_XU5_CONFIG_PROPERTY_INDEX_DDR4_RAM_PL_SIZE_MB 9
 #define MERCURY_XU5_CONFIG_PROPERTY_INDEX_EMMC_FLASH_SIZE_GB 10
 #define MERCURY_XU5_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 11
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU7
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU7
 extern char MERCURY_XU7_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_XU7_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_XU7_MPSOC_TYPE_VALUE_KEY[];
@@ -538,13 +562,11 @@ extern const ModulePropertyValueKey_t MERCURY_XU7_REAL_TIME_CLOCK_EQUIPPED_VALUE
 #define MERCURY_XU7_CONFIG_PROPERTY_INDEX_DDR4_RAM_PL_SIZE_GB 8
 #define MERCURY_XU7_CONFIG_PROPERTY_INDEX_EMMC_FLASH_SIZE_GB 9
 #define MERCURY_XU7_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 10
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU8
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU8
 extern char MERCURY_XU8_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_XU8_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_XU8_MPSOC_TYPE_VALUE_KEY[];
@@ -566,13 +588,11 @@ extern const ModulePropertyValueKey_t MERCURY_XU8_REAL_TIME_CLOCK_EQUIPPED_VALUE
 #define MERCURY_XU8_CONFIG_PROPERTY_INDEX_DDR4_RAM_PL_SIZE_GB 8
 #define MERCURY_XU8_CONFIG_PROPERTY_INDEX_EMMC_FLASH_SIZE_GB 9
 #define MERCURY_XU8_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 10
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU9
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU9
 extern char MERCURY_XU9_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_XU9_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_XU9_MPSOC_TYPE_VALUE_KEY[];
@@ -594,13 +614,11 @@ extern const ModulePropertyValueKey_t MERCURY_XU9_REAL_TIME_CLOCK_EQUIPPED_VALUE
 #define MERCURY_XU9_CONFIG_PROPERTY_INDEX_DDR4_RAM_PL_SIZE_GB 8
 #define MERCURY_XU9_CONFIG_PROPERTY_INDEX_EMMC_FLASH_SIZE_GB 9
 #define MERCURY_XU9_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 10
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars XU3
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_XU3
 extern char MARS_XU3_MODULE_NAME[];
 extern ModuleConfigProperty_t MARS_XU3_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MARS_XU3_MPSOC_TYPE_VALUE_KEY[];
@@ -620,13 +638,11 @@ extern const ModulePropertyValueKey_t MARS_XU3_POWER_GRADE_VALUE_KEY[];
 #define MARS_XU3_CONFIG_PROPERTY_INDEX_DDR4_RAM_SIZE_GB 6
 #define MARS_XU3_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 7
 #define MARS_XU3_CONFIG_PROPERTY_INDEX_EMMC_FLASH_SIZE_GB 8
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury SA1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_SA1
 extern char MERCURY_SA1_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_SA1_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_SA1_SOC_TYPE_VALUE_KEY[];
@@ -649,13 +665,11 @@ extern const ModulePropertyValueKey_t MERCURY_SA1_REAL_TIME_CLOCK_EQUIPPED_VALUE
 #define MERCURY_SA1_CONFIG_PROPERTY_INDEX_DDR3L_RAM_SIZE_MB 8
 #define MERCURY_SA1_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 9
 #define MERCURY_SA1_CONFIG_PROPERTY_INDEX_EMMC_FLASH_SIZE_GB 10
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars MA3
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_MA3
 extern char MARS_MA3_MODULE_NAME[];
 extern ModuleConfigProperty_t MARS_MA3_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MARS_MA3_SOC_TYPE_VALUE_KEY[];
@@ -677,13 +691,11 @@ extern const ModulePropertyValueKey_t MARS_MA3_REAL_TIME_CLOCK_EQUIPPED_VALUE_KE
 #define MARS_MA3_CONFIG_PROPERTY_INDEX_DDR3L_RAM_SIZE_GB 8
 #define MARS_MA3_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 9
 #define MARS_MA3_CONFIG_PROPERTY_INDEX_EMMC_FLASH_SIZE_GB 10
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury SA2
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_SA2
 extern char MERCURY_SA2_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_SA2_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_SA2_SOC_TYPE_VALUE_KEY[];
@@ -705,13 +717,11 @@ extern const ModulePropertyValueKey_t MERCURY_SA2_REAL_TIME_CLOCK_EQUIPPED_VALUE
 #define MERCURY_SA2_CONFIG_PROPERTY_INDEX_USB_3_0_DEVICE_PORT_COUNT 8
 #define MERCURY_SA2_CONFIG_PROPERTY_INDEX_DDR3L_RAM_SIZE_MB 9
 #define MERCURY_SA2_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 10
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury ZX1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_ZX1
 extern char MERCURY_ZX1_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_ZX1_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_ZX1_SOC_TYPE_VALUE_KEY[];
@@ -734,13 +744,11 @@ extern const ModulePropertyValueKey_t MERCURY_ZX1_REAL_TIME_CLOCK_EQUIPPED_VALUE
 #define MERCURY_ZX1_CONFIG_PROPERTY_INDEX_DDR3L_RAM_PL_SIZE_MB 9
 #define MERCURY_ZX1_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 10
 #define MERCURY_ZX1_CONFIG_PROPERTY_INDEX_NAND_FLASH_SIZE_MB 11
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury ZX5
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_ZX5
 extern char MERCURY_ZX5_MODULE_NAME[];
 extern ModuleConfigProperty_t MERCURY_ZX5_CONFIG_PROPERTIES[];
 extern const ModulePropertyValueKey_t MERCURY_ZX5_SOC_TYPE_VALUE_KEY[];
@@ -763,5 +771,4 @@ extern const ModulePropertyValueKey_t MERCURY_ZX5_REAL_TIME_CLOCK_EQUIPPED_VALUE
 #define MERCURY_ZX5_CONFIG_PROPERTY_INDEX_DDR3L_RAM_SIZE_MB 8
 #define MERCURY_ZX5_CONFIG_PROPERTY_INDEX_QSPI_FLASH_SIZE_MB 9
 #define MERCURY_ZX5_CONFIG_PROPERTY_INDEX_NAND_FLASH_SIZE_MB 10
-#endif
 
@@ -0,0 +1,382 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "RegisterMap.h"
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Get the cache policy of a register.
+ *
+ * \param	pMap			Register map
+ * \param	registerIndex	Index of the register
+ * \returns					Cache policy; registers which are not in any range are volatile
+ */
+ERegisterCachePolicy_t RegisterMap_GetPolicy(const RegisterMap_t* pMap, uint16_t registerIndex)
+{
+    uint32_t rangeIndex;
+    for (rangeIndex = 0; rangeIndex < pMap->pConfig->numberOfRanges; rangeIndex++)
+    {
+        const RegisterMapRange_t* pRange = &pMap->pConfig->pRanges[rangeIndex];
+        if ((registerIndex >= pRange->firstRegister) && (registerIndex <= pRange->lastRegister))
+        {
+            return pRange->policy;
+        }
+    }
+
+    return ERegisterCachePolicy_Volatile;
+}
+
+/**
+ * \brief Get the page of a register.
+ *
+ * \param	pMap			Register map
+ * \param	registerIndex	Index of the register
+ * \returns					Page, or 0 for a device without pages
+ */
+int RegisterMap_GetPage(const RegisterMap_t* pMap, uint16_t registerIndex)
+{
+    return (pMap->pConfig->registersPerPage == 0) ? 0 : (registerIndex / pMap->pConfig->registersPerPage);
+}
+
+/**
+ * \brief Get the address of a register within its page.
+ *
+ * \param	pMap			Register map
+ * \param	registerIndex	Index of the register
+ * \returns					Register address
+ */
+uint16_t RegisterMap_GetAddress(const RegisterMap_t* pMap, uint16_t registerIndex)
+{
+    return (pMap->pConfig->registersPerPage == 0) ? registerIndex : (registerIndex % pMap->pConfig->registersPerPage);
+}
+
+/**
+ * \brief Check that consecutive registers exist and are on one page.
+ *
+ * \param	pMap				Register map
+ * \param	firstRegister		Index of the first register
+ * \param	numberOfRegisters	Number of registers
+ * \returns						Result code
+ */
+EN_RESULT RegisterMap_CheckRange(const RegisterMap_t* pMap, uint16_t firstRegister, uint32_t numberOfRegisters)
+{
+    if ((pMap == NULL) || (pMap->pConfig == NULL))
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    if ((numberOfRegisters == 0) || ((uint32_t)firstRegister + numberOfRegisters > pMap->pConfig->numberOfRegisters) ||
+        (RegisterMap_GetPage(pMap, firstRegister) != RegisterMap_GetPage(pMap, firstRegister + numberOfRegisters - 1)))
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Write consecutive registers of one page to the device, and update the cache.
+ *
+ * \param	pMap				Register map
+ * \param	firstRegister		Index of the first register
+ * \param	numberOfRegisters	Number of registers
+ * \param	pBuffer				Register values
+ * \returns						Result code
+ */
+EN_RESULT RegisterMap_WriteToDevice(RegisterMap_t* pMap,
+                                    uint16_t firstRegister,
+                                    uint32_t numberOfRegisters,
+                                    const uint8_t* pBuffer)
+{
+    const RegisterMapConfig_t* pConfig = pMap->pConfig;
+    uint16_t address = RegisterMap_GetAddress(pMap, firstRegister);
+    EN_RESULT result = RegisterMap_SelectPage(pMap, RegisterMap_GetPage(pMap, firstRegister));
+    uint32_t index;
+
+    if (EN_SUCCEEDED(result))
+    {
+        if (pConfig->singleRegisterWrites)
+        {
+            for (index = 0; (index < numberOfRegisters) && EN_SUCCEEDED(result); index++)
+            {
+                result = I2cWrite(
+                    pConfig->deviceAddress, address + index, pConfig->subAddressMode, (uint8_t*)&pBuffer[index], 1);
+            }
+        }
+        else
+        {
+            result = I2cWrite(
+                pConfig->deviceAddress, address, pConfig->subAddressMode, (uint8_t*)pBuffer, numberOfRegisters);
+        }
+    }
+
+    // After a failed write the registers may hold the old or the new values, so they are read again next time
+    for (index = 0; index < numberOfRegisters; index++)
+    {
+        uint16_t registerIndex = firstRegister + index;
+        bool valid =
+            EN_SUCCEEDED(result) && (RegisterMap_GetPolicy(pMap, registerIndex) != ERegisterCachePolicy_Volatile);
+
+        pMap->pValues[registerIndex] = pBuffer[index];
+        pMap->pFlags[registerIndex] = valid ? REGISTER_MAP_FLAG_VALID : 0;
+    }
+
+    return result;
+}
+
+EN_RESULT RegisterMap_Initialise(RegisterMap_t* pMap,
+                                 const RegisterMapConfig_t* pConfig,
+                                 uint8_t* pValues,
+                                 uint8_t* pFlags)
+{
+    if ((pMap == NULL) || (pConfig == NULL) || (pValues == NULL) || (pFlags == NULL))
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    pMap->pConfig = pConfig;
+    pMap->pValues = pValues;
+    pMap->pFlags = pFlags;
+    pMap->cacheOnly = false;
+    RegisterMap_Invalidate(pMap);
+
+    return EN_SUCCESS;
+}
+
+void RegisterMap_Invalidate(RegisterMap_t* pMap)
+{
+    uint16_t registerIndex;
+    for (registerIndex = 0; registerIndex < pMap->pConfig->numberOfRegisters; registerIndex++)
+    {
+        pMap->pFlags[registerIndex] = 0;
+    }
+
+    pMap->currentPage = REGISTER_MAP_PAGE_UNKNOWN;
+}
+
+EN_RESULT RegisterMap_SelectPage(RegisterMap_t* pMap, int page)
+{
+    const RegisterMapConfig_t* pConfig = pMap->pConfig;
+
+    if ((pConfig->registersPerPage == 0) || (page == pMap->currentPage))
+    {
+        return EN_SUCCESS;
+    }
+
+    uint8_t pageValue = (uint8_t)page;
+    EN_RESULT result =
+        I2cWrite(pConfig->deviceAddress, pConfig->pageSelectRegister, pConfig->subAddressMode, &pageValue, 1);
+    if (EN_FAILED(result))
+    {
+        // The write may or may not have reached the device
+        pMap->currentPage = REGISTER_MAP_PAGE_UNKNOWN;
+        return result;
+    }
+
+    pMap->currentPage = page;
+
+    // The page select register is present on every page
+    uint16_t registerIndex;
+    for (registerIndex = pConfig->pageSelectRegister; registerIndex < pConfig->numberOfRegisters;
+         registerIndex += pConfig->registersPerPage)
+    {
+        pMap->pValues[registerIndex] = pageValue;
+        pMap->pFlags[registerIndex] = REGISTER_MAP_FLAG_VALID;
+    }
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT RegisterMap_ReadWithPriority(RegisterMap_t* pMap,
+                                       uint16_t firstRegister,
+                                       uint32_t numberOfRegisters,
+                                       uint8_t* pBuffer,
+                                       EI2cPriority_t priority)
+{
+    EN_RETURN_IF_FAILED(RegisterMap_CheckRange(pMap, firstRegister, numberOfRegisters));
+    if (pBuffer == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    int32_t firstUncached = -1;
+    int32_t lastUncached = -1;
+    uint32_t index;
+
+    // Registers with a pending write or a known value are taken from the cache
+    for (index = 0; index < numberOfRegisters; index++)
+    {
+        uint16_t registerIndex = firstRegister + index;
+        ERegisterCachePolicy_t policy = RegisterMap_GetPolicy(pMap, registerIndex);
+        bool dirty = (pMap->pFlags[registerIndex] & REGISTER_MAP_FLAG_DIRTY) != 0;
+        bool valid = (pMap->pFlags[registerIndex] & REGISTER_MAP_FLAG_VALID) != 0;
+        bool inCache = dirty || (valid && (policy != ERegisterCachePolicy_Volatile));
+
+        if (!inCache)
+        {
+            if (policy == ERegisterCachePolicy_WriteOnly)
+            {
+                return EN_ERROR_INVALID_ARGUMENT;
+            }
+
+            if (firstUncached < 0)
+            {
+                firstUncached = index;
+            }
+            lastUncached = index;
+        }
+    }
+
+    if (firstUncached >= 0)
+    {
+        EN_RETURN_IF_FAILED(RegisterMap_SelectPage(pMap, RegisterMap_GetPage(pMap, firstRegister)));
+        EN_RETURN_IF_FAILED(I2cReadWithPriority(pMap->pConfig->deviceAddress,
+                                                RegisterMap_GetAddress(pMap, firstRegister + firstUncached),
+                                                pMap->pConfig->subAddressMode,
+                                                lastUncached - firstUncached + 1,
+                                                pBuffer + firstUncached,
+                                                priority));
+    }
+
+    for (index = 0; index < numberOfRegisters; index++)
+    {
+        uint16_t registerIndex = firstRegister + index;
+        ERegisterCachePolicy_t policy = RegisterMap_GetPolicy(pMap, registerIndex);
+        bool readFromDevice = ((int32_t)index >= firstUncached) && ((int32_t)index <= lastUncached) &&
+                              !(pMap->pFlags[registerIndex] & REGISTER_MAP_FLAG_DIRTY) &&
+                              (policy != ERegisterCachePolicy_WriteOnly);
+
+        if (!readFromDevice)
+        {
+            pBuffer[index] = pMap->pValues[registerIndex];
+        }
+        else if (policy == ERegisterCachePolicy_Cached)
+        {
+            pMap->pValues[registerIndex] = pBuffer[index];
+            pMap->pFlags[registerIndex] = REGISTER_MAP_FLAG_VALID;
+        }
+    }
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT RegisterMap_Read(RegisterMap_t* pMap, uint16_t firstRegister, uint32_t numberOfRegisters, uint8_t* pBuffer)
+{
+    return RegisterMap_ReadWithPriority(pMap, firstRegister, numberOfRegisters, pBuffer, EI2cPriority_Normal);
+}
+
+EN_RESULT RegisterMap_Write(RegisterMap_t* pMap,
+                            uint16_t firstRegister,
+                            uint32_t numberOfRegisters,
+                            const uint8_t* pBuffer)
+{
+    EN_RETURN_IF_FAILED(RegisterMap_CheckRange(pMap, firstRegister, numberOfRegisters));
+    if (pBuffer == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    if (!pMap->cacheOnly)
+    {
+        return RegisterMap_WriteToDevice(pMap, firstRegister, numberOfRegisters, pBuffer);
+    }
+
+    uint32_t index;
+    for (index = 0; index < numberOfRegisters; index++)
+    {
+        pMap->pValues[firstRegister + index] = pBuffer[index];
+        pMap->pFlags[firstRegister + index] |= REGISTER_MAP_FLAG_DIRTY;
+    }
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT RegisterMap_UpdateBits(RegisterMap_t* pMap,
+                                 uint16_t registerIndex,
+                                 uint8_t mask,
+                                 uint8_t value,
+                                 bool* pChanged)
+{
+    uint8_t currentValue;
+    EN_RETURN_IF_FAILED(RegisterMap_Read(pMap, registerIndex, 1, &currentValue));
+
+    uint8_t newValue = (currentValue & ~mask) | (value & mask);
+    bool write =
+        (newValue != currentValue) || (RegisterMap_GetPolicy(pMap, registerIndex) == ERegisterCachePolicy_Volatile);
+
+    if (write)
+    {
+        EN_RETURN_IF_FAILED(RegisterMap_Write(pMap, registerIndex, 1, &newValue));
+    }
+
+    if (pChanged != NULL)
+    {
+        *pChanged = write;
+    }
+
+    return EN_SUCCESS;
+}
+
+void RegisterMap_SetCacheOnly(RegisterMap_t* pMap, bool cacheOnly)
+{
+    pMap->cacheOnly = cacheOnly;
+}
+
+EN_RESULT RegisterMap_Sync(RegisterMap_t* pMap)
+{
+    if ((pMap == NULL) || (pMap->pConfig == NULL))
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    uint16_t firstRegister = 0;
+    while (firstRegister < pMap->pConfig->numberOfRegisters)
+    {
+        if (!(pMap->pFlags[firstRegister] & REGISTER_MAP_FLAG_DIRTY))
+        {
+            firstRegister++;
+            continue;
+        }
+
+        // Extend the burst over the following dirty registers of the same page
+        uint16_t endRegister = firstRegister + 1;
+        while ((endRegister < pMap->pConfig->numberOfRegisters) &&
+               (pMap->pFlags[endRegister] & REGISTER_MAP_FLAG_DIRTY) &&
+               (RegisterMap_GetPage(pMap, endRegister) == RegisterMap_GetPage(pMap, firstRegister)))
+        {
+            endRegister++;
+        }
+
+        EN_RETURN_IF_FAILED(RegisterMap_WriteToDevice(
+            pMap, firstRegister, endRegister - firstRegister, &pMap->pValues[firstRegister]));
+        firstRegister = endRegister;
+    }
+
+    return EN_SUCCESS;
+}
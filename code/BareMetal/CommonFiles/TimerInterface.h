@@ -41,6 +41,31 @@
 EN_RESULT InitialiseTimer();
 
 
+#if defined(__arm__) && SYSTEM != LINUX_USERSPACE
+/**
+ * \brief Interrupt handler of the one-shot wake-up timer, connected in SetupInterruptSystem().
+ *
+ * @param pCallbackRef Timer instance
+ */
+void TimerWakeUpHandler(void* pCallbackRef);
+
+
+/**
+ * \brief Arm the private timer to raise a single interrupt after the given time, which ends a WFI instruction.
+ * An earlier timeout which has not expired yet is replaced.
+ *
+ * @param microseconds Time until the interrupt, in microseconds
+ */
+void StartWakeUpTimer(uint32_t microseconds);
+
+
+/**
+ * \brief Stop the wake-up timer, so that it raises no interrupt.
+ */
+void StopWakeUpTimer();
+#endif
+
+
 /**
  * \brief Sleep for the defined number of milliseconds.
  *
@@ -51,3 +76,21 @@ EN_RESULT InitialiseTimer();
  */
 void SleepMilliseconds(uint32_t milliseconds);
 
+
+/**
+ * \brief Sleep for the defined number of microseconds.
+ *
+ * @param microseconds The number of microseconds to sleep for
+ */
+void SleepMicroseconds(uint32_t microseconds);
+
+
+/**
+ * \brief Get the current value of the free-running system timer.
+ *
+ * The timer is monotonic; its value is only meaningful relative to other values returned by this function.
+ *
+ * @returns Timer value in microseconds
+ */
+uint64_t GetTimeMicroseconds();
+
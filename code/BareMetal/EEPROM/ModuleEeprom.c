@@ -25,10 +25,13 @@
 //-------------------------------------------------------------------------------------------------
 
 #include "ModuleEeprom.h"
+#include "DeviceDiscovery.h"
 #include "I2cInterface.h"
 #include "AtmelAtsha204a.h"
 #include "UtilityFunctions.h"
-#include "TargetModuleConfig.h"
+
+#include <stddef.h>
+#include <string.h>
 
 //-------------------------------------------------------------------------------------------------
 // Directives, typedefs and constants
@@ -65,6 +68,76 @@ EEepromDevice_t g_EepromDeviceType;
 /// Communication mode register value for I2C mode
 #define DS28CN01_REGISTER_VALUE_COMMUNICATION_MODE_I2C 0x00
 
+
+/**
+ * \brief Fields of the module information block, as flags which are combined to request several fields at once.
+ */
+typedef enum
+{
+
+	/// Module serial number
+	EModuleInfoField_SerialNumber = 0x01,
+
+	/// Product number
+	EModuleInfoField_ProductNumber = 0x02,
+
+	/// Module configuration data
+	EModuleInfoField_ConfigData = 0x04,
+
+	/// MAC address
+	EModuleInfoField_MacAddress = 0x08,
+
+} EModuleInfoField_t;
+
+
+/**
+ * \brief Contiguous range of module EEPROM addresses.
+ */
+typedef struct
+{
+
+	/// Address of the first byte
+	uint16_t address;
+
+	/// Number of bytes
+	uint16_t lengthBytes;
+
+} ModuleInfoRange_t;
+
+
+/// Number of fields in the module information block
+#define MODULE_INFO_FIELD_COUNT 4
+
+/// Address range of each field, indexed by the bit number of its EModuleInfoField_t flag. The configuration data is
+/// read with the length of the longest configuration, as the module family is only known from the product number.
+const ModuleInfoRange_t MODULE_INFO_FIELD_RANGES[MODULE_INFO_FIELD_COUNT] = {
+	{ MODULE_INFO_ADDRESS_SERIAL_NUMBER, 4 },
+	{ MODULE_INFO_ADDRESS_PRODUCT_NUMBER, 4 },
+	{ CONFIG_PROPERTIES_START_ADDRESS, MAX_CONFIG_PROPERTIES_LENGTH_BYTES },
+	{ MODULE_INFO_ADDRESS_MAC_ADDRESS, 6 }
+};
+
+/// Size of the module information block, which is slot 0 of the OTP zone on the Atmel ATSHA204A
+#define MODULE_INFO_BLOCK_SIZE_BYTES 32
+
+/// Largest gap between two fields which the Maxim DS28CN01 reads through instead of starting another read. Another
+/// read costs a start condition, the device address twice and the register address, about as long as 4 data bytes.
+#define DS28CN01_READ_MERGE_GAP_BYTES 4
+
+/// Size of the Atmel ATSHA204A 4-byte reads
+#define ATSHA204A_WORD_SIZE_BYTES 4
+
+/// Size of the Atmel ATSHA204A 32-byte reads
+#define ATSHA204A_SLOT_SIZE_BYTES 32
+
+/// Largest gap between two fields which the Atmel ATSHA204A reads through. Another 4-byte read costs an 8-byte command
+/// and a 7-byte response.
+#define ATSHA204A_READ_MERGE_GAP_BYTES 8
+
+/// Largest read which the Atmel ATSHA204A performs with 4-byte reads. Three 4-byte reads exchange more bytes than one
+/// 32-byte read with its 35-byte response.
+#define ATSHA204A_WORD_READ_MAX_BYTES 8
+
 /// Flag to indicate if config properties have been read.
 bool g_configPropertiesRead = false;
 
@@ -77,6 +150,22 @@ ProductNumberInfo_t g_productNumberInfo;
 /// Module MAC address 0 (the first of the 2 assigned to each module)
 uint64_t g_macAddress;
 
+/// Raw product number, as stored in the identity snapshot
+uint32_t g_productNumber;
+
+/// Attribute placing the identity snapshot in RAM which is retained over a reset, e.g.
+/// __attribute__((section(".retained"))) with a NOLOAD section in the linker script. By default, the snapshot is in
+/// normal RAM and is only reused while the application runs, unless it is restored with Eeprom_SetIdentitySnapshot().
+#ifndef MODULE_IDENTITY_SNAPSHOT_SECTION
+#define MODULE_IDENTITY_SNAPSHOT_SECTION
+#endif
+
+/// Identity read from the module EEPROM by the last Eeprom_Read()
+MODULE_IDENTITY_SNAPSHOT_SECTION ModuleIdentitySnapshot_t g_moduleIdentitySnapshot;
+
+/// True if the serial number in the EEPROM matches the identity snapshot, so the snapshot replaces the other reads
+bool g_moduleIdentitySnapshotMatches = false;
+
 
 //-------------------------------------------------------------------------------------------------
 // Function definitions
@@ -102,6 +191,13 @@ EN_RESULT IsEepromPresentAtDeviceAddress(uint8_t eepromI2cAddress, bool* pDevice
 	case EEepromDevice_MaximDs28cn01_0:
 	case EEepromDevice_MaximDs28cn01_1:
 	{
+		// Skip the configuration if the device has not acknowledged the probe of the bus discovery.
+		EN_RETURN_IF_FAILED(DeviceDiscovery_IsDevicePresent(eepromI2cAddress, pDeviceIsPresent));
+		if (!*pDeviceIsPresent)
+		{
+			return EN_SUCCESS;
+		}
+
 		// The Maxim DS28CN01 EEPROM needs to be switched into I2C mode by writing a zero to the communication mode
 		// register.
 		uint8_t communicationModeBuffer = DS28CN01_REGISTER_VALUE_COMMUNICATION_MODE_I2C;
@@ -131,7 +227,8 @@ EN_RESULT IsEepromPresentAtDeviceAddress(uint8_t eepromI2cAddress, bool* pDevice
 	}
 	case EEepromDevice_AtmelAtsha204a:
 	{
-		// Send the wake token, and verify that the response confirms the device is an Atmel ATSHA204A.
+		// Send the wake token, and verify that the response confirms the device is an Atmel ATSHA204A. The device
+		// does not acknowledge the probes of the bus discovery while it sleeps, so the result is recorded here.
 		if (EN_FAILED(AtmelAtsha204a_Wake(true)))
 		{
 			*pDeviceIsPresent = false;
@@ -142,6 +239,8 @@ EN_RESULT IsEepromPresentAtDeviceAddress(uint8_t eepromI2cAddress, bool* pDevice
 			AtmelAtsha204a_Sleep();
 		}
 
+		DeviceDiscovery_SetDevicePresent(eepromI2cAddress, *pDeviceIsPresent);
+
 		break;
 	}
 	default:
@@ -186,138 +285,321 @@ EN_RESULT Eeprom_Initialise()
 }
 
 
-EN_RESULT Eeprom_ReadBasicModuleInfo()
+/**
+ * \brief Plan the reads of a set of module information fields.
+ *
+ * The address ranges of the fields are aligned, sorted, and merged where they overlap or are separated by a small
+ * gap, so that the fields are read with the fewest contiguous reads.
+ *
+ * @param fields				Fields to read, as a combination of EModuleInfoField_t flags
+ * @param alignmentBytes		Alignment of the first and the last address of each read
+ * @param mergeGapBytes			Largest gap between two ranges which is read through
+ * @param[out] pReads			Array of MODULE_INFO_FIELD_COUNT ranges to receive the reads, in address order
+ * @return						The number of reads
+ */
+unsigned int Eeprom_PlanModuleInfoReads(uint32_t fields,
+		uint16_t alignmentBytes,
+		uint16_t mergeGapBytes,
+		ModuleInfoRange_t* pReads)
 {
-	switch (g_EepromDeviceType)
-			{
-			case EEepromDevice_MaximDs28cn01_0:
-			case EEepromDevice_MaximDs28cn01_1:
-			{
-				// Get the serial number
-				uint8_t readBuffer[4];
-				EN_RETURN_IF_FAILED(I2cRead(g_EepromDeviceType,
-						MODULE_INFO_ADDRESS_SERIAL_NUMBER,
-						EI2cSubAddressMode_OneByte,
-						4,
-						(uint8_t*)&readBuffer));
-
-				g_moduleSerialNumber = ByteArrayToUnsignedInt32((uint8_t*)&readBuffer);
-
-				// Product number
-				EN_RETURN_IF_FAILED(I2cRead(g_EepromDeviceType,
-						MODULE_INFO_ADDRESS_PRODUCT_NUMBER,
-						EI2cSubAddressMode_OneByte,
-						4,
-						(uint8_t*)&readBuffer));
-
-				uint32_t productNumber = ByteArrayToUnsignedInt32((uint8_t*)&readBuffer);
-				g_productNumberInfo = ParseProductNumber(productNumber);
-
-				// MAC address
-				uint8_t macAddressBuffer[6];
-				EN_RETURN_IF_FAILED(I2cRead(g_EepromDeviceType,
-						MODULE_INFO_ADDRESS_MAC_ADDRESS,
-						EI2cSubAddressMode_OneByte,
-						6,
-						(uint8_t*)&macAddressBuffer));
-
-				g_macAddress = ByteArrayToUnsignedInt64((uint8_t*)&macAddressBuffer);
+	ModuleInfoRange_t ranges[MODULE_INFO_FIELD_COUNT];
+	unsigned int rangeCount = 0;
+	unsigned int fieldIndex = 0;
+	for (fieldIndex = 0; fieldIndex < MODULE_INFO_FIELD_COUNT; fieldIndex++)
+	{
+		if ((fields & (1u << fieldIndex)) == 0)
+		{
+			continue;
+		}
 
-				break;
-			}
-			case EEepromDevice_AtmelAtsha204a:
+		uint16_t startAddress = MODULE_INFO_FIELD_RANGES[fieldIndex].address;
+		uint16_t endAddress = startAddress + MODULE_INFO_FIELD_RANGES[fieldIndex].lengthBytes;
+		startAddress -= startAddress % alignmentBytes;
+		endAddress += (alignmentBytes - endAddress % alignmentBytes) % alignmentBytes;
+
+		// Insert the range in address order.
+		unsigned int rangeIndex = rangeCount;
+		while (rangeIndex > 0 && ranges[rangeIndex - 1].address > startAddress)
+		{
+			ranges[rangeIndex] = ranges[rangeIndex - 1];
+			rangeIndex--;
+		}
+
+		ranges[rangeIndex].address = startAddress;
+		ranges[rangeIndex].lengthBytes = endAddress - startAddress;
+		rangeCount++;
+	}
+
+	unsigned int readCount = 0;
+	unsigned int rangeIndex = 0;
+	for (rangeIndex = 0; rangeIndex < rangeCount; rangeIndex++)
+	{
+		uint16_t endAddress = ranges[rangeIndex].address + ranges[rangeIndex].lengthBytes;
+
+		if (readCount > 0 &&
+				ranges[rangeIndex].address <= pReads[readCount - 1].address + pReads[readCount - 1].lengthBytes + mergeGapBytes)
+		{
+			// Extend the previous read over this range.
+			if (endAddress > pReads[readCount - 1].address + pReads[readCount - 1].lengthBytes)
 			{
-				uint8_t readBuffer[4];
-				uint16_t encodedAddress = 0;
+				pReads[readCount - 1].lengthBytes = endAddress - pReads[readCount - 1].address;
+			}
+		}
+		else
+		{
+			pReads[readCount] = ranges[rangeIndex];
+			readCount++;
+		}
+	}
 
-				// Config data is stored in slot 0 of the OTP zone.
-				uint8_t slotIndex = 0;
+	return readCount;
+}
 
-				// Serial number
-				uint8_t serialNumberWordOffset = (MODULE_INFO_ADDRESS_SERIAL_NUMBER / 4);
 
-		#if _DEBUG == 1
-				EN_PRINTF("Reading module serial number..\r\n");
-		#endif
+/**
+ * \brief Read a set of module information fields with the fewest contiguous reads the EEPROM device allows.
+ *
+ * The Maxim DS28CN01 reads through small gaps between the fields. The Atmel ATSHA204A reads a few words with 4-byte
+ * reads, and more with a single 32-byte read of slot 0 of the OTP zone, unless the zone is in legacy mode.
+ *
+ * @param fields				Fields to read, as a combination of EModuleInfoField_t flags
+ * @param[out] pBlock			Buffer of MODULE_INFO_BLOCK_SIZE_BYTES bytes, indexed by EEPROM address
+ * @return						Result code
+ */
+EN_RESULT Eeprom_ReadModuleInfoFields(uint32_t fields, uint8_t* pBlock)
+{
+	ModuleInfoRange_t reads[MODULE_INFO_FIELD_COUNT];
+	unsigned int readCount = 0;
 
-				EN_RETURN_IF_FAILED(
-						AtmelAtsha204a_EncodeAddress(EZoneSelect_Otp, slotIndex, serialNumberWordOffset, &encodedAddress));
+	switch (g_EepromDeviceType)
+	{
+	case EEepromDevice_MaximDs28cn01_0:
+	case EEepromDevice_MaximDs28cn01_1:
+		readCount = Eeprom_PlanModuleInfoReads(fields, 1, DS28CN01_READ_MERGE_GAP_BYTES, (ModuleInfoRange_t*)&reads);
+		break;
+	case EEepromDevice_AtmelAtsha204a:
+		readCount = Eeprom_PlanModuleInfoReads(fields,
+				ATSHA204A_WORD_SIZE_BYTES,
+				ATSHA204A_READ_MERGE_GAP_BYTES,
+				(ModuleInfoRange_t*)&reads);
 
-				EN_RETURN_IF_FAILED(
-						AtmelAtsha204a_Read(EReadSizeSelect_4Bytes, EZoneSelect_Otp, encodedAddress, (uint8_t*)&readBuffer));
+		// Read whole slots if more than a few words are needed, so that the device uses 32-byte reads.
+		if (readCount > 1 || (readCount == 1 && reads[0].lengthBytes > ATSHA204A_WORD_READ_MAX_BYTES))
+		{
+			readCount = Eeprom_PlanModuleInfoReads(fields, ATSHA204A_SLOT_SIZE_BYTES, 0, (ModuleInfoRange_t*)&reads);
+		}
+		break;
+	default:
+		memset(pBlock, 0, MODULE_INFO_BLOCK_SIZE_BYTES);
+		return EN_SUCCESS;
+	}
 
-				g_moduleSerialNumber = ByteArrayToUnsignedInt32((uint8_t*)&readBuffer);
+	unsigned int readIndex = 0;
+	for (readIndex = 0; readIndex < readCount; readIndex++)
+	{
+		const ModuleInfoRange_t* pRead = &reads[readIndex];
+		if (pRead->address + pRead->lengthBytes > MODULE_INFO_BLOCK_SIZE_BYTES)
+		{
+			return EN_ERROR_INVALID_ARGUMENT;
+		}
 
-		#if _DEBUG == 1
-				EN_PRINTF("Serial number = %d\r\n", g_moduleSerialNumber);
-		#endif
+#if _DEBUG == 1
+		EN_PRINTF("Reading module info at 0x%x, %d bytes..\r\n", pRead->address, pRead->lengthBytes);
+#endif
 
-				// Product number
-		#if _DEBUG == 1
-				EN_PRINTF("Reading module product number..\r\n");
-		#endif
-				uint8_t productNumberWordOffset = (MODULE_INFO_ADDRESS_PRODUCT_NUMBER / 4);
+		if (g_EepromDeviceType == EEepromDevice_AtmelAtsha204a)
+		{
+			// Config data is stored in slot 0 of the OTP zone.
+			EN_RETURN_IF_FAILED(AtmelAtsha204a_ReadZone(EZoneSelect_Otp,
+					pRead->address,
+					pRead->lengthBytes,
+					&pBlock[pRead->address]));
+		}
+		else
+		{
+			EN_RETURN_IF_FAILED(I2cRead(g_EepromDeviceType,
+					pRead->address,
+					EI2cSubAddressMode_OneByte,
+					pRead->lengthBytes,
+					&pBlock[pRead->address]));
+		}
+	}
 
-				EN_RETURN_IF_FAILED(
-						AtmelAtsha204a_EncodeAddress(EZoneSelect_Otp, slotIndex, productNumberWordOffset, &encodedAddress));
+	return EN_SUCCESS;
+}
 
-				EN_RETURN_IF_FAILED(
-						AtmelAtsha204a_Read(EReadSizeSelect_4Bytes, EZoneSelect_Otp, encodedAddress, (uint8_t*)&readBuffer));
 
-				uint32_t productNumber = ByteArrayToUnsignedInt32((uint8_t*)&readBuffer);
-				g_productNumberInfo = ParseProductNumber(productNumber);
+/**
+ * \brief Read the module serial number from the module EEPROM.
+ *
+ * @param[out] pSerialNumber	Serial number
+ * @return						Result code
+ */
+EN_RESULT Eeprom_ReadSerialNumber(uint32_t* pSerialNumber)
+{
+	uint8_t block[MODULE_INFO_BLOCK_SIZE_BYTES];
+	EN_RETURN_IF_FAILED(Eeprom_ReadModuleInfoFields(EModuleInfoField_SerialNumber, (uint8_t*)&block));
 
-		#if _DEBUG == 1
-				EN_PRINTF("Product number = 0x%x\r\n", productNumber);
-		#endif
+	*pSerialNumber = ByteArrayToUnsignedInt32(&block[MODULE_INFO_ADDRESS_SERIAL_NUMBER]);
 
+#if _DEBUG == 1
+	EN_PRINTF("Serial number = %d\r\n", *pSerialNumber);
+#endif
 
-		#if _DEBUG == 1
-				EN_PRINTF("Reading module MAC address..\r\n");
-		#endif
+	return EN_SUCCESS;
+}
 
-				// MAC address - we need to split this into 2 4-byte reads.
-				uint8_t macAddressBuffer1[4];
-				uint8_t macAddressBuffer2[4];
-				uint8_t macAddressWordOffset = (MODULE_INFO_ADDRESS_MAC_ADDRESS / 4);
 
-				EN_RETURN_IF_FAILED(
-						AtmelAtsha204a_EncodeAddress(EZoneSelect_Otp, slotIndex, macAddressWordOffset, &encodedAddress));
+/**
+ * \brief Calculate the checksum of the module identity snapshot.
+ *
+ * @param pSnapshot		Snapshot
+ * @return				Checksum
+ */
+uint16_t Eeprom_CalculateIdentitySnapshotChecksum(const ModuleIdentitySnapshot_t* pSnapshot)
+{
+	return AtmelAtsha204a_CalculateCrc((const uint8_t*)pSnapshot, offsetof(ModuleIdentitySnapshot_t, checksum));
+}
 
-				EN_RETURN_IF_FAILED(
-						AtmelAtsha204a_Read(EReadSizeSelect_4Bytes, EZoneSelect_Otp, encodedAddress, (uint8_t*)&macAddressBuffer1));
 
-				EN_RETURN_IF_FAILED(
-						AtmelAtsha204a_EncodeAddress(EZoneSelect_Otp, slotIndex, macAddressWordOffset + 1, &encodedAddress));
+/**
+ * \brief Check whether the module identity snapshot is complete and not corrupted.
+ *
+ * @return	True if the snapshot is valid
+ */
+bool Eeprom_IsIdentitySnapshotValid()
+{
+	return (g_moduleIdentitySnapshot.magic == MODULE_IDENTITY_SNAPSHOT_MAGIC) &&
+			(g_moduleIdentitySnapshot.checksum == Eeprom_CalculateIdentitySnapshotChecksum(&g_moduleIdentitySnapshot));
+}
 
-				EN_RETURN_IF_FAILED(
-						AtmelAtsha204a_Read(EReadSizeSelect_4Bytes, EZoneSelect_Otp, encodedAddress, (uint8_t*)&macAddressBuffer2));
 
-				uint8_t fullMacAddressBuffer[6];
+/**
+ * \brief Store the module identity read from the module EEPROM in the identity snapshot.
+ *
+ * @param pRawConfigData	Raw module configuration data
+ */
+void Eeprom_StoreIdentitySnapshot(const uint8_t* pRawConfigData)
+{
+	// Clear the padding as well, as it is covered by the checksum.
+	memset(&g_moduleIdentitySnapshot, 0, sizeof(g_moduleIdentitySnapshot));
+
+	g_moduleIdentitySnapshot.eepromDeviceAddress = (uint8_t)g_EepromDeviceType;
+	g_moduleIdentitySnapshot.serialNumber = g_moduleSerialNumber;
+	g_moduleIdentitySnapshot.productNumber = g_productNumber;
+	g_moduleIdentitySnapshot.macAddress = g_macAddress;
+	memcpy(g_moduleIdentitySnapshot.configData, pRawConfigData, MAX_CONFIG_PROPERTIES_LENGTH_BYTES);
+	g_moduleIdentitySnapshot.magic = MODULE_IDENTITY_SNAPSHOT_MAGIC;
+	g_moduleIdentitySnapshot.checksum = Eeprom_CalculateIdentitySnapshotChecksum(&g_moduleIdentitySnapshot);
+}
 
-				unsigned int byteIndex = 0;
-				for (byteIndex = 0; byteIndex < 4; byteIndex++)
-				{
-					fullMacAddressBuffer[byteIndex] = macAddressBuffer1[byteIndex];
-				}
 
-				for (byteIndex = 4; byteIndex < 6; byteIndex++)
-				{
-					fullMacAddressBuffer[byteIndex] = macAddressBuffer2[byteIndex - 4];
-				}
+/**
+ * \brief Keep the module EEPROM awake for several reads, if it needs to be woken for each command.
+ *
+ * @return	Result code
+ */
+EN_RESULT Eeprom_BeginSession()
+{
+	if (g_EepromDeviceType == EEepromDevice_AtmelAtsha204a)
+	{
+		EN_RETURN_IF_FAILED(AtmelAtsha204a_BeginSession());
+	}
+
+	return EN_SUCCESS;
+}
 
-				g_macAddress = ByteArrayToUnsignedInt64((uint8_t*)&fullMacAddressBuffer);
 
-				break;
-			}
-			default:
-				break;
-			}
+/**
+ * \brief End a session started with Eeprom_BeginSession().
+ */
+void Eeprom_EndSession()
+{
+	if (g_EepromDeviceType == EEepromDevice_AtmelAtsha204a)
+	{
+		AtmelAtsha204a_EndSession();
+	}
+}
+
+
+/**
+ * \brief Select the configuration layout of the module family from the product number.
+ */
+void Eeprom_SelectModuleConfigLayout()
+{
+	g_pModuleConfigLayout = ModuleConfig_FindLayout(g_productNumberInfo.productFamilyCode);
+	g_pConfigProperties = (g_pModuleConfigLayout != NULL) ? g_pModuleConfigLayout->pConfigProperties : NULL;
+	g_configPropertiesRead = false;
+
+#if _DEBUG == 1
+	if (g_pModuleConfigLayout == NULL)
+	{
+		EN_PRINTF("Unknown product family code 0x%x\n\r", g_productNumberInfo.productFamilyCode);
+	}
+#endif
+}
+
+
+/**
+ * \brief Read the basic module information from the module EEPROM, within a session.
+ *
+ * @return	Result code
+ */
+EN_RESULT Eeprom_ReadBasicModuleInfoInSession()
+{
+	// The serial number is read in any case, to check whether the identity snapshot belongs to this module.
+	EN_RETURN_IF_FAILED(Eeprom_ReadSerialNumber(&g_moduleSerialNumber));
+
+	g_moduleIdentitySnapshotMatches = Eeprom_IsIdentitySnapshotValid() &&
+			(g_moduleIdentitySnapshot.eepromDeviceAddress == (uint8_t)g_EepromDeviceType) &&
+			(g_moduleIdentitySnapshot.serialNumber == g_moduleSerialNumber);
+
+	if (g_moduleIdentitySnapshotMatches)
+	{
+		g_productNumber = g_moduleIdentitySnapshot.productNumber;
+		g_productNumberInfo = ParseProductNumber(g_productNumber);
+		Eeprom_SelectModuleConfigLayout();
+		g_macAddress = g_moduleIdentitySnapshot.macAddress;
+
+		return EN_SUCCESS;
+	}
+
+	// Read the remaining fields together, as they are contiguous on all modules. The config data read with them
+	// completes the identity snapshot, so that Eeprom_ReadModuleConfig() does not read the EEPROM again.
+	uint8_t block[MODULE_INFO_BLOCK_SIZE_BYTES];
+	EN_RETURN_IF_FAILED(Eeprom_ReadModuleInfoFields(
+			EModuleInfoField_ProductNumber | EModuleInfoField_ConfigData | EModuleInfoField_MacAddress,
+			(uint8_t*)&block));
+
+	g_productNumber = ByteArrayToUnsignedInt32(&block[MODULE_INFO_ADDRESS_PRODUCT_NUMBER]);
+	g_productNumberInfo = ParseProductNumber(g_productNumber);
+	Eeprom_SelectModuleConfigLayout();
+
+#if _DEBUG == 1
+	EN_PRINTF("Product number = 0x%x\r\n", g_productNumber);
+#endif
+
+	g_macAddress = ByteArrayToUnsignedInt64(&block[MODULE_INFO_ADDRESS_MAC_ADDRESS]);
+
+	Eeprom_StoreIdentitySnapshot(&block[CONFIG_PROPERTIES_START_ADDRESS]);
+	g_moduleIdentitySnapshotMatches = true;
 
 	return EN_SUCCESS;
 }
 
 
+EN_RESULT Eeprom_ReadBasicModuleInfo()
+{
+	EN_RETURN_IF_FAILED(Eeprom_BeginSession());
+
+	EN_RESULT result = Eeprom_ReadBasicModuleInfoInSession();
+
+	Eeprom_EndSession();
+
+	return result;
+}
+
+
 EN_RESULT Eeprom_GetModuleInfo(uint32_t* pSerialNumber,
 		ProductNumberInfo_t* pProductNumberInfo,
 		uint64_t* pMacAddress)
@@ -337,11 +619,22 @@ EN_RESULT Eeprom_GetModuleInfo(uint32_t* pSerialNumber,
 }
 
 
+const char* Eeprom_GetModuleName()
+{
+	return (g_pModuleConfigLayout != NULL) ? g_pModuleConfigLayout->pModuleName : NULL;
+}
+
+
+uint8_t Eeprom_GetModuleConfigPropertyCount()
+{
+	return (g_pModuleConfigLayout != NULL) ? g_pModuleConfigLayout->propertyCount : 0;
+}
+
+
 /**
  * \brief Read the module config info from EEPROM.
  *
- * @param configDataSizeBytes	The number of bytes to read
- * @param[out] pConfigData		Pointer to buffer to receive the config data
+ * @param[out] pConfigData		Pointer to buffer of MAX_CONFIG_PROPERTIES_LENGTH_BYTES bytes to receive the config data
  * @return						Result code
  */
 EN_RESULT Eeprom_GetModuleConfigData(uint8_t* pConfigData)
@@ -351,54 +644,10 @@ EN_RESULT Eeprom_GetModuleConfigData(uint8_t* pConfigData)
 		return EN_ERROR_NULL_POINTER;
 	}
 
-	switch (g_EepromDeviceType)
-	{
-	case EEepromDevice_MaximDs28cn01_0:
-	case EEepromDevice_MaximDs28cn01_1:
-	{
-		EN_RETURN_IF_FAILED(I2cRead(g_EepromDeviceType,
-				CONFIG_PROPERTIES_START_ADDRESS,
-				EI2cSubAddressMode_OneByte,
-				CONFIG_PROPERTIES_LENGTH_BYTES,
-				pConfigData));
-		break;
-	}
-	case EEepromDevice_AtmelAtsha204a:
-	{
-		uint8_t required4ByteReads = DivideRoundUp(CONFIG_PROPERTIES_LENGTH_BYTES, 4);
-		uint8_t transferBytesRemaining = CONFIG_PROPERTIES_LENGTH_BYTES;
-
-		uint8_t readIndex = 0;
-		for (readIndex = 0; readIndex < required4ByteReads; readIndex++)
-		{
-			uint16_t encodedAddress = 0;
-			uint8_t configDataWordOffset = (CONFIG_PROPERTIES_START_ADDRESS / 4) + readIndex;
-
-			EN_RETURN_IF_FAILED(
-					AtmelAtsha204a_EncodeAddress(EZoneSelect_Otp, 0, configDataWordOffset, &encodedAddress));
-
-			uint8_t readBuffer[4];
-			EN_RETURN_IF_FAILED(
-					AtmelAtsha204a_Read(EReadSizeSelect_4Bytes, EZoneSelect_Otp, encodedAddress, (uint8_t*)&readBuffer));
-
-			// Copy the read bytes to the output buffer.
-			uint8_t dataBytesToCopy = min(4, transferBytesRemaining);
+	uint8_t block[MODULE_INFO_BLOCK_SIZE_BYTES];
+	EN_RETURN_IF_FAILED(Eeprom_ReadModuleInfoFields(EModuleInfoField_ConfigData, (uint8_t*)&block));
 
-			uint8_t byteIndex = 0;
-			uint8_t byteOffset = readIndex * 4;
-			for (byteIndex = 0; byteIndex < dataBytesToCopy; byteIndex++)
-			{
-				pConfigData[byteOffset + byteIndex] = readBuffer[byteIndex];
-			}
-
-			transferBytesRemaining -= 4;
-		}
-
-		break;
-	}
-	default:
-		break;
-	}
+	memcpy(pConfigData, &block[CONFIG_PROPERTIES_START_ADDRESS], MAX_CONFIG_PROPERTIES_LENGTH_BYTES);
 
 	return EN_SUCCESS;
 }
@@ -424,8 +673,13 @@ EN_RESULT ParseByteVectorToModuleConfig(const uint8_t* pRawConfigData)
 		return EN_ERROR_NULL_POINTER;
 	}
 
+	if (g_pModuleConfigLayout == NULL)
+	{
+		return EN_ERROR_UNKNOWN_MODULE_FAMILY;
+	}
+
 	unsigned int propertyIndex = 0;
-	for (propertyIndex = 0; propertyIndex < CONFIG_PROPERTY_COUNT; propertyIndex++)
+	for (propertyIndex = 0; propertyIndex < g_pModuleConfigLayout->propertyCount; propertyIndex++)
 	{
 		ModuleConfigProperty_t* pConfigProperty = &g_pConfigProperties[propertyIndex];
 
@@ -464,13 +718,13 @@ EN_RESULT ParseByteVectorToModuleConfig(const uint8_t* pRawConfigData)
 
 void Eeprom_PrintModuleConfig()
 {
-	if (g_pConfigProperties == NULL)
+	if (g_pModuleConfigLayout == NULL)
 	{
 		return;
 	}
 
 	unsigned int propertyIndex = 0;
-	for (propertyIndex = 0; propertyIndex < CONFIG_PROPERTY_COUNT; propertyIndex++)
+	for (propertyIndex = 0; propertyIndex < g_pModuleConfigLayout->propertyCount; propertyIndex++)
 	{
 		const ModuleConfigProperty_t* pConfigProperty = &g_pConfigProperties[propertyIndex];
 
@@ -518,7 +772,17 @@ void Eeprom_PrintModuleConfig()
  */
 EN_RESULT Eeprom_ReadModuleConfig()
 {
-	uint8_t rawConfigData[CONFIG_PROPERTIES_LENGTH_BYTES];
+	// The snapshot has been checked against the serial number in the EEPROM, or filled, by Eeprom_ReadBasicModuleInfo().
+	if (g_moduleIdentitySnapshotMatches)
+	{
+		EN_RETURN_IF_FAILED(ParseByteVectorToModuleConfig(g_moduleIdentitySnapshot.configData));
+
+		g_configPropertiesRead = true;
+
+		return EN_SUCCESS;
+	}
+
+	uint8_t rawConfigData[MAX_CONFIG_PROPERTIES_LENGTH_BYTES];
 	EN_RESULT result = Eeprom_GetModuleConfigData((uint8_t*)&rawConfigData);
 
 	if (EN_FAILED(result))
@@ -531,6 +795,9 @@ EN_RESULT Eeprom_ReadModuleConfig()
 
 	g_configPropertiesRead = true;
 
+	Eeprom_StoreIdentitySnapshot((uint8_t*)&rawConfigData);
+	g_moduleIdentitySnapshotMatches = true;
+
 	return EN_SUCCESS;
 }
 
@@ -542,7 +809,7 @@ EN_RESULT Eeprom_GetModuleConfigProperty(uint8_t propertyIndex, ModuleConfigProp
 		return EN_ERROR_NULL_POINTER;
 	}
 
-	if (propertyIndex > CONFIG_PROPERTY_COUNT - 1)
+	if (propertyIndex >= Eeprom_GetModuleConfigPropertyCount())
 	{
 		return EN_ERROR_INVALID_MODULE_CONFIG_PROPERTY_INDEX;
 	}
@@ -565,7 +832,7 @@ EN_RESULT Eeprom_GetModuleConfigPropertyValue(uint8_t propertyIndex, uint32_t* p
 		return EN_ERROR_NULL_POINTER;
 	}
 
-	if (propertyIndex > CONFIG_PROPERTY_COUNT - 1)
+	if (propertyIndex >= Eeprom_GetModuleConfigPropertyCount())
 	{
 		return EN_ERROR_INVALID_MODULE_CONFIG_PROPERTY_INDEX;
 	}
@@ -588,7 +855,7 @@ EN_RESULT Eeprom_GetModuleConfigPropertyDescription(uint8_t propertyIndex, char*
 		return EN_ERROR_NULL_POINTER;
 	}
 
-	if (propertyIndex > CONFIG_PROPERTY_COUNT - 1)
+	if (propertyIndex >= Eeprom_GetModuleConfigPropertyCount())
 	{
 		return EN_ERROR_INVALID_MODULE_CONFIG_PROPERTY_INDEX;
 	}
@@ -620,7 +887,7 @@ EN_RESULT Eeprom_GetModuleConfigPropertKeyedValue(uint8_t propertyIndex, char* p
 		return EN_ERROR_NULL_POINTER;
 	}
 
-	if (propertyIndex > CONFIG_PROPERTY_COUNT - 1)
+	if (propertyIndex >= Eeprom_GetModuleConfigPropertyCount())
 	{
 		return EN_ERROR_INVALID_MODULE_CONFIG_PROPERTY_INDEX;
 	}
@@ -665,11 +932,51 @@ EN_RESULT Eeprom_GetModuleConfigPropertKeyedValue(uint8_t propertyIndex, char* p
 }
 
 
-EN_RESULT Eeprom_Read()
+EN_RESULT Eeprom_GetIdentitySnapshot(ModuleIdentitySnapshot_t* pSnapshot)
 {
-	EN_RETURN_IF_FAILED(Eeprom_ReadBasicModuleInfo());
+	if (pSnapshot == NULL)
+	{
+		return EN_ERROR_NULL_POINTER;
+	}
+
+	if (!Eeprom_IsIdentitySnapshotValid())
+	{
+		return EN_ERROR_MODULE_IDENTITY_SNAPSHOT_INVALID;
+	}
 
-	EN_RETURN_IF_FAILED(Eeprom_ReadModuleConfig());
+	*pSnapshot = g_moduleIdentitySnapshot;
 
 	return EN_SUCCESS;
 }
+
+
+EN_RESULT Eeprom_SetIdentitySnapshot(const ModuleIdentitySnapshot_t* pSnapshot)
+{
+	if (pSnapshot == NULL)
+	{
+		return EN_ERROR_NULL_POINTER;
+	}
+
+	g_moduleIdentitySnapshot = *pSnapshot;
+	g_moduleIdentitySnapshotMatches = false;
+
+	return EN_SUCCESS;
+}
+
+
+EN_RESULT Eeprom_Read()
+{
+	// Read everything in one session, so that the Atmel ATSHA204A is only woken once.
+	EN_RETURN_IF_FAILED(Eeprom_BeginSession());
+
+	EN_RESULT result = Eeprom_ReadBasicModuleInfo();
+
+	if (EN_SUCCEEDED(result))
+	{
+		result = Eeprom_ReadModuleConfig();
+	}
+
+	Eeprom_EndSession();
+
+	return result;
+}
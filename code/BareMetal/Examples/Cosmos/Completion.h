@@ -0,0 +1,101 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "StandardIncludes.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Completion object, used to wait for an event signalled from interrupt context (or, on hosted
+ * systems, from another thread).
+ *
+ * On AArch64 bare-metal systems, the waiting code sleeps on a WFE instruction and is woken by the event sent
+ * from Completion_Signal(); on the Cortex-A9, it sleeps on a WFI instruction and is woken by the signalling
+ * interrupt. On hosted systems, a mutex and a condition variable shared by all completions are used, so a
+ * completion holds no resources and needs no clean-up.
+ */
+typedef struct
+{
+    /// True once the completion has been signalled
+    volatile bool signalled;
+} Completion_t;
+
+
+//-------------------------------------------------------------------------------------------------
+// Function declarations
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Initialise a completion object. The completion is initially not signalled.
+ *
+ * @param	pCompletion		Completion object
+ * @return					Result code
+ */
+EN_RESULT Completion_Initialise(Completion_t* pCompletion);
+
+
+/**
+ * \brief Reset a completion object to the non-signalled state.
+ *
+ * This must be called before starting the operation whose completion will be signalled.
+ *
+ * @param	pCompletion		Completion object
+ */
+void Completion_Reset(Completion_t* pCompletion);
+
+
+/**
+ * \brief Signal a completion object, waking any code waiting for it.
+ *
+ * This function may be called from interrupt context.
+ *
+ * @param	pCompletion		Completion object
+ */
+void Completion_Signal(Completion_t* pCompletion);
+
+
+/**
+ * \brief Check whether a completion object has been signalled, without waiting.
+ *
+ * @param	pCompletion		Completion object
+ * @return					True if the completion has been signalled
+ */
+bool Completion_IsSignalled(Completion_t* pCompletion);
+
+
+/**
+ * \brief Wait for a completion object to be signalled.
+ *
+ * @param	pCompletion				Completion object
+ * @param	timeoutMicroseconds		Maximum time to wait, in microseconds
+ * @return							EN_SUCCESS if the completion was signalled, EN_ERROR_TIMEOUT otherwise
+ */
+EN_RESULT Completion_Wait(Completion_t* pCompletion, uint32_t timeoutMicroseconds);
@@ -0,0 +1,210 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "DeviceDiscovery.h"
+#include "I2cInterface.h"
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/// Number of 32-bit words of an address bitmap
+#define DEVICE_DISCOVERY_BITMAP_WORDS (DEVICE_DISCOVERY_NUMBER_OF_ADDRESSES / 32)
+
+/// Addresses of the devices which differ between modules: the Maxim DS28CN01 EEPROM, the two RTC types and the
+/// Si5338 clock generator. The multiplexer is not probed, as writing its control register switches the channels.
+const uint8_t DEVICE_DISCOVERY_MODULE_ADDRESSES[] = { 0x5C, 0x50, 0x6F, 0x51, 0x70 };
+
+//-------------------------------------------------------------------------------------------------
+// Global variable definitions
+//-------------------------------------------------------------------------------------------------
+
+/// Bitmap of the addresses which have been probed
+uint32_t g_deviceDiscoveryProbedAddresses[DEVICE_DISCOVERY_BITMAP_WORDS];
+
+/// Bitmap of the addresses of the devices found to be present
+uint32_t g_deviceDiscoveryPresentAddresses[DEVICE_DISCOVERY_BITMAP_WORDS];
+
+/// True once the module addresses have been scanned
+bool g_deviceDiscoveryModuleScanned = false;
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Set or clear the bit of a device address in a bitmap.
+ */
+void DeviceDiscovery_SetBit(uint32_t* pBitmap, uint8_t deviceAddress, bool value)
+{
+    uint32_t mask = 1U << (deviceAddress % 32);
+
+    if (value)
+    {
+        pBitmap[deviceAddress / 32] |= mask;
+    }
+    else
+    {
+        pBitmap[deviceAddress / 32] &= ~mask;
+    }
+}
+
+/**
+ * \brief Get the bit of a device address in a bitmap.
+ */
+bool DeviceDiscovery_GetBit(const uint32_t* pBitmap, uint8_t deviceAddress)
+{
+    return ((pBitmap[deviceAddress / 32] >> (deviceAddress % 32)) & 1) != 0;
+}
+
+EN_RESULT DeviceDiscovery_Scan(const uint8_t* pAddresses, uint32_t numberOfAddresses)
+{
+    if (pAddresses == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    uint32_t firstIndex;
+    for (firstIndex = 0; firstIndex < numberOfAddresses; firstIndex += DEVICE_DISCOVERY_MAX_PROBES)
+    {
+        I2cTransaction_t probes[DEVICE_DISCOVERY_MAX_PROBES];
+        uint8_t subAddress = 0;
+        uint32_t numberOfProbes = numberOfAddresses - firstIndex;
+        uint32_t numberOfSubmitted = 0;
+        EN_RESULT result = EN_SUCCESS;
+        uint32_t probeIndex;
+
+        if (numberOfProbes > DEVICE_DISCOVERY_MAX_PROBES)
+        {
+            numberOfProbes = DEVICE_DISCOVERY_MAX_PROBES;
+        }
+
+        // The controller cannot address a device without transferring at least one byte, so the probe writes the
+        // register address 0 only. The probes are submitted one by one rather than as a batch, because a batch
+        // fails as a whole on Linux if one of its devices does not acknowledge.
+        for (probeIndex = 0; probeIndex < numberOfProbes; probeIndex++)
+        {
+            uint8_t deviceAddress = pAddresses[firstIndex + probeIndex];
+            if (deviceAddress >= DEVICE_DISCOVERY_NUMBER_OF_ADDRESSES)
+            {
+                result = EN_ERROR_INVALID_ARGUMENT;
+                break;
+            }
+
+            I2cInitialiseTransaction(&probes[probeIndex],
+                                     deviceAddress,
+                                     EI2cDirection_Write,
+                                     subAddress,
+                                     EI2cSubAddressMode_OneByte,
+                                     &subAddress,
+                                     0);
+
+            result = I2cSubmit(&probes[probeIndex]);
+            if (EN_FAILED(result))
+            {
+                break;
+            }
+
+            numberOfSubmitted++;
+        }
+
+        // Wait for all submitted probes, even if a submission failed, as they use the local descriptors.
+        for (probeIndex = 0; probeIndex < numberOfSubmitted; probeIndex++)
+        {
+            uint8_t deviceAddress = probes[probeIndex].deviceAddress;
+            bool isPresent =
+                EN_SUCCEEDED(I2cWaitForTransaction(&probes[probeIndex], DEVICE_DISCOVERY_PROBE_TIMEOUT_MICROSECONDS));
+
+            DeviceDiscovery_SetDevicePresent(deviceAddress, isPresent);
+        }
+
+        EN_RETURN_IF_FAILED(result);
+    }
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT DeviceDiscovery_ScanModule()
+{
+    if (!g_deviceDiscoveryModuleScanned)
+    {
+        EN_RETURN_IF_FAILED(DeviceDiscovery_Scan(DEVICE_DISCOVERY_MODULE_ADDRESSES,
+                                                 sizeof(DEVICE_DISCOVERY_MODULE_ADDRESSES) /
+                                                     sizeof(DEVICE_DISCOVERY_MODULE_ADDRESSES[0])));
+
+        g_deviceDiscoveryModuleScanned = true;
+    }
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT DeviceDiscovery_IsDevicePresent(uint8_t deviceAddress, bool* pIsPresent)
+{
+    if (pIsPresent == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    if (deviceAddress >= DEVICE_DISCOVERY_NUMBER_OF_ADDRESSES)
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!DeviceDiscovery_GetBit(g_deviceDiscoveryProbedAddresses, deviceAddress))
+    {
+        EN_RETURN_IF_FAILED(DeviceDiscovery_ScanModule());
+    }
+
+    if (!DeviceDiscovery_GetBit(g_deviceDiscoveryProbedAddresses, deviceAddress))
+    {
+        EN_RETURN_IF_FAILED(DeviceDiscovery_Scan(&deviceAddress, 1));
+    }
+
+    *pIsPresent = DeviceDiscovery_GetBit(g_deviceDiscoveryPresentAddresses, deviceAddress);
+
+    return EN_SUCCESS;
+}
+
+void DeviceDiscovery_SetDevicePresent(uint8_t deviceAddress, bool isPresent)
+{
+    if (deviceAddress < DEVICE_DISCOVERY_NUMBER_OF_ADDRESSES)
+    {
+        DeviceDiscovery_SetBit(g_deviceDiscoveryProbedAddresses, deviceAddress, true);
+        DeviceDiscovery_SetBit(g_deviceDiscoveryPresentAddresses, deviceAddress, isPresent);
+    }
+}
+
+void DeviceDiscovery_Reset()
+{
+    uint32_t wordIndex;
+    for (wordIndex = 0; wordIndex < DEVICE_DISCOVERY_BITMAP_WORDS; wordIndex++)
+    {
+        g_deviceDiscoveryProbedAddresses[wordIndex] = 0;
+        g_deviceDiscoveryPresentAddresses[wordIndex] = 0;
+    }
+
+    g_deviceDiscoveryModuleScanned = false;
+}
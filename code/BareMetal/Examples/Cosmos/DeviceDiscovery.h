@@ -0,0 +1,100 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "StandardIncludes.h"
+#include "ErrorCodes.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/// Number of 7-bit device addresses
+#define DEVICE_DISCOVERY_NUMBER_OF_ADDRESSES 128
+
+/// Maximum number of probes which are queued at the same time
+#define DEVICE_DISCOVERY_MAX_PROBES 16
+
+/// Time to wait for a probe to complete
+#define DEVICE_DISCOVERY_PROBE_TIMEOUT_MICROSECONDS (10000)
+
+
+//-------------------------------------------------------------------------------------------------
+// Function declarations
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Probe device addresses and record in the presence bitmap which of them are acknowledged.
+ *
+ * Each probe only writes the register address 0, without data, so it does not change the state of a register
+ * based device. All probes are queued before waiting for the first one, so they are transferred back to back.
+ *
+ * Note that a device in sleep mode (e.g. the Atmel ATSHA204A) does not acknowledge its address, so it is only
+ * found if it has been woken before.
+ *
+ * \param	pAddresses			Device addresses to probe
+ * \param	numberOfAddresses	Number of device addresses
+ * \returns						Result code
+ */
+EN_RESULT DeviceDiscovery_Scan(const uint8_t* pAddresses, uint32_t numberOfAddresses);
+
+
+/**
+ * \brief Probe the addresses of all devices of the module which may be fitted or not, unless this has been done
+ * already.
+ *
+ * \returns		Result code
+ */
+EN_RESULT DeviceDiscovery_ScanModule();
+
+
+/**
+ * \brief Check whether a device is present.
+ *
+ * If the address has not been probed yet, the module addresses are scanned first, or the address is probed
+ * alone if it is not one of them.
+ *
+ * \param	deviceAddress		Device address
+ * \param[out]	pIsPresent		True if the device has acknowledged its address
+ * \returns						Result code
+ */
+EN_RESULT DeviceDiscovery_IsDevicePresent(uint8_t deviceAddress, bool* pIsPresent);
+
+
+/**
+ * \brief Record the presence of a device which has been detected in another way, e.g. after waking it.
+ *
+ * \param	deviceAddress		Device address
+ * \param	isPresent			True if the device is present
+ */
+void DeviceDiscovery_SetDevicePresent(uint8_t deviceAddress, bool isPresent);
+
+
+/**
+ * \brief Forget the results of all probes, e.g. after a device has been powered up or reset.
+ */
+void DeviceDiscovery_Reset();
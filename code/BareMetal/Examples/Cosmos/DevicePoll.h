@@ -0,0 +1,128 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "StandardIncludes.h"
+#include "ErrorCodes.h"
+#include "I2cInterface.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Timing of a device poll. The interval between two polls starts at the initial interval and doubles after
+ * each poll, up to the maximum interval, so that a slow device does not keep the bus busy.
+ */
+typedef struct
+{
+    /// Interval between the first two polls
+    uint32_t initialIntervalMicroseconds;
+
+    /// Upper limit of the interval between two polls
+    uint32_t maxIntervalMicroseconds;
+
+    /// Time after which the poll gives up
+    uint32_t timeoutMicroseconds;
+} DevicePollTiming_t;
+
+/**
+ * \brief Condition checked by DevicePoll_Wait().
+ *
+ * \param	pContext			Context passed to DevicePoll_Wait()
+ * \param[out]	pConditionMet	Set to true once the device has reached the awaited state
+ * \returns						Result code; a failure ends the poll
+ */
+typedef EN_RESULT (*DevicePollCondition_t)(void* pContext, bool* pConditionMet);
+
+
+//-------------------------------------------------------------------------------------------------
+// Function declarations
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Poll a condition until it is met, with exponential backoff between the polls.
+ *
+ * The condition is checked at least once, and once more after the timeout has expired, so that a long sleep
+ * does not cause a spurious timeout.
+ *
+ * \param	pCondition					Condition to check
+ * \param	pContext					Context passed to the condition
+ * \param	pTiming						Timing of the poll
+ * \param[out]	pElapsedMicroseconds	Time until the condition was met or the poll gave up; may be NULL
+ * \returns								Result code; EN_ERROR_TIMEOUT if the condition was not met in time
+ */
+EN_RESULT DevicePoll_Wait(DevicePollCondition_t pCondition,
+                          void* pContext,
+                          const DevicePollTiming_t* pTiming,
+                          uint32_t* pElapsedMicroseconds);
+
+
+/**
+ * \brief Poll a register until the bits of a mask have the expected value, with exponential backoff.
+ *
+ * \param	deviceAddress				Device address
+ * \param	registerAddress				Register address
+ * \param	subAddressMode				Sub address mode
+ * \param	mask						Bits to check
+ * \param	expectedValue				Expected value of the bits to check
+ * \param	pTiming						Timing of the poll
+ * \param[out]	pValue					Last value read from the register; may be NULL
+ * \param[out]	pElapsedMicroseconds	Time until the bits had the expected value or the poll gave up; may be NULL
+ * \returns								Result code; EN_ERROR_TIMEOUT if the bits did not reach the value in time
+ */
+EN_RESULT DevicePoll_WaitForRegister(uint8_t deviceAddress,
+                                     uint16_t registerAddress,
+                                     EI2cSubAddressMode_t subAddressMode,
+                                     uint8_t mask,
+                                     uint8_t expectedValue,
+                                     const DevicePollTiming_t* pTiming,
+                                     uint8_t* pValue,
+                                     uint32_t* pElapsedMicroseconds);
+
+
+/**
+ * \brief Read from a device which does not acknowledge its address while busy, until the read succeeds, with
+ * exponential backoff.
+ *
+ * \param	deviceAddress				Device address
+ * \param	subAddress					Sub address
+ * \param	subAddressMode				Sub address mode
+ * \param	numberOfBytes				Number of bytes to read
+ * \param[out]	pBuffer					Buffer receiving the data
+ * \param	pTiming						Timing of the poll
+ * \param[out]	pElapsedMicroseconds	Time until the read succeeded or the poll gave up; may be NULL
+ * \returns								Result code; EN_ERROR_TIMEOUT if no read succeeded in time
+ */
+EN_RESULT DevicePoll_ReadWhenReady(uint8_t deviceAddress,
+                                   uint16_t subAddress,
+                                   EI2cSubAddressMode_t subAddressMode,
+                                   uint32_t numberOfBytes,
+                                   uint8_t* pBuffer,
+                                   const DevicePollTiming_t* pTiming,
+                                   uint32_t* pElapsedMicroseconds);
@@ -0,0 +1,247 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "I2cBusSpeed.h"
+#include "SystemDefinitions.h"
+#include "UtilityFunctions.h"
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Bus speed of a device.
+ */
+typedef struct
+{
+    /// Multiplexer channel behind which the device is found, or one of the I2C_MUX_CHANNEL_* values
+    uint8_t muxChannel;
+
+    /// Device address
+    uint8_t deviceAddress;
+
+    /// Highest SCL frequency supported by the device
+    uint32_t maxClockSpeedHz;
+
+    /// True if the device NACKs its address while busy (acknowledge polling)
+    bool nacksWhenBusy;
+
+    /// Current SCL frequency
+    uint32_t clockSpeedHz;
+
+    /// Number of consecutive failed transfers at the current SCL frequency
+    uint32_t errorCount;
+} I2cDeviceSpeed_t;
+
+//-------------------------------------------------------------------------------------------------
+// Global variable definitions
+//-------------------------------------------------------------------------------------------------
+
+/// Bus speeds of the devices found on the Enclustra modules and base boards. The devices on the module share the
+/// bus segment upstream of the base board multiplexer (if any). Addresses which are only used by the module are
+/// matched on any multiplexer channel; addresses which base board devices behind the multiplexer may also use are
+/// only matched while no channel is selected, so that such devices fall back to the default SCL frequency instead
+/// of inheriting the frequency of the module device. Entries for base board devices give their channel.
+/// The current SCL frequency and the error count are set by I2cBusSpeed_Initialise().
+I2cDeviceSpeed_t g_i2cDeviceSpeeds[] = {
+    // The wake token of the Atmel ATSHA204A is a write to address 0, which must hold SDA low for at least 60 us
+    { .muxChannel = I2C_MUX_CHANNEL_ANY,
+      .deviceAddress = 0x00,
+      .maxClockSpeedHz = I2C_STANDARD_MODE_CLOCK_SPEED_HZ,
+      .nacksWhenBusy = true },
+
+    // System controller
+    { .muxChannel = I2C_MUX_CHANNEL_ANY,
+      .deviceAddress = 0x0D,
+      .maxClockSpeedHz = I2C_STANDARD_MODE_CLOCK_SPEED_HZ,
+      .nacksWhenBusy = false },
+
+    // LM96080 system monitor
+    { .muxChannel = I2C_MUX_CHANNEL_ANY,
+      .deviceAddress = 0x2F,
+      .maxClockSpeedHz = I2C_FAST_MODE_CLOCK_SPEED_HZ,
+      .nacksWhenBusy = false },
+
+    // Maxim DS28CN01 EEPROM (alternative address)
+    { .muxChannel = I2C_MUX_CHANNEL_NONE,
+      .deviceAddress = 0x50,
+      .maxClockSpeedHz = I2C_FAST_MODE_CLOCK_SPEED_HZ,
+      .nacksWhenBusy = false },
+
+    // NXP PCF85063A RTC
+    { .muxChannel = I2C_MUX_CHANNEL_NONE,
+      .deviceAddress = 0x51,
+      .maxClockSpeedHz = I2C_FAST_MODE_CLOCK_SPEED_HZ,
+      .nacksWhenBusy = false },
+
+    // Microchip 24AA128 user EEPROM, which NACKs during its write cycle
+    { .muxChannel = I2C_MUX_CHANNEL_NONE,
+      .deviceAddress = 0x56,
+      .maxClockSpeedHz = I2C_FAST_MODE_CLOCK_SPEED_HZ,
+      .nacksWhenBusy = true },
+
+    // Maxim DS28CN01 EEPROM
+    { .muxChannel = I2C_MUX_CHANNEL_ANY,
+      .deviceAddress = 0x5C,
+      .maxClockSpeedHz = I2C_FAST_MODE_CLOCK_SPEED_HZ,
+      .nacksWhenBusy = false },
+
+    // Atmel ATSHA204A, which NACKs while asleep or executing a command
+    { .muxChannel = I2C_MUX_CHANNEL_ANY,
+      .deviceAddress = 0x64,
+      .maxClockSpeedHz = I2C_FAST_MODE_PLUS_CLOCK_SPEED_HZ,
+      .nacksWhenBusy = true },
+
+    // Intersil ISL12020M RTC
+    { .muxChannel = I2C_MUX_CHANNEL_ANY,
+      .deviceAddress = 0x6F,
+      .maxClockSpeedHz = I2C_FAST_MODE_CLOCK_SPEED_HZ,
+      .nacksWhenBusy = false },
+
+    // Silicon Labs Si5338 clock generator
+    { .muxChannel = I2C_MUX_CHANNEL_ANY,
+      .deviceAddress = 0x70,
+      .maxClockSpeedHz = I2C_FAST_MODE_CLOCK_SPEED_HZ,
+      .nacksWhenBusy = false },
+
+    // NXP PCA9547 I2C multiplexer
+    { .muxChannel = I2C_MUX_CHANNEL_ANY,
+      .deviceAddress = 0x74,
+      .maxClockSpeedHz = I2C_FAST_MODE_CLOCK_SPEED_HZ,
+      .nacksWhenBusy = false }
+};
+
+/// SCL frequency for devices which are not in the table
+uint32_t g_i2cDefaultClockSpeedHz = I2C_STANDARD_MODE_CLOCK_SPEED_HZ;
+
+/// Highest SCL frequency supported by the I2C controller
+uint32_t g_i2cMaxClockSpeedHz = I2C_STANDARD_MODE_CLOCK_SPEED_HZ;
+
+/// Currently selected multiplexer channel, or I2C_MUX_CHANNEL_NONE
+uint8_t g_i2cMuxChannel = I2C_MUX_CHANNEL_NONE;
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Find a device in the device speed table, on the currently selected multiplexer channel.
+ *
+ * \param	deviceAddress	Device address
+ * \returns					Table entry, or NULL if the device is not in the table
+ */
+I2cDeviceSpeed_t* I2cBusSpeed_FindDevice(uint8_t deviceAddress)
+{
+    unsigned int index;
+    for (index = 0; index < sizeof(g_i2cDeviceSpeeds) / sizeof(g_i2cDeviceSpeeds[0]); index++)
+    {
+        I2cDeviceSpeed_t* pDevice = &g_i2cDeviceSpeeds[index];
+
+        if ((pDevice->deviceAddress == deviceAddress) &&
+            ((pDevice->muxChannel == I2C_MUX_CHANNEL_ANY) || (pDevice->muxChannel == g_i2cMuxChannel)))
+        {
+            return pDevice;
+        }
+    }
+
+    return NULL;
+}
+
+void I2cBusSpeed_Initialise(uint32_t defaultClockSpeedHz, uint32_t maxClockSpeedHz)
+{
+    g_i2cMaxClockSpeedHz = maxClockSpeedHz;
+    g_i2cDefaultClockSpeedHz = min(defaultClockSpeedHz, maxClockSpeedHz);
+
+    unsigned int index;
+    for (index = 0; index < sizeof(g_i2cDeviceSpeeds) / sizeof(g_i2cDeviceSpeeds[0]); index++)
+    {
+        g_i2cDeviceSpeeds[index].clockSpeedHz = min(g_i2cDeviceSpeeds[index].maxClockSpeedHz, maxClockSpeedHz);
+        g_i2cDeviceSpeeds[index].errorCount = 0;
+    }
+}
+
+uint32_t I2cBusSpeed_GetClockSpeed(uint8_t deviceAddress)
+{
+    I2cDeviceSpeed_t* pDevice = I2cBusSpeed_FindDevice(deviceAddress);
+
+    return (pDevice != NULL) ? pDevice->clockSpeedHz : g_i2cDefaultClockSpeedHz;
+}
+
+void I2cBusSpeed_ReportResult(uint8_t deviceAddress, EN_RESULT result)
+{
+    I2cDeviceSpeed_t* pDevice = I2cBusSpeed_FindDevice(deviceAddress);
+    if (pDevice == NULL)
+    {
+        return;
+    }
+
+    if (EN_SUCCEEDED(result))
+    {
+        pDevice->errorCount = 0;
+        return;
+    }
+
+    // Only NACKs and lost arbitrations (reported as failed reads or writes) point at the SCL frequency;
+    // timeouts and cancelled transactions do not.
+    bool speedError = ((result == EN_ERROR_I2C_SLAVE_NACK) && !pDevice->nacksWhenBusy) ||
+                      (result == EN_ERROR_I2C_READ_FAILED) || (result == EN_ERROR_I2C_WRITE_FAILED);
+
+    if (!speedError || (pDevice->clockSpeedHz <= I2C_STANDARD_MODE_CLOCK_SPEED_HZ))
+    {
+        return;
+    }
+
+    pDevice->errorCount++;
+    if (pDevice->errorCount >= I2C_BUS_SPEED_FALLBACK_ERROR_COUNT)
+    {
+        pDevice->clockSpeedHz = (pDevice->clockSpeedHz > I2C_FAST_MODE_CLOCK_SPEED_HZ) ? I2C_FAST_MODE_CLOCK_SPEED_HZ
+                                                                                      : I2C_STANDARD_MODE_CLOCK_SPEED_HZ;
+        pDevice->errorCount = 0;
+
+#ifdef _DEBUG
+        EN_PRINTF("I2C device 0x%x falls back to %u Hz\n\r", deviceAddress, (unsigned int)pDevice->clockSpeedHz);
+#endif
+    }
+}
+
+EN_RESULT I2cBusSpeed_SetClockSpeed(uint8_t deviceAddress, uint32_t clockSpeedHz)
+{
+    I2cDeviceSpeed_t* pDevice = I2cBusSpeed_FindDevice(deviceAddress);
+    if ((pDevice == NULL) || (clockSpeedHz == 0))
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    pDevice->clockSpeedHz = min(clockSpeedHz, min(pDevice->maxClockSpeedHz, g_i2cMaxClockSpeedHz));
+    pDevice->errorCount = 0;
+
+    return EN_SUCCESS;
+}
+
+void I2cBusSpeed_SetMuxChannel(uint8_t muxChannel)
+{
+    g_i2cMuxChannel = muxChannel;
+}
@@ -25,18 +25,50 @@
 //-------------------------------------------------------------------------------------------------
 
 #include "I2cInterface.h"
+#include "I2cBusSpeed.h"
 #include "I2cInterfaceVariables.h"
+#include "I2cTransactionQueue.h"
 #include "SystemDefinitions.h"
 #include "UtilityFunctions.h"
 #include "TimerInterface.h"
 #include "InterruptController.h"
+#include "Completion.h"
 #include "ErrorCodes.h"
 
 //-------------------------------------------------------------------------------------------------
 // Constants
 //-------------------------------------------------------------------------------------------------
 
-const unsigned int I2C_CLOCK_SPEED_HZ = 100000;
+/// SCL frequency for devices which are not in the device speed table
+const unsigned int I2C_CLOCK_SPEED_HZ = I2C_STANDARD_MODE_CLOCK_SPEED_HZ;
+
+/// Highest SCL frequency supported by the Zynq I2C controller
+const unsigned int I2C_MAX_CLOCK_SPEED_HZ = I2C_FAST_MODE_CLOCK_SPEED_HZ;
+
+/// Timeout for write transfers, including the stop condition
+const uint32_t I2C_WRITE_TIMEOUT_MICROSECONDS = 100000;
+
+/// Timeout for read transfers
+const uint32_t I2C_READ_TIMEOUT_MICROSECONDS = 1000000;
+
+/// Timeout for the stop condition of the previous transfer to finish before starting the next one. The stop
+/// condition and the following bus free time take less than 10 us even at 100 kHz, so this is short enough to
+/// wait for in interrupt context.
+const uint32_t I2C_BUS_IDLE_TIMEOUT_MICROSECONDS = 20;
+
+/// Maximum number of bytes transferred in one go by transactions which can be split into chunks. This bounds
+/// the time a higher priority transaction waits for the bus (about 3 ms at 100 kHz).
+const uint32_t I2C_MAX_CHUNK_LENGTH_BYTES = 32;
+
+/**
+ * \brief Transaction transfer phases.
+ */
+typedef enum
+{
+    EI2cPhase_WriteData,   ///< Writing the header and the data segments
+    EI2cPhase_WriteHeader, ///< Writing the header of a read; the bus is held for a repeated start
+    EI2cPhase_ReadData     ///< Reading the data
+} EI2cPhase_t;
 
 
 //-------------------------------------------------------------------------------------------------
@@ -46,17 +78,418 @@ const unsigned int I2C_CLOCK_SPEED_HZ = 100000;
 XIicPs g_XIicPsInstance;
 XIicPs_Config* g_pXIicPsConfig;
 
-volatile bool g_i2cTransmissionInProgress;
-volatile bool g_i2cReceiveInProgress;
-volatile bool g_i2cSlaveNack;
+/// Transaction currently being transferred
+I2cTransaction_t* volatile g_pActiveTransaction;
+
+/// Queues of submitted transactions waiting for the bus, one per priority
+I2cTransactionQueue_t g_transactionQueues[I2C_NUMBER_OF_PRIORITIES];
+
+/// Partially transferred transactions, interrupted between two chunks by a higher priority transaction
+I2cTransaction_t* g_pSuspendedTransactions[I2C_NUMBER_OF_PRIORITIES];
+
+/// True while a context owns the bus, i.e. is starting a transaction or has a transaction in progress
+volatile uint32_t g_busOwned;
 
 volatile uint32_t g_transmissionErrorCount;
 
+/// SCL frequency the controller is currently programmed with
+uint32_t g_i2cClockSpeedHz;
+
 //-------------------------------------------------------------------------------------------------
 // Function definitions
 //-------------------------------------------------------------------------------------------------
 
 
+EN_RESULT I2cAbort()
+{
+    XIicPs_Abort(&g_XIicPsInstance);
+
+    // Aborting resets the control register, which includes the clock divisors.
+    XIicPs_SetSClk(&g_XIicPsInstance, g_i2cClockSpeedHz);
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Program the SCL frequency, if it differs from the current one. The bus must be idle.
+ *
+ * \param	clockSpeedHz	SCL frequency in Hz
+ * \returns				Result code
+ */
+EN_RESULT I2cSetClockSpeed(uint32_t clockSpeedHz)
+{
+    if (clockSpeedHz != g_i2cClockSpeedHz)
+    {
+        RETURN_IF_XILINX_CALL_FAILED(XIicPs_SetSClk(&g_XIicPsInstance, clockSpeedHz),
+                                     EN_ERROR_FAILED_TO_INITIALISE_I2C_CONTROLLER);
+        g_i2cClockSpeedHz = clockSpeedHz;
+    }
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Release the bus after a failed transfer, if it is held for a repeated start.
+ */
+void I2cReleaseBus()
+{
+    XIicPs_ClearOptions(&g_XIicPsInstance, XIICPS_REP_START_OPTION);
+
+    // Clearing the hold bit makes the controller send the stop condition.
+    uint32_t baseAddress = g_XIicPsInstance.Config.BaseAddress;
+    XIicPs_WriteReg(
+        baseAddress, XIICPS_CR_OFFSET, XIicPs_ReadReg(baseAddress, XIICPS_CR_OFFSET) & ~XIICPS_CR_HOLD_MASK);
+}
+
+/**
+ * \brief Check whether a transaction may be transferred in several chunks.
+ *
+ * \param	pTransaction	Transaction
+ * \returns					True if the transaction may be split
+ */
+bool I2cCanSplitTransaction(const I2cTransaction_t* pTransaction)
+{
+    // Only transactions with a subaddress can be split, as each chunk needs its own subaddress.
+    if ((pTransaction->headerLength == 0) || (pTransaction->pHeader != pTransaction->subAddressBytes) ||
+        (pTransaction->pSegments != NULL))
+    {
+        return false;
+    }
+
+    if (pTransaction->direction == EI2cDirection_Read)
+    {
+        return ((pTransaction->flags & I2C_TRANSACTION_FLAG_NO_SPLIT) == 0);
+    }
+
+    return ((pTransaction->flags & I2C_TRANSACTION_FLAG_SPLIT_WRITE) != 0);
+}
+
+/**
+ * \brief Get one of the segments written by a write transaction.
+ *
+ * Segment 0 is the header; it is followed by the data of the current chunk, or by the data segments of a
+ * scatter-gather write.
+ *
+ * \param	pTransaction	Write transaction
+ * \param	segmentIndex	Segment index
+ * \param	ppData			Receives a pointer to the segment data
+ * \param	pLength			Receives the segment length in bytes
+ * \returns					False if the segment index is beyond the last segment
+ */
+bool I2cGetWriteSegment(const I2cTransaction_t* pTransaction,
+                        uint32_t segmentIndex,
+                        const uint8_t** ppData,
+                        uint32_t* pLength)
+{
+    if (segmentIndex == 0)
+    {
+        *ppData = pTransaction->pHeader;
+        *pLength = pTransaction->headerLength;
+        return true;
+    }
+
+    if (pTransaction->pSegments == NULL)
+    {
+        *ppData = &pTransaction->pData[pTransaction->bytesTransferred];
+        *pLength = pTransaction->chunkLength;
+        return (segmentIndex == 1);
+    }
+
+    if (segmentIndex <= pTransaction->numberOfSegments)
+    {
+        *ppData = pTransaction->pSegments[segmentIndex - 1].pData;
+        *pLength = pTransaction->pSegments[segmentIndex - 1].length;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * \brief Move the write position of a transaction past any fully written or empty segments.
+ *
+ * \param	pTransaction	Write transaction
+ * \returns					False if all the data has been written
+ */
+bool I2cSkipWrittenSegments(I2cTransaction_t* pTransaction)
+{
+    const uint8_t* pSegmentData;
+    uint32_t segmentLength;
+
+    while (I2cGetWriteSegment(pTransaction, pTransaction->segmentIndex, &pSegmentData, &segmentLength))
+    {
+        if (pTransaction->segmentOffset < segmentLength)
+        {
+            return true;
+        }
+
+        pTransaction->segmentIndex++;
+        pTransaction->segmentOffset = 0;
+    }
+
+    return false;
+}
+
+/**
+ * \brief Write the next bytes of a write transaction directly into the controller FIFO.
+ *
+ * This is used while the bus is held after the first segment: the controller continues the transfer as
+ * soon as data is available, without a new start condition.
+ *
+ * \param	pTransaction	Write transaction
+ * \returns					The number of bytes written into the FIFO
+ */
+uint32_t I2cFillWriteFifo(I2cTransaction_t* pTransaction)
+{
+    uint32_t baseAddress = g_XIicPsInstance.Config.BaseAddress;
+    uint32_t bytesQueued = 0;
+    const uint8_t* pSegmentData;
+    uint32_t segmentLength;
+
+    while ((bytesQueued < XIICPS_FIFO_DEPTH) && I2cSkipWrittenSegments(pTransaction))
+    {
+        I2cGetWriteSegment(pTransaction, pTransaction->segmentIndex, &pSegmentData, &segmentLength);
+
+        XIicPs_WriteReg(baseAddress, XIICPS_DATA_OFFSET, pSegmentData[pTransaction->segmentOffset]);
+        pTransaction->segmentOffset++;
+        bytesQueued++;
+    }
+
+    return bytesQueued;
+}
+
+/**
+ * \brief Start transferring the next chunk of a transaction. Must only be called by the bus owner.
+ *
+ * \param	pTransaction	Transaction to start
+ * \returns					Result code
+ */
+EN_RESULT I2cStartTransaction(I2cTransaction_t* pTransaction)
+{
+    // The controller cannot start a transfer while the stop condition of the previous one is still being sent.
+    // This is usually called from the completion interrupt, so the wait is bounded to the length of a stop
+    // condition; a bus which stays busy longer is held by someone else, and the transfer fails.
+    uint64_t startTime = GetTimeMicroseconds();
+    while (XIicPs_BusIsBusy(&g_XIicPsInstance))
+    {
+        if ((GetTimeMicroseconds() - startTime) > I2C_BUS_IDLE_TIMEOUT_MICROSECONDS)
+        {
+            return (pTransaction->direction == EI2cDirection_Read) ? EN_ERROR_I2C_READ_TIMEOUT
+                                                                   : EN_ERROR_I2C_WRITE_TIMEOUT;
+        }
+    }
+
+    // Consecutive transactions usually address the same device, so the clock divisors rarely change.
+    EN_RETURN_IF_FAILED(I2cSetClockSpeed(I2cBusSpeed_GetClockSpeed(pTransaction->deviceAddress)));
+
+    uint32_t remainingBytes = pTransaction->numberOfBytes - pTransaction->bytesTransferred;
+    pTransaction->chunkLength = remainingBytes;
+
+    if (I2cCanSplitTransaction(pTransaction))
+    {
+        pTransaction->chunkLength = min(remainingBytes, I2C_MAX_CHUNK_LENGTH_BYTES);
+
+        // Each chunk starts at the subaddress following the previous chunk.
+        uint16_t chunkSubAddress = pTransaction->subAddress + pTransaction->bytesTransferred;
+        if (pTransaction->subAddressMode == EI2cSubAddressMode_OneByte)
+        {
+            pTransaction->subAddressBytes[0] = (uint8_t)chunkSubAddress;
+        }
+        else
+        {
+            pTransaction->subAddressBytes[0] = GetUpperByte(chunkSubAddress);
+            pTransaction->subAddressBytes[1] = GetLowerByte(chunkSubAddress);
+        }
+    }
+
+    g_pActiveTransaction = pTransaction;
+    pTransaction->status = EI2cTransactionStatus_InProgress;
+    g_transmissionErrorCount = 0;
+
+    if (pTransaction->direction == EI2cDirection_Write)
+    {
+        pTransaction->phase = EI2cPhase_WriteData;
+
+        // The first segment is sent by the driver. Any further segments are written into the FIFO by the status
+        // handler as the transfer progresses, so the data is never copied.
+        const uint8_t* pSegmentData;
+        uint32_t segmentLength;
+
+        pTransaction->segmentIndex = 0;
+        pTransaction->segmentOffset = 0;
+        I2cSkipWrittenSegments(pTransaction);
+        I2cGetWriteSegment(pTransaction, pTransaction->segmentIndex, &pSegmentData, &segmentLength);
+
+        pTransaction->segmentIndex++;
+        if (I2cSkipWrittenSegments(pTransaction))
+        {
+            // Hold the bus after the first segment, so that the following segments continue the same transfer.
+            XIicPs_SetOptions(&g_XIicPsInstance, XIICPS_REP_START_OPTION);
+        }
+
+        XIicPs_MasterSend(&g_XIicPsInstance, (uint8_t*)pSegmentData, segmentLength, pTransaction->deviceAddress);
+    }
+    else if (pTransaction->headerLength == 0)
+    {
+        pTransaction->phase = EI2cPhase_ReadData;
+
+        XIicPs_MasterRecv(&g_XIicPsInstance,
+                          &pTransaction->pData[pTransaction->bytesTransferred],
+                          pTransaction->chunkLength,
+                          pTransaction->deviceAddress);
+    }
+    else
+    {
+        pTransaction->phase = EI2cPhase_WriteHeader;
+
+        // Hold the bus after the header, so that the read phase starts with a repeated start condition
+        // instead of a stop/start pair.
+        XIicPs_SetOptions(&g_XIicPsInstance, XIICPS_REP_START_OPTION);
+
+        XIicPs_MasterSend(&g_XIicPsInstance,
+                          (uint8_t*)pTransaction->pHeader,
+                          pTransaction->headerLength,
+                          pTransaction->deviceAddress);
+    }
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Mark a transaction as complete. Must only be called by the bus owner, or with interrupts disabled.
+ *
+ * \param	pTransaction	Transaction to complete
+ * \param	result			Result code
+ * \param	callCallback	True if the transaction callback is to be called
+ */
+void I2cCompleteTransaction(I2cTransaction_t* pTransaction, EN_RESULT result, bool callCallback)
+{
+    if (g_pActiveTransaction == pTransaction)
+    {
+        g_pActiveTransaction = NULL;
+    }
+
+    pTransaction->result = result;
+    pTransaction->status = EI2cTransactionStatus_Complete;
+    Completion_Signal(&pTransaction->completion);
+
+    // This must be the last access to the transaction, as the callback may resubmit it.
+    if (callCallback && (pTransaction->callback != NULL))
+    {
+        pTransaction->callback(pTransaction, pTransaction->pCallbackContext);
+    }
+}
+
+/**
+ * \brief Try to take ownership of the bus.
+ *
+ * \returns		True if the caller is now the bus owner
+ */
+bool I2cTryAcquireBus()
+{
+    uint32_t expected = false;
+    return __atomic_compare_exchange_n(&g_busOwned, &expected, true, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+/**
+ * \brief Select the next transaction to transfer: the highest priority suspended or queued transaction.
+ * Must only be called by the bus owner.
+ *
+ * \returns		The selected transaction, or NULL if there is nothing to transfer
+ */
+I2cTransaction_t* I2cSelectNextTransaction()
+{
+    unsigned int priority;
+    for (priority = 0; priority < I2C_NUMBER_OF_PRIORITIES; priority++)
+    {
+        // A suspended transaction is resumed before any other transaction of the same priority is started.
+        if (g_pSuspendedTransactions[priority] != NULL)
+        {
+            I2cTransaction_t* pTransaction = g_pSuspendedTransactions[priority];
+            g_pSuspendedTransactions[priority] = NULL;
+            return pTransaction;
+        }
+
+        I2cTransaction_t* pTransaction;
+        while (I2cTransactionQueue_Pop(&g_transactionQueues[priority], &pTransaction))
+        {
+            // Cancelled transactions leave an empty entry in the queue.
+            if (pTransaction != NULL)
+            {
+                return pTransaction;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Start the next transaction. Must only be called by the bus owner, when no transaction is in progress.
+ *
+ * If there is nothing to transfer, the bus ownership is released.
+ */
+void I2cStartNextTransaction()
+{
+    for (;;)
+    {
+        I2cTransaction_t* pTransaction = I2cSelectNextTransaction();
+
+        if (pTransaction != NULL)
+        {
+            EN_RESULT result = I2cStartTransaction(pTransaction);
+            if (EN_SUCCEEDED(result))
+            {
+                // The bus remains owned until the transfer completes.
+                return;
+            }
+
+            I2cCompleteTransaction(pTransaction, result, true);
+            continue;
+        }
+
+        __atomic_store_n(&g_busOwned, false, __ATOMIC_RELEASE);
+
+        // A transaction may have been queued after the queues were checked, by a context which found the bus owned.
+        bool queuesEmpty = true;
+        unsigned int priority;
+        for (priority = 0; priority < I2C_NUMBER_OF_PRIORITIES; priority++)
+        {
+            queuesEmpty = queuesEmpty && I2cTransactionQueue_IsEmpty(&g_transactionQueues[priority]);
+        }
+
+        if (queuesEmpty || !I2cTryAcquireBus())
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * \brief Continue after the current chunk of the active transaction has been transferred.
+ * Must only be called by the bus owner.
+ *
+ * \param	pTransaction	The active transaction
+ */
+void I2cCompleteChunk(I2cTransaction_t* pTransaction)
+{
+    g_pActiveTransaction = NULL;
+    pTransaction->bytesTransferred += pTransaction->chunkLength;
+    I2cBusSpeed_ReportResult(pTransaction->deviceAddress, EN_SUCCESS);
+
+    if (pTransaction->bytesTransferred < pTransaction->numberOfBytes)
+    {
+        // Suspend the transaction, so that a higher priority transaction can take the bus before the next chunk.
+        g_pSuspendedTransactions[pTransaction->priority] = pTransaction;
+    }
+    else
+    {
+        I2cCompleteTransaction(pTransaction, EN_SUCCESS, true);
+    }
+
+    I2cStartNextTransaction();
+}
+
 /**
  * This Status handler is called asynchronously from an interrupt
  * context and indicates the events that have occurred.
@@ -72,45 +505,34 @@ volatile uint32_t g_transmissionErrorCount;
  */
 void StatusHandler(void* InstancePtr, int event)
 {
-    if (event & XIICPS_EVENT_COMPLETE_RECV)
+    I2cTransaction_t* pTransaction = g_pActiveTransaction;
+
+    if ((event & XIICPS_EVENT_SLAVE_RDY) == 0)
     {
-        g_i2cReceiveInProgress = false;
+
+        g_transmissionErrorCount++;
 
 #ifdef _DEBUG
-        EN_PRINTF("Event = receive complete\n\r");
+        EN_PRINTF("Data received with error\n\r");
 #endif
     }
 
-    if (event & XIICPS_EVENT_COMPLETE_SEND)
-    {
-        g_i2cTransmissionInProgress = false;
-
 #ifdef _DEBUG
-        EN_PRINTF("Event = send complete\n\r");
-#endif
+    if (event & XIICPS_EVENT_COMPLETE_RECV)
+    {
+        EN_PRINTF("Event = receive complete\n\r");
     }
 
-
-    if ((event & XIICPS_EVENT_SLAVE_RDY) == 0)
+    if (event & XIICPS_EVENT_COMPLETE_SEND)
     {
-
-        g_transmissionErrorCount++;
-
-#ifdef _DEBUG
-        EN_PRINTF("Data received with error\n\r");
-#endif
+        EN_PRINTF("Event = send complete\n\r");
     }
 
     if (event & XIICPS_EVENT_NACK)
     {
-        g_i2cSlaveNack = true;
-
-#ifdef _DEBUG
         EN_PRINTF("Event = NACK received\n\r");
-#endif
     }
 
-#ifdef _DEBUG
     if (event & XIICPS_EVENT_TIME_OUT)
     {
         EN_PRINTF("Event = timeout\n\r");
@@ -147,6 +569,59 @@ void StatusHandler(void* InstancePtr, int event)
     }
 
 #endif
+
+    if (pTransaction == NULL)
+    {
+        return;
+    }
+
+    if (event & (XIICPS_EVENT_NACK | XIICPS_EVENT_ARB_LOST | XIICPS_EVENT_ERROR))
+    {
+        EN_RESULT result = EN_ERROR_I2C_SLAVE_NACK;
+        if ((event & XIICPS_EVENT_NACK) == 0)
+        {
+            result = (pTransaction->direction == EI2cDirection_Read) ? EN_ERROR_I2C_READ_FAILED
+                                                                     : EN_ERROR_I2C_WRITE_FAILED;
+        }
+
+#ifdef _DEBUG
+        EN_PRINTF("I2C transfer to device 0x%x failed (status code = 0x%x)\n\r", pTransaction->deviceAddress, result);
+#endif
+
+        // The bus may be held for a repeated start or for the next write segment.
+        I2cReleaseBus();
+
+        I2cBusSpeed_ReportResult(pTransaction->deviceAddress, result);
+
+        I2cCompleteTransaction(pTransaction, result, true);
+        I2cStartNextTransaction();
+    }
+    else if ((event & XIICPS_EVENT_COMPLETE_SEND) && (pTransaction->phase == EI2cPhase_WriteHeader))
+    {
+        // The header has been sent and the bus is held. The read phase is the last part of the transfer,
+        // so the stop condition must be sent at its end.
+        XIicPs_ClearOptions(&g_XIicPsInstance, XIICPS_REP_START_OPTION);
+
+        pTransaction->phase = EI2cPhase_ReadData;
+        XIicPs_MasterRecv(&g_XIicPsInstance,
+                          &pTransaction->pData[pTransaction->bytesTransferred],
+                          pTransaction->chunkLength,
+                          pTransaction->deviceAddress);
+    }
+    else if ((event & XIICPS_EVENT_COMPLETE_SEND) && (pTransaction->phase == EI2cPhase_WriteData) &&
+             (I2cFillWriteFifo(pTransaction) > 0))
+    {
+        // More data has been written into the FIFO. Once the last byte is queued, release the bus so that the
+        // stop condition is sent when the FIFO is empty.
+        if (!I2cSkipWrittenSegments(pTransaction))
+        {
+            I2cReleaseBus();
+        }
+    }
+    else if (event & (XIICPS_EVENT_COMPLETE_SEND | XIICPS_EVENT_COMPLETE_RECV))
+    {
+        I2cCompleteChunk(pTransaction);
+    }
 }
 
 EN_RESULT InitialiseI2cInterface()
@@ -164,209 +639,332 @@ EN_RESULT InitialiseI2cInterface()
 
     RETURN_IF_XILINX_CALL_FAILED(XIicPs_SelfTest(&g_XIicPsInstance), EN_ERROR_FAILED_TO_INITIALISE_I2C_CONTROLLER);
 
+    g_pActiveTransaction = NULL;
+    g_busOwned = false;
+
+    unsigned int priority;
+    for (priority = 0; priority < I2C_NUMBER_OF_PRIORITIES; priority++)
+    {
+        I2cTransactionQueue_Initialise(&g_transactionQueues[priority]);
+        g_pSuspendedTransactions[priority] = NULL;
+    }
+
     EN_RETURN_IF_FAILED(SetupInterruptSystem());
 
     // Set the status handler.
     XIicPs_SetStatusHandler(&g_XIicPsInstance, (void*)&g_XIicPsInstance, (XIicPs_IntrHandler)StatusHandler);
 
-    // Set I2C clock to 100kHz
-    XIicPs_SetSClk(&g_XIicPsInstance, I2C_CLOCK_SPEED_HZ);
+    // Start at 100kHz; the SCL frequency is changed before each transaction, to the one of the addressed device.
+    I2cBusSpeed_Initialise(I2C_CLOCK_SPEED_HZ, I2C_MAX_CLOCK_SPEED_HZ);
+    RETURN_IF_XILINX_CALL_FAILED(XIicPs_SetSClk(&g_XIicPsInstance, I2C_CLOCK_SPEED_HZ),
+                                 EN_ERROR_FAILED_TO_INITIALISE_I2C_CONTROLLER);
+    g_i2cClockSpeedHz = I2C_CLOCK_SPEED_HZ;
 
     return EN_SUCCESS;
 }
 
 
-EN_RESULT I2cAbort()
+void I2cInitialiseTransaction(I2cTransaction_t* pTransaction,
+                              uint8_t deviceAddress,
+                              EI2cDirection_t direction,
+                              uint16_t subAddress,
+                              EI2cSubAddressMode_t subAddressMode,
+                              uint8_t* pData,
+                              uint32_t numberOfBytes)
 {
-    XIicPs_Abort(&g_XIicPsInstance);
-    return EN_SUCCESS;
+    pTransaction->deviceAddress = deviceAddress;
+    pTransaction->direction = direction;
+    pTransaction->subAddress = subAddress;
+    pTransaction->subAddressMode = subAddressMode;
+    pTransaction->pData = pData;
+    pTransaction->numberOfBytes = numberOfBytes;
+    pTransaction->pSegments = NULL;
+    pTransaction->numberOfSegments = 0;
+    pTransaction->priority = EI2cPriority_Normal;
+    pTransaction->flags = I2C_TRANSACTION_FLAG_NONE;
+    pTransaction->callback = NULL;
+    pTransaction->pCallbackContext = NULL;
+    pTransaction->status = EI2cTransactionStatus_Idle;
+    pTransaction->result = EN_SUCCESS;
 }
 
-EN_RESULT I2cWrite_NoSubAddress(uint8_t deviceAddress, const uint8_t* pWriteBuffer, uint32_t numberOfBytesToWrite)
+/**
+ * \brief Submit a transaction, with the given bytes written before the data.
+ *
+ * For a read, the header is written first and the data is read after a repeated start condition.
+ *
+ * \param	pTransaction	Transaction descriptor
+ * \param	pHeader			Header bytes
+ * \param	headerLength	Number of header bytes; may be zero
+ * \returns					Result code
+ */
+EN_RESULT I2cSubmitWithHeader(I2cTransaction_t* pTransaction, const uint8_t* pHeader, uint32_t headerLength)
 {
-    if (pWriteBuffer == NULL)
+    if ((pTransaction == NULL) || ((headerLength != 0) && (pHeader == NULL)))
     {
         return EN_ERROR_NULL_POINTER;
     }
 
-    if (numberOfBytesToWrite == 0)
+    if ((pTransaction->status == EI2cTransactionStatus_Queued) ||
+        (pTransaction->status == EI2cTransactionStatus_InProgress) ||
+        (pTransaction->priority >= I2C_NUMBER_OF_PRIORITIES))
     {
         return EN_ERROR_INVALID_ARGUMENT;
     }
 
-#ifdef _DEBUG
-    xil_printf("I2C: Writing %d bytes to device address 0x%x\n\r", numberOfBytesToWrite, deviceAddress);
-#endif
-
-    // Wait for bus to become idle
-    while (XIicPs_BusIsBusy(&g_XIicPsInstance))
+    if (pTransaction->pSegments != NULL)
     {
-        /* NOP */
-    }
-
-    // Set the transmission flags.
-    g_transmissionErrorCount = 0;
-    g_i2cTransmissionInProgress = true;
-    g_i2cSlaveNack = false;
-
-    XIicPs_MasterSend(&g_XIicPsInstance, (uint8_t*)pWriteBuffer, numberOfBytesToWrite, deviceAddress);
+        // Scatter-gather write: the data is taken from the segments.
+        if (pTransaction->direction != EI2cDirection_Write)
+        {
+            return EN_ERROR_INVALID_ARGUMENT;
+        }
 
-    // Wait till data is transmitted.
-    unsigned int timeout = 0;
-    while ((g_i2cTransmissionInProgress && !g_i2cSlaveNack) || (XIicPs_BusIsBusy(&g_XIicPsInstance)))
+        pTransaction->numberOfBytes = 0;
 
-    {
-        SleepMilliseconds(1);
-        timeout++;
-        if (timeout > 100)
+        uint32_t segmentIndex;
+        for (segmentIndex = 0; segmentIndex < pTransaction->numberOfSegments; segmentIndex++)
         {
-#ifdef _DEBUG
-            xil_printf(
-                "Error: I2C timeout when writing %d bytes to device 0x%x\n\r", numberOfBytesToWrite, deviceAddress);
-#endif
+            if ((pTransaction->pSegments[segmentIndex].pData == NULL) &&
+                (pTransaction->pSegments[segmentIndex].length != 0))
+            {
+                return EN_ERROR_NULL_POINTER;
+            }
 
-            return EN_ERROR_I2C_WRITE_TIMEOUT;
+            pTransaction->numberOfBytes += pTransaction->pSegments[segmentIndex].length;
         }
     }
+    else if (pTransaction->pData == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
 
-    if (g_i2cSlaveNack)
+    // A write may consist of the header only (e.g. the wake token of the Atmel ATSHA204A), but a read needs data.
+    if ((pTransaction->numberOfBytes == 0) &&
+        ((pTransaction->direction == EI2cDirection_Read) || (headerLength == 0)))
     {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    pTransaction->pHeader = pHeader;
+    pTransaction->headerLength = headerLength;
+
 #ifdef _DEBUG
-        xil_printf("NACK received from I2C slave at address 0x%x\n\r", deviceAddress);
+    xil_printf("I2C: Submitting %s of %d bytes for device address 0x%x\n\r",
+               (pTransaction->direction == EI2cDirection_Read) ? "read" : "write",
+               pTransaction->numberOfBytes,
+               pTransaction->deviceAddress);
 #endif
 
-        return EN_ERROR_I2C_SLAVE_NACK;
+    EN_RETURN_IF_FAILED(Completion_Initialise(&pTransaction->completion));
+
+    pTransaction->bytesTransferred = 0;
+    pTransaction->result = EN_SUCCESS;
+    pTransaction->status = EI2cTransactionStatus_Queued;
+
+    if (!I2cTransactionQueue_Push(&g_transactionQueues[pTransaction->priority], pTransaction))
+    {
+        pTransaction->status = EI2cTransactionStatus_Idle;
+        return EN_ERROR_I2C_QUEUE_FULL;
+    }
+
+    // If the bus is free, start the transaction now; otherwise, the bus owner starts it when the bus is free.
+    if (I2cTryAcquireBus())
+    {
+        I2cStartNextTransaction();
     }
 
     return EN_SUCCESS;
 }
 
-EN_RESULT I2cWrite_ByteSubAddress(uint8_t deviceAddress,
-                                  uint8_t subAddress,
-                                  const uint8_t* pWriteBuffer,
-                                  uint32_t numberOfBytesToWrite)
+EN_RESULT I2cSubmit(I2cTransaction_t* pTransaction)
 {
-    // Create a new array, to contain both the subaddress and the write data.
-    uint8_t transferSizeBytes = numberOfBytesToWrite + 1;
-    uint8_t transferData[transferSizeBytes];
-    transferData[0] = subAddress;
+    if (pTransaction == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
 
-    unsigned int dataByteIndex = 0;
-    for (dataByteIndex = 0; dataByteIndex < numberOfBytesToWrite; dataByteIndex++)
+    uint32_t headerLength = 0;
+
+    switch (pTransaction->subAddressMode)
+    {
+    case EI2cSubAddressMode_None:
     {
-        transferData[dataByteIndex + 1] = pWriteBuffer[dataByteIndex];
+        break;
+    }
+    case EI2cSubAddressMode_OneByte:
+    {
+        pTransaction->subAddressBytes[0] = (uint8_t)pTransaction->subAddress;
+        headerLength = 1;
+        break;
+    }
+    case EI2cSubAddressMode_TwoBytes:
+    {
+        // The subaddress is sent most significant byte first.
+        pTransaction->subAddressBytes[0] = GetUpperByte(pTransaction->subAddress);
+        pTransaction->subAddressBytes[1] = GetLowerByte(pTransaction->subAddress);
+        headerLength = 2;
+        break;
+    }
+    default:
+        return EN_ERROR_INVALID_ARGUMENT;
     }
 
-    EN_RETURN_IF_FAILED(I2cWrite_NoSubAddress(deviceAddress, (uint8_t*)&transferData, transferSizeBytes));
+    EN_RETURN_IF_FAILED(I2cSubmitWithHeader(pTransaction, pTransaction->subAddressBytes, headerLength));
 
     return EN_SUCCESS;
 }
 
-EN_RESULT I2cWrite_TwoByteSubAddress(uint8_t deviceAddress,
-                                     uint16_t subAddress,
-                                     const uint8_t* pWriteBuffer,
-                                     uint32_t numberOfBytesToWrite)
+EN_RESULT I2cSubmitBatch(I2cTransaction_t* const* ppTransactions, uint32_t numberOfTransactions)
 {
-    // Create a new array, to contain both the subaddress and the write data.
-    uint8_t transferSizeBytes = numberOfBytesToWrite + 2;
-    uint8_t transferData[transferSizeBytes];
-    transferData[0] = GetUpperByte(subAddress);
-    transferData[1] = GetLowerByte(subAddress);
-
-    unsigned int dataByteIndex = 0;
-    for (dataByteIndex = 0; dataByteIndex < numberOfBytesToWrite; dataByteIndex++)
+    if (ppTransactions == NULL)
     {
-        transferData[dataByteIndex + 2] = pWriteBuffer[dataByteIndex];
+        return EN_ERROR_NULL_POINTER;
     }
 
-    EN_RETURN_IF_FAILED(I2cWrite_NoSubAddress(deviceAddress, (uint8_t*)&transferData, transferSizeBytes));
+    // The queues keep the submission order within each priority.
+    uint32_t transactionIndex;
+    for (transactionIndex = 0; transactionIndex < numberOfTransactions; transactionIndex++)
+    {
+        EN_RETURN_IF_FAILED(I2cSubmit(ppTransactions[transactionIndex]));
+    }
 
     return EN_SUCCESS;
 }
 
-EN_RESULT I2cRead_NoSubAddress(uint8_t deviceAddress, uint8_t* pReadBuffer, uint32_t numberOfBytesToRead)
+bool I2cIsTransactionComplete(const I2cTransaction_t* pTransaction)
+{
+    return (pTransaction->status == EI2cTransactionStatus_Complete);
+}
+
+void I2cCancel(I2cTransaction_t* pTransaction, EN_RESULT result)
 {
+    // With interrupts disabled, neither the status handler nor a submitting interrupt can run.
+    uint32_t interruptState = DisableInterrupts();
 
-    if (pReadBuffer == NULL)
+    if (pTransaction == g_pActiveTransaction)
     {
-        return EN_ERROR_NULL_POINTER;
-    }
+        I2cAbort();
+        XIicPs_ClearOptions(&g_XIicPsInstance, XIICPS_REP_START_OPTION);
 
-    if (numberOfBytesToRead == 0)
+        // No interrupt will arrive for the aborted transfer, so the bus ownership passes to this context.
+        I2cCompleteTransaction(pTransaction, result, false);
+        I2cStartNextTransaction();
+    }
+    else if (pTransaction == g_pSuspendedTransactions[pTransaction->priority])
     {
-        return EN_ERROR_INVALID_ARGUMENT;
+        g_pSuspendedTransactions[pTransaction->priority] = NULL;
+        I2cCompleteTransaction(pTransaction, result, false);
     }
-
-#ifdef _DEBUG
-    xil_printf("I2C: Reading %d bytes from device address 0x%x\n\r", numberOfBytesToRead, deviceAddress);
-#endif
-
-    // Wait for bus to become idle
-    while (XIicPs_BusIsBusy(&g_XIicPsInstance))
+    else if (pTransaction->status == EI2cTransactionStatus_Queued)
     {
-        /* NOP */
+        I2cTransactionQueue_Remove(&g_transactionQueues[pTransaction->priority], pTransaction);
+        I2cCompleteTransaction(pTransaction, result, false);
     }
 
-    // Set the transmission flags.
-    g_transmissionErrorCount = 0;
-    g_i2cReceiveInProgress = true;
-    g_i2cSlaveNack = false;
-
-    // Receive the data.
-    XIicPs_MasterRecv(&g_XIicPsInstance, pReadBuffer, numberOfBytesToRead, deviceAddress);
+    RestoreInterrupts(interruptState);
+}
 
-    // Wait till all the data is received.
-    unsigned int timeout = 0;
-    while (g_i2cReceiveInProgress && !g_i2cSlaveNack)
+EN_RESULT I2cWaitForTransaction(I2cTransaction_t* pTransaction, uint32_t timeoutMicroseconds)
+{
+    if (pTransaction == NULL)
     {
-        SleepMilliseconds(1);
-        timeout++;
-        if (timeout > 1000)
-        {
-#ifdef _DEBUG
-            xil_printf(
-                "Error: I2C timeout when receiving %d bytes from device 0x%x\n\r", numberOfBytesToRead, deviceAddress);
-#endif
-            return EN_ERROR_I2C_READ_TIMEOUT;
-        }
+        return EN_ERROR_NULL_POINTER;
     }
 
-    if (g_i2cSlaveNack)
+    if (EN_FAILED(Completion_Wait(&pTransaction->completion, timeoutMicroseconds)))
     {
+        EN_RESULT timeoutResult = (pTransaction->direction == EI2cDirection_Read) ? EN_ERROR_I2C_READ_TIMEOUT
+                                                                                  : EN_ERROR_I2C_WRITE_TIMEOUT;
+
 #ifdef _DEBUG
-        xil_printf("NACK received from I2C slave at address 0x%x\n\r", deviceAddress);
+        xil_printf("Error: I2C timeout when transferring %d bytes with device 0x%x\n\r",
+                   pTransaction->numberOfBytes,
+                   pTransaction->deviceAddress);
 #endif
 
-        return EN_ERROR_I2C_SLAVE_NACK;
+        // The transaction may have completed just after the timeout; cancelling has no effect in this case.
+        I2cCancel(pTransaction, timeoutResult);
     }
 
+    return pTransaction->result;
+}
+
+/**
+ * \brief Submit a transaction and wait for it to complete.
+ *
+ * \param	pTransaction			Transaction descriptor
+ * \param	pHeader					Header bytes, written before the data
+ * \param	headerLength			Number of header bytes; may be zero
+ * \param	timeoutMicroseconds		Maximum time to wait, in microseconds
+ * \returns							Result code
+ */
+EN_RESULT I2cTransfer(I2cTransaction_t* pTransaction,
+                      const uint8_t* pHeader,
+                      uint32_t headerLength,
+                      uint32_t timeoutMicroseconds)
+{
+    EN_RETURN_IF_FAILED(I2cSubmitWithHeader(pTransaction, pHeader, headerLength));
+
+    EN_RETURN_IF_FAILED(I2cWaitForTransaction(pTransaction, timeoutMicroseconds));
+
     return EN_SUCCESS;
 }
 
-EN_RESULT I2cRead_ByteSubAddress(uint8_t deviceAddress,
-                                 uint8_t subAddress,
-                                 uint8_t* pReadBuffer,
-                                 uint32_t numberOfBytesToRead)
+EN_RESULT I2cWriteRead(uint8_t deviceAddress,
+                       const uint8_t* pWriteBuffer,
+                       uint32_t numberOfBytesToWrite,
+                       uint8_t* pReadBuffer,
+                       uint32_t numberOfBytesToRead)
 {
-    // Write the subaddress, with start condition asserted but stop condition not.
-    EN_RETURN_IF_FAILED(I2cWrite_NoSubAddress(deviceAddress, (uint8_t*)&subAddress, 1));
+    if (pWriteBuffer == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    if (numberOfBytesToWrite == 0)
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
 
-    // Perform the read.
-    EN_RETURN_IF_FAILED(I2cRead_NoSubAddress(deviceAddress, pReadBuffer, numberOfBytesToRead));
+    I2cTransaction_t transaction;
+    I2cInitialiseTransaction(&transaction,
+                             deviceAddress,
+                             EI2cDirection_Read,
+                             0,
+                             EI2cSubAddressMode_None,
+                             pReadBuffer,
+                             numberOfBytesToRead);
+
+    // The write data is sent as the header of the read transaction. The header is not a subaddress, so the
+    // transaction cannot be split.
+    transaction.flags = I2C_TRANSACTION_FLAG_NO_SPLIT;
+    EN_RETURN_IF_FAILED(
+        I2cTransfer(&transaction, pWriteBuffer, numberOfBytesToWrite, I2C_READ_TIMEOUT_MICROSECONDS));
 
     return EN_SUCCESS;
 }
 
-EN_RESULT I2cRead_WordSubAddress(uint8_t deviceAddress,
-                                 uint16_t subAddress,
-                                 uint8_t* pReadBuffer,
-                                 uint32_t numberOfBytesToRead)
+EN_RESULT I2cReadWithPriority(uint8_t deviceAddress,
+                              uint16_t subAddress,
+                              EI2cSubAddressMode_t subAddressMode,
+                              uint32_t numberOfBytesToRead,
+                              uint8_t* pReadBuffer,
+                              EI2cPriority_t priority)
 {
-    // Write the subaddress, with start condition asserted but stop condition not.
-    EN_RETURN_IF_FAILED(I2cWrite_NoSubAddress(deviceAddress, (uint8_t*)&subAddress, 2));
+    I2cTransaction_t transaction;
+    I2cInitialiseTransaction(&transaction,
+                             deviceAddress,
+                             EI2cDirection_Read,
+                             subAddress,
+                             subAddressMode,
+                             pReadBuffer,
+                             numberOfBytesToRead);
+    transaction.priority = priority;
+
+    EN_RETURN_IF_FAILED(I2cSubmit(&transaction));
 
-    // Perform the read.
-    EN_RETURN_IF_FAILED(I2cRead_NoSubAddress(deviceAddress, pReadBuffer, numberOfBytesToRead));
+    EN_RETURN_IF_FAILED(I2cWaitForTransaction(&transaction, I2C_READ_TIMEOUT_MICROSECONDS));
 
     return EN_SUCCESS;
 }
@@ -377,28 +975,8 @@ EN_RESULT I2cRead(uint8_t deviceAddress,
                   uint32_t numberOfBytesToRead,
                   uint8_t* pReadBuffer)
 {
-
-    switch (subAddressMode)
-    {
-    case EI2cSubAddressMode_None:
-    {
-        EN_RETURN_IF_FAILED(I2cRead_NoSubAddress(deviceAddress, pReadBuffer, numberOfBytesToRead));
-        break;
-    }
-    case EI2cSubAddressMode_OneByte:
-    {
-        EN_RETURN_IF_FAILED(
-            I2cRead_ByteSubAddress(deviceAddress, (uint8_t)subAddress, pReadBuffer, numberOfBytesToRead));
-        break;
-    }
-    case EI2cSubAddressMode_TwoBytes:
-    {
-        EN_RETURN_IF_FAILED(
-            I2cRead_WordSubAddress(deviceAddress, (uint16_t)subAddress, pReadBuffer, numberOfBytesToRead));
-    }
-    default:
-        break;
-    }
+    EN_RETURN_IF_FAILED(I2cReadWithPriority(
+        deviceAddress, subAddress, subAddressMode, numberOfBytesToRead, pReadBuffer, EI2cPriority_Normal));
 
     return EN_SUCCESS;
 }
@@ -409,28 +987,42 @@ EN_RESULT I2cWrite(uint8_t deviceAddress,
                    const uint8_t* pWriteBuffer,
                    uint32_t numberOfBytesToWrite)
 {
+    I2cTransaction_t transaction;
+    I2cInitialiseTransaction(&transaction,
+                             deviceAddress,
+                             EI2cDirection_Write,
+                             subAddress,
+                             subAddressMode,
+                             (uint8_t*)pWriteBuffer,
+                             numberOfBytesToWrite);
 
-    switch (subAddressMode)
-    {
-    case EI2cSubAddressMode_None:
-    {
-        EN_RETURN_IF_FAILED(I2cWrite_NoSubAddress(deviceAddress, pWriteBuffer, numberOfBytesToWrite));
-        break;
-    }
-    case EI2cSubAddressMode_OneByte:
-    {
-        EN_RETURN_IF_FAILED(
-            I2cWrite_ByteSubAddress(deviceAddress, (uint8_t)subAddress, pWriteBuffer, numberOfBytesToWrite));
-        break;
-    }
-    case EI2cSubAddressMode_TwoBytes:
+    EN_RETURN_IF_FAILED(I2cSubmit(&transaction));
+
+    EN_RETURN_IF_FAILED(I2cWaitForTransaction(&transaction, I2C_WRITE_TIMEOUT_MICROSECONDS));
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT I2cWriteVector(uint8_t deviceAddress,
+                         uint16_t subAddress,
+                         EI2cSubAddressMode_t subAddressMode,
+                         const I2cSegment_t* pSegments,
+                         uint32_t numberOfSegments)
+{
+    if (pSegments == NULL)
     {
-        EN_RETURN_IF_FAILED(I2cWrite_TwoByteSubAddress(deviceAddress, subAddress, pWriteBuffer, numberOfBytesToWrite));
-        break;
-    }
-    default:
-        break;
+        return EN_ERROR_NULL_POINTER;
     }
 
+    I2cTransaction_t transaction;
+    I2cInitialiseTransaction(
+        &transaction, deviceAddress, EI2cDirection_Write, subAddress, subAddressMode, NULL, 0);
+    transaction.pSegments = pSegments;
+    transaction.numberOfSegments = numberOfSegments;
+
+    EN_RETURN_IF_FAILED(I2cSubmit(&transaction));
+
+    EN_RETURN_IF_FAILED(I2cWaitForTransaction(&transaction, I2C_WRITE_TIMEOUT_MICROSECONDS));
+
     return EN_SUCCESS;
 }
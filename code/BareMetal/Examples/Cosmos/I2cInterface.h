@@ -27,6 +27,7 @@
 //-------------------------------------------------------------------------------------------------
 
 #include "StandardIncludes.h"
+#include "Completion.h"
 
 
 //-------------------------------------------------------------------------------------------------
@@ -44,6 +45,159 @@ typedef enum
 } EI2cSubAddressMode_t;
 
 
+/**
+* \brief I2C transfer directions.
+*/
+typedef enum
+{
+    EI2cDirection_Write, ///< Write data to the device
+    EI2cDirection_Read   ///< Read data from the device
+} EI2cDirection_t;
+
+
+/**
+* \brief I2C transaction states.
+*/
+typedef enum
+{
+    EI2cTransactionStatus_Idle,       ///< Not yet submitted
+    EI2cTransactionStatus_Queued,     ///< Submitted, waiting for the bus
+    EI2cTransactionStatus_InProgress, ///< Being transferred
+    EI2cTransactionStatus_Complete    ///< Finished; the result field holds the result code
+} EI2cTransactionStatus_t;
+
+
+/**
+* \brief I2C transaction priorities.
+*
+* Queued transactions are started in priority order. Long transactions are transferred in chunks, and a
+* higher priority transaction may be started between two chunks.
+*/
+typedef enum
+{
+    EI2cPriority_Urgent, ///< Time-critical transfers, e.g. safety-related monitoring
+    EI2cPriority_Normal, ///< Default priority
+    EI2cPriority_Bulk    ///< Large, non time-critical transfers, e.g. register dumps
+} EI2cPriority_t;
+
+/// Number of transaction priorities
+#define I2C_NUMBER_OF_PRIORITIES 3
+
+
+/// No transaction flags
+#define I2C_TRANSACTION_FLAG_NONE 0x00
+
+/// Do not split a long read into chunks; needed for devices which do not auto-increment the subaddress
+#define I2C_TRANSACTION_FLAG_NO_SPLIT 0x01
+
+/// Allow a long write to be split into chunks; the device must accept the chunks as separate writes
+#define I2C_TRANSACTION_FLAG_SPLIT_WRITE 0x02
+
+
+/**
+ * \brief Data segment of a scatter-gather write.
+ */
+typedef struct
+{
+    /// Segment data
+    const uint8_t* pData;
+
+    /// Segment length in bytes; may be zero
+    uint32_t length;
+} I2cSegment_t;
+
+
+struct I2cTransaction_t;
+
+/**
+ * \brief Transaction completion callback.
+ *
+ * The callback is called from interrupt context (on Linux, from the submitting thread), after the
+ * transaction status has been set to EI2cTransactionStatus_Complete. The driver does not access the transaction after calling the
+ * callback, so it may be resubmitted from within the callback.
+ */
+typedef void (*I2cTransactionCallback_t)(struct I2cTransaction_t* pTransaction, void* pContext);
+
+
+/**
+ * \brief I2C transaction descriptor, used with the asynchronous API.
+ *
+ * The caller fills in the request fields and submits the transaction with I2cSubmit(). The descriptor
+ * and the data buffer must remain valid until the transaction is complete.
+ */
+typedef struct I2cTransaction_t
+{
+    /// Device address
+    uint8_t deviceAddress;
+
+    /// Transfer direction
+    EI2cDirection_t direction;
+
+    /// Register subaddress
+    uint16_t subAddress;
+
+    /// Subaddress mode
+    EI2cSubAddressMode_t subAddressMode;
+
+    /// Data buffer; the write data or the buffer to receive read data
+    uint8_t* pData;
+
+    /// Number of bytes to transfer; for scatter-gather writes, this is calculated when submitting
+    uint32_t numberOfBytes;
+
+    /// Data segments of a scatter-gather write, used instead of pData; NULL for other transactions
+    const I2cSegment_t* pSegments;
+
+    /// Number of data segments
+    uint32_t numberOfSegments;
+
+    /// Transaction priority
+    EI2cPriority_t priority;
+
+    /// Transaction flags (I2C_TRANSACTION_FLAG_...)
+    uint32_t flags;
+
+    /// Optional callback, called when the transaction is complete
+    I2cTransactionCallback_t callback;
+
+    /// Context passed to the callback
+    void* pCallbackContext;
+
+    /// Transaction status, set by the driver
+    volatile EI2cTransactionStatus_t status;
+
+    /// Result code, valid once the status is EI2cTransactionStatus_Complete
+    volatile EN_RESULT result;
+
+    /// Internal: bytes written before the data (i.e. the subaddress)
+    const uint8_t* pHeader;
+
+    /// Internal: number of header bytes
+    uint32_t headerLength;
+
+    /// Internal: subaddress, in transmission byte order
+    uint8_t subAddressBytes[2];
+
+    /// Internal: current transfer phase
+    uint8_t phase;
+
+    /// Internal: number of bytes transferred by the previous chunks
+    uint32_t bytesTransferred;
+
+    /// Internal: number of bytes in the current chunk
+    uint32_t chunkLength;
+
+    /// Internal: index of the segment being written (0 is the header)
+    uint32_t segmentIndex;
+
+    /// Internal: number of bytes of the current segment already written
+    uint32_t segmentOffset;
+
+    /// Internal: signalled when the transaction is complete
+    Completion_t completion;
+} I2cTransaction_t;
+
+
 
 
 //-------------------------------------------------------------------------------------------------
@@ -58,9 +212,101 @@ typedef enum
 EN_RESULT InitialiseI2cInterface();
 
 
+/**
+ * \brief Initialise a transaction descriptor for use with I2cSubmit().
+ *
+ * The transaction gets normal priority, no flags and no callback; change these fields after calling
+ * this function if required.
+ *
+ * \param[out]	pTransaction	Transaction descriptor
+ * \param[in]	deviceAddress	The device address
+ * \param[in]	direction		Transfer direction
+ * \param[in]	subAddress		Register subaddress
+ * \param[in]	subAddressMode	Subaddress mode
+ * \param[in]	pData			Write data, or buffer to receive read data
+ * \param[in]	numberOfBytes	The number of bytes to transfer
+ */
+void I2cInitialiseTransaction(I2cTransaction_t* pTransaction,
+                              uint8_t deviceAddress,
+                              EI2cDirection_t direction,
+                              uint16_t subAddress,
+                              EI2cSubAddressMode_t subAddressMode,
+                              uint8_t* pData,
+                              uint32_t numberOfBytes);
+
+
+/**
+ * \brief Submit a transaction for asynchronous processing.
+ *
+ * The transaction is queued and started as soon as the bus is free; this function does not wait for
+ * the transfer. The transaction descriptor serves as the handle: use I2cIsTransactionComplete() or
+ * I2cWaitForTransaction() to check for completion, or set a callback in the descriptor.
+ *
+ * This function may be called from interrupt context (e.g. from a completion callback).
+ *
+ * \param[in]	pTransaction	Transaction descriptor
+ * \returns						Result code
+ */
+EN_RESULT I2cSubmit(I2cTransaction_t* pTransaction);
+
+
+/**
+ * \brief Submit several independent transactions together.
+ *
+ * The transactions are transferred in the given order. On Linux, they are passed to the kernel in as few
+ * I2C_RDWR requests as possible, with repeated start conditions between them; if a request fails, all
+ * its transactions complete with the error. On bare metal, the transactions are queued as with
+ * I2cSubmit().
+ *
+ * If a transaction cannot be submitted, the transactions before it remain submitted and the error is
+ * returned.
+ *
+ * \param[in]	ppTransactions			Transaction descriptors
+ * \param[in]	numberOfTransactions	The number of transactions
+ * \returns								Result code
+ */
+EN_RESULT I2cSubmitBatch(I2cTransaction_t* const* ppTransactions, uint32_t numberOfTransactions);
+
+
+/**
+ * \brief Check whether a submitted transaction is complete, without waiting.
+ *
+ * \param[in]	pTransaction	Transaction descriptor
+ * \returns						True if the transaction is complete
+ */
+bool I2cIsTransactionComplete(const I2cTransaction_t* pTransaction);
+
+
+/**
+ * \brief Wait for a submitted transaction to complete.
+ *
+ * If the transaction does not complete within the timeout, it is cancelled.
+ *
+ * \param[in]	pTransaction			Transaction descriptor
+ * \param[in]	timeoutMicroseconds		Maximum time to wait, in microseconds
+ * \returns								The transaction result code, or a timeout error
+ */
+EN_RESULT I2cWaitForTransaction(I2cTransaction_t* pTransaction, uint32_t timeoutMicroseconds);
+
+
+/**
+ * \brief Cancel a submitted transaction.
+ *
+ * If the transaction is being transferred, the transfer is aborted. The transaction completes with
+ * the given result code; its callback is not called.
+ *
+ * \param[in]	pTransaction	Transaction descriptor
+ * \param[in]	result			Result code to complete the transaction with
+ */
+void I2cCancel(I2cTransaction_t* pTransaction, EN_RESULT result);
+
+
 /**
  * \brief Perform a read from the I2C bus.
  *
+ * If a subaddress is used, it is written and the data is read in a single combined transfer, with a
+ * repeated start condition between the write and the read phase.
+ *
  * \param[in]	deviceAddress			The device address
  * \param[in]	subAddress				Register subaddress
  * \param[in]	subAddressMode			Subaddress mode
@@ -74,6 +320,45 @@ EN_RESULT I2cRead(uint8_t deviceAddress,
                   uint32_t numberOfBytesToRead,
                   uint8_t* pReadBuffer);
 
+/**
+ * \brief Perform a read from the I2C bus, with the given transaction priority.
+ *
+ * As I2cRead(), which uses normal priority.
+ *
+ * \param[in]	deviceAddress			The device address
+ * \param[in]	subAddress				Register subaddress
+ * \param[in]	subAddressMode			Subaddress mode
+ * \param[in]	numberOfBytesToRead		The number of bytes to read
+ * \param[out]	pReadBuffer				Buffer to receive read data
+ * \param[in]	priority				Transaction priority
+ * \returns								Result code
+ */
+EN_RESULT I2cReadWithPriority(uint8_t deviceAddress,
+                              uint16_t subAddress,
+                              EI2cSubAddressMode_t subAddressMode,
+                              uint32_t numberOfBytesToRead,
+                              uint8_t* pReadBuffer,
+                              EI2cPriority_t priority);
+
+/**
+ * \brief Perform a combined write/read transfer on the I2C bus.
+ *
+ * The bus is not released between the write and the read phase: the read is issued with a repeated
+ * start condition, and the stop condition is only sent at the end of the read.
+ *
+ * \param[in]	deviceAddress			The device address
+ * \param[in]	pWriteBuffer			Buffer containing write data
+ * \param[in]	numberOfBytesToWrite	The number of bytes to write
+ * \param[out]	pReadBuffer				Buffer to receive read data
+ * \param[in]	numberOfBytesToRead		The number of bytes to read
+ * \returns								Result code
+ */
+EN_RESULT I2cWriteRead(uint8_t deviceAddress,
+                       const uint8_t* pWriteBuffer,
+                       uint32_t numberOfBytesToWrite,
+                       uint8_t* pReadBuffer,
+                       uint32_t numberOfBytesToRead);
+
 /**
  * \brief Perform a write to the I2C bus.
  *
@@ -89,3 +374,22 @@ EN_RESULT I2cWrite(uint8_t deviceAddress,
                    EI2cSubAddressMode_t subAddressMode,
                    const uint8_t* pWriteBuffer,
                    uint32_t numberOfBytesToWrite);
+
+/**
+ * \brief Perform a scatter-gather write to the I2C bus.
+ *
+ * The subaddress and the data of all segments are sent in a single transfer. The segments are written
+ * directly into the controller FIFO, so the data is not copied and its length is not limited.
+ *
+ * \param	deviceAddress			Device address
+ * \param	subAddress				Register subaddress
+ * \param	subAddressMode			Subaddress mode
+ * \param	pSegments				Data segments
+ * \param	numberOfSegments		The number of data segments
+ * \returns							Result code
+ */
+EN_RESULT I2cWriteVector(uint8_t deviceAddress,
+                         uint16_t subAddress,
+                         EI2cSubAddressMode_t subAddressMode,
+                         const I2cSegment_t* pSegments,
+                         uint32_t numberOfSegments);
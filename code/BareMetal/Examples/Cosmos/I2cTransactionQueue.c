@@ -0,0 +1,155 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "I2cTransactionQueue.h"
+
+//-------------------------------------------------------------------------------------------------
+// Definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+#define I2C_TRANSACTION_QUEUE_INDEX_MASK (I2C_TRANSACTION_QUEUE_LENGTH - 1)
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+void I2cTransactionQueue_Initialise(I2cTransactionQueue_t* pQueue)
+{
+    uint32_t entryIndex;
+    for (entryIndex = 0; entryIndex < I2C_TRANSACTION_QUEUE_LENGTH; entryIndex++)
+    {
+        pQueue->entries[entryIndex].sequence = entryIndex;
+        pQueue->entries[entryIndex].pTransaction = NULL;
+    }
+
+    pQueue->enqueuePosition = 0;
+    pQueue->dequeuePosition = 0;
+}
+
+bool I2cTransactionQueue_Push(I2cTransactionQueue_t* pQueue, I2cTransaction_t* pTransaction)
+{
+    I2cTransactionQueueEntry_t* pEntry;
+    uint32_t position = __atomic_load_n(&pQueue->enqueuePosition, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        pEntry = &pQueue->entries[position & I2C_TRANSACTION_QUEUE_INDEX_MASK];
+        uint32_t sequence = __atomic_load_n(&pEntry->sequence, __ATOMIC_ACQUIRE);
+        int32_t difference = (int32_t)(sequence - position);
+
+        if (difference == 0)
+        {
+            // The entry is free; claim it by advancing the enqueue position.
+            if (__atomic_compare_exchange_n(
+                    &pQueue->enqueuePosition, &position, position + 1, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The entry still holds a transaction from the previous lap: the queue is full.
+            return false;
+        }
+        else
+        {
+            // Another producer has claimed the entry; retry at the current position.
+            position = __atomic_load_n(&pQueue->enqueuePosition, __ATOMIC_RELAXED);
+        }
+    }
+
+    pEntry->pTransaction = pTransaction;
+
+    // Publish the entry to the consumers.
+    __atomic_store_n(&pEntry->sequence, position + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+bool I2cTransactionQueue_Pop(I2cTransactionQueue_t* pQueue, I2cTransaction_t** ppTransaction)
+{
+    I2cTransactionQueueEntry_t* pEntry;
+    uint32_t position = __atomic_load_n(&pQueue->dequeuePosition, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        pEntry = &pQueue->entries[position & I2C_TRANSACTION_QUEUE_INDEX_MASK];
+        uint32_t sequence = __atomic_load_n(&pEntry->sequence, __ATOMIC_ACQUIRE);
+        int32_t difference = (int32_t)(sequence - (position + 1));
+
+        if (difference == 0)
+        {
+            // The entry holds a transaction; claim it by advancing the dequeue position.
+            if (__atomic_compare_exchange_n(
+                    &pQueue->dequeuePosition, &position, position + 1, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The entry has not been published yet: the queue is empty.
+            return false;
+        }
+        else
+        {
+            // Another consumer has claimed the entry; retry at the current position.
+            position = __atomic_load_n(&pQueue->dequeuePosition, __ATOMIC_RELAXED);
+        }
+    }
+
+    *ppTransaction = pEntry->pTransaction;
+
+    // Free the entry for the next lap of the producers.
+    __atomic_store_n(&pEntry->sequence, position + I2C_TRANSACTION_QUEUE_LENGTH, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+bool I2cTransactionQueue_IsEmpty(I2cTransactionQueue_t* pQueue)
+{
+    uint32_t position = __atomic_load_n(&pQueue->dequeuePosition, __ATOMIC_RELAXED);
+    I2cTransactionQueueEntry_t* pEntry = &pQueue->entries[position & I2C_TRANSACTION_QUEUE_INDEX_MASK];
+    uint32_t sequence = __atomic_load_n(&pEntry->sequence, __ATOMIC_ACQUIRE);
+
+    return ((int32_t)(sequence - (position + 1)) < 0);
+}
+
+bool I2cTransactionQueue_Remove(I2cTransactionQueue_t* pQueue, I2cTransaction_t* pTransaction)
+{
+    uint32_t position;
+    for (position = pQueue->dequeuePosition; position != pQueue->enqueuePosition; position++)
+    {
+        I2cTransactionQueueEntry_t* pEntry = &pQueue->entries[position & I2C_TRANSACTION_QUEUE_INDEX_MASK];
+        if (pEntry->pTransaction == pTransaction)
+        {
+            pEntry->pTransaction = NULL;
+            return true;
+        }
+    }
+
+    return false;
+}
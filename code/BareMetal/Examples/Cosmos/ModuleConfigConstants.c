@@ -26,8 +26,6 @@
 // Cosmos XZQ10
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == COSMOS_XZQ10
-
 char COSMOS_XZQ10_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Cosmos XZQ10";
 ModuleConfigProperty_t COSMOS_XZQ10_CONFIG_PROPERTIES[COSMOS_XZQ10_PROPERTY_COUNT] = {
 { "SoC type\0", 0x08, 4, 4, 7, 0, 2, 0, 3, (ModulePropertyValueKey_t*)&COSMOS_XZQ10_SOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -50,16 +48,12 @@ ModuleConfigProperty_t COSMOS_XZQ10_CONFIG_PROPERTIES[COSMOS_XZQ10_PROPERTY_COUN
 { "FMC1 connector equipped\0", 0x0E, 1, 2, 2, 0, 1, 0, 2, (ModulePropertyValueKey_t*)&COSMOS_XZQ10_FMC1_CONNECTOR_EQUIPPED_VALUE_KEY, 0, 0 }, 
 { "MGT multiplexers equipped\0", 0x0E, 1, 1, 1, 0, 1, 0, 2, (ModulePropertyValueKey_t*)&COSMOS_XZQ10_MGT_MULTIPLEXERS_EQUIPPED_VALUE_KEY, 0, 0 }, 
 { "System monitor equipped\0", 0x0E, 1, 0, 0, 0, 1, 0, 2, (ModulePropertyValueKey_t*)&COSMOS_XZQ10_SYSTEM_MONITOR_EQUIPPED_VALUE_KEY, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&COSMOS_XZQ10_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mars AX3
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_AX3
-
 char MARS_AX3_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mars AX3";
 ModuleConfigProperty_t MARS_AX3_CONFIG_PROPERTIES[MARS_AX3_PROPERTY_COUNT] = {
 { "FPGA type\0", 0x08, 4, 4, 7, 1, 4, 0, 4, (ModulePropertyValueKey_t*)&MARS_AX3_FPGA_TYPE_VALUE_KEY, 0, 0 }, 
@@ -71,16 +65,12 @@ ModuleConfigProperty_t MARS_AX3_CONFIG_PROPERTIES[MARS_AX3_PROPERTY_COUNT] = {
 { "Real-time clock equipped\0", 0x09, 1, 2, 2, 0, 1, 0, 2, (ModulePropertyValueKey_t*)&MARS_AX3_REAL_TIME_CLOCK_EQUIPPED_VALUE_KEY, 0, 0 }, 
 { "DDR3 RAM size (MB)\0", 0x0B, 4, 4, 7, 0, 7, 8, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MARS_AX3_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mars MX1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_MX1
-
 char MARS_MX1_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mars MX1";
 ModuleConfigProperty_t MARS_MX1_CONFIG_PROPERTIES[MARS_MX1_PROPERTY_COUNT] = {
 { "FPGA type\0", 0x08, 4, 4, 7, 0, 3, 0, 4, (ModulePropertyValueKey_t*)&MARS_MX1_FPGA_TYPE_VALUE_KEY, 0, 0 }, 
@@ -92,16 +82,12 @@ ModuleConfigProperty_t MARS_MX1_CONFIG_PROPERTIES[MARS_MX1_PROPERTY_COUNT] = {
 { "Real-time clock equipped\0", 0x09, 1, 2, 2, 0, 1, 0, 2, (ModulePropertyValueKey_t*)&MARS_MX1_REAL_TIME_CLOCK_EQUIPPED_VALUE_KEY, 0, 0 }, 
 { "DDR2 RAM size (MB)\0", 0x0B, 4, 4, 7, 0, 5, 8, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 5, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MARS_MX1_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mars MX2
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_MX2
-
 char MARS_MX2_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mars MX2";
 ModuleConfigProperty_t MARS_MX2_CONFIG_PROPERTIES[MARS_MX2_PROPERTY_COUNT] = {
 { "FPGA type\0", 0x08, 4, 4, 7, 0, 1, 0, 2, (ModulePropertyValueKey_t*)&MARS_MX2_FPGA_TYPE_VALUE_KEY, 0, 0 }, 
@@ -113,16 +99,12 @@ ModuleConfigProperty_t MARS_MX2_CONFIG_PROPERTIES[MARS_MX2_PROPERTY_COUNT] = {
 { "Real-time clock equipped\0", 0x09, 1, 2, 2, 0, 1, 0, 2, (ModulePropertyValueKey_t*)&MARS_MX2_REAL_TIME_CLOCK_EQUIPPED_VALUE_KEY, 0, 0 }, 
 { "DDR2 RAM size (MB)\0", 0x0B, 4, 4, 7, 0, 6, 8, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 5, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MARS_MX2_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mars ZX2
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_ZX2
-
 char MARS_ZX2_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mars ZX2";
 ModuleConfigProperty_t MARS_ZX2_CONFIG_PROPERTIES[MARS_ZX2_PROPERTY_COUNT] = {
 { "SoC type\0", 0x08, 4, 4, 7, 0, 1, 0, 2, (ModulePropertyValueKey_t*)&MARS_ZX2_SOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -135,16 +117,12 @@ ModuleConfigProperty_t MARS_ZX2_CONFIG_PROPERTIES[MARS_ZX2_PROPERTY_COUNT] = {
 { "USB 2.0 port count\0", 0x0A, 2, 0, 1, 0, 1, 0, 0, NULL, 0, 0 }, 
 { "DDR3 RAM size (MB)\0", 0x0B, 4, 4, 7, 0, 8, 8, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MARS_ZX2_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mars ZX3
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_ZX3
-
 char MARS_ZX3_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mars ZX3";
 ModuleConfigProperty_t MARS_ZX3_CONFIG_PROPERTIES[MARS_ZX3_PROPERTY_COUNT] = {
 { "SoC type\0", 0x08, 4, 4, 7, 0, 0, 0, 1, (ModulePropertyValueKey_t*)&MARS_ZX3_SOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -158,16 +136,12 @@ ModuleConfigProperty_t MARS_ZX3_CONFIG_PROPERTIES[MARS_ZX3_PROPERTY_COUNT] = {
 { "DDR3 RAM size (MB)\0", 0x0B, 4, 4, 7, 0, 8, 8, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 }, 
 { "NAND flash size (MB)\0", 0x0C, 4, 0, 3, 0, 10, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MARS_ZX3_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury AA1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_AA1
-
 char MERCURY_AA1_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury+ AA1";
 ModuleConfigProperty_t MERCURY_AA1_CONFIG_PROPERTIES[MERCURY_AA1_PROPERTY_COUNT] = {
 { "SoC type\0", 0x08, 4, 4, 7, 0, 1, 0, 2, (ModulePropertyValueKey_t*)&MERCURY_AA1_SOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -182,16 +156,12 @@ ModuleConfigProperty_t MERCURY_AA1_CONFIG_PROPERTIES[MERCURY_AA1_PROPERTY_COUNT]
 { "DDR4 ECC RAM size (GB)\0", 0x0B, 4, 4, 7, 0, 3, 1, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 }, 
 { "eMMC flash size (GB)\0", 0x0C, 4, 4, 7, 0, 5, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_AA1_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury CA1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_CA1
-
 char MERCURY_CA1_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury CA1";
 ModuleConfigProperty_t MERCURY_CA1_CONFIG_PROPERTIES[MERCURY_CA1_PROPERTY_COUNT] = {
 { "FPGA type\0", 0x08, 4, 4, 7, 0, 4, 0, 5, (ModulePropertyValueKey_t*)&MERCURY_CA1_FPGA_TYPE_VALUE_KEY, 0, 0 }, 
@@ -204,16 +174,12 @@ ModuleConfigProperty_t MERCURY_CA1_CONFIG_PROPERTIES[MERCURY_CA1_PROPERTY_COUNT]
 { "USB 2.0 device port count\0", 0x0A, 2, 0, 1, 0, 1, 0, 0, NULL, 0, 0 }, 
 { "DDR2 RAM size (MB)\0", 0x0B, 4, 4, 7, 0, 6, 8, 0, NULL, 0, 0 }, 
 { "SPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 5, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_CA1_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury KX1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_KX1
-
 char MERCURY_KX1_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury KX1";
 ModuleConfigProperty_t MERCURY_KX1_CONFIG_PROPERTIES[MERCURY_KX1_PROPERTY_COUNT] = {
 { "FPGA type\0", 0x08, 4, 4, 7, 0, 5, 0, 6, (ModulePropertyValueKey_t*)&MERCURY_KX1_FPGA_TYPE_VALUE_KEY, 0, 0 }, 
@@ -227,16 +193,12 @@ ModuleConfigProperty_t MERCURY_KX1_CONFIG_PROPERTIES[MERCURY_KX1_PROPERTY_COUNT]
 { "DDR3 RAM size (MB)\0", 0x0B, 4, 4, 7, 0, 9, 8, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 }, 
 { "Secondary DDR3 RAM size (MB)\0", 0x0C, 4, 0, 3, 0, 9, 2, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_KX1_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury KX2
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_KX2
-
 char MERCURY_KX2_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury+ KX2";
 ModuleConfigProperty_t MERCURY_KX2_CONFIG_PROPERTIES[MERCURY_KX2_PROPERTY_COUNT] = {
 { "FPGA type\0", 0x08, 4, 4, 7, 0, 3, 0, 4, (ModulePropertyValueKey_t*)&MERCURY_KX2_FPGA_TYPE_VALUE_KEY, 0, 0 }, 
@@ -248,16 +210,12 @@ ModuleConfigProperty_t MERCURY_KX2_CONFIG_PROPERTIES[MERCURY_KX2_PROPERTY_COUNT]
 { "USB 2.0 device port count\0", 0x0A, 2, 0, 1, 0, 1, 0, 0, NULL, 0, 0 }, 
 { "DDR3 RAM size (MB)\0", 0x0B, 4, 4, 7, 0, 10, 8, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_KX2_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU1
-
 char MERCURY_XU1_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury+ XU1";
 ModuleConfigProperty_t MERCURY_XU1_CONFIG_PROPERTIES[MERCURY_XU1_PROPERTY_COUNT] = {
 { "MPSoC type\0", 0x08, 4, 4, 7, 0, 4, 0, 5, (ModulePropertyValueKey_t*)&MERCURY_XU1_MPSOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -272,16 +230,12 @@ ModuleConfigProperty_t MERCURY_XU1_CONFIG_PROPERTIES[MERCURY_XU1_PROPERTY_COUNT]
 { "DDR4 RAM size (GB)\0", 0x0B, 4, 4, 7, 0, 4, 1, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 }, 
 { "eMMC flash size (GB)\0", 0x0C, 4, 4, 7, 0, 5, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_XU1_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU5
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU5
-
 char MERCURY_XU5_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury XU5";
 ModuleConfigProperty_t MERCURY_XU5_CONFIG_PROPERTIES[MERCURY_XU5_PROPERTY_COUNT] = {
 { "MPSoC type\0", 0x08, 4, 4, 7, 0, 3, 0, 4, (ModulePropertyValueKey_t*)&MERCURY_XU5_MPSOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -296,16 +250,12 @@ ModuleConfigProperty_t MERCURY_XU5_CONFIG_PROPERTIES[MERCURY_XU5_PROPERTY_COUNT]
 { "DDR4 RAM (PL) size (MB)\0", 0x0B, 4, 0, 3, 0, 9, 8, 0, NULL, 0, 0 }, 
 { "eMMC flash size (GB)\0", 0x0C, 4, 4, 7, 0, 5, 1, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0C, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_XU5_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU7
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU7
-
 char MERCURY_XU7_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury+ XU7";
 ModuleConfigProperty_t MERCURY_XU7_CONFIG_PROPERTIES[MERCURY_XU7_PROPERTY_COUNT] = {
 { "MPSoC type\0", 0x08, 4, 4, 7, 0, 2, 0, 3, (ModulePropertyValueKey_t*)&MERCURY_XU7_MPSOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -319,16 +269,12 @@ ModuleConfigProperty_t MERCURY_XU7_CONFIG_PROPERTIES[MERCURY_XU7_PROPERTY_COUNT]
 { "DDR4 RAM (PL) size (GB)\0", 0x0B, 4, 0, 3, 0, 3, 1, 0, NULL, 0, 0 }, 
 { "eMMC flash size (GB)\0", 0x0C, 4, 4, 7, 0, 5, 1, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0C, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_XU7_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU8
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU8
-
 char MERCURY_XU8_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury+ XU8";
 ModuleConfigProperty_t MERCURY_XU8_CONFIG_PROPERTIES[MERCURY_XU8_PROPERTY_COUNT] = {
 { "MPSoC type\0", 0x08, 4, 4, 7, 0, 2, 0, 3, (ModulePropertyValueKey_t*)&MERCURY_XU8_MPSOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -342,16 +288,12 @@ ModuleConfigProperty_t MERCURY_XU8_CONFIG_PROPERTIES[MERCURY_XU8_PROPERTY_COUNT]
 { "DDR4 RAM (PL) size (GB)\0", 0x0B, 4, 0, 3, 0, 3, 1, 0, NULL, 0, 0 }, 
 { "eMMC flash size (GB)\0", 0x0C, 4, 4, 7, 0, 5, 1, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0C, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_XU8_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU9
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU9
-
 char MERCURY_XU9_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury+ XU9";
 ModuleConfigProperty_t MERCURY_XU9_CONFIG_PROPERTIES[MERCURY_XU9_PROPERTY_COUNT] = {
 { "MPSoC type\0", 0x08, 4, 4, 7, 0, 3, 0, 4, (ModulePropertyValueKey_t*)&MERCURY_XU9_MPSOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -365,16 +307,12 @@ ModuleConfigProperty_t MERCURY_XU9_CONFIG_PROPERTIES[MERCURY_XU9_PROPERTY_COUNT]
 { "DDR4 RAM (PL) size (GB)\0", 0x0B, 4, 0, 3, 0, 4, 1, 0, NULL, 0, 0 }, 
 { "eMMC flash size (GB)\0", 0x0C, 4, 4, 7, 0, 5, 1, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0C, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_XU9_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mars XU3
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_XU3
-
 char MARS_XU3_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mars XU3";
 ModuleConfigProperty_t MARS_XU3_CONFIG_PROPERTIES[MARS_XU3_PROPERTY_COUNT] = {
 { "MPSoC type\0", 0x08, 4, 4, 7, 0, 3, 0, 4, (ModulePropertyValueKey_t*)&MARS_XU3_MPSOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -386,16 +324,12 @@ ModuleConfigProperty_t MARS_XU3_CONFIG_PROPERTIES[MARS_XU3_PROPERTY_COUNT] = {
 { "DDR4 RAM size (GB)\0", 0x0B, 4, 4, 7, 0, 3, 1, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 }, 
 { "eMMC flash size (GB)\0", 0x0C, 4, 4, 7, 0, 5, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MARS_XU3_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury SA1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_SA1
-
 char MERCURY_SA1_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury SA1";
 ModuleConfigProperty_t MERCURY_SA1_CONFIG_PROPERTIES[MERCURY_SA1_PROPERTY_COUNT] = {
 { "SoC type\0", 0x08, 4, 4, 7, 0, 2, 0, 3, (ModulePropertyValueKey_t*)&MERCURY_SA1_SOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -409,16 +343,12 @@ ModuleConfigProperty_t MERCURY_SA1_CONFIG_PROPERTIES[MERCURY_SA1_PROPERTY_COUNT]
 { "DDR3L RAM size (MB)\0", 0x0B, 4, 4, 7, 0, 10, 8, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 }, 
 { "eMMC flash size (GB)\0", 0x0C, 4, 0, 3, 0, 5, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_SA1_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mars MA3
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_MA3
-
 char MARS_MA3_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mars MA3";
 ModuleConfigProperty_t MARS_MA3_CONFIG_PROPERTIES[MARS_MA3_PROPERTY_COUNT] = {
 { "SoC type\0", 0x08, 4, 4, 7, 0, 3, 0, 4, (ModulePropertyValueKey_t*)&MARS_MA3_SOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -432,16 +362,12 @@ ModuleConfigProperty_t MARS_MA3_CONFIG_PROPERTIES[MARS_MA3_PROPERTY_COUNT] = {
 { "DDR3L RAM size (GB)\0", 0x0B, 4, 4, 7, 0, 2, 1, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 }, 
 { "eMMC flash size (GB)\0", 0x0C, 4, 0, 3, 0, 5, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MARS_MA3_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury SA2
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_SA2
-
 char MERCURY_SA2_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury+ SA2";
 ModuleConfigProperty_t MERCURY_SA2_CONFIG_PROPERTIES[MERCURY_SA2_PROPERTY_COUNT] = {
 { "SoC type\0", 0x08, 4, 4, 7, 0, 0, 0, 1, (ModulePropertyValueKey_t*)&MERCURY_SA2_SOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -455,16 +381,12 @@ ModuleConfigProperty_t MERCURY_SA2_CONFIG_PROPERTIES[MERCURY_SA2_PROPERTY_COUNT]
 { "USB 3.0 device port count\0", 0x0A, 1, 0, 0, 0, 1, 0, 0, NULL, 0, 0 }, 
 { "DDR3L RAM size (MB)\0", 0x0B, 4, 4, 7, 0, 10, 8, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_SA2_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury ZX1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_ZX1
-
 char MERCURY_ZX1_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury ZX1";
 ModuleConfigProperty_t MERCURY_ZX1_CONFIG_PROPERTIES[MERCURY_ZX1_PROPERTY_COUNT] = {
 { "SoC type\0", 0x08, 4, 4, 7, 0, 2, 0, 3, (ModulePropertyValueKey_t*)&MERCURY_ZX1_SOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -479,16 +401,12 @@ ModuleConfigProperty_t MERCURY_ZX1_CONFIG_PROPERTIES[MERCURY_ZX1_PROPERTY_COUNT]
 { "DDR3L RAM (PL) size (MB)\0", 0x0B, 4, 0, 3, 0, 6, 8, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0C, 4, 4, 7, 0, 7, 1, 0, NULL, 0, 0 }, 
 { "NAND flash size (MB)\0", 0x0C, 4, 0, 3, 0, 7, 8, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_ZX1_CONFIG_PROPERTIES;
-#endif
 
 
 //-------------------------------------------------------------------------------------------------
 // Mercury ZX5
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_ZX5
-
 char MERCURY_ZX5_MODULE_NAME[MAX_MODULE_NAME_LENGTH_CHARACTERS] = "Mercury ZX5";
 ModuleConfigProperty_t MERCURY_ZX5_CONFIG_PROPERTIES[MERCURY_ZX5_PROPERTY_COUNT] = {
 { "SoC type\0", 0x08, 4, 4, 7, 0, 1, 0, 2, (ModulePropertyValueKey_t*)&MERCURY_ZX5_SOC_TYPE_VALUE_KEY, 0, 0 }, 
@@ -502,5 +420,62 @@ ModuleConfigProperty_t MERCURY_ZX5_CONFIG_PROPERTIES[MERCURY_ZX5_PROPERTY_COUNT]
 { "DDR3L RAM size (MB)\0", 0x0B, 4, 4, 7, 0, 8, 8, 0, NULL, 0, 0 }, 
 { "QSPI flash size (MB)\0", 0x0B, 4, 0, 3, 0, 7, 1, 0, NULL, 0, 0 }, 
 { "NAND flash size (MB)\0", 0x0C, 4, 0, 3, 0, 10, 1, 0, NULL, 0, 0 } };
-ModuleConfigProperty_t* g_pConfigProperties = (ModuleConfigProperty_t*)&MERCURY_ZX5_CONFIG_PROPERTIES;
-#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// Module configuration layouts
+//-------------------------------------------------------------------------------------------------
+
+const ModuleConfigLayout_t MODULE_CONFIG_LAYOUTS[MODULE_CONFIG_LAYOUT_COUNT] = {
+{ PRODUCT_FAMILY_CODE_MARS_MX1, MARS_MX1_MODULE_NAME, MARS_MX1_CONFIG_PROPERTIES, MARS_MX1_PROPERTY_COUNT, MARS_MX1_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MARS_MX2, MARS_MX2_MODULE_NAME, MARS_MX2_CONFIG_PROPERTIES, MARS_MX2_PROPERTY_COUNT, MARS_MX2_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_CA1, MERCURY_CA1_MODULE_NAME, MERCURY_CA1_CONFIG_PROPERTIES, MERCURY_CA1_PROPERTY_COUNT, MERCURY_CA1_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MARS_ZX3, MARS_ZX3_MODULE_NAME, MARS_ZX3_CONFIG_PROPERTIES, MARS_ZX3_PROPERTY_COUNT, MARS_ZX3_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MARS_AX3, MARS_AX3_MODULE_NAME, MARS_AX3_CONFIG_PROPERTIES, MARS_AX3_PROPERTY_COUNT, MARS_AX3_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_KX1, MERCURY_KX1_MODULE_NAME, MERCURY_KX1_CONFIG_PROPERTIES, MERCURY_KX1_PROPERTY_COUNT, MERCURY_KX1_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_SA1, MERCURY_SA1_MODULE_NAME, MERCURY_SA1_CONFIG_PROPERTIES, MERCURY_SA1_PROPERTY_COUNT, MERCURY_SA1_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_ZX1, MERCURY_ZX1_MODULE_NAME, MERCURY_ZX1_CONFIG_PROPERTIES, MERCURY_ZX1_PROPERTY_COUNT, MERCURY_ZX1_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_ZX5, MERCURY_ZX5_MODULE_NAME, MERCURY_ZX5_CONFIG_PROPERTIES, MERCURY_ZX5_PROPERTY_COUNT, MERCURY_ZX5_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MARS_ZX2, MARS_ZX2_MODULE_NAME, MARS_ZX2_CONFIG_PROPERTIES, MARS_ZX2_PROPERTY_COUNT, MARS_ZX2_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_SA2, MERCURY_SA2_MODULE_NAME, MERCURY_SA2_CONFIG_PROPERTIES, MERCURY_SA2_PROPERTY_COUNT, MERCURY_SA2_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_AA1, MERCURY_AA1_MODULE_NAME, MERCURY_AA1_CONFIG_PROPERTIES, MERCURY_AA1_PROPERTY_COUNT, MERCURY_AA1_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_KX2, MERCURY_KX2_MODULE_NAME, MERCURY_KX2_CONFIG_PROPERTIES, MERCURY_KX2_PROPERTY_COUNT, MERCURY_KX2_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_XU1, MERCURY_XU1_MODULE_NAME, MERCURY_XU1_CONFIG_PROPERTIES, MERCURY_XU1_PROPERTY_COUNT, MERCURY_XU1_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MARS_XU3, MARS_XU3_MODULE_NAME, MARS_XU3_CONFIG_PROPERTIES, MARS_XU3_PROPERTY_COUNT, MARS_XU3_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MARS_MA3, MARS_MA3_MODULE_NAME, MARS_MA3_CONFIG_PROPERTIES, MARS_MA3_PROPERTY_COUNT, MARS_MA3_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_COSMOS_XZQ10, COSMOS_XZQ10_MODULE_NAME, COSMOS_XZQ10_CONFIG_PROPERTIES, COSMOS_XZQ10_PROPERTY_COUNT, COSMOS_XZQ10_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_XU5, MERCURY_XU5_MODULE_NAME, MERCURY_XU5_CONFIG_PROPERTIES, MERCURY_XU5_PROPERTY_COUNT, MERCURY_XU5_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_XU7, MERCURY_XU7_MODULE_NAME, MERCURY_XU7_CONFIG_PROPERTIES, MERCURY_XU7_PROPERTY_COUNT, MERCURY_XU7_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_XU8, MERCURY_XU8_MODULE_NAME, MERCURY_XU8_CONFIG_PROPERTIES, MERCURY_XU8_PROPERTY_COUNT, MERCURY_XU8_CONFIG_PROPERTIES_LENGTH_BYTES }, 
+{ PRODUCT_FAMILY_CODE_MERCURY_XU9, MERCURY_XU9_MODULE_NAME, MERCURY_XU9_CONFIG_PROPERTIES, MERCURY_XU9_PROPERTY_COUNT, MERCURY_XU9_CONFIG_PROPERTIES_LENGTH_BYTES } };
+
+const ModuleConfigLayout_t* g_pModuleConfigLayout = NULL;
+ModuleConfigProperty_t* g_pConfigProperties = NULL;
+
+
+const ModuleConfigLayout_t* ModuleConfig_FindLayout(uint16_t productFamilyCode)
+{
+    // Binary search of the layouts, which are sorted by product family code.
+    unsigned int lowIndex = 0;
+    unsigned int highIndex = MODULE_CONFIG_LAYOUT_COUNT;
+    while (lowIndex < highIndex)
+    {
+        unsigned int middleIndex = (lowIndex + highIndex) / 2;
+        uint16_t middleCode = MODULE_CONFIG_LAYOUTS[middleIndex].productFamilyCode;
+
+        if (middleCode == productFamilyCode)
+        {
+            return &MODULE_CONFIG_LAYOUTS[middleIndex];
+        }
+        else if (middleCode < productFamilyCode)
+        {
+            lowIndex = middleIndex + 1;
+        }
+        else
+        {
+            highIndex = middleIndex;
+        }
+    }
+
+    return NULL;
+}
@@ -26,7 +26,6 @@
 // Cosmos XZQ10
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == COSMOS_XZQ10
  const ModulePropertyValueKey_t COSMOS_XZQ10_SOC_TYPE_VALUE_KEY[4] = {
 {0, "Xilinx Zynq-7030 FBG\0" }, 
 {1, "Xilinx Zynq-7035 FBG\0" }, 
@@ -77,13 +76,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars AX3
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_AX3
  const ModulePropertyValueKey_t MARS_AX3_FPGA_TYPE_VALUE_KEY[4] = {
 {1, "Xilinx Artix-7 XC7A35T\0" }, 
 {2, "Xilinx Artix-7 XC7A50T\0" }, 
@@ -106,13 +103,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars MX1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_MX1
  const ModulePropertyValueKey_t MARS_MX1_FPGA_TYPE_VALUE_KEY[4] = {
 {0, "Xilinx Spartan-6 XC6SLX9\0" }, 
 {1, "Xilinx Spartan-6 XC6SLX16\0" }, 
@@ -135,13 +130,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars MX2
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_MX2
  const ModulePropertyValueKey_t MARS_MX2_FPGA_TYPE_VALUE_KEY[2] = {
 {0, "Xilinx Spartan-6 XC6SLX25T\0" }, 
 {1, "Xilinx Spartan-6 XC6SLX45T\0" }
@@ -162,13 +155,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars ZX2
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_ZX2
  const ModulePropertyValueKey_t MARS_ZX2_SOC_TYPE_VALUE_KEY[2] = {
 {0, "Xilinx Zynq-7010\0" }, 
 {1, "Xilinx Zynq-7020\0" }
@@ -189,13 +180,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars ZX3
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_ZX3
  const ModulePropertyValueKey_t MARS_ZX3_SOC_TYPE_VALUE_KEY[1] = {
 {0, "Xilinx Zynq-7020\0" }
  };
@@ -215,13 +204,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury AA1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_AA1
  const ModulePropertyValueKey_t MERCURY_AA1_SOC_TYPE_VALUE_KEY[2] = {
 {0, "Altera Arria 10 10AS027\0" }, 
 {1, "Altera Arria 10 10AS048\0" }
@@ -245,13 +232,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury CA1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_CA1
  const ModulePropertyValueKey_t MERCURY_CA1_FPGA_TYPE_VALUE_KEY[5] = {
 {0, "Altera Cyclone IV EP4CE30\0" }, 
 {1, "Altera Cyclone IV EP4CE40\0" }, 
@@ -275,13 +260,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury KX1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_KX1
  const ModulePropertyValueKey_t MERCURY_KX1_FPGA_TYPE_VALUE_KEY[6] = {
 {0, "Xilinx Kintex-7 XC7K160T FBG\0" }, 
 {1, "Xilinx Kintex-7 XC7K325T FBG\0" }, 
@@ -306,13 +289,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury KX2
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_KX2
  const ModulePropertyValueKey_t MERCURY_KX2_FPGA_TYPE_VALUE_KEY[4] = {
 {0, "Xilinx Kintex-7 XC7K160T FBG\0" }, 
 {1, "Xilinx Kintex-7 XC7K160T FFG\0" }, 
@@ -331,13 +312,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU1
  const ModulePropertyValueKey_t MERCURY_XU1_MPSOC_TYPE_VALUE_KEY[5] = {
 {0, "Xilinx Zynq UltraScale+ XCZU9EG ES\0" }, 
 {1, "Xilinx Zynq UltraScale+ XCZU6EG\0" }, 
@@ -366,13 +345,11 @@
 {0, "Yes\0" }, 
 {1, "No\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU5
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU5
  const ModulePropertyValueKey_t MERCURY_XU5_MPSOC_TYPE_VALUE_KEY[4] = {
 {0, "Xilinx Zynq UltraScale+ XCZU2EG\0" }, 
 {1, "Xilinx Zynq UltraScale+ XCZU3EG\0" }, 
@@ -396,13 +373,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU7
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU7
  const ModulePropertyValueKey_t MERCURY_XU7_MPSOC_TYPE_VALUE_KEY[3] = {
 {0, "Xilinx Zynq UltraScale+ XCZU6EG\0" }, 
 {1, "Xilinx Zynq UltraScale+ XCZU9EG\0" }, 
@@ -421,13 +396,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU8
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU8
  const ModulePropertyValueKey_t MERCURY_XU8_MPSOC_TYPE_VALUE_KEY[3] = {
 {0, "Xilinx Zynq UltraScale+ XCZU4CG\0" }, 
 {1, "Xilinx Zynq UltraScale+ XCZU5EV\0" }, 
@@ -446,13 +419,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury XU9
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_XU9
  const ModulePropertyValueKey_t MERCURY_XU9_MPSOC_TYPE_VALUE_KEY[4] = {
 {0, "Xilinx Zynq UltraScale+ XCZU4CG\0" }, 
 {1, "Xilinx Zynq UltraScale+ XCZU4EV\0" }, 
@@ -472,13 +443,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars XU3
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_XU3
  const ModulePropertyValueKey_t MARS_XU3_MPSOC_TYPE_VALUE_KEY[4] = {
 {0, "Xilinx Zynq UltraScale+ XCZU3EG ES\0" }, 
 {1, "Xilinx Zynq UltraScale+ XCZU2EG\0" }, 
@@ -500,13 +469,11 @@
 {0, "Normal\0" }, 
 {1, "Low power\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury SA1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_SA1
  const ModulePropertyValueKey_t MERCURY_SA1_SOC_TYPE_VALUE_KEY[3] = {
 {0, "Altera Cyclone V 5CSEBA2U23\0" }, 
 {1, "Altera Cyclone V 5CSXFC5C6U23\0" }, 
@@ -528,13 +495,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mars MA3
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MARS_MA3
  const ModulePropertyValueKey_t MARS_MA3_SOC_TYPE_VALUE_KEY[4] = {
 {0, "Altera Cyclone V 5CSEBA4U23\0" }, 
 {1, "Altera Cyclone V 5CSEBA5U23\0" }, 
@@ -553,13 +518,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury SA2
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_SA2
  const ModulePropertyValueKey_t MERCURY_SA2_SOC_TYPE_VALUE_KEY[1] = {
 {0, "Altera Cyclone V 5CSTFD6D5F31\0" }
  };
@@ -575,13 +538,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury ZX1
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_ZX1
  const ModulePropertyValueKey_t MERCURY_ZX1_SOC_TYPE_VALUE_KEY[3] = {
 {0, "Xilinx Zynq-7030 FBG\0" }, 
 {1, "Xilinx Zynq-7035 FBG\0" }, 
@@ -599,13 +560,11 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
 //-------------------------------------------------------------------------------------------------
 // Mercury ZX5
 //-------------------------------------------------------------------------------------------------
 
-#if TARGET_MODULE == MERCURY_ZX5
  const ModulePropertyValueKey_t MERCURY_ZX5_SOC_TYPE_VALUE_KEY[2] = {
 {0, "Xilinx Zynq-7015\0" }, 
 {1, "Xilinx Zynq-7030\0" }
@@ -626,5 +585,4 @@
 {0, "No\0" }, 
 {1, "Yes\0" }
  };
-#endif
 
@@ -59,9 +59,13 @@ EN_RESULT ReadSystemMonitor()
 	int vBus;
 	int i;
 
+	// Read all channels first, then convert them with the divider of each channel.
+	SystemMonitorReadings_t readings;
+	EN_RETURN_IF_FAILED(SystemMonitor_ReadAllChannels(&readings));
+
 	for (i = 0; i < 7; i++)
 	{
-		EN_RETURN_IF_FAILED(SystemMonitor_ReadVoltage(i, &vBus, voltReadingSel0[i].VoltageDivResistors[0], voltReadingSel0[i].VoltageDivResistors[1]));
+		vBus = SystemMonitor_ConvertVoltage(readings.values[i], voltReadingSel0[i].VoltageDivResistors[0], voltReadingSel0[i].VoltageDivResistors[1]);
 		EN_PRINTF("%s%-15s%s%d mV\n\r", LEFT_PADDING, voltReadingSel0[i].VoltageLabel, "Voltage = ", vBus);
 	}
 
@@ -74,6 +74,23 @@ EN_RESULT Rtc_SetTime(int hour, int minutes, int seconds);
 EN_RESULT Rtc_ReadDate(int* pDay, int* pMonth, int* pYear);
 
 
+/**
+ * \brief Read the date and the time from the RTC, with a single read of all date and time registers.
+ *
+ * Unlike separate calls of Rtc_ReadDate() and Rtc_ReadTime(), the date and the time cannot be torn apart by
+ * a roll-over between the two reads (e.g. at midnight).
+ *
+ * @param[out] pDay		Pointer to variable to receive day value
+ * @param[out] pMonth	Pointer to variable to receive month value
+ * @param[out] pYear	Pointer to variable to receive year value
+ * @param[out] pHour	Pointer to variable to receive hour value
+ * @param[out] pMinutes	Pointer to variable to receive minutes value
+ * @param[out] pSeconds	Pointer to variable to receive seconds value
+ * @return				Result code
+ */
+EN_RESULT Rtc_ReadDateTime(int* pDay, int* pMonth, int* pYear, int* pHour, int* pMinutes, int* pSeconds);
+
+
 /**
  * \brief Set the date in the RTC.
  *
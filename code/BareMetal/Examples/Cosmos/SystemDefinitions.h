@@ -32,6 +32,7 @@
 #define ALTERA_NIOS 2
 #define ALTERA_ARM_SOC 3
 #define UBOOT 4
+#define LINUX_USERSPACE 5
 
 
 //-------------------------------------------------------------------------------------------------
@@ -115,4 +116,8 @@
 #elif SYSTEM == UBOOT
 #define EN_PRINTF printf
 #define EN_FLUSH fflush(stdout)
+#elif SYSTEM == LINUX_USERSPACE
+#include <stdio.h>
+#define EN_PRINTF printf
+#define EN_FLUSH fflush(stdout)
 #endif
@@ -69,6 +69,9 @@
 // Value RAM Base Address
 #define SYSTEM_MONITOR_REGISTER_ADDRESS_VALUE_BASE 0x20
 
+// Temperature reading, following the voltage channel readings in the value RAM
+#define SYSTEM_MONITOR_REGISTER_ADDRESS_TEMPERATURE 0x27
+
 //-------------------------------------------------------------------------------------------------
 // Function definitions
 //-------------------------------------------------------------------------------------------------
@@ -125,58 +128,108 @@ EN_RESULT SystemMonitor_Initialise()
 
 EN_RESULT SystemMonitor_ReadValue(uint16_t channel, uint16_t* pValue)
 {
-	EN_RETURN_IF_FAILED(I2cRead(SYSTEM_MONITOR_DEVICE_ADDRESS,
-								SYSTEM_MONITOR_REGISTER_ADDRESS_VALUE_BASE+channel,
-								EI2cSubAddressMode_OneByte,
-								2,
-								(uint8_t*)pValue));
+	// Supply monitoring is time-critical, so the readings are not delayed behind bulk transfers.
+	EN_RETURN_IF_FAILED(I2cReadWithPriority(SYSTEM_MONITOR_DEVICE_ADDRESS,
+											SYSTEM_MONITOR_REGISTER_ADDRESS_VALUE_BASE+channel,
+											EI2cSubAddressMode_OneByte,
+											2,
+											(uint8_t*)pValue,
+											EI2cPriority_Urgent));
 
 	return EN_SUCCESS;
 }
 
-EN_RESULT SystemMonitor_ReadVoltage(uint16_t channel, int* pVoltage, int RUpper, int RLower)
+/**
+ * \brief Convert a value register word, as read from the bus (most significant byte first), to the reading.
+ */
+uint16_t SystemMonitor_GetReading(const uint8_t* pRegisterBytes)
 {
-	uint16_t tempValue;
-	EN_RETURN_IF_FAILED(I2cRead(SYSTEM_MONITOR_DEVICE_ADDRESS,
-								SYSTEM_MONITOR_REGISTER_ADDRESS_VALUE_BASE+channel,
-								EI2cSubAddressMode_OneByte,
-								2,
-								(uint8_t*)&tempValue));
-
-	// Convert value to voltage
-	tempValue = (tempValue << 8) | (tempValue >> 8);
-    // Only the first 10 bits contain the value
-	tempValue = tempValue >> 6;
+	// Only the first 10 bits contain the value
+	return (uint16_t)((pRegisterBytes[0] << 8) | pRegisterBytes[1]) >> 6;
+}
 
+int SystemMonitor_ConvertVoltage(uint16_t value, int RUpper, int RLower)
+{
 	if ( RLower != 1 )
 	{
         /** from voltage divider formula; the constant 2.5 corresponds to the 2.5 mV LSB weighting from the data sheet */
-		*pVoltage = (tempValue * 2.5 * (RUpper + RLower) / RLower);
-	} else {
-		/**no divider to ground - the voltage is more or less the same (depending on the current through RUpper resistor)*/
-		*pVoltage = (tempValue * 2.5 );
+		return (value * 2.5 * (RUpper + RLower) / RLower);
 	}
 
+	/**no divider to ground - the voltage is more or less the same (depending on the current through RUpper resistor)*/
+	return (value * 2.5 );
+}
+
+int SystemMonitor_ConvertCurrent(uint16_t value, int RShunt, int vRef)
+{
+	/** Calculate current value: I=U/R; 100 is the gain of the current shunt monitor TI INA 199; the value of RShunt is given in integer and needs to be converted to mOhm, thus the factor 0.001; vRef is typically 0 V*/
+	return (((value * 2.5) - vRef) / (100 * (0.001 * RShunt)));
+}
+
+EN_RESULT SystemMonitor_ReadVoltage(uint16_t channel, int* pVoltage, int RUpper, int RLower)
+{
+	uint8_t registerBytes[2];
+	EN_RETURN_IF_FAILED(I2cReadWithPriority(SYSTEM_MONITOR_DEVICE_ADDRESS,
+											SYSTEM_MONITOR_REGISTER_ADDRESS_VALUE_BASE+channel,
+											EI2cSubAddressMode_OneByte,
+											2,
+											registerBytes,
+											EI2cPriority_Urgent));
+
+	*pVoltage = SystemMonitor_ConvertVoltage(SystemMonitor_GetReading(registerBytes), RUpper, RLower);
 
 	return EN_SUCCESS;
 }
 
 EN_RESULT SystemMonitor_ReadCurrent(uint16_t channel, int* pCurrent, int RShunt, int vRef)
 {
-	uint16_t tempValue = 0;
-	EN_RETURN_IF_FAILED(I2cRead(SYSTEM_MONITOR_DEVICE_ADDRESS,
-								SYSTEM_MONITOR_REGISTER_ADDRESS_VALUE_BASE+channel,
-								EI2cSubAddressMode_OneByte,
-								2,
-								(uint8_t*)&tempValue));
+	uint8_t registerBytes[2];
+	EN_RETURN_IF_FAILED(I2cReadWithPriority(SYSTEM_MONITOR_DEVICE_ADDRESS,
+											SYSTEM_MONITOR_REGISTER_ADDRESS_VALUE_BASE+channel,
+											EI2cSubAddressMode_OneByte,
+											2,
+											registerBytes,
+											EI2cPriority_Urgent));
 
-	// Convert value to voltage
-	tempValue = (tempValue << 8) | (tempValue >> 8);
-    // Only the first 10 bits contain the value
-	tempValue = tempValue >> 6;
-	/** Calculate current value: I=U/R; 100 is the gain of the current shunt monitor TI INA 199; the value of RShunt is given in integer and needs to be converted to mOhm, thus the factor 0.001; vRef is typically 0 V*/
-	*pCurrent = (((tempValue * 2.5) - vRef) / (100 * (0.001 * RShunt)));
+	*pCurrent = SystemMonitor_ConvertCurrent(SystemMonitor_GetReading(registerBytes), RShunt, vRef);
 
 	return EN_SUCCESS;
 }
 
+EN_RESULT SystemMonitor_ReadAllChannels(SystemMonitorReadings_t* pReadings)
+{
+	if (pReadings == NULL)
+	{
+		return EN_ERROR_NULL_POINTER;
+	}
+
+	/** Each value register is read with its own 2-byte read, as in SystemMonitor_ReadVoltage(). The data sheet does
+	 * not state that the register address advances to the next value register within a longer read, so the
+	 * registers are not read in one burst */
+	uint8_t registerBytes[2 * (SYSTEM_MONITOR_NUMBER_OF_VOLTAGE_CHANNELS + 1)];
+	int channel;
+	for (channel = 0; channel <= SYSTEM_MONITOR_NUMBER_OF_VOLTAGE_CHANNELS; channel++)
+	{
+		EN_RETURN_IF_FAILED(I2cReadWithPriority(SYSTEM_MONITOR_DEVICE_ADDRESS,
+												SYSTEM_MONITOR_REGISTER_ADDRESS_VALUE_BASE+channel,
+												EI2cSubAddressMode_OneByte,
+												2,
+												&registerBytes[2 * channel],
+												EI2cPriority_Urgent));
+	}
+
+	for (channel = 0; channel < SYSTEM_MONITOR_NUMBER_OF_VOLTAGE_CHANNELS; channel++)
+	{
+		pReadings->values[channel] = SystemMonitor_GetReading(&registerBytes[2 * channel]);
+		pReadings->inputVoltages[channel] = SystemMonitor_ConvertVoltage(pReadings->values[channel], 0, 1);
+	}
+
+	/** The temperature is a left-aligned two's complement value; with the resolution selected in
+	 * SystemMonitor_Initialise(), the upper byte holds whole degrees and the lower byte the fraction */
+	const uint8_t* pTemperatureBytes =
+		&registerBytes[2 * (SYSTEM_MONITOR_REGISTER_ADDRESS_TEMPERATURE - SYSTEM_MONITOR_REGISTER_ADDRESS_VALUE_BASE)];
+	int16_t temperatureValue = (int16_t)((pTemperatureBytes[0] << 8) | pTemperatureBytes[1]);
+	pReadings->temperatureMilliCelsius = (temperatureValue * 1000) / 256;
+
+	return EN_SUCCESS;
+}
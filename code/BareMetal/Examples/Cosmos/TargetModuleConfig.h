@@ -1,276 +0,0 @@
-/**---------------------------------------------------------------------------------------------------
--- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
---
--- Permission is hereby granted, free of charge, to any person obtaining a copy of
--- this hardware, software, firmware, and associated documentation files (the
--- "Product"), to deal in the Product without restriction, including without
--- limitation the rights to use, copy, modify, merge, publish, distribute,
--- sublicense, and/or sell copies of the Product, and to permit persons to whom the
--- Product is furnished to do so, subject to the following conditions:
---
--- The above copyright notice and this permission notice shall be included in all
--- copies or substantial portions of the Product.
---
--- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
--- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
--- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
--- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
--- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
--- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
----------------------------------------------------------------------------------------------------
-*/
-
-#include "ModuleConfigConstants.h"
-
-//-------------------------------------------------------------------------------------------------
-// Cosmos XZQ10
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == COSMOS_XZQ10
-#define CONFIG_PROPERTY_COUNT COSMOS_XZQ10_PROPERTY_COUNT
-#define MODULE_NAME COSMOS_XZQ10_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS COSMOS_XZQ10_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES COSMOS_XZQ10_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS COSMOS_XZQ10_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mars AX3
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MARS_AX3
-#define CONFIG_PROPERTY_COUNT MARS_AX3_PROPERTY_COUNT
-#define MODULE_NAME MARS_AX3_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MARS_AX3_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MARS_AX3_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MARS_AX3_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mars MX1
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MARS_MX1
-#define CONFIG_PROPERTY_COUNT MARS_MX1_PROPERTY_COUNT
-#define MODULE_NAME MARS_MX1_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MARS_MX1_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MARS_MX1_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MARS_MX1_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mars MX2
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MARS_MX2
-#define CONFIG_PROPERTY_COUNT MARS_MX2_PROPERTY_COUNT
-#define MODULE_NAME MARS_MX2_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MARS_MX2_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MARS_MX2_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MARS_MX2_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mars ZX2
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MARS_ZX2
-#define CONFIG_PROPERTY_COUNT MARS_ZX2_PROPERTY_COUNT
-#define MODULE_NAME MARS_ZX2_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MARS_ZX2_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MARS_ZX2_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MARS_ZX2_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mars ZX3
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MARS_ZX3
-#define CONFIG_PROPERTY_COUNT MARS_ZX3_PROPERTY_COUNT
-#define MODULE_NAME MARS_ZX3_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MARS_ZX3_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MARS_ZX3_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MARS_ZX3_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury AA1
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_AA1
-#define CONFIG_PROPERTY_COUNT MERCURY_AA1_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_AA1_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_AA1_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_AA1_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_AA1_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury CA1
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_CA1
-#define CONFIG_PROPERTY_COUNT MERCURY_CA1_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_CA1_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_CA1_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_CA1_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_CA1_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury KX1
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_KX1
-#define CONFIG_PROPERTY_COUNT MERCURY_KX1_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_KX1_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_KX1_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_KX1_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_KX1_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury KX2
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_KX2
-#define CONFIG_PROPERTY_COUNT MERCURY_KX2_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_KX2_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_KX2_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_KX2_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_KX2_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury XU1
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_XU1
-#define CONFIG_PROPERTY_COUNT MERCURY_XU1_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_XU1_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_XU1_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_XU1_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_XU1_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury XU5
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_XU5
-#define CONFIG_PROPERTY_COUNT MERCURY_XU5_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_XU5_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_XU5_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_XU5_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_XU5_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury XU7
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_XU7
-#define CONFIG_PROPERTY_COUNT MERCURY_XU7_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_XU7_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_XU7_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_XU7_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_XU7_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury XU8
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_XU8
-#define CONFIG_PROPERTY_COUNT MERCURY_XU8_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_XU8_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_XU8_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_XU8_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_XU8_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury XU9
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_XU9
-#define CONFIG_PROPERTY_COUNT MERCURY_XU9_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_XU9_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_XU9_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_XU9_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_XU9_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mars XU3
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MARS_XU3
-#define CONFIG_PROPERTY_COUNT MARS_XU3_PROPERTY_COUNT
-#define MODULE_NAME MARS_XU3_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MARS_XU3_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MARS_XU3_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MARS_XU3_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury SA1
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_SA1
-#define CONFIG_PROPERTY_COUNT MERCURY_SA1_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_SA1_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_SA1_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_SA1_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_SA1_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mars MA3
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MARS_MA3
-#define CONFIG_PROPERTY_COUNT MARS_MA3_PROPERTY_COUNT
-#define MODULE_NAME MARS_MA3_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MARS_MA3_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MARS_MA3_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MARS_MA3_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury SA2
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_SA2
-#define CONFIG_PROPERTY_COUNT MERCURY_SA2_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_SA2_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_SA2_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_SA2_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_SA2_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury ZX1
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_ZX1
-#define CONFIG_PROPERTY_COUNT MERCURY_ZX1_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_ZX1_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_ZX1_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_ZX1_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_ZX1_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
-//-------------------------------------------------------------------------------------------------
-// Mercury ZX5
-//-------------------------------------------------------------------------------------------------
-
-#if TARGET_MODULE == MERCURY_ZX5
-#define CONFIG_PROPERTY_COUNT MERCURY_ZX5_PROPERTY_COUNT
-#define MODULE_NAME MERCURY_ZX5_MODULE_NAME
-#define MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS MERCURY_ZX5_MAX_CONFIG_PROPERTY_NAME_LENGTH_CHARACTERS
-#define CONFIG_PROPERTIES_LENGTH_BYTES MERCURY_ZX5_CONFIG_PROPERTIES_LENGTH_BYTES
-#define CONFIG_PROPERTIES_START_ADDRESS MERCURY_ZX5_CONFIG_PROPERTIES_START_ADDRESS
-#endif
-
@@ -26,22 +26,129 @@
 
 #include "TimerInterface.h"
 #include "TimerInterfaceVariables.h"
+
+#if SYSTEM == LINUX_USERSPACE
+#include <time.h>
+#include <unistd.h>
+#else
 #include "sleep.h"
+#include "xtime_l.h"
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+
+#if defined(__aarch64__) && SYSTEM != LINUX_USERSPACE
+/**
+ * Counter bit used to trigger the generic timer event stream, i.e. an event every
+ * 2^(EVENT_STREAM_COUNTER_BIT + 1) counter ticks (about 10 us at a 100 MHz counter).
+ */
+#define EVENT_STREAM_COUNTER_BIT 9
+#endif
+
+#if defined(__arm__) && SYSTEM != LINUX_USERSPACE
+/// The private timer is clocked at half the CPU frequency.
+#define PRIVATE_TIMER_FREQUENCY_HZ (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2)
+#endif
 
 //-------------------------------------------------------------------------------------------------
 // Global variable definitions
 //-------------------------------------------------------------------------------------------------
 
+#if defined(__arm__) && SYSTEM != LINUX_USERSPACE
+/// Cortex-A9 private timer, declared in TimerInterfaceVariables.h
+XScuTimer g_privateTimer;
+#endif
+
 //-------------------------------------------------------------------------------------------------
 // Function definitions
 //-------------------------------------------------------------------------------------------------
 
 EN_RESULT InitialiseTimer()
 {
+#if defined(__aarch64__) && SYSTEM != LINUX_USERSPACE
+    // Enable the generic timer event stream, so that a WFE instruction waiting for an event which never
+    // comes wakes up periodically. This allows time-limited waits to check their timeout.
+    uint64_t timerControl;
+    __asm__ volatile("mrs %0, cntkctl_el1" : "=r"(timerControl));
+    timerControl &= ~(0xFULL << 4);
+    timerControl |= ((uint64_t)EVENT_STREAM_COUNTER_BIT << 4) | (1 << 2);
+    __asm__ volatile("msr cntkctl_el1, %0" : : "r"(timerControl));
+    __asm__ volatile("isb");
+#elif defined(__arm__) && SYSTEM != LINUX_USERSPACE
+    // The Cortex-A9 has no event stream, so a time-limited wait arms the private timer as a one-shot interrupt
+    // at its timeout instead (see StartWakeUpTimer()). The timer stays stopped while nothing waits, so it costs
+    // no interrupts. The interrupt is connected in SetupInterruptSystem().
+    XScuTimer_Config* pTimerConfig = XScuTimer_LookupConfig(TIMER_DEVICE_ID);
+
+    if (NULL == pTimerConfig)
+    {
+        return EN_ERROR_TIMER_INITIALISATION_FAILED;
+    }
+
+    RETURN_IF_XILINX_CALL_FAILED(XScuTimer_CfgInitialize(&g_privateTimer, pTimerConfig, pTimerConfig->BaseAddr),
+                                 EN_ERROR_TIMER_INITIALISATION_FAILED);
+
+    XScuTimer_DisableAutoReload(&g_privateTimer);
+    XScuTimer_EnableInterrupt(&g_privateTimer);
+#endif
+
     return EN_SUCCESS;
 }
 
+#if defined(__arm__) && SYSTEM != LINUX_USERSPACE
+void TimerWakeUpHandler(void* pCallbackRef)
+{
+    // The interrupt only exists to end a WFI instruction; acknowledge it and return.
+    XScuTimer_ClearInterruptStatus((XScuTimer*)pCallbackRef);
+}
+
+void StartWakeUpTimer(uint32_t microseconds)
+{
+    uint64_t counts = ((uint64_t)PRIVATE_TIMER_FREQUENCY_HZ * microseconds) / 1000000;
+
+    // The counter is 32 bits wide (about 13 s at 333 MHz); a longer wait simply wakes up early and re-arms.
+    if (counts > UINT32_MAX)
+    {
+        counts = UINT32_MAX;
+    }
+
+    XScuTimer_Stop(&g_privateTimer);
+    XScuTimer_ClearInterruptStatus(&g_privateTimer);
+    XScuTimer_LoadTimer(&g_privateTimer, (uint32_t)counts);
+    XScuTimer_Start(&g_privateTimer);
+}
+
+void StopWakeUpTimer()
+{
+    XScuTimer_Stop(&g_privateTimer);
+    XScuTimer_ClearInterruptStatus(&g_privateTimer);
+}
+#endif
+
 void SleepMilliseconds(uint32_t milliseconds)
 {
     usleep(1000 * milliseconds);
 }
+
+void SleepMicroseconds(uint32_t microseconds)
+{
+    usleep(microseconds);
+}
+
+uint64_t GetTimeMicroseconds()
+{
+#if SYSTEM == LINUX_USERSPACE
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000) + ((uint64_t)now.tv_nsec / 1000);
+#else
+    XTime now;
+    XTime_GetTime(&now);
+    // Split into whole seconds and remainder, so that the conversion cannot overflow.
+    uint64_t seconds = now / COUNTS_PER_SECOND;
+    uint64_t remainderCounts = now % COUNTS_PER_SECOND;
+    return (seconds * 1000000) + ((remainderCounts * 1000000) / COUNTS_PER_SECOND);
+#endif
+}
@@ -26,10 +26,12 @@
 //-------------------------------------------------------------------------------------------------
 
 #include "AtmelAtsha204a.h"
+#include "DevicePoll.h"
 #include "I2cInterface.h"
 #include "TimerInterface.h"
 #include "UtilityFunctions.h"
 
+#include <string.h>
 
 
 //-------------------------------------------------------------------------------------------------
@@ -81,6 +83,12 @@ const uint8_t DATA_ZONE_SLOT_MODULE_CONFIGURATION = 0;
 /// Byte index of the OTP mode byte within its configuration word.
 const uint8_t OTP_MODE_WORD_BYTE_INDEX = 2;
 
+/// Word offset of the word containing the OTP mode byte, in slot 0 of the configuration zone
+const uint8_t OTP_MODE_WORD_OFFSET = 4;
+
+/// OTP mode in which the OTP zone may only be read with 4-byte reads
+const uint8_t OTP_MODE_LEGACY = 0x00;
+
 
 //-------------------------------------------------------------------------------------------------
 // Command packets and I/O
@@ -122,6 +130,109 @@ const uint8_t COMMAND_PACKET_PARAM2_BYTE_INDEX = 3;
 /// Size of param 2 in a command packet
 const uint8_t COMMAND_PACKET_PARAM2_SIZE_BYTES = 2;
 
+/// Size of the largest read response: count, 32 data bytes and checksum
+#define MAX_READ_RESPONSE_SIZE_BYTES (1 + 32 + 2)
+
+/// Size of the largest command packet: count, opcode, param 1, param 2, data and checksum
+#define MAX_COMMAND_PACKET_SIZE_BYTES (1 + 1 + 1 + 2 + ATMEL_ATSHA204A_MAX_COMMAND_DATA_SIZE_BYTES + 2)
+
+
+//-------------------------------------------------------------------------------------------------
+// Command execution times
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Typical and maximum execution time of a command.
+ */
+typedef struct
+{
+    ECommand_t command;
+    uint32_t typicalMicroseconds;
+    uint32_t maxMicroseconds;
+} AtmelAtsha204aExecutionTime_t;
+
+/// Command execution times, from the data sheet
+const AtmelAtsha204aExecutionTime_t ATMEL_ATSHA204A_EXECUTION_TIMES[] = {
+    { ECommand_CheckMac, 12000, 38000 },
+    { ECommand_DeriveKey, 14000, 62000 },
+    { ECommand_GetDeviceRevision, 400, 2000 },
+    { ECommand_GenerateDigest, 11000, 43000 },
+    { ECommand_Hmac, 27000, 69000 },
+    { ECommand_Lock, 5000, 24000 },
+    { ECommand_Mac, 12000, 35000 },
+    { ECommand_Nonce, 22000, 60000 },
+    { ECommand_Pause, 400, 2000 },
+    { ECommand_Random, 11000, 50000 },
+    { ECommand_Read, 100, 4000 },
+    { ECommand_Sha, 11000, 22000 },
+    { ECommand_UpdateExtra, 8000, 12000 },
+    { ECommand_Write, 4000, 42000 }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// CRC
+//-------------------------------------------------------------------------------------------------
+
+/// CRC-16 remainders for polynomial 0x8005, indexed by the upper CRC byte XORed with the bit-reversed data byte
+const uint16_t CRC_TABLE[256] = {
+    0x0000, 0x8005, 0x800F, 0x000A, 0x801B, 0x001E, 0x0014, 0x8011,
+    0x8033, 0x0036, 0x003C, 0x8039, 0x0028, 0x802D, 0x8027, 0x0022,
+    0x8063, 0x0066, 0x006C, 0x8069, 0x0078, 0x807D, 0x8077, 0x0072,
+    0x0050, 0x8055, 0x805F, 0x005A, 0x804B, 0x004E, 0x0044, 0x8041,
+    0x80C3, 0x00C6, 0x00CC, 0x80C9, 0x00D8, 0x80DD, 0x80D7, 0x00D2,
+    0x00F0, 0x80F5, 0x80FF, 0x00FA, 0x80EB, 0x00EE, 0x00E4, 0x80E1,
+    0x00A0, 0x80A5, 0x80AF, 0x00AA, 0x80BB, 0x00BE, 0x00B4, 0x80B1,
+    0x8093, 0x0096, 0x009C, 0x8099, 0x0088, 0x808D, 0x8087, 0x0082,
+    0x8183, 0x0186, 0x018C, 0x8189, 0x0198, 0x819D, 0x8197, 0x0192,
+    0x01B0, 0x81B5, 0x81BF, 0x01BA, 0x81AB, 0x01AE, 0x01A4, 0x81A1,
+    0x01E0, 0x81E5, 0x81EF, 0x01EA, 0x81FB, 0x01FE, 0x01F4, 0x81F1,
+    0x81D3, 0x01D6, 0x01DC, 0x81D9, 0x01C8, 0x81CD, 0x81C7, 0x01C2,
+    0x0140, 0x8145, 0x814F, 0x014A, 0x815B, 0x015E, 0x0154, 0x8151,
+    0x8173, 0x0176, 0x017C, 0x8179, 0x0168, 0x816D, 0x8167, 0x0162,
+    0x8123, 0x0126, 0x012C, 0x8129, 0x0138, 0x813D, 0x8137, 0x0132,
+    0x0110, 0x8115, 0x811F, 0x011A, 0x810B, 0x010E, 0x0104, 0x8101,
+    0x8303, 0x0306, 0x030C, 0x8309, 0x0318, 0x831D, 0x8317, 0x0312,
+    0x0330, 0x8335, 0x833F, 0x033A, 0x832B, 0x032E, 0x0324, 0x8321,
+    0x0360, 0x8365, 0x836F, 0x036A, 0x837B, 0x037E, 0x0374, 0x8371,
+    0x8353, 0x0356, 0x035C, 0x8359, 0x0348, 0x834D, 0x8347, 0x0342,
+    0x03C0, 0x83C5, 0x83CF, 0x03CA, 0x83DB, 0x03DE, 0x03D4, 0x83D1,
+    0x83F3, 0x03F6, 0x03FC, 0x83F9, 0x03E8, 0x83ED, 0x83E7, 0x03E2,
+    0x83A3, 0x03A6, 0x03AC, 0x83A9, 0x03B8, 0x83BD, 0x83B7, 0x03B2,
+    0x0390, 0x8395, 0x839F, 0x039A, 0x838B, 0x038E, 0x0384, 0x8381,
+    0x0280, 0x8285, 0x828F, 0x028A, 0x829B, 0x029E, 0x0294, 0x8291,
+    0x82B3, 0x02B6, 0x02BC, 0x82B9, 0x02A8, 0x82AD, 0x82A7, 0x02A2,
+    0x82E3, 0x02E6, 0x02EC, 0x82E9, 0x02F8, 0x82FD, 0x82F7, 0x02F2,
+    0x02D0, 0x82D5, 0x82DF, 0x02DA, 0x82CB, 0x02CE, 0x02C4, 0x82C1,
+    0x8243, 0x0246, 0x024C, 0x8249, 0x0258, 0x825D, 0x8257, 0x0252,
+    0x0270, 0x8275, 0x827F, 0x027A, 0x826B, 0x026E, 0x0264, 0x8261,
+    0x0220, 0x8225, 0x822F, 0x022A, 0x823B, 0x023E, 0x0234, 0x8231,
+    0x8213, 0x0216, 0x021C, 0x8219, 0x0208, 0x820D, 0x8207, 0x0202
+};
+
+/// Bit-reversed values of 4-bit nibbles; the device feeds the bits of each data byte into the CRC LSB first
+const uint8_t CRC_NIBBLE_REVERSE_TABLE[16] = {
+    0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Global variable definitions
+//-------------------------------------------------------------------------------------------------
+
+/// Number of nested wake sessions; while a session is open, commands do not wake the device and reads do not put it
+/// to sleep
+unsigned int g_atmelAtsha204aSessionDepth = 0;
+
+/// Time of the last wake token, from which the watchdog runs
+uint64_t g_atmelAtsha204aWakeTimeMicroseconds = 0;
+
+/// True once the OTP mode has been read from the configuration zone
+bool g_atmelAtsha204aOtpModeRead = false;
+
+/// OTP mode of the device
+uint8_t g_atmelAtsha204aOtpMode = 0;
+
 
 //-------------------------------------------------------------------------------------------------
 // Function declarations
@@ -129,43 +240,53 @@ const uint8_t COMMAND_PACKET_PARAM2_SIZE_BYTES = 2;
 
 /**
  *
- * \brief Calculate a CRC-16 used when communicating with the device. Code taken from Atmel's library.
+ * \brief Continue a CRC-16 used when communicating with the device over further data.
  *
  * The Atmel documentation only specifies that the CRC algorithm used on the ATSHA204A is CRC-16 with polynomial
- * 0x8005; compared to a standard CRC-16, however, the used algorithm doesn't use remainder reflection.
+ * 0x8005; compared to a standard CRC-16, however, the used algorithm doesn't use remainder reflection. It feeds the
+ * bits of each data byte in LSB first, so the table is indexed with the bit-reversed data byte.
  *
- * @param pData				The data to calculate the CRC for
+ * @param crc				The CRC of the preceding data, 0 at the start of a packet
+ * @param pData				The data to continue the CRC over
  * @param dataLengthBytes	The number of bytes to process
  * @return					The CRC
  */
-uint16_t AtmelAtsha204a_CalculateCrc(const uint8_t* pData, uint8_t dataLengthBytes)
+uint16_t AtmelAtsha204a_UpdateCrc(uint16_t crc, const uint8_t* pData, uint16_t dataLengthBytes)
 {
     if (pData == NULL)
     {
-        return 0;
+        return crc;
+    }
+
+    for (uint16_t byteIndex = 0; byteIndex < dataLengthBytes; byteIndex++)
+    {
+        uint8_t dataByte = pData[byteIndex];
+        uint8_t reversedByte =
+            (CRC_NIBBLE_REVERSE_TABLE[dataByte & 0x0F] << 4) | CRC_NIBBLE_REVERSE_TABLE[dataByte >> 4];
+
+        crc = (crc << 8) ^ CRC_TABLE[(crc >> 8) ^ reversedByte];
     }
 
-    uint8_t counter;
-    uint16_t crcRegister = 0;
-    uint16_t polynomial = 0x8005;
-    uint8_t shiftRegister;
-    uint8_t dataBit, crcBit;
+    return crc;
+}
+
 
-    for (counter = 0; counter < dataLengthBytes; counter++)
+/**
+ *
+ * \brief Calculate a CRC-16 used when communicating with the device.
+ *
+ * @param pData				The data to calculate the CRC for
+ * @param dataLengthBytes	The number of bytes to process
+ * @return					The CRC
+ */
+uint16_t AtmelAtsha204a_CalculateCrc(const uint8_t* pData, uint8_t dataLengthBytes)
+{
+    if (pData == NULL)
     {
-        for (shiftRegister = 0x01; shiftRegister > 0x00; shiftRegister <<= 1)
-        {
-            dataBit = (pData[counter] & shiftRegister) ? 1 : 0;
-            crcBit = crcRegister >> 15;
-            crcRegister <<= 1;
-            if (dataBit != crcBit)
-            {
-                crcRegister ^= polynomial;
-            }
-        }
+        return 0;
     }
 
-    return crcRegister;
+    return AtmelAtsha204a_UpdateCrc(0, pData, dataLengthBytes);
 }
 
 
@@ -182,21 +303,30 @@ EN_RESULT AtmelAtsha204a_Wake(bool verifyDeviceIsAtmelAtsha204a)
 #endif
 
     I2cWrite(0, 0, EI2cSubAddressMode_OneByte, (uint8_t*)&dummyWriteData, 0);
+    g_atmelAtsha204aWakeTimeMicroseconds = GetTimeMicroseconds();
 
-    // Wait for the device to wake up. 
-    SleepMilliseconds(ATMEL_ATSHA204A_WAKE_TIME_MILLISECONDS);
+    // The device does not communicate before tWHI has passed. Once it has, polling for the status block below
+    // detects the wake-up as soon as the device answers.
+    SleepMicroseconds(ATMEL_ATSHA204A_WAKE_HIGH_TIME_MICROSECONDS);
 
     if (verifyDeviceIsAtmelAtsha204a)
     {
-        // Attempt to read the status block.
+        // Attempt to read the status block. The device does not acknowledge its address until it is awake.
         uint8_t readBuffer[4];
-        EN_RESULT readResult;
-
-        do
+        const DevicePollTiming_t pollTiming = { ATMEL_ATSHA204A_POLL_INITIAL_INTERVAL_MICROSECONDS,
+                                                ATMEL_ATSHA204A_POLL_MAX_INTERVAL_MICROSECONDS,
+                                                ATMEL_ATSHA204A_WAKE_POLL_TIMEOUT_MICROSECONDS };
+
+        if (EN_FAILED(DevicePoll_ReadWhenReady(ATMEL_ATSHA204A_DEVICE_ADDRESS,
+                                               0,
+                                               EI2cSubAddressMode_None,
+                                               sizeof(readBuffer),
+                                               (uint8_t*)&readBuffer,
+                                               &pollTiming,
+                                               NULL)))
         {
-            readResult = I2cRead(
-                ATMEL_ATSHA204A_DEVICE_ADDRESS, 0, EI2cSubAddressMode_None, sizeof(readBuffer), (uint8_t*)&readBuffer);
-        } while (readResult != EN_SUCCESS);
+            return EN_ERROR_FAILED_TO_WAKE_ATMEL_ATSHA204A;
+        }
 
 
         // At this point, we need to verify the device is actually the EEPROM we think it is.
@@ -347,7 +477,7 @@ EN_RESULT AtmelAtsha204a_ConstructCommandPacket(ECommand_t command,
                                                 uint8_t parameter1,
                                                 uint16_t parameter2,
                                                 uint8_t additionalDataLengthBytes,
-                                                uint8_t* pAdditionalData,
+                                                const uint8_t* pAdditionalData,
                                                 uint8_t* pCommandPacket)
 {
     if (pCommandPacket == NULL)
@@ -363,20 +493,28 @@ EN_RESULT AtmelAtsha204a_ConstructCommandPacket(ECommand_t command,
     *(pCommandPacket + COMMAND_PACKET_PARAM2_BYTE_INDEX) = GetUpperByte(parameter2);
     *(pCommandPacket + COMMAND_PACKET_PARAM2_BYTE_INDEX + 1) = GetLowerByte(parameter2);
 
+    unsigned int dataStartByteIndex = COMMAND_PACKET_COUNT_SIZE_BYTES + COMMAND_PACKET_OPCODE_LENGTH_BYTES +
+                                      COMMAND_PACKET_PARAM1_SIZE_BYTES + COMMAND_PACKET_PARAM2_SIZE_BYTES;
+
+    // The checksum is accumulated over the header and then over the additional data as it is copied in
+    uint16_t checksum = AtmelAtsha204a_UpdateCrc(0, pCommandPacket, dataStartByteIndex);
+
     if (additionalDataLengthBytes > 0)
     {
-        unsigned int dataStartByteIndex = COMMAND_PACKET_COUNT_SIZE_BYTES + COMMAND_PACKET_OPCODE_LENGTH_BYTES +
-                                          COMMAND_PACKET_PARAM1_SIZE_BYTES + COMMAND_PACKET_PARAM2_SIZE_BYTES;
+        if (pAdditionalData == NULL)
+        {
+            return EN_ERROR_NULL_POINTER;
+        }
 
         unsigned int byteIndex = 0;
         for (byteIndex = 0; byteIndex < additionalDataLengthBytes; byteIndex++)
         {
             *(pCommandPacket + dataStartByteIndex + byteIndex) = pAdditionalData[byteIndex];
         }
-    }
 
+        checksum = AtmelAtsha204a_UpdateCrc(checksum, pAdditionalData, additionalDataLengthBytes);
+    }
 
-    uint16_t checksum = AtmelAtsha204a_CalculateCrc(pCommandPacket, commandPacketLength - CHECKSUM_LENGTH_BYTES);
 
     *(pCommandPacket + commandPacketLength - 2) = GetLowerByte(checksum);
     *(pCommandPacket + commandPacketLength - 1) = GetUpperByte(checksum);
@@ -476,13 +614,16 @@ EN_RESULT AtmelAtsha20a4_CheckCommandResponseBlock(const uint8_t* pResponseBlock
 
 
 /**
- * \brief Perform a read from the device's output buffer in response to a sent Read command.
+ * \brief Perform a read from the device's output buffer in response to a sent command.
  *
  * @param[in] numberOfBytesToRead	The number of bytes to read
+ * @param[in] pPollTiming			Timing of the poll for the response
  * @param[out] pReadData			Pointer to buffer to receive read data
  * @return							EN_RESULT code
  */
-EN_RESULT AtmelAtsha204a_ReadDataResponse(uint8_t numberOfBytesToRead, uint8_t* pReadData)
+EN_RESULT AtmelAtsha204a_ReadDataResponse(uint8_t numberOfBytesToRead,
+                                          const DevicePollTiming_t* pPollTiming,
+                                          uint8_t* pReadData)
 {
     if (pReadData == NULL)
     {
@@ -491,24 +632,34 @@ EN_RESULT AtmelAtsha204a_ReadDataResponse(uint8_t numberOfBytesToRead, uint8_t*
 
     // Response packets also contain a count byte and a 2-byte checksum.
     uint8_t totalResponsePacketSizeBytes = numberOfBytesToRead + 1 + CHECKSUM_LENGTH_BYTES;
-    uint8_t completeResponsePacket[7];
+    uint8_t completeResponsePacket[MAX_READ_RESPONSE_SIZE_BYTES];
 
-    EN_RESULT result;
-    do
+    if (totalResponsePacketSizeBytes > MAX_READ_RESPONSE_SIZE_BYTES)
     {
-        result = I2cRead(ATMEL_ATSHA204A_DEVICE_ADDRESS,
-                         0,
-                         EI2cSubAddressMode_None,
-                         totalResponsePacketSizeBytes,
-                         (uint8_t*)&completeResponsePacket);
-    } while (EN_FAILED(result));
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    // The device does not acknowledge its address while it is executing the command
+    EN_RETURN_IF_FAILED(DevicePoll_ReadWhenReady(ATMEL_ATSHA204A_DEVICE_ADDRESS,
+                                                 0,
+                                                 EI2cSubAddressMode_None,
+                                                 totalResponsePacketSizeBytes,
+                                                 (uint8_t*)&completeResponsePacket,
+                                                 pPollTiming,
+                                                 NULL));
 
 
     uint8_t responseSize = completeResponsePacket[STATUS_RESPONSE_COUNT_BYTE_INDEX];
 
-    if (responseSize != totalResponsePacketSizeBytes && responseSize == STATUS_RESPONSE_BLOCK_SIZE_BYTES)
+    // A status block is returned by commands which only respond with a status, and by all commands which fail
+    if (responseSize == STATUS_RESPONSE_BLOCK_SIZE_BYTES)
+    {
+        EN_RETURN_IF_FAILED(AtmelAtsha20a4_CheckCommandResponseBlock(completeResponsePacket));
+    }
+
+    if (responseSize != totalResponsePacketSizeBytes)
     {
-        return AtmelAtsha20a4_CheckCommandResponseBlock(completeResponsePacket);
+        return EN_ERROR_ATSHA204A_INVALID_RESPONSE_SIZE;
     }
 
     EN_RETURN_IF_FAILED(AtmelAtsha20a4_CheckResponseCrc((uint8_t*)&completeResponsePacket));
@@ -524,21 +675,77 @@ EN_RESULT AtmelAtsha204a_ReadDataResponse(uint8_t numberOfBytesToRead, uint8_t*
 }
 
 
+/**
+ * \brief Check whether the device stays awake long enough before the watchdog puts it to sleep.
+ *
+ * The time since the wake token, which includes the wake itself (tWHI and polling for the status block), counts
+ * against the watchdog window.
+ *
+ * @param[in] requiredMicroseconds	Time for which the device has to stay awake, in addition to the margin
+ * @return							True if the time fits into the rest of the watchdog window
+ */
+bool AtmelAtsha204a_FitsWatchdogWindow(uint32_t requiredMicroseconds)
+{
+    uint64_t awakeMicroseconds = GetTimeMicroseconds() - g_atmelAtsha204aWakeTimeMicroseconds;
+
+    return awakeMicroseconds + requiredMicroseconds + ATMEL_ATSHA204A_WATCHDOG_MARGIN_MILLISECONDS * 1000ULL <
+           ATMEL_ATSHA204A_WATCHDOG_MILLISECONDS * 1000ULL;
+}
+
+
+/**
+ * \brief Put the device to sleep and wake it again if the watchdog is about to put it to sleep.
+ *
+ * The watchdog puts the device to sleep a fixed time after the wake token, regardless of the commands executed in
+ * the meantime; only a sleep/wake cycle restarts it.
+ *
+ * @param[in] requiredMicroseconds	Time for which the device has to stay awake, in addition to the margin
+ * @return							EN_RESULT code; EN_ERROR_ATSHA204A_WATCHDOG_WINDOW_EXCEEDED if the time does not
+ *									fit into the watchdog window even after a new wake
+ */
+EN_RESULT AtmelAtsha204a_RenewSession(uint32_t requiredMicroseconds)
+{
+    if (!AtmelAtsha204a_FitsWatchdogWindow(requiredMicroseconds))
+    {
+        AtmelAtsha204a_Sleep();
+        EN_RETURN_IF_FAILED(AtmelAtsha204a_Wake(true));
+
+        // The wake has used part of the new window.
+        if (!AtmelAtsha204a_FitsWatchdogWindow(requiredMicroseconds))
+        {
+            return EN_ERROR_ATSHA204A_WATCHDOG_WINDOW_EXCEEDED;
+        }
+    }
+
+    return EN_SUCCESS;
+}
+
+
 /**
  * \brief Send a command to the device.
  *
  * @param[in] pCommandPacket			Command packet
  * @param[in] commandPacketLengthBytes		Length of the command packet
+ * @param[in] executionMicroseconds		Maximum execution time of the command
  * @return								EN_RESULT code
  */
-EN_RESULT AtmelAtsha204a_SendCommand(const uint8_t* pCommandPacket, uint8_t commandPacketLengthBytes)
+EN_RESULT AtmelAtsha204a_SendCommand(const uint8_t* pCommandPacket,
+                                     uint8_t commandPacketLengthBytes,
+                                     uint32_t executionMicroseconds)
 {
     if (pCommandPacket == NULL)
     {
         return EN_ERROR_NULL_POINTER;
     }
 
-    AtmelAtsha204a_Wake(true);
+    if (g_atmelAtsha204aSessionDepth != 0)
+    {
+        EN_RETURN_IF_FAILED(AtmelAtsha204a_RenewSession(executionMicroseconds));
+    }
+    else
+    {
+        EN_RETURN_IF_FAILED(AtmelAtsha204a_Wake(true));
+    }
 
     EN_RETURN_IF_FAILED(I2cWrite(ATMEL_ATSHA204A_DEVICE_ADDRESS,
                                  EPacketFunction_Command,
@@ -550,6 +757,309 @@ EN_RESULT AtmelAtsha204a_SendCommand(const uint8_t* pCommandPacket, uint8_t comm
 }
 
 
+/**
+ * \brief Look up the execution time of a command.
+ *
+ * @param[in] command	Command opcode
+ * @return				The execution time, or NULL if the opcode is unknown
+ */
+const AtmelAtsha204aExecutionTime_t* AtmelAtsha204a_GetExecutionTime(ECommand_t command)
+{
+    unsigned int index;
+    for (index = 0; index < sizeof(ATMEL_ATSHA204A_EXECUTION_TIMES) / sizeof(ATMEL_ATSHA204A_EXECUTION_TIMES[0]);
+         index++)
+    {
+        if (ATMEL_ATSHA204A_EXECUTION_TIMES[index].command == command)
+        {
+            return &ATMEL_ATSHA204A_EXECUTION_TIMES[index];
+        }
+    }
+
+    return NULL;
+}
+
+
+EN_RESULT AtmelAtsha204a_ExecuteCommand(ECommand_t command,
+                                        uint8_t parameter1,
+                                        uint16_t parameter2,
+                                        uint8_t additionalDataLengthBytes,
+                                        const uint8_t* pAdditionalData,
+                                        uint8_t responseDataLengthBytes,
+                                        uint8_t* pResponseData)
+{
+    if (pResponseData == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    const AtmelAtsha204aExecutionTime_t* pExecutionTime = AtmelAtsha204a_GetExecutionTime(command);
+    uint8_t commandPacketLength = AtmelAtsha204a_GetCommandPacketSize(additionalDataLengthBytes);
+
+    if ((pExecutionTime == NULL) || (commandPacketLength > MAX_COMMAND_PACKET_SIZE_BYTES))
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint8_t commandPacket[MAX_COMMAND_PACKET_SIZE_BYTES];
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_ConstructCommandPacket(command,
+                                                              parameter1,
+                                                              parameter2,
+                                                              additionalDataLengthBytes,
+                                                              pAdditionalData,
+                                                              (uint8_t*)&commandPacket));
+
+    EN_RESULT result =
+        AtmelAtsha204a_SendCommand((uint8_t*)&commandPacket, commandPacketLength, pExecutionTime->maxMicroseconds);
+
+    if (EN_SUCCEEDED(result))
+    {
+        // Most commands complete close to their typical execution time, so the response is first polled for then;
+        // a device which has not responded by the maximum execution time is not going to
+        SleepMicroseconds(pExecutionTime->typicalMicroseconds);
+
+        const DevicePollTiming_t pollTiming = { ATMEL_ATSHA204A_POLL_INITIAL_INTERVAL_MICROSECONDS,
+                                                ATMEL_ATSHA204A_POLL_MAX_INTERVAL_MICROSECONDS,
+                                                pExecutionTime->maxMicroseconds -
+                                                    pExecutionTime->typicalMicroseconds };
+
+        result = AtmelAtsha204a_ReadDataResponse(responseDataLengthBytes, &pollTiming, pResponseData);
+    }
+
+    if (g_atmelAtsha204aSessionDepth == 0)
+    {
+        AtmelAtsha204a_Sleep();
+    }
+
+    return result;
+}
+
+
+EN_RESULT AtmelAtsha204a_ExecuteCommands(AtmelAtsha204aCommand_t* pCommands, unsigned int numberOfCommands)
+{
+    if (pCommands == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    uint32_t pipelineMicroseconds = 0;
+
+    unsigned int index;
+    for (index = 0; index < numberOfCommands; index++)
+    {
+        const AtmelAtsha204aExecutionTime_t* pExecutionTime = AtmelAtsha204a_GetExecutionTime(pCommands[index].command);
+        if (pExecutionTime == NULL)
+        {
+            return EN_ERROR_INVALID_ARGUMENT;
+        }
+
+        pipelineMicroseconds += pExecutionTime->maxMicroseconds;
+        pCommands[index].result = EN_ERROR_ATSHA204A_COMMAND_NOT_EXECUTED;
+    }
+
+    // The pipeline has to fit into a single watchdog window, as TempKey does not survive a sleep/wake cycle. A
+    // pipeline which cannot even fit into a whole window is rejected without waking the device.
+    if (pipelineMicroseconds + ATMEL_ATSHA204A_WAKE_HIGH_TIME_MICROSECONDS +
+            ATMEL_ATSHA204A_WATCHDOG_MARGIN_MILLISECONDS * 1000UL >=
+        ATMEL_ATSHA204A_WATCHDOG_MILLISECONDS * 1000UL)
+    {
+        return EN_ERROR_ATSHA204A_WATCHDOG_WINDOW_EXCEEDED;
+    }
+
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_BeginSession());
+
+    // Budget the pipeline against the rest of the window, after the wake has completed. If it does not fit, the
+    // device is woken again, and the pipeline is rejected if the wake leaves too little of the new window.
+    EN_RESULT result = AtmelAtsha204a_RenewSession(pipelineMicroseconds);
+
+    for (index = 0; (index < numberOfCommands) && EN_SUCCEEDED(result); index++)
+    {
+        AtmelAtsha204aCommand_t* pCommand = &pCommands[index];
+
+        pCommand->result = AtmelAtsha204a_ExecuteCommand(pCommand->command,
+                                                         pCommand->parameter1,
+                                                         pCommand->parameter2,
+                                                         pCommand->additionalDataLengthBytes,
+                                                         (uint8_t*)&pCommand->additionalData,
+                                                         pCommand->responseDataLengthBytes,
+                                                         pCommand->pResponseData);
+        result = pCommand->result;
+    }
+
+    AtmelAtsha204a_EndSession();
+
+    return result;
+}
+
+
+/**
+ * \brief Set up a pipeline command.
+ *
+ * @param[out] pCommand						Command
+ * @param[in] command						Command opcode
+ * @param[in] parameter1					Param 1
+ * @param[in] parameter2					Param 2, in the order of the data sheet
+ * @param[in] responseDataLengthBytes		Number of data bytes of the response; 1 for a status only
+ * @param[out] pResponseData				Buffer to receive the response data; NULL for a status only
+ * @return									EN_RESULT code
+ */
+EN_RESULT AtmelAtsha204a_PrepareCommand(AtmelAtsha204aCommand_t* pCommand,
+                                        ECommand_t command,
+                                        uint8_t parameter1,
+                                        uint16_t parameter2,
+                                        uint8_t responseDataLengthBytes,
+                                        uint8_t* pResponseData)
+{
+    if (pCommand == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    pCommand->command = command;
+    pCommand->parameter1 = parameter1;
+
+    // Param 2 is transmitted with the lower byte first
+    pCommand->parameter2 = (GetLowerByte(parameter2) << 8) | GetUpperByte(parameter2);
+
+    pCommand->additionalDataLengthBytes = 0;
+    pCommand->responseDataLengthBytes = responseDataLengthBytes;
+    pCommand->pResponseData = (pResponseData != NULL) ? pResponseData : &pCommand->status;
+    pCommand->status = 0;
+    pCommand->result = EN_ERROR_ATSHA204A_COMMAND_NOT_EXECUTED;
+
+    return EN_SUCCESS;
+}
+
+
+/**
+ * \brief Append data to the additional data of a pipeline command.
+ *
+ * @param[in,out] pCommand	Command
+ * @param[in] pData			Data to append
+ * @param[in] lengthBytes	The number of bytes to append
+ * @return					EN_RESULT code
+ */
+EN_RESULT AtmelAtsha204a_AppendCommandData(AtmelAtsha204aCommand_t* pCommand, const uint8_t* pData, uint8_t lengthBytes)
+{
+    if (pData == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    if (pCommand->additionalDataLengthBytes + lengthBytes > ATMEL_ATSHA204A_MAX_COMMAND_DATA_SIZE_BYTES)
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    memcpy(&pCommand->additionalData[pCommand->additionalDataLengthBytes], pData, lengthBytes);
+    pCommand->additionalDataLengthBytes += lengthBytes;
+
+    return EN_SUCCESS;
+}
+
+
+EN_RESULT AtmelAtsha204a_PrepareDeviceRevision(AtmelAtsha204aCommand_t* pCommand, uint8_t* pRevision)
+{
+    if (pRevision == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    return AtmelAtsha204a_PrepareCommand(pCommand,
+                                         ECommand_GetDeviceRevision,
+                                         0,
+                                         0,
+                                         ATMEL_ATSHA204A_DEVICE_REVISION_SIZE_BYTES,
+                                         pRevision);
+}
+
+
+EN_RESULT AtmelAtsha204a_PrepareRandom(AtmelAtsha204aCommand_t* pCommand, ERandomMode_t mode, uint8_t* pRandom)
+{
+    if (pRandom == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    return AtmelAtsha204a_PrepareCommand(pCommand,
+                                         ECommand_Random,
+                                         (uint8_t)mode,
+                                         0,
+                                         ATMEL_ATSHA204A_RANDOM_SIZE_BYTES,
+                                         pRandom);
+}
+
+
+EN_RESULT AtmelAtsha204a_PrepareNonce(AtmelAtsha204aCommand_t* pCommand,
+                                      ENonceMode_t mode,
+                                      const uint8_t* pNumIn,
+                                      uint8_t* pRandOut)
+{
+    if (mode == ENonceMode_PassThrough)
+    {
+        // The input is loaded into TempKey unchanged, and only a status is returned
+        EN_RETURN_IF_FAILED(AtmelAtsha204a_PrepareCommand(pCommand, ECommand_Nonce, (uint8_t)mode, 0, 1, NULL));
+
+        return AtmelAtsha204a_AppendCommandData(pCommand, pNumIn, ATMEL_ATSHA204A_NONCE_PASS_THROUGH_INPUT_SIZE_BYTES);
+    }
+
+    if (pRandOut == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_PrepareCommand(pCommand,
+                                                      ECommand_Nonce,
+                                                      (uint8_t)mode,
+                                                      0,
+                                                      ATMEL_ATSHA204A_RANDOM_SIZE_BYTES,
+                                                      pRandOut));
+
+    return AtmelAtsha204a_AppendCommandData(pCommand, pNumIn, ATMEL_ATSHA204A_NONCE_INPUT_SIZE_BYTES);
+}
+
+
+EN_RESULT AtmelAtsha204a_PrepareMac(AtmelAtsha204aCommand_t* pCommand,
+                                    uint8_t mode,
+                                    uint16_t keyId,
+                                    const uint8_t* pChallenge,
+                                    uint8_t* pDigest)
+{
+    if (pDigest == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    EN_RETURN_IF_FAILED(
+        AtmelAtsha204a_PrepareCommand(pCommand, ECommand_Mac, mode, keyId, ATMEL_ATSHA204A_DIGEST_SIZE_BYTES, pDigest));
+
+    // The challenge is only sent if it is not taken from TempKey
+    if ((mode & EMacMode_TempKeyChallenge) == 0)
+    {
+        EN_RETURN_IF_FAILED(
+            AtmelAtsha204a_AppendCommandData(pCommand, pChallenge, ATMEL_ATSHA204A_CHALLENGE_SIZE_BYTES));
+    }
+
+    return EN_SUCCESS;
+}
+
+
+EN_RESULT AtmelAtsha204a_PrepareCheckMac(AtmelAtsha204aCommand_t* pCommand,
+                                         uint8_t mode,
+                                         uint16_t keyId,
+                                         const uint8_t* pClientChallenge,
+                                         const uint8_t* pClientResponse,
+                                         const uint8_t* pOtherData)
+{
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_PrepareCommand(pCommand, ECommand_CheckMac, mode, keyId, 1, NULL));
+
+    EN_RETURN_IF_FAILED(
+        AtmelAtsha204a_AppendCommandData(pCommand, pClientChallenge, ATMEL_ATSHA204A_CHALLENGE_SIZE_BYTES));
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_AppendCommandData(pCommand, pClientResponse, ATMEL_ATSHA204A_DIGEST_SIZE_BYTES));
+
+    return AtmelAtsha204a_AppendCommandData(pCommand, pOtherData, ATMEL_ATSHA204A_CHECK_MAC_OTHER_DATA_SIZE_BYTES);
+}
+
+
 EN_RESULT AtmelAtsha204a_Read(EReadSizeSelect_t sizeSelect,
                               EZoneSelect_t zoneSelect,
                               uint16_t encodedAddress,
@@ -574,12 +1084,9 @@ EN_RESULT AtmelAtsha204a_Read(EReadSizeSelect_t sizeSelect,
     {
         numberOfBytesToRead = 32;
 
-        // Set bit 7 to indicate a 32-byte write. The exception is if we're reading from the OTP zone, for which bit 7
-        // must always be 0.
-        if (zoneSelect != EZoneSelect_Otp)
-        {
-            zone |= 1 << 7;
-        }
+        // Set bit 7 to indicate a 32-byte read. The OTP zone only supports 32-byte reads if it is not in legacy
+        // mode; AtmelAtsha204a_ReadZone() checks this.
+        zone |= 1 << 7;
 
         break;
     }
@@ -594,20 +1101,169 @@ EN_RESULT AtmelAtsha204a_Read(EReadSizeSelect_t sizeSelect,
               encodedAddress);
 #endif
 
-    uint8_t commandPacket[7];
-    AtmelAtsha204a_ConstructCommandPacket(ECommand_Read, zone, encodedAddress, 0, NULL, (uint8_t*)&commandPacket);
+    return AtmelAtsha204a_ExecuteCommand(ECommand_Read, zone, encodedAddress, 0, NULL, numberOfBytesToRead, pReadData);
+}
 
-    EN_RETURN_IF_FAILED(AtmelAtsha204a_SendCommand((uint8_t*)&commandPacket, 7));
 
-#ifndef _DEBUG
-    // Wait for the read command to  be processed.
-    SleepMilliseconds(ATMEL_ATSHA204A_READ_EXECUTION_TIME_MILLISECONDS);
-#endif
+EN_RESULT AtmelAtsha204a_BeginSession()
+{
+    if (g_atmelAtsha204aSessionDepth == 0)
+    {
+        EN_RETURN_IF_FAILED(AtmelAtsha204a_Wake(true));
+    }
+
+    g_atmelAtsha204aSessionDepth++;
+
+    return EN_SUCCESS;
+}
 
-    // Read the response.
-    EN_RETURN_IF_FAILED(AtmelAtsha204a_ReadDataResponse(numberOfBytesToRead, pReadData));
 
-    AtmelAtsha204a_Sleep();
+EN_RESULT AtmelAtsha204a_EndSession()
+{
+    if (g_atmelAtsha204aSessionDepth != 0)
+    {
+        g_atmelAtsha204aSessionDepth--;
+
+        if (g_atmelAtsha204aSessionDepth == 0)
+        {
+            AtmelAtsha204a_Sleep();
+        }
+    }
 
     return EN_SUCCESS;
 }
+
+
+/**
+ * \brief Check whether a slot of a zone may be read with a single 32-byte read.
+ *
+ * @param[in] zone					Zone select
+ * @param[in] slotIndex				Slot select
+ * @param[out] pIsAllowed			True if 32-byte reads are allowed
+ * @return							EN_RESULT code
+ */
+EN_RESULT AtmelAtsha204a_Is32ByteReadAllowed(EZoneSelect_t zone, uint8_t slotIndex, bool* pIsAllowed)
+{
+    switch (zone)
+    {
+    case EZoneSelect_Config:
+    {
+        // The last slot of the configuration zone is shorter than 32 bytes.
+        *pIsAllowed = (slotIndex < CONFIGURATION_ZONE_SIZE_SLOTS - 1);
+        break;
+    }
+    case EZoneSelect_Otp:
+    {
+        if (!g_atmelAtsha204aOtpModeRead)
+        {
+            uint16_t encodedAddress = 0;
+            uint8_t readBuffer[4];
+
+            EN_RETURN_IF_FAILED(
+                AtmelAtsha204a_EncodeAddress(EZoneSelect_Config, 0, OTP_MODE_WORD_OFFSET, &encodedAddress));
+            EN_RETURN_IF_FAILED(
+                AtmelAtsha204a_Read(EReadSizeSelect_4Bytes, EZoneSelect_Config, encodedAddress, (uint8_t*)&readBuffer));
+
+            g_atmelAtsha204aOtpMode = readBuffer[OTP_MODE_WORD_BYTE_INDEX];
+            g_atmelAtsha204aOtpModeRead = true;
+        }
+
+        *pIsAllowed = (g_atmelAtsha204aOtpMode != OTP_MODE_LEGACY);
+        break;
+    }
+    default:
+    {
+        *pIsAllowed = true;
+        break;
+    }
+    }
+
+    return EN_SUCCESS;
+}
+
+
+/**
+ * \brief Read consecutive bytes of a zone, within an open wake session.
+ *
+ * @param[in] zone					Zone select
+ * @param[in] byteAddress			Address of the first byte within the zone
+ * @param[in] numberOfBytes			The number of bytes to read
+ * @param[out] pReadData			Buffer to receive read data
+ * @return							EN_RESULT code
+ */
+EN_RESULT AtmelAtsha204a_ReadZoneInSession(EZoneSelect_t zone,
+                                           uint16_t byteAddress,
+                                           uint16_t numberOfBytes,
+                                           uint8_t* pReadData)
+{
+    while (numberOfBytes != 0)
+    {
+        uint8_t slotIndex = byteAddress / SLOT_SIZE_BYTES;
+        uint8_t slotOffset = byteAddress % SLOT_SIZE_BYTES;
+        uint16_t slotBytes = min(numberOfBytes, SLOT_SIZE_BYTES - slotOffset);
+        uint8_t wordsInSlot = DivideRoundUp(slotOffset % WORD_SIZE_BYTES + slotBytes, WORD_SIZE_BYTES);
+        bool is32ByteReadAllowed = false;
+        uint8_t readBuffer[32];
+        uint8_t readOffset;
+        uint16_t encodedAddress = 0;
+
+        if (wordsInSlot > 1)
+        {
+            EN_RETURN_IF_FAILED(AtmelAtsha204a_Is32ByteReadAllowed(zone, slotIndex, &is32ByteReadAllowed));
+        }
+
+        if (is32ByteReadAllowed)
+        {
+            // Read the whole slot at once.
+            EN_RETURN_IF_FAILED(AtmelAtsha204a_EncodeAddress(zone, slotIndex, 0, &encodedAddress));
+            EN_RETURN_IF_FAILED(
+                AtmelAtsha204a_Read(EReadSizeSelect_32Bytes, zone, encodedAddress, (uint8_t*)&readBuffer));
+
+            readOffset = slotOffset;
+        }
+        else
+        {
+            // Read the word containing the next byte.
+            slotBytes = min(slotBytes, WORD_SIZE_BYTES - slotOffset % WORD_SIZE_BYTES);
+
+            EN_RETURN_IF_FAILED(
+                AtmelAtsha204a_EncodeAddress(zone, slotIndex, slotOffset / WORD_SIZE_BYTES, &encodedAddress));
+            EN_RETURN_IF_FAILED(
+                AtmelAtsha204a_Read(EReadSizeSelect_4Bytes, zone, encodedAddress, (uint8_t*)&readBuffer));
+
+            readOffset = slotOffset % WORD_SIZE_BYTES;
+        }
+
+        unsigned int byteIndex;
+        for (byteIndex = 0; byteIndex < slotBytes; byteIndex++)
+        {
+            pReadData[byteIndex] = readBuffer[readOffset + byteIndex];
+        }
+
+        pReadData += slotBytes;
+        byteAddress += slotBytes;
+        numberOfBytes -= slotBytes;
+    }
+
+    return EN_SUCCESS;
+}
+
+
+EN_RESULT AtmelAtsha204a_ReadZone(EZoneSelect_t zone,
+                                  uint16_t byteAddress,
+                                  uint16_t numberOfBytes,
+                                  uint8_t* pReadData)
+{
+    if (pReadData == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_BeginSession());
+
+    EN_RESULT result = AtmelAtsha204a_ReadZoneInSession(zone, byteAddress, numberOfBytes, pReadData);
+
+    AtmelAtsha204a_EndSession();
+
+    return result;
+}
@@ -34,11 +34,66 @@
 // Constants
 //-------------------------------------------------------------------------------------------------
 
-/// The number of milliseconds it takes for the device to come out of sleep mode
-#define ATMEL_ATSHA204A_WAKE_TIME_MILLISECONDS (500)
+/// Time after the wake token before the device communicates (tWHI); the status block is then polled for
+#define ATMEL_ATSHA204A_WAKE_HIGH_TIME_MICROSECONDS (2500)
 
-/// Average time for the read command to complete, after which polling should start
-#define ATMEL_ATSHA204A_READ_EXECUTION_TIME_MILLISECONDS (1)
+/// Interval between the first two polls for a response; the interval doubles up to the maximum
+#define ATMEL_ATSHA204A_POLL_INITIAL_INTERVAL_MICROSECONDS (100)
+#define ATMEL_ATSHA204A_POLL_MAX_INTERVAL_MICROSECONDS (2000)
+
+/// Time after which polling for the status block after wake gives up
+#define ATMEL_ATSHA204A_WAKE_POLL_TIMEOUT_MICROSECONDS (10000)
+
+/// Minimum time after the wake token after which the watchdog puts the device to sleep (tWATCHDOG)
+#define ATMEL_ATSHA204A_WATCHDOG_MILLISECONDS (700)
+
+/// Time left in the watchdog window below which a wake session is renewed by a sleep/wake cycle before a command
+#define ATMEL_ATSHA204A_WATCHDOG_MARGIN_MILLISECONDS (50)
+
+/// Largest amount of command data, that of the CheckMac command: client challenge, client response and other data
+#define ATMEL_ATSHA204A_MAX_COMMAND_DATA_SIZE_BYTES (32 + 32 + 13)
+
+/// Command data and response sizes
+#define ATMEL_ATSHA204A_DEVICE_REVISION_SIZE_BYTES (4)
+#define ATMEL_ATSHA204A_RANDOM_SIZE_BYTES (32)
+#define ATMEL_ATSHA204A_NONCE_INPUT_SIZE_BYTES (20)
+#define ATMEL_ATSHA204A_NONCE_PASS_THROUGH_INPUT_SIZE_BYTES (32)
+#define ATMEL_ATSHA204A_CHALLENGE_SIZE_BYTES (32)
+#define ATMEL_ATSHA204A_DIGEST_SIZE_BYTES (32)
+#define ATMEL_ATSHA204A_CHECK_MAC_OTHER_DATA_SIZE_BYTES (13)
+
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief A command of a pipeline run by AtmelAtsha204a_ExecuteCommands(), set up by one of the
+ * AtmelAtsha204a_Prepare...() functions.
+ */
+typedef struct
+{
+    ECommand_t command;
+    uint8_t parameter1;
+
+    /// Param 2, with the bytes swapped as expected by the command packet construction
+    uint16_t parameter2;
+
+    uint8_t additionalDataLengthBytes;
+    uint8_t additionalData[ATMEL_ATSHA204A_MAX_COMMAND_DATA_SIZE_BYTES];
+
+    /// Number of data bytes of the response, without count and checksum
+    uint8_t responseDataLengthBytes;
+
+    /// Buffer to receive the response data
+    uint8_t* pResponseData;
+
+    /// Status byte of commands which only respond with a status
+    uint8_t status;
+
+    /// Result of the command; EN_ERROR_ATSHA204A_COMMAND_NOT_EXECUTED if an earlier command failed
+    EN_RESULT result;
+} AtmelAtsha204aCommand_t;
 
 
 //-------------------------------------------------------------------------------------------------
@@ -50,6 +105,28 @@
 // Function declarations
 //-------------------------------------------------------------------------------------------------
 
+/**
+ * \brief Calculate the CRC-16 (polynomial 0x8005, without remainder reflection) used by the device.
+ *
+ * @param pData				The data to calculate the CRC for
+ * @param dataLengthBytes	The number of bytes to process
+ * @return					The CRC
+ */
+uint16_t AtmelAtsha204a_CalculateCrc(const uint8_t* pData, uint8_t dataLengthBytes);
+
+
+/**
+ * \brief Continue a CRC over further data, so that a packet can be checksummed piece by piece as it is built or
+ * received. Starting from 0, the result over all pieces equals AtmelAtsha204a_CalculateCrc() over the whole packet.
+ *
+ * @param crc				The CRC of the preceding data, 0 at the start of a packet
+ * @param pData				The data to continue the CRC over
+ * @param dataLengthBytes	The number of bytes to process
+ * @return					The CRC
+ */
+uint16_t AtmelAtsha204a_UpdateCrc(uint16_t crc, const uint8_t* pData, uint16_t dataLengthBytes);
+
+
 /**
  * \brief Wake the device by setting I2C SDA low for the required time period.
  *
@@ -84,6 +161,124 @@ EN_RESULT AtmelAtsha204a_EncodeAddress(EZoneSelect_t zone,
                                        uint16_t* encodedAddress);
 
 
+/**
+ * \brief Send a command to the device and read its response.
+ *
+ * The response is first polled for after the typical execution time of the command, at growing intervals, and the
+ * poll gives up with EN_ERROR_TIMEOUT once the maximum execution time of the command has passed. Unless a wake
+ * session is open, the device is woken before the command and put to sleep afterwards.
+ *
+ * @param[in] command					Command opcode
+ * @param[in] parameter1				Param 1
+ * @param[in] parameter2				Param 2
+ * @param[in] additionalDataLengthBytes	Number of additional data bytes of the command
+ * @param[in] pAdditionalData			Additional data of the command; may be NULL if there is none
+ * @param[in] responseDataLengthBytes	Number of data bytes of the response, without count and checksum
+ * @param[out] pResponseData			Buffer to receive the response data
+ * @return								Result code
+ */
+EN_RESULT AtmelAtsha204a_ExecuteCommand(ECommand_t command,
+                                        uint8_t parameter1,
+                                        uint16_t parameter2,
+                                        uint8_t additionalDataLengthBytes,
+                                        const uint8_t* pAdditionalData,
+                                        uint8_t responseDataLengthBytes,
+                                        uint8_t* pResponseData);
+
+
+/**
+ * \brief Run a pipeline of commands in a single wake window, without putting the device to sleep in between.
+ *
+ * If the remaining watchdog window is too short for the maximum execution time of all commands, the device is put to
+ * sleep and woken once before the first command, so that TempKey, which is cleared by sleep, lasts for the whole
+ * pipeline. The time taken by the wake counts against the window. The response of each command is checked for its
+ * CRC and status. The pipeline stops at the first command which fails; the result of each command is stored with it.
+ *
+ * @param[in,out] pCommands		Commands, set up by the AtmelAtsha204a_Prepare...() functions
+ * @param[in] numberOfCommands	The number of commands
+ * @return						Result code; the result of the first command which failed, or
+ *								EN_ERROR_ATSHA204A_WATCHDOG_WINDOW_EXCEEDED if the pipeline does not fit into the
+ *								window left after a wake; split it into pipelines which do not share TempKey
+ */
+EN_RESULT AtmelAtsha204a_ExecuteCommands(AtmelAtsha204aCommand_t* pCommands, unsigned int numberOfCommands);
+
+
+/**
+ * \brief Set up a DevRev command, which reads the device revision.
+ *
+ * @param[out] pCommand		Command
+ * @param[out] pRevision	Buffer to receive the ATMEL_ATSHA204A_DEVICE_REVISION_SIZE_BYTES revision bytes
+ * @return					Result code
+ */
+EN_RESULT AtmelAtsha204a_PrepareDeviceRevision(AtmelAtsha204aCommand_t* pCommand, uint8_t* pRevision);
+
+
+/**
+ * \brief Set up a Random command, which generates a random number.
+ *
+ * @param[out] pCommand		Command
+ * @param[in] mode			Whether to update the seed
+ * @param[out] pRandom		Buffer to receive the ATMEL_ATSHA204A_RANDOM_SIZE_BYTES random bytes
+ * @return					Result code
+ */
+EN_RESULT AtmelAtsha204a_PrepareRandom(AtmelAtsha204aCommand_t* pCommand, ERandomMode_t mode, uint8_t* pRandom);
+
+
+/**
+ * \brief Set up a Nonce command, which loads TempKey for a following MAC or CheckMac command.
+ *
+ * @param[out] pCommand		Command
+ * @param[in] mode			Nonce mode
+ * @param[in] pNumIn		ATMEL_ATSHA204A_NONCE_INPUT_SIZE_BYTES input bytes, or
+ *							ATMEL_ATSHA204A_NONCE_PASS_THROUGH_INPUT_SIZE_BYTES in pass-through mode
+ * @param[out] pRandOut		Buffer to receive the ATMEL_ATSHA204A_RANDOM_SIZE_BYTES random bytes which were combined
+ *							with the input; NULL in pass-through mode
+ * @return					Result code
+ */
+EN_RESULT AtmelAtsha204a_PrepareNonce(AtmelAtsha204aCommand_t* pCommand,
+                                      ENonceMode_t mode,
+                                      const uint8_t* pNumIn,
+                                      uint8_t* pRandOut);
+
+
+/**
+ * \brief Set up a MAC command, which computes a SHA-256 digest of a key, a challenge and device data.
+ *
+ * @param[out] pCommand		Command
+ * @param[in] mode			Combination of EMacMode_t bits
+ * @param[in] keyId			Data slot of the key
+ * @param[in] pChallenge	ATMEL_ATSHA204A_CHALLENGE_SIZE_BYTES challenge bytes; NULL if TempKey is the challenge
+ * @param[out] pDigest		Buffer to receive the ATMEL_ATSHA204A_DIGEST_SIZE_BYTES digest bytes
+ * @return					Result code
+ */
+EN_RESULT AtmelAtsha204a_PrepareMac(AtmelAtsha204aCommand_t* pCommand,
+                                    uint8_t mode,
+                                    uint16_t keyId,
+                                    const uint8_t* pChallenge,
+                                    uint8_t* pDigest);
+
+
+/**
+ * \brief Set up a CheckMac command, which verifies the response of another device to a challenge. The command
+ * fails with EN_ERROR_ATSHA204A_INVALID_MAC if the response does not match.
+ *
+ * @param[out] pCommand			Command
+ * @param[in] mode				Combination of EMacMode_t bits
+ * @param[in] keyId				Data slot of the key
+ * @param[in] pClientChallenge	ATMEL_ATSHA204A_CHALLENGE_SIZE_BYTES challenge bytes sent to the other device
+ * @param[in] pClientResponse	ATMEL_ATSHA204A_DIGEST_SIZE_BYTES response bytes of the other device
+ * @param[in] pOtherData		ATMEL_ATSHA204A_CHECK_MAC_OTHER_DATA_SIZE_BYTES bytes of the other device's MAC
+ *								message
+ * @return						Result code
+ */
+EN_RESULT AtmelAtsha204a_PrepareCheckMac(AtmelAtsha204aCommand_t* pCommand,
+                                         uint8_t mode,
+                                         uint16_t keyId,
+                                         const uint8_t* pClientChallenge,
+                                         const uint8_t* pClientResponse,
+                                         const uint8_t* pOtherData);
+
+
 /**
  * \brief Read from the device.
  *
@@ -97,3 +292,41 @@ EN_RESULT AtmelAtsha204a_Read(EReadSizeSelect_t sizeSelect,
                               EZoneSelect_t zoneSelect,
                               uint16_t encodedAddress,
                               uint8_t* pReadData);
+
+
+/**
+ * \brief Wake the device and keep it awake until AtmelAtsha204a_EndSession() is called.
+ *
+ * While a session is open, commands are sent without waking the device, and reads do not put it to sleep. If the
+ * watchdog window is about to expire, the device is put to sleep and woken again before the next command. Sessions
+ * may be nested; only the outermost one wakes the device and puts it to sleep.
+ *
+ * @return	Result code
+ */
+EN_RESULT AtmelAtsha204a_BeginSession();
+
+
+/**
+ * \brief End a wake session, putting the device to sleep when the outermost session ends.
+ *
+ * @return	Result code
+ */
+EN_RESULT AtmelAtsha204a_EndSession();
+
+
+/**
+ * \brief Read consecutive bytes of a zone in a single wake session.
+ *
+ * Whole slots are read with 32-byte reads where the zone allows it: the configuration zone except its last, shorter
+ * slot, the data zone, and the OTP zone unless it is in legacy mode. Other bytes are read with 4-byte reads.
+ *
+ * @param[in] zone				Zone select
+ * @param[in] byteAddress		Address of the first byte within the zone
+ * @param[in] numberOfBytes		The number of bytes to read
+ * @param[out] pReadData		Buffer to receive read data
+ * @return						Result code
+ */
+EN_RESULT AtmelAtsha204a_ReadZone(EZoneSelect_t zone,
+                                  uint16_t byteAddress,
+                                  uint16_t numberOfBytes,
+                                  uint8_t* pReadData);
@@ -83,6 +83,56 @@ typedef enum
 } EZoneSelect_t;
 
 
+/// Random command mode
+typedef enum
+{
+    /// Update the random number seed in EEPROM before generating the number
+    ERandomMode_UpdateSeed = 0x00,
+
+    /// Generate the number without updating the seed
+    ERandomMode_NoSeedUpdate = 0x01
+} ERandomMode_t;
+
+
+/// Nonce command mode
+typedef enum
+{
+    /// Combine a 20-byte input with a random number generated after updating the seed
+    ENonceMode_UpdateSeed = 0x00,
+
+    /// Combine a 20-byte input with a random number generated without updating the seed
+    ENonceMode_NoSeedUpdate = 0x01,
+
+    /// Load a 32-byte input into TempKey unchanged
+    ENonceMode_PassThrough = 0x03
+} ENonceMode_t;
+
+
+/**
+ * \brief Mode bits of the MAC and CheckMac commands, selecting the contents of the message digested by the device.
+ */
+typedef enum
+{
+    /// The second 32 bytes are TempKey rather than the challenge
+    EMacMode_TempKeyChallenge = 0x01,
+
+    /// The first 32 bytes are TempKey rather than the key in the given slot
+    EMacMode_TempKeyKey = 0x02,
+
+    /// Expected TempKey source flag if TempKey is used: set for a pass-through nonce, cleared for a random nonce
+    EMacMode_TempKeySourceInput = 0x04,
+
+    /// Include the first 88 OTP bits (MAC only)
+    EMacMode_IncludeOtp88Bits = 0x10,
+
+    /// Include the first 64 OTP bits
+    EMacMode_IncludeOtp64Bits = 0x20,
+
+    /// Include the serial number bytes SN[2:3] and SN[4:7] (MAC only)
+    EMacMode_IncludeSerialNumber = 0x40
+} EMacMode_t;
+
+
 /**
  * \brief Command opcodes.
  */
@@ -79,7 +79,14 @@ typedef enum EN_RESULT
     EN_ERROR_RTC_FEATURE_NOT_SUPPORTED,
     EN_ERROR_RTC_NOT_WORKING,
     EN_ERROR_IOTEST_FAILED,
-    EN_ERROR_SUPPLY_OUT_OF_RANGE
+    EN_ERROR_SUPPLY_OUT_OF_RANGE,
+    EN_ERROR_FAILED_TO_INITIALISE_COMPLETION,
+    EN_ERROR_TIMEOUT,
+    EN_ERROR_I2C_QUEUE_FULL,
+    EN_ERROR_MODULE_IDENTITY_SNAPSHOT_INVALID,
+    EN_ERROR_ATSHA204A_COMMAND_NOT_EXECUTED,
+    EN_ERROR_UNKNOWN_MODULE_FAMILY,
+    EN_ERROR_ATSHA204A_WATCHDOG_WINDOW_EXCEEDED
 
 } EN_RESULT;
 
@@ -27,6 +27,7 @@
 #include "InterruptController.h"
 #include "I2cInterfaceVariables.h"
 #include "TimerInterfaceVariables.h"
+#include "TimerInterface.h"
 
 #include <xil_exception.h>
 #include <xscugic.h>
@@ -85,6 +86,17 @@ EN_RESULT SetupInterruptSystem()
     // Enable the interrupts for the IIC device.
     XScuGic_Enable(&g_interruptController, IIC_INTR_ID);
 
+#if defined(__arm__)
+    // Connect the one-shot wake-up timer of time-limited waits (see InitialiseTimer()).
+    RETURN_IF_XILINX_CALL_FAILED(XScuGic_Connect(&g_interruptController,
+                                                 TIMER_INTR_ID,
+                                                 (Xil_InterruptHandler)TimerWakeUpHandler,
+                                                 &g_privateTimer),
+                                 EN_ERROR_FAILED_TO_INITIALISE_INTERRUPT_CONTROLLER);
+
+    XScuGic_Enable(&g_interruptController, TIMER_INTR_ID);
+#endif
+
     // INSERT ANY FURTHER INTERRUPT ENABLES HERE //
 
     // Enable non-critical exceptions.
@@ -92,3 +104,22 @@ EN_RESULT SetupInterruptSystem()
 
     return EN_SUCCESS;
 }
+
+uint32_t DisableInterrupts()
+{
+    // The IRQ mask bit is set if interrupts are currently disabled.
+    uint32_t previousState = mfcpsr() & XIL_EXCEPTION_IRQ;
+
+    Xil_ExceptionDisable();
+
+    return previousState;
+}
+
+void RestoreInterrupts(uint32_t previousState)
+{
+    // Only re-enable interrupts if they were enabled when the critical section was entered.
+    if ((previousState & XIL_EXCEPTION_IRQ) == 0)
+    {
+        Xil_ExceptionEnable();
+    }
+}
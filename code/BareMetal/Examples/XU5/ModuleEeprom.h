@@ -31,6 +31,46 @@
 #include "StandardIncludes.h"
 
 
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/// Marks a stored module identity snapshot
+#define MODULE_IDENTITY_SNAPSHOT_MAGIC 0x4D494453
+
+/**
+ * \brief Module identity read from the module EEPROM.
+ *
+ * The snapshot is kept after the EEPROM has been read, so that the next Eeprom_Read() only needs to read the
+ * serial number to check that the module is the same. It may be kept in RAM which is retained over a reset (see
+ * MODULE_IDENTITY_SNAPSHOT_SECTION in ModuleEeprom.c), or saved to a file with Eeprom_GetIdentitySnapshot()
+ * and restored with Eeprom_SetIdentitySnapshot().
+ */
+typedef struct
+{
+	/// MODULE_IDENTITY_SNAPSHOT_MAGIC once the snapshot is complete
+	uint32_t magic;
+
+	/// Device address of the module EEPROM the snapshot has been read from
+	uint8_t eepromDeviceAddress;
+
+	/// Module serial number
+	uint32_t serialNumber;
+
+	/// Raw product number
+	uint32_t productNumber;
+
+	/// Module MAC address 0
+	uint64_t macAddress;
+
+	/// Raw module configuration data, as long as the longest configuration of all module families
+	uint8_t configData[MAX_CONFIG_PROPERTIES_LENGTH_BYTES];
+
+	/// CRC-16 of the snapshot up to this field
+	uint16_t checksum;
+} ModuleIdentitySnapshot_t;
+
+
 //-------------------------------------------------------------------------------------------------
 // EEPROM function declarations
 //-------------------------------------------------------------------------------------------------
@@ -71,6 +111,43 @@ EN_RESULT Eeprom_GetModuleInfo(uint32_t* pSerialNumber,
 		uint64_t* pMacAddress);
 
 
+/**
+ * \brief Get the name of the module family, selected at runtime from the product number.
+ *
+ * @return	Module name, or NULL if the product number has not been read or the module family is not known
+ */
+const char* Eeprom_GetModuleName();
+
+
+/**
+ * \brief Get the number of configuration properties of the module family.
+ *
+ * @return	The number of properties, or zero if the product number has not been read or the module family is not
+ *			known
+ */
+uint8_t Eeprom_GetModuleConfigPropertyCount();
+
+
+/**
+ * \brief Get the module identity snapshot, e.g. to save it to a file.
+ *
+ * @param[out] pSnapshot		Snapshot
+ * @return						Result code; EN_ERROR_MODULE_IDENTITY_SNAPSHOT_INVALID if the EEPROM has not been
+ *								read yet
+ */
+EN_RESULT Eeprom_GetIdentitySnapshot(ModuleIdentitySnapshot_t* pSnapshot);
+
+
+/**
+ * \brief Restore a module identity snapshot, e.g. from a file, before calling Eeprom_Read().
+ *
+ * The snapshot is only used if its checksum is valid and the serial number matches the one in the EEPROM.
+ *
+ * @param pSnapshot			Snapshot
+ * @return					Result code
+ */
+EN_RESULT Eeprom_SetIdentitySnapshot(const ModuleIdentitySnapshot_t* pSnapshot);
+
 
 /**
  * \brief Print the module configuration properties.
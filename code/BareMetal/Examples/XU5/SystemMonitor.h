@@ -28,6 +28,28 @@
 
 #include "StandardIncludes.h"
 
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/// Number of voltage channels of the system monitor
+#define SYSTEM_MONITOR_NUMBER_OF_VOLTAGE_CHANNELS 7
+
+/**
+ * \brief Readings of all system monitor channels, taken by SystemMonitor_ReadAllChannels().
+ */
+typedef struct
+{
+	/// Raw readings of the voltage channels (10 bits, 2.5 mV per LSB)
+	uint16_t values[SYSTEM_MONITOR_NUMBER_OF_VOLTAGE_CHANNELS];
+
+	/// Voltages at the channel inputs in millivolts, without any voltage divider
+	int inputVoltages[SYSTEM_MONITOR_NUMBER_OF_VOLTAGE_CHANNELS];
+
+	/// Temperature in millidegrees Celsius
+	int temperatureMilliCelsius;
+} SystemMonitorReadings_t;
+
 //-------------------------------------------------------------------------------------------------
 // Function declarations
 //-------------------------------------------------------------------------------------------------
@@ -69,3 +91,32 @@ EN_RESULT SystemMonitor_ReadVoltage(uint16_t channel, int* pVoltage, int RUpper,
  * @return					Result code
  */
 EN_RESULT SystemMonitor_ReadCurrent(uint16_t channel, int* pCurrent, int RShunt, int vRef);
+
+/**
+ * \brief Read all voltage channels and the temperature from the system monitor, with one I2C read per value
+ * register, and convert them.
+ *
+ * @param[out] pReadings	Pointer to structure to receive the readings
+ * @return					Result code
+ */
+EN_RESULT SystemMonitor_ReadAllChannels(SystemMonitorReadings_t* pReadings);
+
+/**
+ * \brief Convert a raw reading to a voltage in millivolt
+ *
+ * @param[in] value			Raw reading, as in SystemMonitorReadings_t
+ * @param[in] RUpper		Voltage divider upper resistor (0 if no divider is used) in milliohms
+ * @param[in] RLower		Voltage divider lower resistor (1 if no divider is used) in milliohms
+ * @return					Voltage in millivolt
+ */
+int SystemMonitor_ConvertVoltage(uint16_t value, int RUpper, int RLower);
+
+/**
+ * \brief Convert a raw reading of a current sense channel to a current in milliampere
+ *
+ * @param[in] value			Raw reading, as in SystemMonitorReadings_t
+ * @param[in] RShunt		Shunt resistor value in milliohms
+ * @param[in] vRef			Reference Voltage of INA199A2 current sensor
+ * @return					Current in milliampere
+ */
+int SystemMonitor_ConvertCurrent(uint16_t value, int RShunt, int vRef);
@@ -28,19 +28,34 @@
 
 #include "StandardIncludes.h"
 
+#if SYSTEM != LINUX_USERSPACE
 #include <xparameters.h>
+#if defined(__arm__)
+#include <xscutimer.h>
+#endif
+#endif
 
 //-------------------------------------------------------------------------------------------------
 // Definitions and constants
 //-------------------------------------------------------------------------------------------------
 
-// no defines needed for Xilinx SOC
+#if defined(__arm__) && SYSTEM != LINUX_USERSPACE
+
+/// Device ID of the Cortex-A9 private timer
+#define TIMER_DEVICE_ID XPAR_XSCUTIMER_0_DEVICE_ID
+
+/// Interrupt ID of the Cortex-A9 private timer
+#define TIMER_INTR_ID XPAR_SCUTIMER_INTR
+
+#endif
 
 //-------------------------------------------------------------------------------------------------
 // Global variable declarations
 //-------------------------------------------------------------------------------------------------
 
-// no defines needed for Xilinx SOC
+#if defined(__arm__) && SYSTEM != LINUX_USERSPACE
+extern XScuTimer g_privateTimer;
+#endif
 
 
 
@@ -0,0 +1,189 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "DevicePoll.h"
+#include "TimerInterface.h"
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Context of DevicePoll_WaitForRegister().
+ */
+typedef struct
+{
+    uint8_t deviceAddress;
+    uint16_t registerAddress;
+    EI2cSubAddressMode_t subAddressMode;
+    uint8_t mask;
+    uint8_t expectedValue;
+
+    /// Last value read from the register
+    uint8_t value;
+} DevicePollRegisterContext_t;
+
+/**
+ * \brief Context of DevicePoll_ReadWhenReady().
+ */
+typedef struct
+{
+    uint8_t deviceAddress;
+    uint16_t subAddress;
+    EI2cSubAddressMode_t subAddressMode;
+    uint32_t numberOfBytes;
+    uint8_t* pBuffer;
+} DevicePollReadContext_t;
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+EN_RESULT DevicePoll_Wait(DevicePollCondition_t pCondition,
+                          void* pContext,
+                          const DevicePollTiming_t* pTiming,
+                          uint32_t* pElapsedMicroseconds)
+{
+    if ((pCondition == NULL) || (pTiming == NULL))
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    uint64_t startTime = GetTimeMicroseconds();
+    uint32_t intervalMicroseconds = pTiming->initialIntervalMicroseconds;
+    bool timedOut = false;
+    bool conditionMet = false;
+    EN_RESULT result;
+
+    while (true)
+    {
+        result = pCondition(pContext, &conditionMet);
+        if (EN_FAILED(result) || conditionMet || timedOut)
+        {
+            break;
+        }
+
+        SleepMicroseconds(intervalMicroseconds);
+
+        intervalMicroseconds *= 2;
+        if (intervalMicroseconds > pTiming->maxIntervalMicroseconds)
+        {
+            intervalMicroseconds = pTiming->maxIntervalMicroseconds;
+        }
+
+        // Check the condition once more after the deadline, as the sleep may have taken longer than expected
+        timedOut = (GetTimeMicroseconds() - startTime) >= pTiming->timeoutMicroseconds;
+    }
+
+    if (pElapsedMicroseconds != NULL)
+    {
+        *pElapsedMicroseconds = (uint32_t)(GetTimeMicroseconds() - startTime);
+    }
+
+    if (EN_SUCCEEDED(result) && !conditionMet)
+    {
+        result = EN_ERROR_TIMEOUT;
+    }
+
+    return result;
+}
+
+/**
+ * \brief Condition of DevicePoll_WaitForRegister(): the bits of the mask have the expected value.
+ *
+ * \param	pContext			Poll context (DevicePollRegisterContext_t)
+ * \param[out]	pConditionMet	True if the bits have the expected value
+ * \returns						Result code
+ */
+EN_RESULT DevicePoll_IsRegisterValue(void* pContext, bool* pConditionMet)
+{
+    DevicePollRegisterContext_t* pRegisterContext = (DevicePollRegisterContext_t*)pContext;
+
+    EN_RETURN_IF_FAILED(I2cRead(pRegisterContext->deviceAddress,
+                                pRegisterContext->registerAddress,
+                                pRegisterContext->subAddressMode,
+                                1,
+                                &pRegisterContext->value));
+
+    *pConditionMet = (pRegisterContext->value & pRegisterContext->mask) == pRegisterContext->expectedValue;
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT DevicePoll_WaitForRegister(uint8_t deviceAddress,
+                                     uint16_t registerAddress,
+                                     EI2cSubAddressMode_t subAddressMode,
+                                     uint8_t mask,
+                                     uint8_t expectedValue,
+                                     const DevicePollTiming_t* pTiming,
+                                     uint8_t* pValue,
+                                     uint32_t* pElapsedMicroseconds)
+{
+    DevicePollRegisterContext_t context = { deviceAddress, registerAddress, subAddressMode, mask, expectedValue, 0 };
+
+    EN_RESULT result = DevicePoll_Wait(DevicePoll_IsRegisterValue, &context, pTiming, pElapsedMicroseconds);
+
+    if (pValue != NULL)
+    {
+        *pValue = context.value;
+    }
+
+    return result;
+}
+
+/**
+ * \brief Condition of DevicePoll_ReadWhenReady(): the read succeeds. A device which is busy does not acknowledge
+ * its address, or the read fails otherwise; both are retried.
+ *
+ * \param	pContext			Poll context (DevicePollReadContext_t)
+ * \param[out]	pConditionMet	True if the read succeeded
+ * \returns						Result code; always EN_SUCCESS
+ */
+EN_RESULT DevicePoll_IsReadSuccessful(void* pContext, bool* pConditionMet)
+{
+    DevicePollReadContext_t* pReadContext = (DevicePollReadContext_t*)pContext;
+
+    *pConditionMet = EN_SUCCEEDED(I2cRead(pReadContext->deviceAddress,
+                                          pReadContext->subAddress,
+                                          pReadContext->subAddressMode,
+                                          pReadContext->numberOfBytes,
+                                          pReadContext->pBuffer));
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT DevicePoll_ReadWhenReady(uint8_t deviceAddress,
+                                   uint16_t subAddress,
+                                   EI2cSubAddressMode_t subAddressMode,
+                                   uint32_t numberOfBytes,
+                                   uint8_t* pBuffer,
+                                   const DevicePollTiming_t* pTiming,
+                                   uint32_t* pElapsedMicroseconds)
+{
+    DevicePollReadContext_t context = { deviceAddress, subAddress, subAddressMode, numberOfBytes, pBuffer };
+
+    return DevicePoll_Wait(DevicePoll_IsReadSuccessful, &context, pTiming, pElapsedMicroseconds);
+}
@@ -0,0 +1,128 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "StandardIncludes.h"
+#include "I2cInterface.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/// Number of entries in a transaction queue; must be a power of two
+#define I2C_TRANSACTION_QUEUE_LENGTH 16
+
+
+/**
+ * \brief Queue entry.
+ */
+typedef struct
+{
+    /// Sequence number, used to synchronise producers and consumers
+    volatile uint32_t sequence;
+
+    /// Queued transaction; NULL if the transaction has been removed from the queue
+    I2cTransaction_t* volatile pTransaction;
+} I2cTransactionQueueEntry_t;
+
+
+/**
+ * \brief Fixed-size lock-free transaction queue.
+ *
+ * The queue is a bounded multi-producer/multi-consumer ring buffer: each entry carries a sequence number
+ * which tells producers and consumers whether the entry is free or holds a transaction. No locks are
+ * taken and no function waits for another context, so the queue may be used from interrupt context.
+ */
+typedef struct
+{
+    /// Queue entries
+    I2cTransactionQueueEntry_t entries[I2C_TRANSACTION_QUEUE_LENGTH];
+
+    /// Position of the next entry to write
+    volatile uint32_t enqueuePosition;
+
+    /// Position of the next entry to read
+    volatile uint32_t dequeuePosition;
+} I2cTransactionQueue_t;
+
+
+//-------------------------------------------------------------------------------------------------
+// Function declarations
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Initialise a transaction queue. The queue is initially empty.
+ *
+ * @param	pQueue		Transaction queue
+ */
+void I2cTransactionQueue_Initialise(I2cTransactionQueue_t* pQueue);
+
+
+/**
+ * \brief Add a transaction to the end of a queue.
+ *
+ * @param	pQueue			Transaction queue
+ * @param	pTransaction	Transaction to add
+ * @return					True if the transaction was added; false if the queue is full
+ */
+bool I2cTransactionQueue_Push(I2cTransactionQueue_t* pQueue, I2cTransaction_t* pTransaction);
+
+
+/**
+ * \brief Remove the transaction at the front of a queue.
+ *
+ * If the entry at the front of the queue has been removed with I2cTransactionQueue_Remove(), this function
+ * succeeds and sets *ppTransaction to NULL.
+ *
+ * @param	pQueue			Transaction queue
+ * @param	ppTransaction	Receives the transaction
+ * @return					True if an entry was removed; false if the queue is empty
+ */
+bool I2cTransactionQueue_Pop(I2cTransactionQueue_t* pQueue, I2cTransaction_t** ppTransaction);
+
+
+/**
+ * \brief Check whether a queue is empty.
+ *
+ * @param	pQueue		Transaction queue
+ * @return				True if the queue is empty
+ */
+bool I2cTransactionQueue_IsEmpty(I2cTransactionQueue_t* pQueue);
+
+
+/**
+ * \brief Remove a transaction from anywhere in a queue.
+ *
+ * The entry is not freed, but marked as removed; it is skipped when it reaches the front of the queue.
+ * This function must be called with interrupts disabled, on a single-core system.
+ *
+ * @param	pQueue			Transaction queue
+ * @param	pTransaction	Transaction to remove
+ * @return					True if the transaction was found in the queue
+ */
+bool I2cTransactionQueue_Remove(I2cTransactionQueue_t* pQueue, I2cTransaction_t* pTransaction);
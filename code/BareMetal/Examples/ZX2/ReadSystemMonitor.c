@@ -67,18 +67,22 @@ EN_RESULT ReadSystemMonitor()
 		
 			Rshunt = 10;
 		
+			// Read all channels first, then convert them with the divider of each channel.
+			SystemMonitorReadings_t readings;
+			EN_RETURN_IF_FAILED(SystemMonitor_ReadAllChannels(&readings));
+
 			//Read Current Sense VREF Voltage
-			EN_RETURN_IF_FAILED(SystemMonitor_ReadVoltage(6, &vRef, voltReadingSel0[6].VoltageDivResistors[0], voltReadingSel0[6].VoltageDivResistors[1]));
+			vRef = SystemMonitor_ConvertVoltage(readings.values[6], voltReadingSel0[6].VoltageDivResistors[0], voltReadingSel0[6].VoltageDivResistors[1]);
 		
 			for (i = 0; i < 7; i++)
 			{
 				if(i== 5)
 				{
-					EN_RETURN_IF_FAILED(SystemMonitor_ReadCurrent(i, &cBus, Rshunt, vRef));
+					cBus = SystemMonitor_ConvertCurrent(readings.values[i], Rshunt, vRef);
 					EN_PRINTF("%s%-15s%s%d mA\n\r", LEFT_PADDING, voltReadingSel0[i].VoltageLabel, "Current = ", cBus);
 				}
 				else {
-					EN_RETURN_IF_FAILED(SystemMonitor_ReadVoltage(i, &vBus, voltReadingSel0[i].VoltageDivResistors[0], voltReadingSel0[i].VoltageDivResistors[1]));
+					vBus = SystemMonitor_ConvertVoltage(readings.values[i], voltReadingSel0[i].VoltageDivResistors[0], voltReadingSel0[i].VoltageDivResistors[1]);
 					EN_PRINTF("%s%-15s%s%d mV\n\r", LEFT_PADDING, voltReadingSel0[i].VoltageLabel, "Voltage = ", vBus);
 				}
 			}
@@ -94,9 +98,11 @@ EN_RESULT ReadSystemMonitor()
 				{"VCC_P198", {0, 1}}
 			};
 		
+			EN_RETURN_IF_FAILED(SystemMonitor_ReadAllChannels(&readings));
+
 			for (i = 0; i < 4; i++)
 			{
-				EN_RETURN_IF_FAILED(SystemMonitor_ReadVoltage(i, &vBus, voltReadingSel1[i].VoltageDivResistors[0], voltReadingSel1[i].VoltageDivResistors[1]));
+				vBus = SystemMonitor_ConvertVoltage(readings.values[i], voltReadingSel1[i].VoltageDivResistors[0], voltReadingSel1[i].VoltageDivResistors[1]);
 				EN_PRINTF("%s%-15s%s%d mV\n\r", LEFT_PADDING, voltReadingSel1[i].VoltageLabel, "Voltage = ", vBus);
 		
 			}
@@ -0,0 +1,246 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "StandardIncludes.h"
+#include "ErrorCodes.h"
+#include "I2cInterface.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/// Value of RegisterMap_t::currentPage while the selected page is unknown
+#define REGISTER_MAP_PAGE_UNKNOWN (-1)
+
+/// Flag of a register whose value in the cache is the value in the device
+#define REGISTER_MAP_FLAG_VALID 0x01
+
+/// Flag of a register which has been written to the cache only, and still needs to be written to the device
+#define REGISTER_MAP_FLAG_DIRTY 0x02
+
+/**
+ * \brief How the register map caches a register.
+ */
+typedef enum
+{
+    ERegisterCachePolicy_Volatile,  ///< Changed by the device itself, e.g. status or time; always read from the device
+    ERegisterCachePolicy_Cached,    ///< Only changed by writes; read from the device once, then from the cache
+    ERegisterCachePolicy_WriteOnly  ///< Cannot be read back; reads return the last written value
+} ERegisterCachePolicy_t;
+
+/**
+ * \brief Cache policy of a range of registers.
+ */
+typedef struct
+{
+    /// Index of the first register of the range
+    uint16_t firstRegister;
+
+    /// Index of the last register of the range
+    uint16_t lastRegister;
+
+    /// Cache policy of the registers of the range
+    ERegisterCachePolicy_t policy;
+} RegisterMapRange_t;
+
+/**
+ * \brief Description of the registers of a device.
+ *
+ * Registers are identified by their index, which is page * registersPerPage + address for devices with pages, and
+ * the register address otherwise. Registers which are not in any range are volatile.
+ */
+typedef struct
+{
+    /// Device address
+    uint8_t deviceAddress;
+
+    /// Subaddress mode of the register address
+    EI2cSubAddressMode_t subAddressMode;
+
+    /// Number of registers, on all pages
+    uint16_t numberOfRegisters;
+
+    /// Number of registers per page, or 0 if the device has no pages
+    uint16_t registersPerPage;
+
+    /// Address of the page select register, which is present on every page
+    uint16_t pageSelectRegister;
+
+    /// True if the device does not increment the register address within a write, so registers are written one by one
+    bool singleRegisterWrites;
+
+    /// Cache policies of the registers
+    const RegisterMapRange_t* pRanges;
+
+    /// Number of entries of pRanges
+    uint32_t numberOfRanges;
+} RegisterMapConfig_t;
+
+/**
+ * \brief Register map of a device: the register cache and the state of the device.
+ *
+ * A register map may be defined statically, with pValues and pFlags pointing to zero-initialised arrays of
+ * numberOfRegisters bytes and currentPage set to REGISTER_MAP_PAGE_UNKNOWN, or be set up with
+ * RegisterMap_Initialise().
+ */
+typedef struct
+{
+    /// Description of the registers
+    const RegisterMapConfig_t* pConfig;
+
+    /// Cached register values
+    uint8_t* pValues;
+
+    /// REGISTER_MAP_FLAG_ flags of each register
+    uint8_t* pFlags;
+
+    /// Page currently selected in the device, or REGISTER_MAP_PAGE_UNKNOWN
+    int currentPage;
+
+    /// True while writes only go to the cache, until RegisterMap_Sync() is called
+    bool cacheOnly;
+} RegisterMap_t;
+
+
+//-------------------------------------------------------------------------------------------------
+// Function declarations
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Initialise a register map with an empty cache.
+ *
+ * \param	pMap		Register map
+ * \param	pConfig		Description of the registers; must stay valid while the register map is used
+ * \param	pValues		Buffer of pConfig->numberOfRegisters bytes for the cached values
+ * \param	pFlags		Buffer of pConfig->numberOfRegisters bytes for the flags of the registers
+ * \returns				Result code
+ */
+EN_RESULT RegisterMap_Initialise(RegisterMap_t* pMap,
+                                 const RegisterMapConfig_t* pConfig,
+                                 uint8_t* pValues,
+                                 uint8_t* pFlags);
+
+
+/**
+ * \brief Forget all cached values, pending writes and the selected page, e.g. after the device has been reset.
+ *
+ * \param	pMap		Register map
+ */
+void RegisterMap_Invalidate(RegisterMap_t* pMap);
+
+
+/**
+ * \brief Select a page of a device with pages, unless it is selected already.
+ *
+ * \param	pMap		Register map
+ * \param	page		Page to select
+ * \returns				Result code
+ */
+EN_RESULT RegisterMap_SelectPage(RegisterMap_t* pMap, int page);
+
+
+/**
+ * \brief Read consecutive registers of one page.
+ *
+ * Registers are taken from the cache where possible. The registers which must be read from the device are read with
+ * a single burst read, from the first to the last of them.
+ *
+ * \param	pMap				Register map
+ * \param	firstRegister		Index of the first register
+ * \param	numberOfRegisters	Number of registers
+ * \param[out]	pBuffer			Buffer receiving the register values
+ * \param	priority			Priority of the read on the bus
+ * \returns						Result code; EN_ERROR_INVALID_ARGUMENT for a write-only register which has not been
+ *								written yet, or for registers on more than one page
+ */
+EN_RESULT RegisterMap_ReadWithPriority(RegisterMap_t* pMap,
+                                       uint16_t firstRegister,
+                                       uint32_t numberOfRegisters,
+                                       uint8_t* pBuffer,
+                                       EI2cPriority_t priority);
+
+
+/**
+ * \brief As RegisterMap_ReadWithPriority(), with normal priority.
+ */
+EN_RESULT RegisterMap_Read(RegisterMap_t* pMap, uint16_t firstRegister, uint32_t numberOfRegisters, uint8_t* pBuffer);
+
+
+/**
+ * \brief Write consecutive registers of one page with a single burst write, or to the cache only while the register
+ * map is in cache-only mode.
+ *
+ * \param	pMap				Register map
+ * \param	firstRegister		Index of the first register
+ * \param	numberOfRegisters	Number of registers
+ * \param	pBuffer				Register values
+ * \returns						Result code
+ */
+EN_RESULT RegisterMap_Write(RegisterMap_t* pMap,
+                            uint16_t firstRegister,
+                            uint32_t numberOfRegisters,
+                            const uint8_t* pBuffer);
+
+
+/**
+ * \brief Change bits of a register. The current value is taken from the cache if possible, and the register is only
+ * written if its value changes, or if it is volatile.
+ *
+ * \param	pMap			Register map
+ * \param	registerIndex	Index of the register
+ * \param	mask			Bits to change
+ * \param	value			New value of the bits to change
+ * \param[out]	pChanged	Set to true if the register was written; may be NULL
+ * \returns					Result code
+ */
+EN_RESULT RegisterMap_UpdateBits(RegisterMap_t* pMap,
+                                 uint16_t registerIndex,
+                                 uint8_t mask,
+                                 uint8_t value,
+                                 bool* pChanged);
+
+
+/**
+ * \brief Enable or disable cache-only mode. While it is enabled, writes only change the cache and mark the registers
+ * as dirty, so that several writes can be combined by RegisterMap_Sync().
+ *
+ * \param	pMap		Register map
+ * \param	cacheOnly	True to enable cache-only mode
+ */
+void RegisterMap_SetCacheOnly(RegisterMap_t* pMap, bool cacheOnly);
+
+
+/**
+ * \brief Write all dirty registers to the device. Dirty registers with consecutive indices on one page are written
+ * with a single burst write.
+ *
+ * \param	pMap		Register map
+ * \returns				Result code
+ */
+EN_RESULT RegisterMap_Sync(RegisterMap_t* pMap);
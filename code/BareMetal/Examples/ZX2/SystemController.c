@@ -25,6 +25,7 @@
 //-------------------------------------------------------------------------------------------------
 
 #include "I2cInterface.h"
+#include "RegisterMap.h"
 #include "TimerInterface.h"
 #include "UtilityFunctions.h" 
  
@@ -40,6 +41,36 @@
  
 #define SYSTEM_CONTROLLER_REGISTER_ADDRESS_VMON_SEL    20
 #define SYSTEM_CONTROLLER_REGISTER_ADDRESS_VMON_SEL_EN 21
+
+#define SYSTEM_CONTROLLER_NUMBER_OF_REGISTERS (SYSTEM_CONTROLLER_REGISTER_ADDRESS_VMON_SEL_EN + 1)
+
+/// Time for the system monitor inputs to settle after switching the monitored voltages
+#define SYSTEM_CONTROLLER_VMON_SEL_SETTLE_TIME_MILLISECONDS 750
+
+//-------------------------------------------------------------------------------------------------
+// Global variable definitions
+//-------------------------------------------------------------------------------------------------
+
+/// The voltage monitor selection is only changed by this driver, so it is cached
+const RegisterMapRange_t g_systemControllerRegisterRanges[] = {
+	{ SYSTEM_CONTROLLER_REGISTER_ADDRESS_VMON_SEL, SYSTEM_CONTROLLER_REGISTER_ADDRESS_VMON_SEL_EN,
+	  ERegisterCachePolicy_Cached }
+};
+
+/// The registers are written one by one, as the system controller is not known to increment the register address
+const RegisterMapConfig_t g_systemControllerRegisterMapConfig = {
+	SYSTEM_CONTROLLER_DEVICE_ADDRESS, EI2cSubAddressMode_OneByte, SYSTEM_CONTROLLER_NUMBER_OF_REGISTERS, 0, 0, true,
+	g_systemControllerRegisterRanges, sizeof(g_systemControllerRegisterRanges) / sizeof(g_systemControllerRegisterRanges[0])
+};
+
+uint8_t g_systemControllerRegisterValues[SYSTEM_CONTROLLER_NUMBER_OF_REGISTERS];
+uint8_t g_systemControllerRegisterFlags[SYSTEM_CONTROLLER_NUMBER_OF_REGISTERS];
+
+/// Register cache of the system controller
+RegisterMap_t g_systemControllerRegisterMap = {
+	&g_systemControllerRegisterMapConfig, g_systemControllerRegisterValues, g_systemControllerRegisterFlags,
+	REGISTER_MAP_PAGE_UNKNOWN, false
+};
  
  
 //-------------------------------------------------------------------------------------------------
@@ -48,44 +79,27 @@
 
 EN_RESULT SystemController_SetVmonSel(int set_bit)
 {
-
-	uint8_t tempValue = 0;
-	EN_RETURN_IF_FAILED(I2cRead(SYSTEM_CONTROLLER_DEVICE_ADDRESS,
-			SYSTEM_CONTROLLER_REGISTER_ADDRESS_VMON_SEL,
-			EI2cSubAddressMode_OneByte,
-			1,
-			(uint8_t*)&tempValue));
+	bool vmonSelChanged = false;
+	bool vmonSelEnableChanged = false;
 
 	//Set/Reset Bit 2 of Register 20 --> set Vmon_Sel to 1/0
-	if (set_bit) {
-		tempValue |= (1 << 2);
-	}
-	else {
-		tempValue &= ~(1 << 2);
-	}
-
-	EN_RETURN_IF_FAILED(I2cWrite(SYSTEM_CONTROLLER_DEVICE_ADDRESS,
-    		SYSTEM_CONTROLLER_REGISTER_ADDRESS_VMON_SEL,
-    		EI2cSubAddressMode_OneByte,
-    		&tempValue,
-    		1));
-
-    tempValue = 0;
-	EN_RETURN_IF_FAILED(I2cRead(SYSTEM_CONTROLLER_DEVICE_ADDRESS,
-			SYSTEM_CONTROLLER_REGISTER_ADDRESS_VMON_SEL_EN,
-			EI2cSubAddressMode_OneByte,
-			1,
-			(uint8_t*)&tempValue));
+	EN_RETURN_IF_FAILED(RegisterMap_UpdateBits(&g_systemControllerRegisterMap,
+			SYSTEM_CONTROLLER_REGISTER_ADDRESS_VMON_SEL,
+			(1 << 2),
+			set_bit ? (1 << 2) : 0,
+			&vmonSelChanged));
 
 	//Set Bit 2 of Register 21 --> set Vmon_Sel Enable to 1
-	tempValue |= (1 << 2);
-
-    EN_RETURN_IF_FAILED(I2cWrite(SYSTEM_CONTROLLER_DEVICE_ADDRESS,
-    		SYSTEM_CONTROLLER_REGISTER_ADDRESS_VMON_SEL_EN,
-    		EI2cSubAddressMode_OneByte,
-    		&tempValue,
-    		1));
+	EN_RETURN_IF_FAILED(RegisterMap_UpdateBits(&g_systemControllerRegisterMap,
+			SYSTEM_CONTROLLER_REGISTER_ADDRESS_VMON_SEL_EN,
+			(1 << 2),
+			(1 << 2),
+			&vmonSelEnableChanged));
 
-	SleepMilliseconds(750);
+	// The registers are only read the first time; if the selection did not change, there is nothing to wait for
+	if (vmonSelChanged || vmonSelEnableChanged) {
+		SleepMilliseconds(SYSTEM_CONTROLLER_VMON_SEL_SETTLE_TIME_MILLISECONDS);
+	}
 
+	return EN_SUCCESS;
 }
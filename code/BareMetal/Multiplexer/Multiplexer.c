@@ -25,6 +25,7 @@
 //-------------------------------------------------------------------------------------------------
 
 #include "Multiplexer.h"
+#include "I2cBusSpeed.h"
 
 //-------------------------------------------------------------------------------------------------
 // Directives, typedefs and constants
@@ -36,6 +37,9 @@
 // Configuration register read mask: only the 4 LSBs are relevant (bit 3 is enable bit, bit 2-0 are used for channel selection)
 #define READ_CONFIGURATION_REGISTER_MASK 0x0F
 
+// Channel selection bits of the configuration register
+#define MULTIPLEXER_CHANNEL_MASK 0x07
+
 //-------------------------------------------------------------------------------------------------
 
 //-------------------------------------------------------------------------------------------------
@@ -85,5 +89,8 @@ EN_RESULT Mux_Write(uint8_t writeBuffer) {
 
 	EN_RETURN_IF_FAILED(I2cWrite(MULTIPLEXER_DEVICE_ADDRESS, 0x00, EI2cSubAddressMode_OneByte, (uint8_t*)&writeBuffer, 1));
 
+	// Devices behind the multiplexer may share their address with a module device, but not its bus speed.
+	I2cBusSpeed_SetMuxChannel(writeBuffer & MULTIPLEXER_CHANNEL_MASK);
+
 	return EN_SUCCESS;
 }
@@ -25,7 +25,9 @@
 //-------------------------------------------------------------------------------------------------
 
 #include "RealtimeClock.h"
+#include "DeviceDiscovery.h"
 #include "I2cInterface.h"
+#include "RegisterMap.h"
 #include "UtilityFunctions.h"
 
 
@@ -113,6 +115,19 @@ ERtcDevice_t g_RtcDeviceType;
 #define PCF85063A_REGISTER_ADDRESS_YEAR 0x0A
 
 
+/// Number of registers of the ISL12020 accessed by the driver, up to the temperature registers
+#define ISL12020_NUMBER_OF_REGISTERS 0x2A
+
+/// Number of registers of the PCF85063A
+#define PCF85063A_NUMBER_OF_REGISTERS 0x12
+
+/// Largest number of registers of both RTCs
+#define RTC_NUMBER_OF_REGISTERS_MAX ISL12020_NUMBER_OF_REGISTERS
+
+/// Largest number of registers holding the date and time (seconds to years, including the weekday of the PCF85063A)
+#define RTC_DATE_TIME_REGISTER_COUNT_MAX 7
+
+
 uint8_t g_secondsRegisterAddress;
 uint8_t g_minutesRegisterAddress;
 uint8_t g_hourRegisterAddress;
@@ -121,6 +136,39 @@ uint8_t g_monthRegisterAddress;
 uint8_t g_yearRegisterAddress;
 
 
+/// Cache policies of the ISL12020 registers: control, alarm and DST registers are cached; the time, status, time
+/// stamp and temperature registers change by themselves
+const RegisterMapRange_t ISL12020_REGISTER_RANGES[] = {
+    { 0x08, 0x15, ERegisterCachePolicy_Cached },
+    { 0x20, 0x27, ERegisterCachePolicy_Cached }
+};
+
+/// Cache policies of the PCF85063A registers: Control_1, offset, RAM and alarm registers are cached; Control_2 holds
+/// the alarm and timer flags, and the time and timer registers change by themselves
+const RegisterMapRange_t PCF85063A_REGISTER_RANGES[] = {
+    { 0x00, 0x00, ERegisterCachePolicy_Cached },
+    { 0x02, 0x03, ERegisterCachePolicy_Cached },
+    { 0x0B, 0x0F, ERegisterCachePolicy_Cached },
+    { 0x11, 0x11, ERegisterCachePolicy_Cached }
+};
+
+const RegisterMapConfig_t ISL12020_REGISTER_MAP_CONFIG = {
+    ERtcDevice_ISL12020, EI2cSubAddressMode_OneByte, ISL12020_NUMBER_OF_REGISTERS, 0, 0, false,
+    ISL12020_REGISTER_RANGES, sizeof(ISL12020_REGISTER_RANGES) / sizeof(ISL12020_REGISTER_RANGES[0])
+};
+
+const RegisterMapConfig_t PCF85063A_REGISTER_MAP_CONFIG = {
+    ERtcDevice_NXPPCF85063A, EI2cSubAddressMode_OneByte, PCF85063A_NUMBER_OF_REGISTERS, 0, 0, false,
+    PCF85063A_REGISTER_RANGES, sizeof(PCF85063A_REGISTER_RANGES) / sizeof(PCF85063A_REGISTER_RANGES[0])
+};
+
+uint8_t g_rtcRegisterValues[RTC_NUMBER_OF_REGISTERS_MAX];
+uint8_t g_rtcRegisterFlags[RTC_NUMBER_OF_REGISTERS_MAX];
+
+/// Register cache of the detected RTC
+RegisterMap_t g_rtcRegisterMap;
+
+
 //-------------------------------------------------------------------------------------------------
 // Function definitions
 //-------------------------------------------------------------------------------------------------
@@ -137,34 +185,11 @@ EN_RESULT IsRtcPresentAtDeviceAddress(uint8_t rtcI2cAddress, bool* pDeviceIsPres
     switch (rtcI2cAddress)
     {
     case ERtcDevice_ISL12020:
-    {
-        // Try to read from address 0 to see if the device responds.
-        uint8_t readBuffer;
-        if (EN_FAILED(
-                I2cRead(rtcI2cAddress, 0, EI2cSubAddressMode_OneByte, sizeof(readBuffer), (uint8_t*)&readBuffer)))
-        {
-            *pDeviceIsPresent = false;
-        }
-        else
-        {
-            *pDeviceIsPresent = true;
-        }
-
-        break;
-    }
     case ERtcDevice_NXPPCF85063A:
     {
-        // Try to read from address 0 to see if the device responds.
-        uint8_t readBuffer;
-        if (EN_FAILED(
-                I2cRead(rtcI2cAddress, 0, EI2cSubAddressMode_OneByte, sizeof(readBuffer), (uint8_t*)&readBuffer)))
-        {
-            *pDeviceIsPresent = false;
-        }
-        else
-        {
-            *pDeviceIsPresent = true;
-        }
+        // The RTCs need no configuration to be detected, so the result of the bus discovery is used, which probes
+        // the addresses of all RTC types at once.
+        EN_RETURN_IF_FAILED(DeviceDiscovery_IsDevicePresent(rtcI2cAddress, pDeviceIsPresent));
 
         break;
     }
@@ -236,6 +261,12 @@ EN_RESULT Rtc_Initialise()
 
     SetRegisterAddresses();
 
+    EN_RETURN_IF_FAILED(RegisterMap_Initialise(&g_rtcRegisterMap,
+                                               (g_RtcDeviceType == ERtcDevice_ISL12020) ? &ISL12020_REGISTER_MAP_CONFIG
+                                                                                        : &PCF85063A_REGISTER_MAP_CONFIG,
+                                               g_rtcRegisterValues,
+                                               g_rtcRegisterFlags));
+
     switch (g_RtcDeviceType)
     {
     case ERtcDevice_ISL12020:
@@ -246,19 +277,13 @@ EN_RESULT Rtc_Initialise()
         // Enable write access
         // Disable Frequency Output
         uint8_t writeEnable = 0x40;
-        EN_RETURN_IF_FAILED(I2cWrite(ERtcDevice_ISL12020, 0x08, EI2cSubAddressMode_OneByte, &writeEnable, 1));
+        EN_RETURN_IF_FAILED(RegisterMap_Write(&g_rtcRegisterMap, 0x08, 1, &writeEnable));
 
         /** Enable temp sense:
-        * read the register value
-        * set bit 8 (TSE) in register at address 0x0D
-        * write it back 
+        * set bit 8 (TSE) in register at address 0x0D; the register is only read the first time, and only
+        * written if the bit is not set yet
         */
-        uint8_t configRegister;
-        EN_RETURN_IF_FAILED(I2cRead(ERtcDevice_ISL12020, 0x0D, EI2cSubAddressMode_OneByte, 1, &configRegister));
-
-        configRegister = configRegister | 0x80;
-
-        EN_RETURN_IF_FAILED(I2cWrite(ERtcDevice_ISL12020, 0x0D, EI2cSubAddressMode_OneByte, &configRegister, 1));
+        EN_RETURN_IF_FAILED(RegisterMap_UpdateBits(&g_rtcRegisterMap, 0x0D, 0x80, 0x80, NULL));
         break;
     }
     case ERtcDevice_NXPPCF85063A:
@@ -267,12 +292,7 @@ EN_RESULT Rtc_Initialise()
         EN_PRINTF("Detected RTC NXPPCF85063A\r\n");
 #endif
         // Enable 24-hour mode and set oscillator capacity
-        uint8_t configRegister = 0;
-        EN_RETURN_IF_FAILED(I2cRead(ERtcDevice_NXPPCF85063A, 0x00, EI2cSubAddressMode_OneByte, 1, &configRegister));
-
-        configRegister = configRegister | 0x01;
-
-        EN_RETURN_IF_FAILED(I2cWrite(ERtcDevice_NXPPCF85063A, 0x00, EI2cSubAddressMode_OneByte, &configRegister, 1));
+        EN_RETURN_IF_FAILED(RegisterMap_UpdateBits(&g_rtcRegisterMap, 0x00, 0x01, 0x01, NULL));
 
         break;
     }
@@ -284,33 +304,94 @@ EN_RESULT Rtc_Initialise()
     return EN_SUCCESS;
 }
 
-EN_RESULT Rtc_ReadTime(int* pHour, int* pMinutes, int* pSeconds)
+/**
+ * \brief Read a block of consecutive date and time registers with a single I2C read.
+ *
+ * Both RTCs freeze the time registers while they are read, so the values are consistent even if the time
+ * rolls over during the read.
+ *
+ * @param	firstRegisterAddress	Address of the first register
+ * @param	lastRegisterAddress		Address of the last register
+ * @param[out] pRegisters			Buffer of RTC_DATE_TIME_REGISTER_COUNT_MAX bytes to receive the register
+ *									values, from firstRegisterAddress on
+ * @return							Result code
+ */
+EN_RESULT ReadDateTimeRegisters(uint8_t firstRegisterAddress, uint8_t lastRegisterAddress, uint8_t* pRegisters)
 {
-    if (pHour == NULL || pMinutes == NULL || pSeconds == NULL)
+    uint32_t numberOfRegisters = lastRegisterAddress - firstRegisterAddress + 1;
+    if ((lastRegisterAddress < firstRegisterAddress) || (numberOfRegisters > RTC_DATE_TIME_REGISTER_COUNT_MAX))
     {
-        return EN_ERROR_NULL_POINTER;
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    EN_RETURN_IF_FAILED(RegisterMap_Read(&g_rtcRegisterMap, firstRegisterAddress, numberOfRegisters, pRegisters));
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Write date or time registers, combining registers with consecutive addresses into one burst write.
+ *
+ * @param	pRegisterAddresses		Register addresses
+ * @param	pValues					Register values
+ * @param	numberOfRegisters		Number of registers
+ * @return							Result code
+ */
+EN_RESULT WriteDateTimeRegisters(const uint8_t* pRegisterAddresses, const uint8_t* pValues, int numberOfRegisters)
+{
+    EN_RESULT result = EN_SUCCESS;
+    int index;
+
+    // Collect the writes in the cache, and write them with as few transfers as possible
+    RegisterMap_SetCacheOnly(&g_rtcRegisterMap, true);
+    for (index = 0; (index < numberOfRegisters) && EN_SUCCEEDED(result); index++)
+    {
+        result = RegisterMap_Write(&g_rtcRegisterMap, pRegisterAddresses[index], 1, &pValues[index]);
     }
+    RegisterMap_SetCacheOnly(&g_rtcRegisterMap, false);
 
-    //read seconds value from register and convert it to decimal
-    uint8_t binaryCodedSeconds;
-    EN_RETURN_IF_FAILED(
-        I2cRead(g_RtcDeviceType, g_secondsRegisterAddress, EI2cSubAddressMode_OneByte, 1, &binaryCodedSeconds));
-    *pSeconds = ConvertBinaryCodedDecimalToDecimal(binaryCodedSeconds);
+    EN_RETURN_IF_FAILED(result);
 
-    //read minutes value from register and convert it to decimal
-    uint8_t binaryCodedMinutes;
-    EN_RETURN_IF_FAILED(
-        I2cRead(g_RtcDeviceType, g_minutesRegisterAddress, EI2cSubAddressMode_OneByte, 1, &binaryCodedMinutes));
-    *pMinutes = ConvertBinaryCodedDecimalToDecimal(binaryCodedMinutes);
+    return RegisterMap_Sync(&g_rtcRegisterMap);
+}
 
-    //read hour value from register and convert it to decimal
-    uint8_t binaryCodedHour;
-    EN_RETURN_IF_FAILED(
-        I2cRead(g_RtcDeviceType, g_hourRegisterAddress, EI2cSubAddressMode_OneByte, 1, &binaryCodedHour));
+/**
+ * \brief Convert the time registers, read from firstRegisterAddress on, to decimal values.
+ */
+void DecodeTimeRegisters(
+    const uint8_t* pRegisters, uint8_t firstRegisterAddress, int* pHour, int* pMinutes, int* pSeconds)
+{
+    // Bit 7 of the seconds register is the oscillator stop flag of the PCF85063A.
+    *pSeconds = ConvertBinaryCodedDecimalToDecimal(pRegisters[g_secondsRegisterAddress - firstRegisterAddress] & 0x7F);
+    *pMinutes = ConvertBinaryCodedDecimalToDecimal(pRegisters[g_minutesRegisterAddress - firstRegisterAddress] & 0x7F);
 
 	/** 0x3F mask is needed since only the first 6 bits of the register contain the individual values and the 8th bit of the register can be used to switch between 24 hour and 12 hour mode, so it needs to be excluded from the conversion
 	*/
-    *pHour = ConvertBinaryCodedDecimalToDecimal(binaryCodedHour & 0x3F);
+    *pHour = ConvertBinaryCodedDecimalToDecimal(pRegisters[g_hourRegisterAddress - firstRegisterAddress] & 0x3F);
+}
+
+/**
+ * \brief Convert the date registers, read from firstRegisterAddress on, to decimal values.
+ */
+void DecodeDateRegisters(const uint8_t* pRegisters, uint8_t firstRegisterAddress, int* pDay, int* pMonth, int* pYear)
+{
+    *pDay = ConvertBinaryCodedDecimalToDecimal(pRegisters[g_dayRegisterAddress - firstRegisterAddress] & 0x3F);
+    *pMonth = ConvertBinaryCodedDecimalToDecimal(pRegisters[g_monthRegisterAddress - firstRegisterAddress] & 0x1F);
+    *pYear = ConvertBinaryCodedDecimalToDecimal(pRegisters[g_yearRegisterAddress - firstRegisterAddress]);
+}
+
+EN_RESULT Rtc_ReadTime(int* pHour, int* pMinutes, int* pSeconds)
+{
+    if (pHour == NULL || pMinutes == NULL || pSeconds == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    // The seconds, minutes and hour registers are consecutive in both RTCs.
+    uint8_t registers[RTC_DATE_TIME_REGISTER_COUNT_MAX];
+    EN_RETURN_IF_FAILED(ReadDateTimeRegisters(g_secondsRegisterAddress, g_hourRegisterAddress, registers));
+
+    DecodeTimeRegisters(registers, g_secondsRegisterAddress, pHour, pMinutes, pSeconds);
 
     return EN_SUCCESS;
 }
@@ -324,19 +405,11 @@ EN_RESULT Rtc_SetTime(int hour, int minutes, int seconds)
 
     binaryCodedHour |= 0x80; // enable 24h format
 
-    //set seconds value
-    EN_RETURN_IF_FAILED(
-        I2cWrite(g_RtcDeviceType, g_secondsRegisterAddress, EI2cSubAddressMode_OneByte, &binaryCodedSeconds, 1));
-
-    //set minutes value
-    EN_RETURN_IF_FAILED(
-        I2cWrite(g_RtcDeviceType, g_minutesRegisterAddress, EI2cSubAddressMode_OneByte, &binaryCodedMinutes, 1));
+    //set seconds, minutes and hour value; the registers are consecutive, so they are written with one burst write
+    const uint8_t registerAddresses[3] = { g_secondsRegisterAddress, g_minutesRegisterAddress, g_hourRegisterAddress };
+    const uint8_t values[3] = { binaryCodedSeconds, binaryCodedMinutes, binaryCodedHour };
 
-    //set hour value
-    EN_RETURN_IF_FAILED(
-        I2cWrite(g_RtcDeviceType, g_hourRegisterAddress, EI2cSubAddressMode_OneByte, &binaryCodedHour, 1));
-
-    return EN_SUCCESS;
+    return WriteDateTimeRegisters(registerAddresses, values, 3);
 }
 
 EN_RESULT Rtc_ReadDate(int* pDay, int* pMonth, int* pYear)
@@ -346,19 +419,28 @@ EN_RESULT Rtc_ReadDate(int* pDay, int* pMonth, int* pYear)
         return EN_ERROR_NULL_POINTER;
     }
 
-    uint8_t binaryCodedDay;
-    EN_RETURN_IF_FAILED(I2cRead(g_RtcDeviceType, g_dayRegisterAddress, EI2cSubAddressMode_OneByte, 1, &binaryCodedDay));
-    *pDay = ConvertBinaryCodedDecimalToDecimal(binaryCodedDay);
+    // The day, month and year registers are consecutive, apart from the weekday register of the PCF85063A.
+    uint8_t registers[RTC_DATE_TIME_REGISTER_COUNT_MAX];
+    EN_RETURN_IF_FAILED(ReadDateTimeRegisters(g_dayRegisterAddress, g_yearRegisterAddress, registers));
+
+    DecodeDateRegisters(registers, g_dayRegisterAddress, pDay, pMonth, pYear);
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT Rtc_ReadDateTime(int* pDay, int* pMonth, int* pYear, int* pHour, int* pMinutes, int* pSeconds)
+{
+    if (pDay == NULL || pMonth == NULL || pYear == NULL || pHour == NULL || pMinutes == NULL || pSeconds == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
 
-    uint8_t binaryCodedMonth;
-    EN_RETURN_IF_FAILED(
-        I2cRead(g_RtcDeviceType, g_monthRegisterAddress, EI2cSubAddressMode_OneByte, 1, &binaryCodedMonth));
-    *pMonth = ConvertBinaryCodedDecimalToDecimal(binaryCodedMonth);
+    // Read all registers from seconds to year at once, so that the date and the time belong together.
+    uint8_t registers[RTC_DATE_TIME_REGISTER_COUNT_MAX];
+    EN_RETURN_IF_FAILED(ReadDateTimeRegisters(g_secondsRegisterAddress, g_yearRegisterAddress, registers));
 
-    uint8_t binaryCodedYear;
-    EN_RETURN_IF_FAILED(
-        I2cRead(g_RtcDeviceType, g_yearRegisterAddress, EI2cSubAddressMode_OneByte, 1, &binaryCodedYear));
-    *pYear = ConvertBinaryCodedDecimalToDecimal(binaryCodedYear);
+    DecodeTimeRegisters(registers, g_secondsRegisterAddress, pHour, pMinutes, pSeconds);
+    DecodeDateRegisters(registers, g_secondsRegisterAddress, pDay, pMonth, pYear);
 
     return EN_SUCCESS;
 }
@@ -370,16 +452,11 @@ EN_RESULT Rtc_SetDate(int day, int month, int year)
     uint8_t binaryCodedMonth = ConvertDecimalToBinaryCodedDecimal(month);
     uint8_t binaryCodedYear = ConvertDecimalToBinaryCodedDecimal(year);
 
-    EN_RETURN_IF_FAILED(
-        I2cWrite(g_RtcDeviceType, g_dayRegisterAddress, EI2cSubAddressMode_OneByte, &binaryCodedDay, 1));
-
-    EN_RETURN_IF_FAILED(
-        I2cWrite(g_RtcDeviceType, g_monthRegisterAddress, EI2cSubAddressMode_OneByte, &binaryCodedMonth, 1));
-
-    EN_RETURN_IF_FAILED(
-        I2cWrite(g_RtcDeviceType, g_yearRegisterAddress, EI2cSubAddressMode_OneByte, &binaryCodedYear, 1));
+    // The weekday register of the PCF85063A lies between day and month, so it takes two burst writes there
+    const uint8_t registerAddresses[3] = { g_dayRegisterAddress, g_monthRegisterAddress, g_yearRegisterAddress };
+    const uint8_t values[3] = { binaryCodedDay, binaryCodedMonth, binaryCodedYear };
 
-    return EN_SUCCESS;
+    return WriteDateTimeRegisters(registerAddresses, values, 3);
 }
 
 EN_RESULT Rtc_ReadTemperature(int* pTemperatureCelsius)
@@ -396,14 +473,12 @@ EN_RESULT Rtc_ReadTemperature(int* pTemperatureCelsius)
 
     /**temperature value is 2 bytes, therefore we need two uint8_t variables
 	*/
-    uint8_t value0;
-    uint8_t value1;
-
-    //read both values
-    EN_RETURN_IF_FAILED(
-        I2cRead(g_RtcDeviceType, ISL12020_REGISTER_ADDRESS_TEMPERATURE1, EI2cSubAddressMode_OneByte, 1, &value0));
-    EN_RETURN_IF_FAILED(
-        I2cRead(g_RtcDeviceType, ISL12020_REGISTER_ADDRESS_TEMPERATURE2, EI2cSubAddressMode_OneByte, 1, &value1));
+    uint8_t values[2];
+
+    //read both values with one burst read
+    EN_RETURN_IF_FAILED(RegisterMap_Read(&g_rtcRegisterMap, ISL12020_REGISTER_ADDRESS_TEMPERATURE1, 2, values));
+    uint8_t value0 = values[0];
+    uint8_t value1 = values[1];
 
     /**calculate the temperature in celsius using the read values according to the data sheet; value1 needs to be shifted 8 bits to the left as the bottom two bits of the register at ISL12020_REGISTER_ADDRESS_TEMPERATURE2 hold the MSBs of the combined value
 	*/
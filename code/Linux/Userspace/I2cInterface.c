@@ -0,0 +1,666 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "I2cInterface.h"
+#include "I2cInterfaceVariables.h"
+#include "UtilityFunctions.h"
+#include "Completion.h"
+#include "ErrorCodes.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+
+/// Timeout for write transfers
+const uint32_t I2C_WRITE_TIMEOUT_MICROSECONDS = 100000;
+
+/// Timeout for read transfers
+const uint32_t I2C_READ_TIMEOUT_MICROSECONDS = 1000000;
+
+/// Maximum number of data bytes in one message, as accepted by the I2C_RDWR ioctl
+const uint32_t I2C_MAX_MESSAGE_LENGTH_BYTES = 8192;
+
+/// Maximum number of messages in one I2C_RDWR ioctl
+#define I2C_MAX_MESSAGES_PER_REQUEST I2C_RDWR_IOCTL_MAX_MSGS
+
+//-------------------------------------------------------------------------------------------------
+// Global variable definitions
+//-------------------------------------------------------------------------------------------------
+
+/// File descriptor of the I2C bus device, or -1 if it is not open
+int g_i2cFileDescriptor = -1;
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Convert the error of a failed I2C_RDWR ioctl to a result code.
+ *
+ * \param	errorNumber		The errno value
+ * \param	direction		Direction of the failed transaction
+ * \returns					Result code
+ */
+EN_RESULT I2cGetErrorResult(int errorNumber, EI2cDirection_t direction)
+{
+    switch (errorNumber)
+    {
+    case ENXIO:
+    case EREMOTEIO:
+        return EN_ERROR_I2C_SLAVE_NACK;
+    case ETIMEDOUT:
+        return (direction == EI2cDirection_Read) ? EN_ERROR_I2C_READ_TIMEOUT : EN_ERROR_I2C_WRITE_TIMEOUT;
+    default:
+        return (direction == EI2cDirection_Read) ? EN_ERROR_I2C_READ_FAILED : EN_ERROR_I2C_WRITE_FAILED;
+    }
+}
+
+/**
+ * \brief Complete a transaction and call its callback.
+ *
+ * \param	pTransaction	Transaction descriptor
+ * \param	result			Result code
+ */
+void I2cCompleteTransaction(I2cTransaction_t* pTransaction, EN_RESULT result)
+{
+    pTransaction->result = result;
+    pTransaction->status = EI2cTransactionStatus_Complete;
+    Completion_Signal(&pTransaction->completion);
+
+    if (pTransaction->callback != NULL)
+    {
+        pTransaction->callback(pTransaction, pTransaction->pCallbackContext);
+    }
+}
+
+/**
+ * \brief Get the number of I2C messages needed for a transaction.
+ *
+ * A read with a header is sent as a write message followed by a read message; the kernel issues a
+ * repeated start condition between them.
+ *
+ * \param	pTransaction	Transaction descriptor
+ * \returns					The number of messages
+ */
+uint32_t I2cGetNumberOfMessages(const I2cTransaction_t* pTransaction)
+{
+    return ((pTransaction->direction == EI2cDirection_Read) && (pTransaction->headerLength != 0)) ? 2 : 1;
+}
+
+/**
+ * \brief Get the number of bytes of a transaction which must be gathered into one write message.
+ *
+ * \param	pTransaction	Transaction descriptor
+ * \returns					The number of bytes; zero for reads and for writes which need no copy
+ */
+uint32_t I2cGetGatherLength(const I2cTransaction_t* pTransaction)
+{
+    if ((pTransaction->direction == EI2cDirection_Write) &&
+        ((pTransaction->headerLength != 0) || (pTransaction->pSegments != NULL)))
+    {
+        return pTransaction->headerLength + pTransaction->numberOfBytes;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Copy the header and the data segments of a write into a contiguous buffer.
+ *
+ * \param	pTransaction	Transaction descriptor
+ * \param	pBuffer			Buffer of I2cGetGatherLength() bytes
+ */
+void I2cGatherWriteData(const I2cTransaction_t* pTransaction, uint8_t* pBuffer)
+{
+    memcpy(pBuffer, pTransaction->pHeader, pTransaction->headerLength);
+    pBuffer += pTransaction->headerLength;
+
+    if (pTransaction->pSegments == NULL)
+    {
+        memcpy(pBuffer, pTransaction->pData, pTransaction->numberOfBytes);
+        return;
+    }
+
+    uint32_t segmentIndex;
+    for (segmentIndex = 0; segmentIndex < pTransaction->numberOfSegments; segmentIndex++)
+    {
+        memcpy(pBuffer, pTransaction->pSegments[segmentIndex].pData, pTransaction->pSegments[segmentIndex].length);
+        pBuffer += pTransaction->pSegments[segmentIndex].length;
+    }
+}
+
+/**
+ * \brief Transfer transactions with a single I2C_RDWR ioctl, and complete them.
+ *
+ * \param	ppTransactions			Transaction descriptors, needing at most I2C_MAX_MESSAGES_PER_REQUEST messages
+ * \param	numberOfTransactions	The number of transactions
+ */
+void I2cTransferRequest(I2cTransaction_t* const* ppTransactions, uint32_t numberOfTransactions)
+{
+    struct i2c_msg messages[I2C_MAX_MESSAGES_PER_REQUEST];
+    uint32_t numberOfMessages = 0;
+    uint32_t gatherLength = 0;
+    uint32_t transactionIndex;
+
+    for (transactionIndex = 0; transactionIndex < numberOfTransactions; transactionIndex++)
+    {
+        gatherLength += I2cGetGatherLength(ppTransactions[transactionIndex]);
+    }
+
+    // Writes with a subaddress or with several segments must be sent as one message, so they are copied into
+    // a single buffer for the whole request.
+    uint8_t* pGatherBuffer = NULL;
+    if (gatherLength != 0)
+    {
+        pGatherBuffer = (uint8_t*)malloc(gatherLength);
+    }
+
+    EN_RESULT result = EN_SUCCESS;
+    int errorNumber = 0;
+
+    if ((gatherLength != 0) && (pGatherBuffer == NULL))
+    {
+        errorNumber = ENOMEM;
+    }
+    else
+    {
+        uint8_t* pGatherPosition = pGatherBuffer;
+
+        for (transactionIndex = 0; transactionIndex < numberOfTransactions; transactionIndex++)
+        {
+            I2cTransaction_t* pTransaction = ppTransactions[transactionIndex];
+            pTransaction->status = EI2cTransactionStatus_InProgress;
+
+            struct i2c_msg* pMessage = &messages[numberOfMessages++];
+            pMessage->addr = pTransaction->deviceAddress;
+
+            if (pTransaction->direction == EI2cDirection_Write)
+            {
+                uint32_t length = I2cGetGatherLength(pTransaction);
+                pMessage->flags = 0;
+
+                if (length != 0)
+                {
+                    I2cGatherWriteData(pTransaction, pGatherPosition);
+                    pMessage->buf = pGatherPosition;
+                    pMessage->len = length;
+                    pGatherPosition += length;
+                }
+                else
+                {
+                    pMessage->buf = pTransaction->pData;
+                    pMessage->len = pTransaction->numberOfBytes;
+                }
+            }
+            else
+            {
+                if (pTransaction->headerLength != 0)
+                {
+                    pMessage->flags = 0;
+                    pMessage->buf = (uint8_t*)pTransaction->pHeader;
+                    pMessage->len = pTransaction->headerLength;
+
+                    pMessage = &messages[numberOfMessages++];
+                    pMessage->addr = pTransaction->deviceAddress;
+                }
+
+                pMessage->flags = I2C_M_RD;
+                pMessage->buf = pTransaction->pData;
+                pMessage->len = pTransaction->numberOfBytes;
+            }
+        }
+
+        struct i2c_rdwr_ioctl_data request;
+        request.msgs = messages;
+        request.nmsgs = numberOfMessages;
+
+        if (ioctl(g_i2cFileDescriptor, I2C_RDWR, &request) < 0)
+        {
+            errorNumber = errno;
+        }
+    }
+
+    free(pGatherBuffer);
+
+    // The kernel does not report which message failed, so all transactions of a failed request get the error.
+    for (transactionIndex = 0; transactionIndex < numberOfTransactions; transactionIndex++)
+    {
+        I2cTransaction_t* pTransaction = ppTransactions[transactionIndex];
+
+        if (errorNumber != 0)
+        {
+            result = I2cGetErrorResult(errorNumber, pTransaction->direction);
+
+#ifdef _DEBUG
+            EN_PRINTF("Error: I2C transfer with device 0x%x failed: %s\n",
+                      pTransaction->deviceAddress,
+                      strerror(errorNumber));
+#endif
+        }
+
+        I2cCompleteTransaction(pTransaction, result);
+    }
+}
+
+/**
+ * \brief Set the header (i.e. the subaddress) of a transaction, from its subaddress fields.
+ *
+ * \param	pTransaction	Transaction descriptor
+ * \returns					Result code
+ */
+EN_RESULT I2cSetSubAddressHeader(I2cTransaction_t* pTransaction)
+{
+    pTransaction->pHeader = pTransaction->subAddressBytes;
+
+    switch (pTransaction->subAddressMode)
+    {
+    case EI2cSubAddressMode_None:
+    {
+        pTransaction->headerLength = 0;
+        break;
+    }
+    case EI2cSubAddressMode_OneByte:
+    {
+        pTransaction->subAddressBytes[0] = (uint8_t)pTransaction->subAddress;
+        pTransaction->headerLength = 1;
+        break;
+    }
+    case EI2cSubAddressMode_TwoBytes:
+    {
+        // The subaddress is sent most significant byte first.
+        pTransaction->subAddressBytes[0] = GetUpperByte(pTransaction->subAddress);
+        pTransaction->subAddressBytes[1] = GetLowerByte(pTransaction->subAddress);
+        pTransaction->headerLength = 2;
+        break;
+    }
+    default:
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Check a transaction and prepare it for transfer.
+ *
+ * The header (pHeader, headerLength) must already be set.
+ *
+ * \param	pTransaction	Transaction descriptor
+ * \returns					Result code
+ */
+EN_RESULT I2cPrepareTransaction(I2cTransaction_t* pTransaction)
+{
+    if ((pTransaction->headerLength != 0) && (pTransaction->pHeader == NULL))
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    if ((pTransaction->status == EI2cTransactionStatus_Queued) ||
+        (pTransaction->status == EI2cTransactionStatus_InProgress))
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (pTransaction->pSegments != NULL)
+    {
+        // Scatter-gather write: the data is taken from the segments.
+        if (pTransaction->direction != EI2cDirection_Write)
+        {
+            return EN_ERROR_INVALID_ARGUMENT;
+        }
+
+        pTransaction->numberOfBytes = 0;
+
+        uint32_t segmentIndex;
+        for (segmentIndex = 0; segmentIndex < pTransaction->numberOfSegments; segmentIndex++)
+        {
+            if ((pTransaction->pSegments[segmentIndex].pData == NULL) &&
+                (pTransaction->pSegments[segmentIndex].length != 0))
+            {
+                return EN_ERROR_NULL_POINTER;
+            }
+
+            pTransaction->numberOfBytes += pTransaction->pSegments[segmentIndex].length;
+        }
+    }
+    else if (pTransaction->pData == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    // A write may consist of the header only (e.g. the wake token of the Atmel ATSHA204A), but a read needs data.
+    if ((pTransaction->numberOfBytes == 0) &&
+        ((pTransaction->direction == EI2cDirection_Read) || (pTransaction->headerLength == 0)))
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (pTransaction->headerLength + pTransaction->numberOfBytes > I2C_MAX_MESSAGE_LENGTH_BYTES)
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (g_i2cFileDescriptor < 0)
+    {
+        return EN_ERROR_FAILED_TO_INITIALISE_I2C_CONTROLLER;
+    }
+
+    EN_RETURN_IF_FAILED(Completion_Initialise(&pTransaction->completion));
+
+    pTransaction->bytesTransferred = 0;
+    pTransaction->result = EN_SUCCESS;
+    pTransaction->status = EI2cTransactionStatus_Queued;
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Transfer prepared transactions, using as few I2C_RDWR ioctls as possible.
+ *
+ * \param	ppTransactions			Transaction descriptors
+ * \param	numberOfTransactions	The number of transactions
+ */
+void I2cTransferTransactions(I2cTransaction_t* const* ppTransactions, uint32_t numberOfTransactions)
+{
+    uint32_t firstIndex = 0;
+
+    while (firstIndex < numberOfTransactions)
+    {
+        uint32_t numberOfMessages = 0;
+        uint32_t endIndex = firstIndex;
+
+        while ((endIndex < numberOfTransactions) &&
+               (numberOfMessages + I2cGetNumberOfMessages(ppTransactions[endIndex]) <= I2C_MAX_MESSAGES_PER_REQUEST))
+        {
+            numberOfMessages += I2cGetNumberOfMessages(ppTransactions[endIndex]);
+            endIndex++;
+        }
+
+        I2cTransferRequest(&ppTransactions[firstIndex], endIndex - firstIndex);
+        firstIndex = endIndex;
+    }
+}
+
+EN_RESULT InitialiseI2cInterface()
+{
+    if (g_i2cFileDescriptor >= 0)
+    {
+        return EN_SUCCESS;
+    }
+
+    int fileDescriptor = open(I2C_DEVICE_PATH, O_RDWR);
+    if (fileDescriptor < 0)
+    {
+        EN_PRINTF("Error: Failed to open %s: %s\n", I2C_DEVICE_PATH, strerror(errno));
+        return EN_ERROR_FAILED_TO_INITIALISE_I2C_CONTROLLER;
+    }
+
+    // Combined transfers need an adapter which supports plain I2C messages, not only SMBus commands.
+    unsigned long functionality;
+    if ((ioctl(fileDescriptor, I2C_FUNCS, &functionality) < 0) || ((functionality & I2C_FUNC_I2C) == 0))
+    {
+        EN_PRINTF("Error: %s does not support I2C_RDWR transfers\n", I2C_DEVICE_PATH);
+        close(fileDescriptor);
+        return EN_ERROR_FAILED_TO_INITIALISE_I2C_CONTROLLER;
+    }
+
+    g_i2cFileDescriptor = fileDescriptor;
+
+    return EN_SUCCESS;
+}
+
+void I2cInitialiseTransaction(I2cTransaction_t* pTransaction,
+                              uint8_t deviceAddress,
+                              EI2cDirection_t direction,
+                              uint16_t subAddress,
+                              EI2cSubAddressMode_t subAddressMode,
+                              uint8_t* pData,
+                              uint32_t numberOfBytes)
+{
+    pTransaction->deviceAddress = deviceAddress;
+    pTransaction->direction = direction;
+    pTransaction->subAddress = subAddress;
+    pTransaction->subAddressMode = subAddressMode;
+    pTransaction->pData = pData;
+    pTransaction->numberOfBytes = numberOfBytes;
+    pTransaction->pSegments = NULL;
+    pTransaction->numberOfSegments = 0;
+    pTransaction->priority = EI2cPriority_Normal;
+    pTransaction->flags = I2C_TRANSACTION_FLAG_NONE;
+    pTransaction->callback = NULL;
+    pTransaction->pCallbackContext = NULL;
+    pTransaction->status = EI2cTransactionStatus_Idle;
+    pTransaction->result = EN_SUCCESS;
+}
+
+EN_RESULT I2cSubmit(I2cTransaction_t* pTransaction)
+{
+    EN_RETURN_IF_FAILED(I2cSubmitBatch(&pTransaction, 1));
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT I2cSubmitBatch(I2cTransaction_t* const* ppTransactions, uint32_t numberOfTransactions)
+{
+    if (ppTransactions == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    // The kernel serialises the transfers, so priorities and chunking are not needed: the transactions are
+    // transferred before this function returns.
+    EN_RESULT result = EN_SUCCESS;
+    uint32_t numberOfPrepared;
+
+    for (numberOfPrepared = 0; numberOfPrepared < numberOfTransactions; numberOfPrepared++)
+    {
+        I2cTransaction_t* pTransaction = ppTransactions[numberOfPrepared];
+
+        if (pTransaction == NULL)
+        {
+            result = EN_ERROR_NULL_POINTER;
+            break;
+        }
+
+        result = I2cSetSubAddressHeader(pTransaction);
+        if (EN_SUCCEEDED(result))
+        {
+            result = I2cPrepareTransaction(pTransaction);
+        }
+
+        if (EN_FAILED(result))
+        {
+            break;
+        }
+    }
+
+    I2cTransferTransactions(ppTransactions, numberOfPrepared);
+
+    return result;
+}
+
+bool I2cIsTransactionComplete(const I2cTransaction_t* pTransaction)
+{
+    return (pTransaction->status == EI2cTransactionStatus_Complete);
+}
+
+void I2cCancel(I2cTransaction_t* pTransaction, EN_RESULT result)
+{
+    // Submitted transactions are complete when I2cSubmit() returns, so there is nothing to abort.
+    if ((pTransaction->status == EI2cTransactionStatus_Queued) ||
+        (pTransaction->status == EI2cTransactionStatus_InProgress))
+    {
+        pTransaction->result = result;
+        pTransaction->status = EI2cTransactionStatus_Complete;
+        Completion_Signal(&pTransaction->completion);
+    }
+}
+
+EN_RESULT I2cWaitForTransaction(I2cTransaction_t* pTransaction, uint32_t timeoutMicroseconds)
+{
+    if (pTransaction == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    if (EN_FAILED(Completion_Wait(&pTransaction->completion, timeoutMicroseconds)))
+    {
+        I2cCancel(pTransaction,
+                  (pTransaction->direction == EI2cDirection_Read) ? EN_ERROR_I2C_READ_TIMEOUT
+                                                                  : EN_ERROR_I2C_WRITE_TIMEOUT);
+    }
+
+    return pTransaction->result;
+}
+
+EN_RESULT I2cWriteRead(uint8_t deviceAddress,
+                       const uint8_t* pWriteBuffer,
+                       uint32_t numberOfBytesToWrite,
+                       uint8_t* pReadBuffer,
+                       uint32_t numberOfBytesToRead)
+{
+    if (pWriteBuffer == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    if (numberOfBytesToWrite == 0)
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    I2cTransaction_t transaction;
+    I2cInitialiseTransaction(&transaction,
+                             deviceAddress,
+                             EI2cDirection_Read,
+                             0,
+                             EI2cSubAddressMode_None,
+                             pReadBuffer,
+                             numberOfBytesToRead);
+
+    // The write data is sent as the header of the read transaction.
+    transaction.pHeader = pWriteBuffer;
+    transaction.headerLength = numberOfBytesToWrite;
+    EN_RETURN_IF_FAILED(I2cPrepareTransaction(&transaction));
+
+    I2cTransaction_t* pTransaction = &transaction;
+    I2cTransferTransactions(&pTransaction, 1);
+
+    EN_RETURN_IF_FAILED(I2cWaitForTransaction(&transaction, I2C_READ_TIMEOUT_MICROSECONDS));
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT I2cReadWithPriority(uint8_t deviceAddress,
+                              uint16_t subAddress,
+                              EI2cSubAddressMode_t subAddressMode,
+                              uint32_t numberOfBytesToRead,
+                              uint8_t* pReadBuffer,
+                              EI2cPriority_t priority)
+{
+    I2cTransaction_t transaction;
+    I2cInitialiseTransaction(&transaction,
+                             deviceAddress,
+                             EI2cDirection_Read,
+                             subAddress,
+                             subAddressMode,
+                             pReadBuffer,
+                             numberOfBytesToRead);
+    transaction.priority = priority;
+
+    EN_RETURN_IF_FAILED(I2cSubmit(&transaction));
+
+    EN_RETURN_IF_FAILED(I2cWaitForTransaction(&transaction, I2C_READ_TIMEOUT_MICROSECONDS));
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT I2cRead(uint8_t deviceAddress,
+                  uint16_t subAddress,
+                  EI2cSubAddressMode_t subAddressMode,
+                  uint32_t numberOfBytesToRead,
+                  uint8_t* pReadBuffer)
+{
+    EN_RETURN_IF_FAILED(I2cReadWithPriority(
+        deviceAddress, subAddress, subAddressMode, numberOfBytesToRead, pReadBuffer, EI2cPriority_Normal));
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT I2cWrite(uint8_t deviceAddress,
+                   uint16_t subAddress,
+                   EI2cSubAddressMode_t subAddressMode,
+                   const uint8_t* pWriteBuffer,
+                   uint32_t numberOfBytesToWrite)
+{
+    I2cTransaction_t transaction;
+    I2cInitialiseTransaction(&transaction,
+                             deviceAddress,
+                             EI2cDirection_Write,
+                             subAddress,
+                             subAddressMode,
+                             (uint8_t*)pWriteBuffer,
+                             numberOfBytesToWrite);
+
+    EN_RETURN_IF_FAILED(I2cSubmit(&transaction));
+
+    EN_RETURN_IF_FAILED(I2cWaitForTransaction(&transaction, I2C_WRITE_TIMEOUT_MICROSECONDS));
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT I2cWriteVector(uint8_t deviceAddress,
+                         uint16_t subAddress,
+                         EI2cSubAddressMode_t subAddressMode,
+                         const I2cSegment_t* pSegments,
+                         uint32_t numberOfSegments)
+{
+    if (pSegments == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    I2cTransaction_t transaction;
+    I2cInitialiseTransaction(
+        &transaction, deviceAddress, EI2cDirection_Write, subAddress, subAddressMode, NULL, 0);
+    transaction.pSegments = pSegments;
+    transaction.numberOfSegments = numberOfSegments;
+
+    EN_RETURN_IF_FAILED(I2cSubmit(&transaction));
+
+    EN_RETURN_IF_FAILED(I2cWaitForTransaction(&transaction, I2C_WRITE_TIMEOUT_MICROSECONDS));
+
+    return EN_SUCCESS;
+}
@@ -0,0 +1,803 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "StandardIncludes.h"
+#include "I2cInterface.h"
+#include "I2cInterfaceVariables.h"
+#include "TimerInterface.h"
+#include "DeviceDiscovery.h"
+#include "DevicePoll.h"
+#include "AtmelAtsha204a.h"
+#include "AtmelAtsha204aMac.h"
+#include "ModuleEeprom.h"
+#include "RealtimeClock.h"
+#include "SystemMonitor.h"
+#include "ClockGenerator.h"
+#include "Multiplexer.h"
+#include "SimulatedBus.h"
+#include "SimulatedDevices.h"
+
+#include <string.h>
+#include <time.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/// Maximum number of benchmark results
+#define BENCHMARK_MAX_RESULTS 64
+
+/// User EEPROM address used by the benchmark
+#define BENCHMARK_USER_EEPROM_ADDRESS 0x56
+
+/// Voltage applied to a system monitor channel; a multiple of the 2.5 mV resolution
+#define BENCHMARK_CHANNEL_MILLIVOLTS(channel) (1000 + 250 * (channel))
+
+/**
+ * \brief Result of a benchmarked call.
+ */
+typedef struct
+{
+    /// Name of the call
+    const char* pName;
+
+    /// Result code
+    EN_RESULT result;
+
+    /// Bus statistics
+    SimulatedBusStatistics_t statistics;
+
+    /// Simulated time taken by the call, including sleeps, in nanoseconds
+    uint64_t totalTimeNanoseconds;
+} BenchmarkResult_t;
+
+/// Module information stored in the module EEPROM: serial number (0x00), product number (0x04), configuration
+/// (0x08) and MAC address (0x10), as on a Mercury XU5 module
+const uint8_t MODULE_INFO[] = { 0x00, 0x01, 0x23, 0x45, 0x03, 0x33, 0x05, 0x03, 0x12, 0x50, 0x02,
+                                  0x32, 0x46, 0xFF, 0xFF, 0xFF, 0x20, 0xB0, 0xF7, 0x01, 0x23, 0x45 };
+
+/// Data slot of the Atmel ATSHA204A key used by the authentication benchmarks
+#define BENCHMARK_ATSHA204A_KEY_ID 1
+
+/// Number of MACs verified by the MAC verification throughput benchmark
+#define BENCHMARK_MAC_VERIFICATIONS 100000
+
+/// Longest buffer, and number of random buffers per length, of the CRC test vectors
+#define BENCHMARK_CRC_MAX_LENGTH_BYTES 256
+#define BENCHMARK_CRC_VECTORS_PER_LENGTH 16
+
+//-------------------------------------------------------------------------------------------------
+// Global variable definitions
+//-------------------------------------------------------------------------------------------------
+
+/// Benchmark results
+BenchmarkResult_t g_benchmarkResults[BENCHMARK_MAX_RESULTS];
+
+/// Number of benchmark results
+uint32_t g_numberOfBenchmarkResults;
+
+/// Simulated devices
+SimulatedAtmelAtsha204a_t g_simulatedAtsha204a;
+SimulatedMaximDs28cn01_t g_simulatedDs28cn01;
+SimulatedRealtimeClock_t g_simulatedRealtimeClock;
+SimulatedSystemMonitor_t g_simulatedSystemMonitor;
+SimulatedClockGenerator_t g_simulatedClockGenerator;
+SimulatedMultiplexer_t g_simulatedMultiplexer;
+SimulatedUserEeprom_t g_simulatedUserEeprom;
+
+//-------------------------------------------------------------------------------------------------
+// Function declarations
+//-------------------------------------------------------------------------------------------------
+
+// Not exported by ModuleEeprom.h, but benchmarked separately from Eeprom_Read().
+EN_RESULT Eeprom_ReadBasicModuleInfo();
+EN_RESULT Eeprom_ReadModuleConfig();
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Record the result of a benchmarked call, and the bus statistics since Benchmark_Begin().
+ *
+ * \param	pName				Name of the call
+ * \param	result				Result code
+ * \param	startNanoseconds	Simulated time at Benchmark_Begin()
+ */
+void Benchmark_End(const char* pName, EN_RESULT result, uint64_t startNanoseconds)
+{
+    if (g_numberOfBenchmarkResults >= BENCHMARK_MAX_RESULTS)
+    {
+        return;
+    }
+
+    BenchmarkResult_t* pResult = &g_benchmarkResults[g_numberOfBenchmarkResults++];
+    pResult->pName = pName;
+    pResult->result = result;
+    pResult->totalTimeNanoseconds = SimulatedBus_GetTimeNanoseconds() - startNanoseconds;
+    SimulatedBus_GetStatistics(&pResult->statistics);
+}
+
+/**
+ * \brief Reset the bus statistics before a benchmarked call.
+ *
+ * \returns		Simulated time at the start of the call
+ */
+uint64_t Benchmark_Begin()
+{
+    SimulatedBus_ResetStatistics();
+
+    return SimulatedBus_GetTimeNanoseconds();
+}
+
+/// Benchmark a call returning a result code.
+#define BENCHMARK(name, call)                              \
+    do                                                     \
+    {                                                      \
+        uint64_t benchmarkStart = Benchmark_Begin();       \
+        EN_RESULT benchmarkResult = (call);                \
+        Benchmark_End((name), benchmarkResult, benchmarkStart); \
+    } while (0)
+
+/**
+ * \brief Print the benchmark results.
+ */
+void Benchmark_PrintResults()
+{
+    EN_PRINTF("\n%-40s %-10s %9s %8s %7s %5s %12s %14s\n",
+              "Call",
+              "Result",
+              "Transfers",
+              "Messages",
+              "Bytes",
+              "NACKs",
+              "Bus time/us",
+              "Total time/us");
+
+    uint32_t resultIndex;
+    for (resultIndex = 0; resultIndex < g_numberOfBenchmarkResults; resultIndex++)
+    {
+        const BenchmarkResult_t* pResult = &g_benchmarkResults[resultIndex];
+
+        EN_PRINTF("%-40s 0x%08x %9u %8u %7u %5u %12llu %14llu\n",
+                  pResult->pName,
+                  (unsigned int)pResult->result,
+                  pResult->statistics.numberOfTransfers,
+                  pResult->statistics.numberOfMessages,
+                  pResult->statistics.numberOfBytes,
+                  pResult->statistics.numberOfNacks,
+                  (unsigned long long)(pResult->statistics.busTimeNanoseconds / 1000),
+                  (unsigned long long)(pResult->totalTimeNanoseconds / 1000));
+    }
+}
+
+/**
+ * \brief Read the system monitor supply voltage channel 0.
+ */
+EN_RESULT Benchmark_SystemMonitorReadVoltage()
+{
+    int voltage;
+    EN_RETURN_IF_FAILED(SystemMonitor_ReadVoltage(0, &voltage, 1, 1));
+
+    return (voltage == BENCHMARK_CHANNEL_MILLIVOLTS(0)) ? EN_SUCCESS : EN_ERROR_SUPPLY_OUT_OF_RANGE;
+}
+
+/**
+ * \brief Read all system monitor voltage channels, one channel at a time.
+ */
+EN_RESULT Benchmark_SystemMonitorReadEachChannel()
+{
+    uint16_t channel;
+    for (channel = 0; channel < SYSTEM_MONITOR_NUMBER_OF_VOLTAGE_CHANNELS; channel++)
+    {
+        int voltage;
+        EN_RETURN_IF_FAILED(SystemMonitor_ReadVoltage(channel, &voltage, 1, 1));
+
+        if (voltage != BENCHMARK_CHANNEL_MILLIVOLTS(channel))
+        {
+            return EN_ERROR_SUPPLY_OUT_OF_RANGE;
+        }
+    }
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Read all system monitor channels and the temperature with a single read.
+ */
+EN_RESULT Benchmark_SystemMonitorReadAllChannels()
+{
+    SystemMonitorReadings_t readings;
+    EN_RETURN_IF_FAILED(SystemMonitor_ReadAllChannels(&readings));
+
+    uint16_t channel;
+    for (channel = 0; channel < SYSTEM_MONITOR_NUMBER_OF_VOLTAGE_CHANNELS; channel++)
+    {
+        if (readings.inputVoltages[channel] != BENCHMARK_CHANNEL_MILLIVOLTS(channel))
+        {
+            return EN_ERROR_SUPPLY_OUT_OF_RANGE;
+        }
+    }
+
+    EN_PRINTF("System monitor temperature: %d mC\n", readings.temperatureMilliCelsius);
+
+    return (readings.temperatureMilliCelsius == 42500) ? EN_SUCCESS : EN_ERROR_SUPPLY_OUT_OF_RANGE;
+}
+
+/**
+ * \brief Read the time and date from the RTC.
+ */
+EN_RESULT Benchmark_RtcReadTimeAndDate()
+{
+    int hour, minutes, seconds, day, month, year;
+    EN_RETURN_IF_FAILED(Rtc_ReadTime(&hour, &minutes, &seconds));
+    EN_RETURN_IF_FAILED(Rtc_ReadDate(&day, &month, &year));
+
+    EN_PRINTF("RTC: 20%02d-%02d-%02d %02d:%02d:%02d\n", year, month, day, hour, minutes, seconds);
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Read the date and time from the RTC with a single burst read.
+ */
+EN_RESULT Benchmark_RtcReadDateTime()
+{
+    int hour, minutes, seconds, day, month, year;
+    EN_RETURN_IF_FAILED(Rtc_ReadDateTime(&day, &month, &year, &hour, &minutes, &seconds));
+
+    EN_PRINTF("RTC: 20%02d-%02d-%02d %02d:%02d:%02d\n", year, month, day, hour, minutes, seconds);
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Read the RTC temperature.
+ */
+EN_RESULT Benchmark_RtcReadTemperature()
+{
+    int temperatureCelsius;
+    EN_RETURN_IF_FAILED(Rtc_ReadTemperature(&temperatureCelsius));
+
+    EN_PRINTF("RTC temperature: %d C\n", temperatureCelsius);
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Check that the module information read from the module EEPROM matches the simulated contents.
+ */
+EN_RESULT Benchmark_CheckModuleInfo()
+{
+    uint32_t serialNumber;
+    ProductNumberInfo_t productNumberInfo;
+    uint64_t macAddress;
+    EN_RETURN_IF_FAILED(Eeprom_GetModuleInfo(&serialNumber, &productNumberInfo, &macAddress));
+
+    // The configuration layout is selected at runtime from the product family code.
+    const char* pModuleName = Eeprom_GetModuleName();
+
+    EN_PRINTF("Module: %s, serial number %u, product family 0x%x, MAC address 0x%llx\n",
+              (pModuleName != NULL) ? pModuleName : "unknown",
+              serialNumber,
+              productNumberInfo.productFamilyCode,
+              (unsigned long long)macAddress);
+
+    if ((serialNumber != 0x00012345) || (productNumberInfo.productFamilyCode != 0x0333) ||
+        (macAddress != 0x20B0F7012345ULL) || (pModuleName == NULL) || (strcmp(pModuleName, "Mercury XU5") != 0))
+    {
+        return EN_ERROR_FAILED_TO_INITIALISE_EEPROM;
+    }
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Read the module EEPROM as after a warm boot, with the identity snapshot saved and restored as a host would
+ * do with a file.
+ */
+EN_RESULT Benchmark_EepromWarmBoot()
+{
+    ModuleIdentitySnapshot_t snapshot;
+    EN_RETURN_IF_FAILED(Eeprom_GetIdentitySnapshot(&snapshot));
+    EN_RETURN_IF_FAILED(Eeprom_SetIdentitySnapshot(&snapshot));
+
+    EN_RETURN_IF_FAILED(Eeprom_Read());
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Read the module EEPROM as after a cold boot, without an identity snapshot.
+ */
+EN_RESULT Benchmark_EepromColdBoot()
+{
+    ModuleIdentitySnapshot_t snapshot;
+    memset(&snapshot, 0, sizeof(snapshot));
+    EN_RETURN_IF_FAILED(Eeprom_SetIdentitySnapshot(&snapshot));
+
+    EN_RETURN_IF_FAILED(Eeprom_Read());
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Check the table-driven CRC of the ATSHA204A driver against the bitwise CRC of the simulated device, which
+ * serves as the reference: over every length from 0 to BENCHMARK_CRC_MAX_LENGTH_BYTES, for buffers of zeros, of
+ * ones and of pseudo-random bytes, both in one piece and continued over two pieces.
+ */
+EN_RESULT Benchmark_CheckAtmelAtsha204aCrc()
+{
+    uint8_t buffer[BENCHMARK_CRC_MAX_LENGTH_BYTES];
+    uint32_t state = 0x12345678;
+
+    uint32_t length;
+    for (length = 0; length <= BENCHMARK_CRC_MAX_LENGTH_BYTES; length++)
+    {
+        uint32_t vector;
+        for (vector = 0; vector < BENCHMARK_CRC_VECTORS_PER_LENGTH + 2; vector++)
+        {
+            uint32_t index;
+            for (index = 0; index < length; index++)
+            {
+                // The first two vectors are all zeros and all ones; the others come from a linear congruential
+                // generator, so that the vectors are the same on every run.
+                state = state * 1664525 + 1013904223;
+                buffer[index] = (vector == 0) ? 0x00 : (vector == 1) ? 0xFF : (uint8_t)(state >> 24);
+            }
+
+            uint16_t expectedCrc = SimulatedAtmelAtsha204a_CalculateCrc(buffer, length);
+            uint16_t splitIndex = (uint16_t)((length != 0) ? (state >> 8) % (length + 1) : 0);
+
+            if ((AtmelAtsha204a_UpdateCrc(0, buffer, (uint16_t)length) != expectedCrc) ||
+                (AtmelAtsha204a_UpdateCrc(AtmelAtsha204a_UpdateCrc(0, buffer, splitIndex),
+                                          &buffer[splitIndex],
+                                          (uint16_t)(length - splitIndex)) != expectedCrc))
+            {
+                EN_PRINTF("CRC mismatch for %u bytes (vector %u)\n", length, vector);
+                return EN_ERROR_ATSHA204A_INVALID_RESPONSE_CRC;
+            }
+        }
+    }
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Read the device revision, generate a random number and compute a MAC of a challenge on the ATSHA204A.
+ *
+ * \param	pipelined	True to run the commands as one pipeline, false to run each of them on its own
+ */
+EN_RESULT Benchmark_AtmelAtsha204aCommands(bool pipelined)
+{
+    uint8_t revision[ATMEL_ATSHA204A_DEVICE_REVISION_SIZE_BYTES];
+    uint8_t random[ATMEL_ATSHA204A_RANDOM_SIZE_BYTES];
+    uint8_t challenge[ATMEL_ATSHA204A_CHALLENGE_SIZE_BYTES];
+    uint8_t digest[ATMEL_ATSHA204A_DIGEST_SIZE_BYTES];
+    AtmelAtsha204aCommand_t commands[3];
+
+    memset(challenge, 0x5A, sizeof(challenge));
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_PrepareDeviceRevision(&commands[0], revision));
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_PrepareRandom(&commands[1], ERandomMode_NoSeedUpdate, random));
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_PrepareMac(&commands[2], 0, BENCHMARK_ATSHA204A_KEY_ID, challenge, digest));
+
+    if (pipelined)
+    {
+        return AtmelAtsha204a_ExecuteCommands(commands, 3);
+    }
+
+    unsigned int index;
+    for (index = 0; index < 3; index++)
+    {
+        EN_RETURN_IF_FAILED(AtmelAtsha204a_ExecuteCommands(&commands[index], 1));
+    }
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Authenticate with a nonce on the ATSHA204A, verify the MACs on the host, and check a MAC with CheckMac: the
+ * MAC must be accepted, and a MAC with a flipped bit must be rejected.
+ */
+EN_RESULT Benchmark_AtmelAtsha204aAuthenticate()
+{
+    uint8_t numIn[ATMEL_ATSHA204A_NONCE_INPUT_SIZE_BYTES];
+    uint8_t randOut[ATMEL_ATSHA204A_RANDOM_SIZE_BYTES];
+    uint8_t challenge[ATMEL_ATSHA204A_CHALLENGE_SIZE_BYTES];
+    uint8_t nonceDigest[ATMEL_ATSHA204A_DIGEST_SIZE_BYTES];
+    uint8_t digest[ATMEL_ATSHA204A_DIGEST_SIZE_BYTES];
+    AtmelAtsha204aCommand_t commands[3];
+
+    // MAC of the TempKey loaded by a random nonce, and MAC of a challenge
+    memset(numIn, 0xA5, sizeof(numIn));
+    memset(challenge, 0x5A, sizeof(challenge));
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_PrepareNonce(&commands[0], ENonceMode_NoSeedUpdate, numIn, randOut));
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_PrepareMac(
+        &commands[1], EMacMode_TempKeyChallenge, BENCHMARK_ATSHA204A_KEY_ID, NULL, nonceDigest));
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_PrepareMac(&commands[2], 0, BENCHMARK_ATSHA204A_KEY_ID, challenge, digest));
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_ExecuteCommands(commands, 3));
+
+    // Verify both MACs on the host, with the key of the erased data slot, and the serial number and OTP zone read
+    // from the device
+    uint8_t key[ATMEL_ATSHA204A_CHALLENGE_SIZE_BYTES];
+    uint8_t tempKey[ATMEL_ATSHA204A_MAC_DIGEST_SIZE_BYTES];
+    uint8_t configZone[13];
+    AtmelAtsha204aMacDevice_t device;
+    bool valid[2];
+
+    memset(key, 0xFF, sizeof(key));
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_BeginSession());
+    EN_RESULT result = AtmelAtsha204a_ReadZone(EZoneSelect_Config, 0, sizeof(configZone), configZone);
+    if (EN_SUCCEEDED(result))
+    {
+        result = AtmelAtsha204a_ReadZone(EZoneSelect_Otp, 0, sizeof(device.otp), device.otp);
+    }
+    AtmelAtsha204a_EndSession();
+    EN_RETURN_IF_FAILED(result);
+    memcpy(&device.serialNumber[0], &configZone[0], 4);
+    memcpy(&device.serialNumber[4], &configZone[8], 5);
+    EN_RETURN_IF_FAILED(AtmelAtsha204aMac_CalculateNonceTempKey(randOut, numIn, ENonceMode_NoSeedUpdate, tempKey));
+
+    const AtmelAtsha204aMacCheck_t checks[2] = {
+        { &device, EMacMode_TempKeyChallenge, BENCHMARK_ATSHA204A_KEY_ID, key, tempKey, nonceDigest },
+        { &device, 0, BENCHMARK_ATSHA204A_KEY_ID, key, challenge, digest }
+    };
+
+    EN_RETURN_IF_FAILED(AtmelAtsha204aMac_VerifyBatch(checks, 2, valid));
+    if (!valid[0] || !valid[1])
+    {
+        return EN_ERROR_ATSHA204A_INVALID_MAC;
+    }
+
+    // The other data holds the opcode, mode and key ID of the MAC command
+    const uint8_t otherData[ATMEL_ATSHA204A_CHECK_MAC_OTHER_DATA_SIZE_BYTES] = { ECommand_Mac,
+                                                                               0,
+                                                                               BENCHMARK_ATSHA204A_KEY_ID };
+
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_PrepareCheckMac(
+        &commands[0], 0, BENCHMARK_ATSHA204A_KEY_ID, challenge, digest, otherData));
+    digest[0] ^= 0x01;
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_PrepareCheckMac(
+        &commands[1], 0, BENCHMARK_ATSHA204A_KEY_ID, challenge, digest, otherData));
+
+    EN_RETURN_IF_FAILED(AtmelAtsha204a_ExecuteCommands(&commands[0], 1));
+    if (AtmelAtsha204a_ExecuteCommands(&commands[1], 1) != EN_ERROR_ATSHA204A_INVALID_MAC)
+    {
+        return EN_ERROR_ATSHA204A_INVALID_MAC;
+    }
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Get the real time, for the benchmarks which run on the host rather than on the simulated bus.
+ *
+ * \returns		Time in nanoseconds
+ */
+uint64_t Benchmark_GetHostTimeNanoseconds()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (uint64_t)time.tv_sec * 1000000000ULL + time.tv_nsec;
+}
+
+/**
+ * \brief Measure the host throughput of the MAC verification, batched and one MAC at a time, and check that all
+ * MACs are accepted and that a MAC with a flipped bit is rejected.
+ */
+EN_RESULT Benchmark_MacVerificationThroughput()
+{
+    static uint8_t challenges[BENCHMARK_MAC_VERIFICATIONS][ATMEL_ATSHA204A_CHALLENGE_SIZE_BYTES];
+    static uint8_t responses[BENCHMARK_MAC_VERIFICATIONS][ATMEL_ATSHA204A_MAC_DIGEST_SIZE_BYTES];
+    static AtmelAtsha204aMacCheck_t checks[BENCHMARK_MAC_VERIFICATIONS];
+    static bool valid[BENCHMARK_MAC_VERIFICATIONS];
+    uint8_t key[ATMEL_ATSHA204A_CHALLENGE_SIZE_BYTES];
+    uint8_t message[ATMEL_ATSHA204A_MAC_MESSAGE_SIZE_BYTES];
+    AtmelAtsha204aMacDevice_t device;
+
+    memset(key, 0xFF, sizeof(key));
+    memset(&device, 0x3C, sizeof(device));
+
+    uint32_t index;
+    for (index = 0; index < BENCHMARK_MAC_VERIFICATIONS; index++)
+    {
+        memset(challenges[index], 0, sizeof(challenges[index]));
+        memcpy(challenges[index], &index, sizeof(index));
+
+        checks[index].pDevice = &device;
+        checks[index].mode = EMacMode_IncludeSerialNumber;
+        checks[index].keyId = BENCHMARK_ATSHA204A_KEY_ID;
+        checks[index].pKey = key;
+        checks[index].pChallenge = challenges[index];
+        checks[index].pResponse = responses[index];
+
+        EN_RETURN_IF_FAILED(AtmelAtsha204aMac_BuildMessage(&checks[index], message));
+        AtmelAtsha204aMac_Sha256(message, sizeof(message), responses[index]);
+    }
+
+    responses[BENCHMARK_MAC_VERIFICATIONS / 2][7] ^= 0x10;
+
+    uint64_t startNanoseconds = Benchmark_GetHostTimeNanoseconds();
+    EN_RETURN_IF_FAILED(AtmelAtsha204aMac_VerifyBatch(checks, BENCHMARK_MAC_VERIFICATIONS, valid));
+    uint64_t batchNanoseconds = Benchmark_GetHostTimeNanoseconds() - startNanoseconds;
+
+    for (index = 0; index < BENCHMARK_MAC_VERIFICATIONS; index++)
+    {
+        if (valid[index] != (index != BENCHMARK_MAC_VERIFICATIONS / 2))
+        {
+            return EN_ERROR_ATSHA204A_INVALID_MAC;
+        }
+    }
+
+    startNanoseconds = Benchmark_GetHostTimeNanoseconds();
+    for (index = 0; index < BENCHMARK_MAC_VERIFICATIONS; index++)
+    {
+        EN_RETURN_IF_FAILED(AtmelAtsha204aMac_VerifyBatch(&checks[index], 1, &valid[index]));
+    }
+    uint64_t singleNanoseconds = Benchmark_GetHostTimeNanoseconds() - startNanoseconds;
+
+    EN_PRINTF("MAC verification on the host: %u MACs, %llu per second batched (%u per batch, %s), "
+              "%llu per second one by one\n",
+              BENCHMARK_MAC_VERIFICATIONS,
+              (unsigned long long)(BENCHMARK_MAC_VERIFICATIONS * 1000000000ULL / (batchNanoseconds + 1)),
+              ATMEL_ATSHA204A_MAC_BATCH_SIZE,
+              AtmelAtsha204aMac_GetBatchImplementation(),
+              (unsigned long long)(BENCHMARK_MAC_VERIFICATIONS * 1000000000ULL / (singleNanoseconds + 1)));
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Initialise the clock generator.
+ */
+EN_RESULT Benchmark_ClockGeneratorInitialise()
+{
+    bool devicePresent = false;
+    EN_RETURN_IF_FAILED(ClkGen_Initialise(&devicePresent));
+
+    return devicePresent ? EN_SUCCESS : EN_ERROR_I2C_SLAVE_NACK;
+}
+
+/**
+ * \brief Reprogram the clock generator after a few multisynth registers have drifted from the register map.
+ */
+EN_RESULT Benchmark_ClockGeneratorWriteChangedData()
+{
+    g_simulatedClockGenerator.registers[0][53] ^= 0x01;
+    g_simulatedClockGenerator.registers[0][55] ^= 0x01;
+
+    // The registers were changed behind the back of the driver, so its register cache is stale
+    ClkGen_InvalidateCache();
+
+    return ClkGen_WriteChangedData();
+}
+
+/**
+ * \brief Retune output 0 of the clock generator from 200 MHz to 156.25 MHz, and check the MultiSynth parameters.
+ */
+EN_RESULT Benchmark_ClockGeneratorSetOutputFrequency()
+{
+    EN_RETURN_IF_FAILED(ClkGen_SetOutputFrequency(0, 156250000));
+
+    // 2.4 GHz / 156.25 MHz = 15 + 9/25: P1 = 15 * 128 + floor(9 * 128 / 25) - 512 = 1454, P2 = 1152 mod 25 = 2, P3 = 25
+    const uint8_t* pParameters = &g_simulatedClockGenerator.registers[0][53];
+    uint32_t p1 = pParameters[0] | (pParameters[1] << 8) | ((pParameters[2] & 0x03) << 16);
+    uint32_t p2 = (pParameters[2] >> 2) | (pParameters[3] << 6) | (pParameters[4] << 14) | (pParameters[5] << 22);
+    uint32_t p3 = pParameters[6] | (pParameters[7] << 8) | (pParameters[8] << 16) | ((pParameters[9] & 0x3F) << 24);
+
+    return ((p1 == 1454) && (p2 == 2) && (p3 == 25)) ? EN_SUCCESS : EN_ERROR_INVALID_ARGUMENT;
+}
+
+/**
+ * \brief Initialise the multiplexer.
+ */
+EN_RESULT Benchmark_MultiplexerInitialise()
+{
+    bool devicePresent = false;
+    EN_RETURN_IF_FAILED(Mux_Initialise(&devicePresent));
+
+    return devicePresent ? EN_SUCCESS : EN_ERROR_I2C_SLAVE_NACK;
+}
+
+/**
+ * \brief Write a page of the user EEPROM.
+ */
+EN_RESULT Benchmark_UserEepromWritePage()
+{
+    uint8_t page[SIMULATED_USER_EEPROM_PAGE_SIZE_BYTES];
+
+    uint32_t byteIndex;
+    for (byteIndex = 0; byteIndex < sizeof(page); byteIndex++)
+    {
+        page[byteIndex] = (uint8_t)byteIndex;
+    }
+
+    return I2cWrite(BENCHMARK_USER_EEPROM_ADDRESS, 0x0040, EI2cSubAddressMode_TwoBytes, page, sizeof(page));
+}
+
+/**
+ * \brief Read back the page of the user EEPROM, polling until the write cycle is complete.
+ */
+EN_RESULT Benchmark_UserEepromReadPage()
+{
+    uint8_t page[SIMULATED_USER_EEPROM_PAGE_SIZE_BYTES];
+
+    // The write cycle takes at most 5 ms
+    const DevicePollTiming_t pollTiming = { 100, 1000, 10000 };
+    EN_RETURN_IF_FAILED(DevicePoll_ReadWhenReady(
+        BENCHMARK_USER_EEPROM_ADDRESS, 0x0040, EI2cSubAddressMode_TwoBytes, sizeof(page), page, &pollTiming, NULL));
+
+    uint32_t byteIndex;
+    for (byteIndex = 0; byteIndex < sizeof(page); byteIndex++)
+    {
+        if (page[byteIndex] != (uint8_t)byteIndex)
+        {
+            return EN_ERROR_I2C_READ_FAILED;
+        }
+    }
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Attach the devices of a module to the simulated bus.
+ *
+ * \param	atmelAtsha204a	True for an Atmel ATSHA204A module EEPROM, false for a Maxim DS28CN01
+ * \param	rtcType			Realtime clock type
+ */
+void Benchmark_AttachDevices(bool atmelAtsha204a, ESimulatedRtcType_t rtcType)
+{
+    uint8_t otpZone[SIMULATED_ATSHA204A_OTP_ZONE_SIZE_BYTES];
+    memset(otpZone, 0xFF, sizeof(otpZone));
+    memcpy(otpZone, MODULE_INFO, sizeof(MODULE_INFO));
+
+    SimulatedBus_Initialise(I2C_CLOCK_SPEED_HZ);
+
+    if (atmelAtsha204a)
+    {
+        SimulatedAtmelAtsha204a_Initialise(&g_simulatedAtsha204a, otpZone);
+        SimulatedBus_AttachDevice(&g_simulatedAtsha204a.device);
+    }
+    else
+    {
+        uint8_t eeprom[128];
+        memset(eeprom, 0xFF, sizeof(eeprom));
+        memcpy(eeprom, MODULE_INFO, sizeof(MODULE_INFO));
+
+        SimulatedMaximDs28cn01_Initialise(&g_simulatedDs28cn01, 0x5C, eeprom);
+        SimulatedBus_AttachDevice(&g_simulatedDs28cn01.device);
+    }
+
+    SimulatedRealtimeClock_Initialise(&g_simulatedRealtimeClock, rtcType);
+    SimulatedBus_AttachDevice(&g_simulatedRealtimeClock.device);
+
+    SimulatedSystemMonitor_Initialise(&g_simulatedSystemMonitor);
+    uint8_t channel;
+    for (channel = 0; channel < SYSTEM_MONITOR_NUMBER_OF_VOLTAGE_CHANNELS; channel++)
+    {
+        SimulatedSystemMonitor_SetChannelVoltage(
+            &g_simulatedSystemMonitor, channel, BENCHMARK_CHANNEL_MILLIVOLTS(channel));
+    }
+    SimulatedSystemMonitor_SetTemperature(&g_simulatedSystemMonitor, 42500);
+    SimulatedBus_AttachDevice(&g_simulatedSystemMonitor.device);
+
+    SimulatedClockGenerator_Initialise(&g_simulatedClockGenerator);
+    SimulatedBus_AttachDevice(&g_simulatedClockGenerator.device);
+
+    // The user EEPROM is connected behind channel 0 of the multiplexer, to exercise the multiplexer model.
+    SimulatedMultiplexer_Initialise(&g_simulatedMultiplexer);
+    SimulatedBus_AttachDevice(&g_simulatedMultiplexer.device);
+
+    SimulatedUserEeprom_Initialise(&g_simulatedUserEeprom);
+    g_simulatedUserEeprom.device.pMultiplexer = &g_simulatedMultiplexer.device;
+    g_simulatedUserEeprom.device.multiplexerChannel = 0;
+    SimulatedBus_AttachDevice(&g_simulatedUserEeprom.device);
+}
+
+int main(int argc, char* argv[])
+{
+    bool trace = (argc > 1) && (strcmp(argv[1], "--trace") == 0);
+
+    InitialiseTimer();
+
+    // Module with an Atmel ATSHA204A module EEPROM and an Intersil ISL12020 RTC
+    Benchmark_AttachDevices(true, ESimulatedRtcType_ISL12020);
+    SimulatedBus_SetTrace(trace);
+    BENCHMARK("InitialiseI2cInterface", InitialiseI2cInterface());
+    BENCHMARK("DeviceDiscovery_ScanModule", DeviceDiscovery_ScanModule());
+
+    BENCHMARK("Eeprom_Initialise (ATSHA204A)", Eeprom_Initialise());
+    BENCHMARK("Eeprom_ReadBasicModuleInfo (ATSHA204A)", Eeprom_ReadBasicModuleInfo());
+    BENCHMARK("Eeprom_ReadModuleConfig (ATSHA204A)", Eeprom_ReadModuleConfig());
+    BENCHMARK("Eeprom_GetModuleInfo", Benchmark_CheckModuleInfo());
+    BENCHMARK("Eeprom_Read (cold boot, ATSHA204A)", Benchmark_EepromColdBoot());
+    BENCHMARK("Eeprom_GetModuleInfo", Benchmark_CheckModuleInfo());
+    BENCHMARK("Eeprom_Read (warm boot, ATSHA204A)", Benchmark_EepromWarmBoot());
+    BENCHMARK("Eeprom_GetModuleInfo", Benchmark_CheckModuleInfo());
+    BENCHMARK("AtmelAtsha204a_UpdateCrc (test vectors)", Benchmark_CheckAtmelAtsha204aCrc());
+    BENCHMARK("ATSHA204A DevRev/Random/MAC (separate)", Benchmark_AtmelAtsha204aCommands(false));
+    BENCHMARK("ATSHA204A DevRev/Random/MAC (pipeline)", Benchmark_AtmelAtsha204aCommands(true));
+    BENCHMARK("ATSHA204A Nonce/MAC/CheckMac", Benchmark_AtmelAtsha204aAuthenticate());
+
+    BENCHMARK("Rtc_Initialise (ISL12020)", Rtc_Initialise());
+    BENCHMARK("Rtc_SetTime", Rtc_SetTime(11, 22, 33));
+    BENCHMARK("Rtc_SetDate", Rtc_SetDate(22, 11, 20));
+    BENCHMARK("Rtc_ReadTime + Rtc_ReadDate", Benchmark_RtcReadTimeAndDate());
+    BENCHMARK("Rtc_ReadDateTime", Benchmark_RtcReadDateTime());
+    BENCHMARK("Rtc_ReadTemperature", Benchmark_RtcReadTemperature());
+
+    BENCHMARK("SystemMonitor_Initialise", SystemMonitor_Initialise());
+    BENCHMARK("SystemMonitor_ReadVoltage", Benchmark_SystemMonitorReadVoltage());
+    BENCHMARK("SystemMonitor_ReadVoltage x7", Benchmark_SystemMonitorReadEachChannel());
+    BENCHMARK("SystemMonitor_ReadAllChannels", Benchmark_SystemMonitorReadAllChannels());
+
+    BENCHMARK("ClkGen_Initialise", Benchmark_ClockGeneratorInitialise());
+    BENCHMARK("ClkGen_WriteData", ClkGen_WriteData());
+    BENCHMARK("ClkGen_WriteChangedData (no change)", ClkGen_WriteChangedData());
+    BENCHMARK("ClkGen_WriteChangedData (cached)", ClkGen_WriteChangedData());
+    BENCHMARK("ClkGen_WriteChangedData (2 changes)", Benchmark_ClockGeneratorWriteChangedData());
+    BENCHMARK("ClkGen_SetOutputFrequency", Benchmark_ClockGeneratorSetOutputFrequency());
+
+    BENCHMARK("Mux_Initialise", Benchmark_MultiplexerInitialise());
+    BENCHMARK("Mux_Write", Mux_Write(0));
+    BENCHMARK("User EEPROM page write", Benchmark_UserEepromWritePage());
+    BENCHMARK("User EEPROM page read", Benchmark_UserEepromReadPage());
+
+    // Module with a Maxim DS28CN01 module EEPROM and an NXP PCF85063A RTC
+    Benchmark_AttachDevices(false, ESimulatedRtcType_NXPPCF85063A);
+    SimulatedBus_SetTrace(trace);
+    DeviceDiscovery_Reset();
+    BENCHMARK("DeviceDiscovery_ScanModule", DeviceDiscovery_ScanModule());
+
+    BENCHMARK("Eeprom_Initialise (DS28CN01)", Eeprom_Initialise());
+    BENCHMARK("Eeprom_ReadBasicModuleInfo (DS28CN01)", Eeprom_ReadBasicModuleInfo());
+    BENCHMARK("Eeprom_ReadModuleConfig (DS28CN01)", Eeprom_ReadModuleConfig());
+    BENCHMARK("Eeprom_GetModuleInfo", Benchmark_CheckModuleInfo());
+    BENCHMARK("Eeprom_Read (cold boot, DS28CN01)", Benchmark_EepromColdBoot());
+    BENCHMARK("Eeprom_GetModuleInfo", Benchmark_CheckModuleInfo());
+    BENCHMARK("Eeprom_Read (warm boot, DS28CN01)", Benchmark_EepromWarmBoot());
+    BENCHMARK("Eeprom_GetModuleInfo", Benchmark_CheckModuleInfo());
+
+    BENCHMARK("Rtc_Initialise (PCF85063A)", Rtc_Initialise());
+    BENCHMARK("Rtc_ReadTime + Rtc_ReadDate", Benchmark_RtcReadTimeAndDate());
+    BENCHMARK("Rtc_ReadDateTime", Benchmark_RtcReadDateTime());
+
+    BENCHMARK("AtmelAtsha204aMac_VerifyBatch (host)", Benchmark_MacVerificationThroughput());
+
+    Benchmark_PrintResults();
+
+    uint32_t resultIndex;
+    for (resultIndex = 0; resultIndex < g_numberOfBenchmarkResults; resultIndex++)
+    {
+        if (EN_FAILED(g_benchmarkResults[resultIndex].result))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
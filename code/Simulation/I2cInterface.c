@@ -0,0 +1,593 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "I2cInterface.h"
+#include "I2cBusSpeed.h"
+#include "I2cInterfaceVariables.h"
+#include "SimulatedBus.h"
+#include "UtilityFunctions.h"
+#include "Completion.h"
+#include "ErrorCodes.h"
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+
+/// Timeout for write transfers
+const uint32_t I2C_WRITE_TIMEOUT_MICROSECONDS = 100000;
+
+/// Timeout for read transfers
+const uint32_t I2C_READ_TIMEOUT_MICROSECONDS = 1000000;
+
+/// Maximum number of address phases in one bus transfer, as for the I2C_RDWR ioctl of the Linux backend
+const uint32_t I2C_MAX_MESSAGES_PER_TRANSFER = 42;
+
+//-------------------------------------------------------------------------------------------------
+// Global variable definitions
+//-------------------------------------------------------------------------------------------------
+
+/// True once the interface has been initialised
+bool g_i2cSimulationInitialised = false;
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Complete a transaction and call its callback.
+ *
+ * \param	pTransaction	Transaction descriptor
+ * \param	result			Result code
+ */
+void I2cCompleteTransaction(I2cTransaction_t* pTransaction, EN_RESULT result)
+{
+    pTransaction->result = result;
+    pTransaction->status = EI2cTransactionStatus_Complete;
+    Completion_Signal(&pTransaction->completion);
+
+    if (pTransaction->callback != NULL)
+    {
+        pTransaction->callback(pTransaction, pTransaction->pCallbackContext);
+    }
+}
+
+/**
+ * \brief Get the number of address phases (i.e. start conditions) needed for a transaction.
+ *
+ * \param	pTransaction	Transaction descriptor
+ * \returns					The number of address phases
+ */
+uint32_t I2cGetNumberOfMessages(const I2cTransaction_t* pTransaction)
+{
+    return ((pTransaction->direction == EI2cDirection_Read) && (pTransaction->headerLength != 0)) ? 2 : 1;
+}
+
+/**
+ * \brief Get the number of bus messages used to describe a transaction.
+ *
+ * The header and each data segment of a write are separate messages, the ones after the first continuing
+ * the write without a start condition, so that no data needs to be copied.
+ *
+ * \param	pTransaction	Transaction descriptor
+ * \returns					The number of messages
+ */
+uint32_t I2cGetNumberOfDescriptors(const I2cTransaction_t* pTransaction)
+{
+    if (pTransaction->direction == EI2cDirection_Read)
+    {
+        return I2cGetNumberOfMessages(pTransaction);
+    }
+
+    uint32_t numberOfDataMessages = (pTransaction->pSegments != NULL) ? pTransaction->numberOfSegments : 1;
+
+    return ((pTransaction->headerLength != 0) ? 1 : 0) + numberOfDataMessages;
+}
+
+/**
+ * \brief Append a message to a message list.
+ *
+ * \param	pMessage		Message to set
+ * \param	deviceAddress	Device address
+ * \param	flags			Message flags
+ * \param	pData			Message data
+ * \param	length			The number of data bytes
+ * \returns					Pointer to the next message
+ */
+SimulatedMessage_t* I2cSetMessage(
+    SimulatedMessage_t* pMessage, uint8_t deviceAddress, uint8_t flags, const uint8_t* pData, uint32_t length)
+{
+    pMessage->deviceAddress = deviceAddress;
+    pMessage->flags = flags;
+    pMessage->pData = (uint8_t*)pData;
+    pMessage->length = length;
+
+    return pMessage + 1;
+}
+
+/**
+ * \brief Transfer transactions with a single bus transfer, and complete them.
+ *
+ * \param	ppTransactions			Transaction descriptors, needing at most I2C_MAX_MESSAGES_PER_TRANSFER
+ *									address phases
+ * \param	numberOfTransactions	The number of transactions
+ */
+void I2cTransferRequest(I2cTransaction_t* const* ppTransactions, uint32_t numberOfTransactions)
+{
+    uint32_t numberOfDescriptors = 0;
+    uint32_t transactionIndex;
+
+    for (transactionIndex = 0; transactionIndex < numberOfTransactions; transactionIndex++)
+    {
+        numberOfDescriptors += I2cGetNumberOfDescriptors(ppTransactions[transactionIndex]);
+    }
+
+    // The messages only reference the transaction buffers, so the list is small enough for the stack.
+    SimulatedMessage_t messages[numberOfDescriptors];
+    SimulatedMessage_t* pMessage = messages;
+
+    for (transactionIndex = 0; transactionIndex < numberOfTransactions; transactionIndex++)
+    {
+        I2cTransaction_t* pTransaction = ppTransactions[transactionIndex];
+        uint8_t address = pTransaction->deviceAddress;
+        pTransaction->status = EI2cTransactionStatus_InProgress;
+
+        if (pTransaction->direction == EI2cDirection_Read)
+        {
+            if (pTransaction->headerLength != 0)
+            {
+                pMessage = I2cSetMessage(pMessage, address, 0, pTransaction->pHeader, pTransaction->headerLength);
+            }
+
+            pMessage = I2cSetMessage(
+                pMessage, address, SIMULATED_MESSAGE_FLAG_READ, pTransaction->pData, pTransaction->numberOfBytes);
+            continue;
+        }
+
+        uint8_t flags = 0;
+        if (pTransaction->headerLength != 0)
+        {
+            pMessage = I2cSetMessage(pMessage, address, 0, pTransaction->pHeader, pTransaction->headerLength);
+            flags = SIMULATED_MESSAGE_FLAG_NO_START;
+        }
+
+        if (pTransaction->pSegments == NULL)
+        {
+            pMessage = I2cSetMessage(pMessage, address, flags, pTransaction->pData, pTransaction->numberOfBytes);
+            continue;
+        }
+
+        uint32_t segmentIndex;
+        for (segmentIndex = 0; segmentIndex < pTransaction->numberOfSegments; segmentIndex++)
+        {
+            pMessage = I2cSetMessage(pMessage,
+                                     address,
+                                     flags,
+                                     pTransaction->pSegments[segmentIndex].pData,
+                                     pTransaction->pSegments[segmentIndex].length);
+            flags = SIMULATED_MESSAGE_FLAG_NO_START;
+        }
+    }
+
+    EN_RESULT result = SimulatedBus_Transfer(messages, numberOfDescriptors);
+
+    // As with the Linux backend, all transactions of a failed transfer get the error.
+    for (transactionIndex = 0; transactionIndex < numberOfTransactions; transactionIndex++)
+    {
+        I2cTransaction_t* pTransaction = ppTransactions[transactionIndex];
+
+#ifdef _DEBUG
+        if (EN_FAILED(result))
+        {
+            EN_PRINTF("Error: I2C transfer with device 0x%x failed\n", pTransaction->deviceAddress);
+        }
+#endif
+
+        if (EN_SUCCEEDED(result))
+        {
+            pTransaction->bytesTransferred = pTransaction->numberOfBytes;
+        }
+
+        I2cBusSpeed_ReportResult(pTransaction->deviceAddress, result);
+        I2cCompleteTransaction(pTransaction, result);
+    }
+}
+
+/**
+ * \brief Set the header (i.e. the subaddress) of a transaction, from its subaddress fields.
+ *
+ * \param	pTransaction	Transaction descriptor
+ * \returns					Result code
+ */
+EN_RESULT I2cSetSubAddressHeader(I2cTransaction_t* pTransaction)
+{
+    pTransaction->pHeader = pTransaction->subAddressBytes;
+
+    switch (pTransaction->subAddressMode)
+    {
+    case EI2cSubAddressMode_None:
+    {
+        pTransaction->headerLength = 0;
+        break;
+    }
+    case EI2cSubAddressMode_OneByte:
+    {
+        pTransaction->subAddressBytes[0] = (uint8_t)pTransaction->subAddress;
+        pTransaction->headerLength = 1;
+        break;
+    }
+    case EI2cSubAddressMode_TwoBytes:
+    {
+        // The subaddress is sent most significant byte first.
+        pTransaction->subAddressBytes[0] = GetUpperByte(pTransaction->subAddress);
+        pTransaction->subAddressBytes[1] = GetLowerByte(pTransaction->subAddress);
+        pTransaction->headerLength = 2;
+        break;
+    }
+    default:
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Check a transaction and prepare it for transfer.
+ *
+ * The header (pHeader, headerLength) must already be set.
+ *
+ * \param	pTransaction	Transaction descriptor
+ * \returns					Result code
+ */
+EN_RESULT I2cPrepareTransaction(I2cTransaction_t* pTransaction)
+{
+    if ((pTransaction->headerLength != 0) && (pTransaction->pHeader == NULL))
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    if ((pTransaction->status == EI2cTransactionStatus_Queued) ||
+        (pTransaction->status == EI2cTransactionStatus_InProgress))
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (pTransaction->pSegments != NULL)
+    {
+        // Scatter-gather write: the data is taken from the segments.
+        if (pTransaction->direction != EI2cDirection_Write)
+        {
+            return EN_ERROR_INVALID_ARGUMENT;
+        }
+
+        pTransaction->numberOfBytes = 0;
+
+        uint32_t segmentIndex;
+        for (segmentIndex = 0; segmentIndex < pTransaction->numberOfSegments; segmentIndex++)
+        {
+            if ((pTransaction->pSegments[segmentIndex].pData == NULL) &&
+                (pTransaction->pSegments[segmentIndex].length != 0))
+            {
+                return EN_ERROR_NULL_POINTER;
+            }
+
+            pTransaction->numberOfBytes += pTransaction->pSegments[segmentIndex].length;
+        }
+    }
+    else if (pTransaction->pData == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    // A write may consist of the header only (e.g. the wake token of the Atmel ATSHA204A), but a read needs data.
+    if ((pTransaction->numberOfBytes == 0) &&
+        ((pTransaction->direction == EI2cDirection_Read) || (pTransaction->headerLength == 0)))
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!g_i2cSimulationInitialised)
+    {
+        return EN_ERROR_FAILED_TO_INITIALISE_I2C_CONTROLLER;
+    }
+
+    EN_RETURN_IF_FAILED(Completion_Initialise(&pTransaction->completion));
+
+    pTransaction->bytesTransferred = 0;
+    pTransaction->result = EN_SUCCESS;
+    pTransaction->status = EI2cTransactionStatus_Queued;
+
+    return EN_SUCCESS;
+}
+
+/**
+ * \brief Transfer prepared transactions, using as few bus transfers as possible. A new bus transfer is started
+ * whenever the SCL frequency changes, as the frequency is set for a whole transfer.
+ *
+ * \param	ppTransactions			Transaction descriptors
+ * \param	numberOfTransactions	The number of transactions
+ */
+void I2cTransferTransactions(I2cTransaction_t* const* ppTransactions, uint32_t numberOfTransactions)
+{
+    uint32_t firstIndex = 0;
+
+    while (firstIndex < numberOfTransactions)
+    {
+        uint32_t numberOfMessages = 0;
+        uint32_t endIndex = firstIndex;
+        uint32_t clockSpeedHz = I2cBusSpeed_GetClockSpeed(ppTransactions[firstIndex]->deviceAddress);
+
+        while ((endIndex < numberOfTransactions) &&
+               (numberOfMessages + I2cGetNumberOfMessages(ppTransactions[endIndex]) <= I2C_MAX_MESSAGES_PER_TRANSFER) &&
+               (I2cBusSpeed_GetClockSpeed(ppTransactions[endIndex]->deviceAddress) == clockSpeedHz))
+        {
+            numberOfMessages += I2cGetNumberOfMessages(ppTransactions[endIndex]);
+            endIndex++;
+        }
+
+        if (clockSpeedHz != SimulatedBus_GetClockFrequency())
+        {
+            SimulatedBus_SetClockFrequency(clockSpeedHz);
+        }
+
+        I2cTransferRequest(&ppTransactions[firstIndex], endIndex - firstIndex);
+        firstIndex = endIndex;
+    }
+}
+
+EN_RESULT InitialiseI2cInterface()
+{
+    // The devices are attached to the simulated bus by the application, before the interface is initialised.
+    // The SCL frequency is changed before each transfer, to the one of the addressed devices.
+    I2cBusSpeed_Initialise(I2C_CLOCK_SPEED_HZ, I2C_MAX_CLOCK_SPEED_HZ);
+    SimulatedBus_SetClockFrequency(I2C_CLOCK_SPEED_HZ);
+    g_i2cSimulationInitialised = true;
+
+    return EN_SUCCESS;
+}
+
+void I2cInitialiseTransaction(I2cTransaction_t* pTransaction,
+                              uint8_t deviceAddress,
+                              EI2cDirection_t direction,
+                              uint16_t subAddress,
+                              EI2cSubAddressMode_t subAddressMode,
+                              uint8_t* pData,
+                              uint32_t numberOfBytes)
+{
+    pTransaction->deviceAddress = deviceAddress;
+    pTransaction->direction = direction;
+    pTransaction->subAddress = subAddress;
+    pTransaction->subAddressMode = subAddressMode;
+    pTransaction->pData = pData;
+    pTransaction->numberOfBytes = numberOfBytes;
+    pTransaction->pSegments = NULL;
+    pTransaction->numberOfSegments = 0;
+    pTransaction->priority = EI2cPriority_Normal;
+    pTransaction->flags = I2C_TRANSACTION_FLAG_NONE;
+    pTransaction->callback = NULL;
+    pTransaction->pCallbackContext = NULL;
+    pTransaction->status = EI2cTransactionStatus_Idle;
+    pTransaction->result = EN_SUCCESS;
+}
+
+EN_RESULT I2cSubmit(I2cTransaction_t* pTransaction)
+{
+    EN_RETURN_IF_FAILED(I2cSubmitBatch(&pTransaction, 1));
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT I2cSubmitBatch(I2cTransaction_t* const* ppTransactions, uint32_t numberOfTransactions)
+{
+    if (ppTransactions == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    // The simulated bus has a single master, so priorities and chunking are not needed: the transactions are
+    // transferred before this function returns.
+    EN_RESULT result = EN_SUCCESS;
+    uint32_t numberOfPrepared;
+
+    for (numberOfPrepared = 0; numberOfPrepared < numberOfTransactions; numberOfPrepared++)
+    {
+        I2cTransaction_t* pTransaction = ppTransactions[numberOfPrepared];
+
+        if (pTransaction == NULL)
+        {
+            result = EN_ERROR_NULL_POINTER;
+            break;
+        }
+
+        result = I2cSetSubAddressHeader(pTransaction);
+        if (EN_SUCCEEDED(result))
+        {
+            result = I2cPrepareTransaction(pTransaction);
+        }
+
+        if (EN_FAILED(result))
+        {
+            break;
+        }
+    }
+
+    I2cTransferTransactions(ppTransactions, numberOfPrepared);
+
+    return result;
+}
+
+bool I2cIsTransactionComplete(const I2cTransaction_t* pTransaction)
+{
+    return (pTransaction->status == EI2cTransactionStatus_Complete);
+}
+
+void I2cCancel(I2cTransaction_t* pTransaction, EN_RESULT result)
+{
+    // Submitted transactions are complete when I2cSubmit() returns, so there is nothing to abort.
+    if ((pTransaction->status == EI2cTransactionStatus_Queued) ||
+        (pTransaction->status == EI2cTransactionStatus_InProgress))
+    {
+        pTransaction->result = result;
+        pTransaction->status = EI2cTransactionStatus_Complete;
+        Completion_Signal(&pTransaction->completion);
+    }
+}
+
+EN_RESULT I2cWaitForTransaction(I2cTransaction_t* pTransaction, uint32_t timeoutMicroseconds)
+{
+    if (pTransaction == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    if (EN_FAILED(Completion_Wait(&pTransaction->completion, timeoutMicroseconds)))
+    {
+        I2cCancel(pTransaction,
+                  (pTransaction->direction == EI2cDirection_Read) ? EN_ERROR_I2C_READ_TIMEOUT
+                                                                  : EN_ERROR_I2C_WRITE_TIMEOUT);
+    }
+
+    return pTransaction->result;
+}
+
+EN_RESULT I2cWriteRead(uint8_t deviceAddress,
+                       const uint8_t* pWriteBuffer,
+                       uint32_t numberOfBytesToWrite,
+                       uint8_t* pReadBuffer,
+                       uint32_t numberOfBytesToRead)
+{
+    if (pWriteBuffer == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    if (numberOfBytesToWrite == 0)
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    I2cTransaction_t transaction;
+    I2cInitialiseTransaction(&transaction,
+                             deviceAddress,
+                             EI2cDirection_Read,
+                             0,
+                             EI2cSubAddressMode_None,
+                             pReadBuffer,
+                             numberOfBytesToRead);
+
+    // The write data is sent as the header of the read transaction.
+    transaction.pHeader = pWriteBuffer;
+    transaction.headerLength = numberOfBytesToWrite;
+    EN_RETURN_IF_FAILED(I2cPrepareTransaction(&transaction));
+
+    I2cTransaction_t* pTransaction = &transaction;
+    I2cTransferTransactions(&pTransaction, 1);
+
+    EN_RETURN_IF_FAILED(I2cWaitForTransaction(&transaction, I2C_READ_TIMEOUT_MICROSECONDS));
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT I2cReadWithPriority(uint8_t deviceAddress,
+                              uint16_t subAddress,
+                              EI2cSubAddressMode_t subAddressMode,
+                              uint32_t numberOfBytesToRead,
+                              uint8_t* pReadBuffer,
+                              EI2cPriority_t priority)
+{
+    I2cTransaction_t transaction;
+    I2cInitialiseTransaction(&transaction,
+                             deviceAddress,
+                             EI2cDirection_Read,
+                             subAddress,
+                             subAddressMode,
+                             pReadBuffer,
+                             numberOfBytesToRead);
+    transaction.priority = priority;
+
+    EN_RETURN_IF_FAILED(I2cSubmit(&transaction));
+
+    EN_RETURN_IF_FAILED(I2cWaitForTransaction(&transaction, I2C_READ_TIMEOUT_MICROSECONDS));
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT I2cRead(uint8_t deviceAddress,
+                  uint16_t subAddress,
+                  EI2cSubAddressMode_t subAddressMode,
+                  uint32_t numberOfBytesToRead,
+                  uint8_t* pReadBuffer)
+{
+    EN_RETURN_IF_FAILED(I2cReadWithPriority(
+        deviceAddress, subAddress, subAddressMode, numberOfBytesToRead, pReadBuffer, EI2cPriority_Normal));
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT I2cWrite(uint8_t deviceAddress,
+                   uint16_t subAddress,
+                   EI2cSubAddressMode_t subAddressMode,
+                   const uint8_t* pWriteBuffer,
+                   uint32_t numberOfBytesToWrite)
+{
+    I2cTransaction_t transaction;
+    I2cInitialiseTransaction(&transaction,
+                             deviceAddress,
+                             EI2cDirection_Write,
+                             subAddress,
+                             subAddressMode,
+                             (uint8_t*)pWriteBuffer,
+                             numberOfBytesToWrite);
+
+    EN_RETURN_IF_FAILED(I2cSubmit(&transaction));
+
+    EN_RETURN_IF_FAILED(I2cWaitForTransaction(&transaction, I2C_WRITE_TIMEOUT_MICROSECONDS));
+
+    return EN_SUCCESS;
+}
+
+EN_RESULT I2cWriteVector(uint8_t deviceAddress,
+                         uint16_t subAddress,
+                         EI2cSubAddressMode_t subAddressMode,
+                         const I2cSegment_t* pSegments,
+                         uint32_t numberOfSegments)
+{
+    if (pSegments == NULL)
+    {
+        return EN_ERROR_NULL_POINTER;
+    }
+
+    I2cTransaction_t transaction;
+    I2cInitialiseTransaction(
+        &transaction, deviceAddress, EI2cDirection_Write, subAddress, subAddressMode, NULL, 0);
+    transaction.pSegments = pSegments;
+    transaction.numberOfSegments = numberOfSegments;
+
+    EN_RETURN_IF_FAILED(I2cSubmit(&transaction));
+
+    EN_RETURN_IF_FAILED(I2cWaitForTransaction(&transaction, I2C_WRITE_TIMEOUT_MICROSECONDS));
+
+    return EN_SUCCESS;
+}
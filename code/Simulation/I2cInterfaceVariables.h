@@ -0,0 +1,51 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "StandardIncludes.h"
+
+//-------------------------------------------------------------------------------------------------
+// Definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/// SCL frequency for devices which are not in the device speed table; can be overridden on the compiler command
+/// line, e.g. -DI2C_CLOCK_SPEED_HZ=400000
+#ifndef I2C_CLOCK_SPEED_HZ
+#define I2C_CLOCK_SPEED_HZ 100000
+#endif
+
+/// Highest SCL frequency of the simulated controller; -DI2C_MAX_CLOCK_SPEED_HZ=100000 runs every device in
+/// standard mode
+#ifndef I2C_MAX_CLOCK_SPEED_HZ
+#define I2C_MAX_CLOCK_SPEED_HZ 1000000
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Global variable declarations
+//-------------------------------------------------------------------------------------------------
+
+extern bool g_i2cSimulationInitialised;
@@ -0,0 +1,673 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "SimulatedDevices.h"
+#include "AtmelAtsha204aMac.h"
+
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+
+/// I2C device address
+#define ATSHA204A_DEVICE_ADDRESS 0x64
+
+/// Minimum SDA low time which wakes the device (tWLO)
+#define ATSHA204A_WAKE_LOW_NANOSECONDS 60000ULL
+
+/// Time after the wake token before the device communicates (tWHI)
+#define ATSHA204A_WAKE_HIGH_NANOSECONDS 2500000ULL
+
+/// Watchdog time after which the device goes to sleep
+#define ATSHA204A_WATCHDOG_NANOSECONDS 1300000000ULL
+
+/// Typical execution times of the commands
+#define ATSHA204A_READ_EXECUTION_NANOSECONDS 100000ULL
+#define ATSHA204A_DEVREV_EXECUTION_NANOSECONDS 400000ULL
+#define ATSHA204A_RANDOM_EXECUTION_NANOSECONDS 11000000ULL
+#define ATSHA204A_NONCE_EXECUTION_NANOSECONDS 22000000ULL
+#define ATSHA204A_MAC_EXECUTION_NANOSECONDS 12000000ULL
+#define ATSHA204A_CHECKMAC_EXECUTION_NANOSECONDS 12000000ULL
+
+/// Configuration zone address of the OTP mode byte, and the OTP modes
+#define ATSHA204A_CONFIG_ADDRESS_OTP_MODE 18
+#define ATSHA204A_OTP_MODE_READ_ONLY 0xAA
+#define ATSHA204A_OTP_MODE_LEGACY 0x00
+
+/// Configuration zone addresses of the serial number bytes SN[0:3] and SN[4:8], and of the revision number
+#define ATSHA204A_CONFIG_ADDRESS_SN_0_3 0
+#define ATSHA204A_CONFIG_ADDRESS_REVISION 4
+#define ATSHA204A_CONFIG_ADDRESS_SN_4_8 8
+
+/// Word addresses
+#define ATSHA204A_WORD_ADDRESS_RESET 0x00
+#define ATSHA204A_WORD_ADDRESS_SLEEP 0x01
+#define ATSHA204A_WORD_ADDRESS_IDLE 0x02
+#define ATSHA204A_WORD_ADDRESS_COMMAND 0x03
+
+/// Opcodes
+#define ATSHA204A_OPCODE_READ 0x02
+#define ATSHA204A_OPCODE_MAC 0x08
+#define ATSHA204A_OPCODE_NONCE 0x16
+#define ATSHA204A_OPCODE_RANDOM 0x1B
+#define ATSHA204A_OPCODE_CHECKMAC 0x28
+#define ATSHA204A_OPCODE_DEVREV 0x30
+
+/// MAC and CheckMac mode bits
+#define ATSHA204A_MAC_MODE_TEMPKEY_CHALLENGE 0x01
+#define ATSHA204A_MAC_MODE_TEMPKEY_KEY 0x02
+#define ATSHA204A_MAC_MODE_TEMPKEY_SOURCE_INPUT 0x04
+#define ATSHA204A_MAC_MODE_OTP_88_BITS 0x10
+#define ATSHA204A_MAC_MODE_OTP_64_BITS 0x20
+#define ATSHA204A_MAC_MODE_SERIAL_NUMBER 0x40
+
+/// Nonce modes
+#define ATSHA204A_NONCE_MODE_PASS_THROUGH 0x03
+
+/// Size of the message digested by the MAC and CheckMac commands
+#define ATSHA204A_MAC_MESSAGE_SIZE_BYTES 88
+
+/// Status codes
+#define ATSHA204A_STATUS_SUCCESS 0x00
+#define ATSHA204A_STATUS_MISCOMPARE 0x01
+#define ATSHA204A_STATUS_PARSE_ERROR 0x03
+#define ATSHA204A_STATUS_EXECUTION_ERROR 0x0F
+#define ATSHA204A_STATUS_AFTER_WAKE 0x11
+#define ATSHA204A_STATUS_IO_ERROR 0xFF
+
+/// Minimum command packet size: count, opcode, param 1, param 2 (2 bytes) and CRC (2 bytes)
+#define ATSHA204A_MIN_COMMAND_PACKET_SIZE_BYTES 7
+
+/// Default serial number bytes SN[0:3] and SN[4:8]; SN[0:1] and SN[8] are fixed for all devices
+const uint8_t SIMULATED_ATSHA204A_SN_0_3[4] = { 0x01, 0x23, 0x6C, 0x1A };
+const uint8_t SIMULATED_ATSHA204A_SN_4_8[5] = { 0x5F, 0x28, 0x91, 0x03, 0xEE };
+
+/// Default revision number
+const uint8_t SIMULATED_ATSHA204A_REVISION[4] = { 0x00, 0x09, 0x04, 0x00 };
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+uint16_t SimulatedAtmelAtsha204a_CalculateCrc(const uint8_t* pData, uint32_t length)
+{
+    uint16_t crc = 0;
+
+    uint32_t byteIndex;
+    for (byteIndex = 0; byteIndex < length; byteIndex++)
+    {
+        // The data bits are processed least significant bit first.
+        uint8_t mask;
+        for (mask = 0x01; mask != 0; mask <<= 1)
+        {
+            bool dataBit = ((pData[byteIndex] & mask) != 0);
+            bool crcBit = ((crc & 0x8000) != 0);
+
+            crc <<= 1;
+            if (dataBit != crcBit)
+            {
+                crc ^= 0x8005;
+            }
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * \brief Set the response packet: count, data and CRC.
+ *
+ * \param	pAtsha			Device
+ * \param	pData			Response data
+ * \param	dataLength		The number of data bytes
+ */
+void SimulatedAtmelAtsha204a_SetResponse(SimulatedAtmelAtsha204a_t* pAtsha, const uint8_t* pData, uint8_t dataLength)
+{
+    uint8_t length = dataLength + 3;
+
+    pAtsha->responsePacket[0] = length;
+    memcpy(&pAtsha->responsePacket[1], pData, dataLength);
+
+    uint16_t crc = SimulatedAtmelAtsha204a_CalculateCrc(pAtsha->responsePacket, length - 2);
+    pAtsha->responsePacket[length - 2] = (uint8_t)crc;
+    pAtsha->responsePacket[length - 1] = (uint8_t)(crc >> 8);
+
+    pAtsha->responseLength = length;
+    pAtsha->responseIndex = 0;
+}
+
+/**
+ * \brief Set a status response packet.
+ *
+ * \param	pAtsha		Device
+ * \param	status		Status code
+ */
+void SimulatedAtmelAtsha204a_SetStatus(SimulatedAtmelAtsha204a_t* pAtsha, uint8_t status)
+{
+    SimulatedAtmelAtsha204a_SetResponse(pAtsha, &status, 1);
+}
+
+/**
+ * \brief Execute the Read command.
+ *
+ * \param	pAtsha		Device
+ * \param	zone		Param 1: zone in bits 1..0, 32-byte read in bit 7
+ * \param	address		Param 2: slot in bits 6..3, word offset in bits 2..0
+ */
+void SimulatedAtmelAtsha204a_ExecuteRead(SimulatedAtmelAtsha204a_t* pAtsha, uint8_t zone, uint16_t address)
+{
+    uint32_t length = ((zone & 0x80) != 0) ? 32 : 4;
+    uint32_t offset = (address >> 3) * 32 + (((length == 4) ? (address & 0x07) : 0) * 4);
+
+    const uint8_t* pZone;
+    uint32_t zoneSize;
+
+    switch (zone & 0x03)
+    {
+    case 0:
+        pZone = pAtsha->configZone;
+        zoneSize = sizeof(pAtsha->configZone);
+        break;
+    case 1:
+        pZone = pAtsha->otpZone;
+        zoneSize = sizeof(pAtsha->otpZone);
+        break;
+    case 2:
+        pZone = pAtsha->dataZone;
+        zoneSize = sizeof(pAtsha->dataZone);
+        break;
+    default:
+        SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_PARSE_ERROR);
+        return;
+    }
+
+    // In legacy mode, the OTP zone only supports 4-byte reads.
+    if ((pZone == pAtsha->otpZone) && (length == 32) &&
+        (pAtsha->configZone[ATSHA204A_CONFIG_ADDRESS_OTP_MODE] == ATSHA204A_OTP_MODE_LEGACY))
+    {
+        SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_EXECUTION_ERROR);
+        return;
+    }
+
+    if (offset + length > zoneSize)
+    {
+        SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_EXECUTION_ERROR);
+        return;
+    }
+
+    SimulatedAtmelAtsha204a_SetResponse(pAtsha, &pZone[offset], (uint8_t)length);
+}
+
+/**
+ * \brief Generate random bytes. The sequence is deterministic, so that benchmark runs are reproducible.
+ *
+ * \param	pAtsha		Device
+ * \param	pRandom		Buffer receiving 32 random bytes
+ */
+void SimulatedAtmelAtsha204a_GenerateRandom(SimulatedAtmelAtsha204a_t* pAtsha, uint8_t* pRandom)
+{
+    int i;
+    for (i = 0; i < 32; i++)
+    {
+        pAtsha->randomState = pAtsha->randomState * 1664525 + 1013904223;
+        pRandom[i] = (uint8_t)(pAtsha->randomState >> 24);
+    }
+}
+
+/**
+ * \brief Execute the Nonce command, loading TempKey.
+ *
+ * \param	pAtsha		Device
+ * \param	mode		Param 1: 0 or 1 to combine the input with a random number, 3 for pass-through
+ * \param	pNumIn		Input data
+ * \param	length		The number of input bytes
+ */
+void SimulatedAtmelAtsha204a_ExecuteNonce(SimulatedAtmelAtsha204a_t* pAtsha,
+                                          uint8_t mode,
+                                          const uint8_t* pNumIn,
+                                          uint32_t length)
+{
+    if (mode == ATSHA204A_NONCE_MODE_PASS_THROUGH)
+    {
+        if (length != 32)
+        {
+            SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_PARSE_ERROR);
+            return;
+        }
+
+        memcpy(pAtsha->tempKey, pNumIn, 32);
+        pAtsha->tempKeyValid = true;
+        pAtsha->tempKeySourceInput = true;
+        SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_SUCCESS);
+        return;
+    }
+
+    if ((mode > 1) || (length != 20))
+    {
+        SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_PARSE_ERROR);
+        return;
+    }
+
+    // TempKey = SHA-256(RandOut || NumIn || opcode || mode || 0x00)
+    uint8_t message[32 + 20 + 3];
+    SimulatedAtmelAtsha204a_GenerateRandom(pAtsha, message);
+    memcpy(&message[32], pNumIn, 20);
+    message[52] = ATSHA204A_OPCODE_NONCE;
+    message[53] = mode;
+    message[54] = 0x00;
+
+    AtmelAtsha204aMac_Sha256(message, sizeof(message), pAtsha->tempKey);
+    pAtsha->tempKeyValid = true;
+    pAtsha->tempKeySourceInput = false;
+
+    SimulatedAtmelAtsha204a_SetResponse(pAtsha, message, 32);
+}
+
+/**
+ * \brief Select the key and challenge of a MAC or CheckMac message from the mode, checking TempKey.
+ *
+ * \param	pAtsha		Device
+ * \param	mode		Mode bits
+ * \param	keyId		Data slot of the key
+ * \param	pChallenge	Challenge, used unless TempKey is selected
+ * \param	pMessage	Message receiving the key and the challenge in its first 64 bytes
+ * \returns			True if the mode and TempKey state are valid; otherwise the status is set
+ */
+bool SimulatedAtmelAtsha204a_SetMacKeyAndChallenge(SimulatedAtmelAtsha204a_t* pAtsha,
+                                                   uint8_t mode,
+                                                   uint16_t keyId,
+                                                   const uint8_t* pChallenge,
+                                                   uint8_t* pMessage)
+{
+    bool useTempKey = (mode & (ATSHA204A_MAC_MODE_TEMPKEY_CHALLENGE | ATSHA204A_MAC_MODE_TEMPKEY_KEY)) != 0;
+
+    if ((keyId > 15) || ((mode & 0x80) != 0))
+    {
+        SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_PARSE_ERROR);
+        return false;
+    }
+
+    if (useTempKey &&
+        (!pAtsha->tempKeyValid ||
+         (pAtsha->tempKeySourceInput != ((mode & ATSHA204A_MAC_MODE_TEMPKEY_SOURCE_INPUT) != 0))))
+    {
+        SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_EXECUTION_ERROR);
+        return false;
+    }
+
+    memcpy(&pMessage[0],
+           ((mode & ATSHA204A_MAC_MODE_TEMPKEY_KEY) != 0) ? pAtsha->tempKey : &pAtsha->dataZone[keyId * 32],
+           32);
+    memcpy(&pMessage[32], ((mode & ATSHA204A_MAC_MODE_TEMPKEY_CHALLENGE) != 0) ? pAtsha->tempKey : pChallenge, 32);
+
+    // TempKey is used up by the command
+    if (useTempKey)
+    {
+        pAtsha->tempKeyValid = false;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Execute the MAC command.
+ *
+ * \param	pAtsha		Device
+ * \param	mode		Param 1: mode bits
+ * \param	keyId		Param 2: data slot of the key
+ * \param	pChallenge	Challenge
+ * \param	length		The number of challenge bytes
+ */
+void SimulatedAtmelAtsha204a_ExecuteMac(SimulatedAtmelAtsha204a_t* pAtsha,
+                                        uint8_t mode,
+                                        uint16_t keyId,
+                                        const uint8_t* pChallenge,
+                                        uint32_t length)
+{
+    uint8_t message[ATSHA204A_MAC_MESSAGE_SIZE_BYTES];
+    const uint8_t* pSn03 = &pAtsha->configZone[ATSHA204A_CONFIG_ADDRESS_SN_0_3];
+    const uint8_t* pSn48 = &pAtsha->configZone[ATSHA204A_CONFIG_ADDRESS_SN_4_8];
+
+    if (length != (((mode & ATSHA204A_MAC_MODE_TEMPKEY_CHALLENGE) != 0) ? 0 : 32))
+    {
+        SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_PARSE_ERROR);
+        return;
+    }
+
+    if (!SimulatedAtmelAtsha204a_SetMacKeyAndChallenge(pAtsha, mode, keyId, pChallenge, message))
+    {
+        return;
+    }
+
+    bool includeOtp88 = (mode & ATSHA204A_MAC_MODE_OTP_88_BITS) != 0;
+    bool includeOtp64 = includeOtp88 || ((mode & ATSHA204A_MAC_MODE_OTP_64_BITS) != 0);
+    bool includeSn = (mode & ATSHA204A_MAC_MODE_SERIAL_NUMBER) != 0;
+
+    memset(&message[64], 0, sizeof(message) - 64);
+    message[64] = ATSHA204A_OPCODE_MAC;
+    message[65] = mode;
+    message[66] = (uint8_t)keyId;
+    message[67] = (uint8_t)(keyId >> 8);
+    if (includeOtp64)
+    {
+        memcpy(&message[68], &pAtsha->otpZone[0], 8);
+    }
+    if (includeOtp88)
+    {
+        memcpy(&message[76], &pAtsha->otpZone[8], 3);
+    }
+    message[79] = pSn48[4];
+    if (includeSn)
+    {
+        memcpy(&message[80], &pSn48[0], 4);
+    }
+    message[84] = pSn03[0];
+    message[85] = pSn03[1];
+    if (includeSn)
+    {
+        message[86] = pSn03[2];
+        message[87] = pSn03[3];
+    }
+
+    uint8_t digest[32];
+    AtmelAtsha204aMac_Sha256(message, sizeof(message), digest);
+    SimulatedAtmelAtsha204a_SetResponse(pAtsha, digest, sizeof(digest));
+}
+
+/**
+ * \brief Execute the CheckMac command.
+ *
+ * \param	pAtsha		Device
+ * \param	mode		Param 1: mode bits
+ * \param	keyId		Param 2: data slot of the key
+ * \param	pData		Client challenge (32 bytes), client response (32 bytes) and other data (13 bytes)
+ * \param	length		The number of data bytes
+ */
+void SimulatedAtmelAtsha204a_ExecuteCheckMac(SimulatedAtmelAtsha204a_t* pAtsha,
+                                             uint8_t mode,
+                                             uint16_t keyId,
+                                             const uint8_t* pData,
+                                             uint32_t length)
+{
+    uint8_t message[ATSHA204A_MAC_MESSAGE_SIZE_BYTES];
+    const uint8_t* pClientResponse = &pData[32];
+    const uint8_t* pOtherData = &pData[64];
+    const uint8_t* pSn03 = &pAtsha->configZone[ATSHA204A_CONFIG_ADDRESS_SN_0_3];
+    const uint8_t* pSn48 = &pAtsha->configZone[ATSHA204A_CONFIG_ADDRESS_SN_4_8];
+
+    if ((length != 32 + 32 + 13) || ((mode & (ATSHA204A_MAC_MODE_OTP_88_BITS | ATSHA204A_MAC_MODE_SERIAL_NUMBER)) != 0))
+    {
+        SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_PARSE_ERROR);
+        return;
+    }
+
+    if (!SimulatedAtmelAtsha204a_SetMacKeyAndChallenge(pAtsha, mode, keyId, pData, message))
+    {
+        return;
+    }
+
+    memset(&message[64], 0, sizeof(message) - 64);
+    memcpy(&message[64], &pOtherData[0], 4);
+    if ((mode & ATSHA204A_MAC_MODE_OTP_64_BITS) != 0)
+    {
+        memcpy(&message[68], &pAtsha->otpZone[0], 8);
+    }
+    memcpy(&message[76], &pOtherData[4], 3);
+    message[79] = pSn48[4];
+    memcpy(&message[80], &pOtherData[7], 4);
+    message[84] = pSn03[0];
+    message[85] = pSn03[1];
+    memcpy(&message[86], &pOtherData[11], 2);
+
+    uint8_t digest[32];
+    AtmelAtsha204aMac_Sha256(message, sizeof(message), digest);
+
+    SimulatedAtmelAtsha204a_SetStatus(
+        pAtsha, (memcmp(digest, pClientResponse, sizeof(digest)) == 0) ? ATSHA204A_STATUS_SUCCESS
+                                                                        : ATSHA204A_STATUS_MISCOMPARE);
+}
+
+/**
+ * \brief Check and execute a received command packet.
+ *
+ * \param	pAtsha		Device
+ */
+void SimulatedAtmelAtsha204a_ExecuteCommand(SimulatedAtmelAtsha204a_t* pAtsha)
+{
+    const uint8_t* pPacket = pAtsha->commandPacket;
+    uint8_t count = pPacket[0];
+
+    if ((count < ATSHA204A_MIN_COMMAND_PACKET_SIZE_BYTES) || (count != pAtsha->commandLength))
+    {
+        SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_IO_ERROR);
+        return;
+    }
+
+    uint16_t crc = SimulatedAtmelAtsha204a_CalculateCrc(pPacket, count - 2);
+    if ((pPacket[count - 2] != (uint8_t)crc) || (pPacket[count - 1] != (uint8_t)(crc >> 8)))
+    {
+        SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_IO_ERROR);
+        return;
+    }
+
+    // Param 2 is sent least significant byte first.
+    uint8_t opcode = pPacket[1];
+    uint8_t param1 = pPacket[2];
+    uint16_t param2 = pPacket[3] | (pPacket[4] << 8);
+
+    const uint8_t* pData = &pPacket[5];
+    uint32_t dataLength = count - ATSHA204A_MIN_COMMAND_PACKET_SIZE_BYTES;
+    uint64_t now = SimulatedBus_GetTimeNanoseconds();
+
+    switch (opcode)
+    {
+    case ATSHA204A_OPCODE_READ:
+        SimulatedAtmelAtsha204a_ExecuteRead(pAtsha, param1, param2);
+        pAtsha->busyUntilNanoseconds = now + ATSHA204A_READ_EXECUTION_NANOSECONDS;
+        break;
+    case ATSHA204A_OPCODE_DEVREV:
+        SimulatedAtmelAtsha204a_SetResponse(pAtsha, &pAtsha->configZone[ATSHA204A_CONFIG_ADDRESS_REVISION], 4);
+        pAtsha->busyUntilNanoseconds = now + ATSHA204A_DEVREV_EXECUTION_NANOSECONDS;
+        break;
+    case ATSHA204A_OPCODE_RANDOM:
+    {
+        uint8_t random[32];
+        SimulatedAtmelAtsha204a_GenerateRandom(pAtsha, random);
+        SimulatedAtmelAtsha204a_SetResponse(pAtsha, random, sizeof(random));
+        pAtsha->busyUntilNanoseconds = now + ATSHA204A_RANDOM_EXECUTION_NANOSECONDS;
+        break;
+    }
+    case ATSHA204A_OPCODE_NONCE:
+        SimulatedAtmelAtsha204a_ExecuteNonce(pAtsha, param1, pData, dataLength);
+        pAtsha->busyUntilNanoseconds = now + ATSHA204A_NONCE_EXECUTION_NANOSECONDS;
+        break;
+    case ATSHA204A_OPCODE_MAC:
+        SimulatedAtmelAtsha204a_ExecuteMac(pAtsha, param1, param2, pData, dataLength);
+        pAtsha->busyUntilNanoseconds = now + ATSHA204A_MAC_EXECUTION_NANOSECONDS;
+        break;
+    case ATSHA204A_OPCODE_CHECKMAC:
+        SimulatedAtmelAtsha204a_ExecuteCheckMac(pAtsha, param1, param2, pData, dataLength);
+        pAtsha->busyUntilNanoseconds = now + ATSHA204A_CHECKMAC_EXECUTION_NANOSECONDS;
+        break;
+    default:
+        SimulatedAtmelAtsha204a_SetStatus(pAtsha, ATSHA204A_STATUS_PARSE_ERROR);
+        break;
+    }
+}
+
+/**
+ * \brief Put the device to sleep if the watchdog has expired.
+ *
+ * \param	pAtsha		Device
+ */
+void SimulatedAtmelAtsha204a_CheckWatchdog(SimulatedAtmelAtsha204a_t* pAtsha)
+{
+    if ((pAtsha->state == ESimulatedAtsha204aState_Awake) &&
+        (SimulatedBus_GetTimeNanoseconds() - pAtsha->wakeTimeNanoseconds >= ATSHA204A_WATCHDOG_NANOSECONDS))
+    {
+        pAtsha->state = ESimulatedAtsha204aState_Asleep;
+        pAtsha->tempKeyValid = false;
+    }
+}
+
+bool SimulatedAtmelAtsha204a_Start(SimulatedDevice_t* pDevice, EI2cDirection_t direction)
+{
+    SimulatedAtmelAtsha204a_t* pAtsha = (SimulatedAtmelAtsha204a_t*)pDevice;
+    uint64_t now = SimulatedBus_GetTimeNanoseconds();
+
+    SimulatedAtmelAtsha204a_CheckWatchdog(pAtsha);
+
+    if ((pAtsha->state != ESimulatedAtsha204aState_Awake) ||
+        (now - pAtsha->wakeTimeNanoseconds < ATSHA204A_WAKE_HIGH_NANOSECONDS) || (now < pAtsha->busyUntilNanoseconds))
+    {
+        return false;
+    }
+
+    if (direction == EI2cDirection_Write)
+    {
+        pAtsha->receivingCommand = false;
+    }
+
+    return true;
+}
+
+bool SimulatedAtmelAtsha204a_WriteByte(SimulatedDevice_t* pDevice, uint8_t data)
+{
+    SimulatedAtmelAtsha204a_t* pAtsha = (SimulatedAtmelAtsha204a_t*)pDevice;
+
+    if (pAtsha->receivingCommand)
+    {
+        if (pAtsha->commandLength < sizeof(pAtsha->commandPacket))
+        {
+            pAtsha->commandPacket[pAtsha->commandLength++] = data;
+        }
+
+        return true;
+    }
+
+    switch (data)
+    {
+    case ATSHA204A_WORD_ADDRESS_RESET:
+        pAtsha->responseIndex = 0;
+        break;
+    case ATSHA204A_WORD_ADDRESS_SLEEP:
+        pAtsha->sleepRequested = true;
+        break;
+    case ATSHA204A_WORD_ADDRESS_IDLE:
+        break;
+    case ATSHA204A_WORD_ADDRESS_COMMAND:
+        pAtsha->receivingCommand = true;
+        pAtsha->commandLength = 0;
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+uint8_t SimulatedAtmelAtsha204a_ReadByte(SimulatedDevice_t* pDevice)
+{
+    SimulatedAtmelAtsha204a_t* pAtsha = (SimulatedAtmelAtsha204a_t*)pDevice;
+
+    if (pAtsha->responseIndex < pAtsha->responseLength)
+    {
+        return pAtsha->responsePacket[pAtsha->responseIndex++];
+    }
+
+    return 0xFF;
+}
+
+void SimulatedAtmelAtsha204a_Stop(SimulatedDevice_t* pDevice)
+{
+    SimulatedAtmelAtsha204a_t* pAtsha = (SimulatedAtmelAtsha204a_t*)pDevice;
+
+    if (pAtsha->receivingCommand && (pAtsha->commandLength != 0))
+    {
+        SimulatedAtmelAtsha204a_ExecuteCommand(pAtsha);
+    }
+
+    pAtsha->receivingCommand = false;
+    pAtsha->commandLength = 0;
+
+    if (pAtsha->sleepRequested)
+    {
+        pAtsha->sleepRequested = false;
+        pAtsha->state = ESimulatedAtsha204aState_Asleep;
+        pAtsha->tempKeyValid = false;
+    }
+}
+
+void SimulatedAtmelAtsha204a_SdaLowPulse(SimulatedDevice_t* pDevice, uint64_t durationNanoseconds)
+{
+    SimulatedAtmelAtsha204a_t* pAtsha = (SimulatedAtmelAtsha204a_t*)pDevice;
+
+    SimulatedAtmelAtsha204a_CheckWatchdog(pAtsha);
+
+    if ((pAtsha->state == ESimulatedAtsha204aState_Asleep) && (durationNanoseconds >= ATSHA204A_WAKE_LOW_NANOSECONDS))
+    {
+        // The I/O buffer holds the wake status until a command is executed.
+        uint8_t status = ATSHA204A_STATUS_AFTER_WAKE;
+
+        pAtsha->state = ESimulatedAtsha204aState_Awake;
+        pAtsha->wakeTimeNanoseconds = SimulatedBus_GetTimeNanoseconds();
+        pAtsha->busyUntilNanoseconds = 0;
+        SimulatedAtmelAtsha204a_SetResponse(pAtsha, &status, 1);
+    }
+}
+
+/// Device model operations
+const SimulatedDeviceOperations_t SIMULATED_ATSHA204A_OPERATIONS = {
+    SimulatedAtmelAtsha204a_Start,
+    SimulatedAtmelAtsha204a_WriteByte,
+    SimulatedAtmelAtsha204a_ReadByte,
+    SimulatedAtmelAtsha204a_Stop,
+    SimulatedAtmelAtsha204a_SdaLowPulse,
+    NULL
+};
+
+void SimulatedAtmelAtsha204a_Initialise(SimulatedAtmelAtsha204a_t* pDevice, const uint8_t* pOtpZone)
+{
+    memset(pDevice, 0, sizeof(*pDevice));
+    memset(pDevice->configZone, 0xFF, sizeof(pDevice->configZone));
+    pDevice->configZone[ATSHA204A_CONFIG_ADDRESS_OTP_MODE] = ATSHA204A_OTP_MODE_READ_ONLY;
+    memcpy(&pDevice->configZone[ATSHA204A_CONFIG_ADDRESS_SN_0_3], SIMULATED_ATSHA204A_SN_0_3, 4);
+    memcpy(&pDevice->configZone[ATSHA204A_CONFIG_ADDRESS_REVISION], SIMULATED_ATSHA204A_REVISION, 4);
+    memcpy(&pDevice->configZone[ATSHA204A_CONFIG_ADDRESS_SN_4_8], SIMULATED_ATSHA204A_SN_4_8, 5);
+    memset(pDevice->otpZone, 0xFF, sizeof(pDevice->otpZone));
+    memset(pDevice->dataZone, 0xFF, sizeof(pDevice->dataZone));
+
+    if (pOtpZone != NULL)
+    {
+        memcpy(pDevice->otpZone, pOtpZone, sizeof(pDevice->otpZone));
+    }
+
+    pDevice->device.pName = "ATSHA204A";
+    pDevice->device.deviceAddress = ATSHA204A_DEVICE_ADDRESS;
+    pDevice->device.pOperations = &SIMULATED_ATSHA204A_OPERATIONS;
+    pDevice->state = ESimulatedAtsha204aState_Asleep;
+}
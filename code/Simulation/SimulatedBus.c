@@ -0,0 +1,371 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "SimulatedBus.h"
+#include "ErrorCodes.h"
+
+//-------------------------------------------------------------------------------------------------
+// Global variable definitions
+//-------------------------------------------------------------------------------------------------
+
+/// Simulated time, in nanoseconds
+uint64_t g_simulatedTimeNanoseconds;
+
+/// SCL frequency
+uint32_t g_simulatedClockFrequencyHz;
+
+/// Devices attached to the bus
+SimulatedDevice_t* g_pSimulatedDevices;
+
+/// Bus statistics
+SimulatedBusStatistics_t g_simulatedBusStatistics;
+
+/// True while SDA is low
+bool g_sdaLow;
+
+/// Time at which SDA went low
+uint64_t g_sdaLowStartNanoseconds;
+
+/// True to print a trace of the bus activity
+bool g_simulatedBusTrace;
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Get the duration of half an SCL period.
+ *
+ * \returns		Duration in nanoseconds
+ */
+uint64_t SimulatedBus_GetHalfBitNanoseconds()
+{
+    return 500000000ULL / g_simulatedClockFrequencyHz;
+}
+
+/**
+ * \brief Advance the time while the bus is busy.
+ *
+ * \param	nanoseconds		Time to advance by
+ */
+void SimulatedBus_Elapse(uint64_t nanoseconds)
+{
+    g_simulatedTimeNanoseconds += nanoseconds;
+    g_simulatedBusStatistics.busTimeNanoseconds += nanoseconds;
+}
+
+/**
+ * \brief Check whether a device is connected to the bus, i.e. not behind a multiplexer channel which is
+ * disconnected.
+ *
+ * \param	pDevice		Device
+ * \returns				True if the device is connected
+ */
+bool SimulatedBus_IsDeviceConnected(const SimulatedDevice_t* pDevice)
+{
+    if (pDevice->pMultiplexer == NULL)
+    {
+        return true;
+    }
+
+    return SimulatedBus_IsDeviceConnected(pDevice->pMultiplexer) &&
+           pDevice->pMultiplexer->pOperations->IsChannelConnected(pDevice->pMultiplexer, pDevice->multiplexerChannel);
+}
+
+/**
+ * \brief Set the SDA level, and report low pulses to the connected devices.
+ *
+ * \param	low		True to pull SDA low
+ */
+void SimulatedBus_SetSda(bool low)
+{
+    if (low && !g_sdaLow)
+    {
+        g_sdaLow = true;
+        g_sdaLowStartNanoseconds = g_simulatedTimeNanoseconds;
+    }
+    else if (!low && g_sdaLow)
+    {
+        g_sdaLow = false;
+
+        uint64_t duration = g_simulatedTimeNanoseconds - g_sdaLowStartNanoseconds;
+        if (duration >= SIMULATED_BUS_MIN_LOW_PULSE_NANOSECONDS)
+        {
+            SimulatedDevice_t* pDevice;
+            for (pDevice = g_pSimulatedDevices; pDevice != NULL; pDevice = pDevice->pNext)
+            {
+                if ((pDevice->pOperations->SdaLowPulse != NULL) && SimulatedBus_IsDeviceConnected(pDevice))
+                {
+                    pDevice->pOperations->SdaLowPulse(pDevice, duration);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \brief Clock a byte and its acknowledge bit over the bus.
+ *
+ * \param	data			The byte, as driven by the master or the device
+ * \param	acknowledged	True if the byte is acknowledged
+ */
+void SimulatedBus_ClockByte(uint8_t data, bool acknowledged)
+{
+    uint64_t bitNanoseconds = 2 * SimulatedBus_GetHalfBitNanoseconds();
+
+    int bitIndex;
+    for (bitIndex = 7; bitIndex >= 0; bitIndex--)
+    {
+        SimulatedBus_SetSda(((data >> bitIndex) & 1) == 0);
+        SimulatedBus_Elapse(bitNanoseconds);
+    }
+
+    SimulatedBus_SetSda(acknowledged);
+    SimulatedBus_Elapse(bitNanoseconds);
+}
+
+/**
+ * \brief Find the connected device with the given address.
+ *
+ * \param	deviceAddress	Device address
+ * \returns					The device, or NULL if no device responds to the address
+ */
+SimulatedDevice_t* SimulatedBus_FindDevice(uint8_t deviceAddress)
+{
+    SimulatedDevice_t* pDevice;
+    for (pDevice = g_pSimulatedDevices; pDevice != NULL; pDevice = pDevice->pNext)
+    {
+        if ((pDevice->deviceAddress == deviceAddress) && SimulatedBus_IsDeviceConnected(pDevice))
+        {
+            return pDevice;
+        }
+    }
+
+    return NULL;
+}
+
+void SimulatedBus_Initialise(uint32_t clockFrequencyHz)
+{
+    g_simulatedTimeNanoseconds = 0;
+    g_simulatedClockFrequencyHz = clockFrequencyHz;
+    g_pSimulatedDevices = NULL;
+    g_sdaLow = false;
+    g_simulatedBusTrace = false;
+
+    SimulatedBus_ResetStatistics();
+}
+
+void SimulatedBus_SetClockFrequency(uint32_t clockFrequencyHz)
+{
+    g_simulatedClockFrequencyHz = clockFrequencyHz;
+}
+
+uint32_t SimulatedBus_GetClockFrequency()
+{
+    return g_simulatedClockFrequencyHz;
+}
+
+void SimulatedBus_AttachDevice(SimulatedDevice_t* pDevice)
+{
+    pDevice->numberOfMessages = 0;
+    pDevice->addressed = false;
+
+    // Devices are kept in attachment order, so that the first device attached at an address responds to it.
+    SimulatedDevice_t** ppLink = &g_pSimulatedDevices;
+    while (*ppLink != NULL)
+    {
+        ppLink = &(*ppLink)->pNext;
+    }
+
+    pDevice->pNext = NULL;
+    *ppLink = pDevice;
+}
+
+EN_RESULT SimulatedBus_Transfer(const SimulatedMessage_t* pMessages, uint32_t numberOfMessages)
+{
+    if ((pMessages == NULL) || (numberOfMessages == 0))
+    {
+        return EN_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint64_t halfBitNanoseconds = SimulatedBus_GetHalfBitNanoseconds();
+    EN_RESULT result = EN_SUCCESS;
+    SimulatedDevice_t* pDevice = NULL;
+
+    g_simulatedBusStatistics.numberOfTransfers++;
+
+    // Start condition: SDA falls while SCL is high.
+    SimulatedBus_SetSda(true);
+    SimulatedBus_Elapse(halfBitNanoseconds);
+
+    if (g_simulatedBusTrace)
+    {
+        EN_PRINTF("I2C:");
+    }
+
+    uint32_t messageIndex;
+    for (messageIndex = 0; (messageIndex < numberOfMessages) && EN_SUCCEEDED(result); messageIndex++)
+    {
+        const SimulatedMessage_t* pMessage = &pMessages[messageIndex];
+        bool read = ((pMessage->flags & SIMULATED_MESSAGE_FLAG_READ) != 0);
+
+        bool continuesWrite = ((pMessage->flags & SIMULATED_MESSAGE_FLAG_NO_START) != 0) && (messageIndex > 0) &&
+                              !read && ((pMessages[messageIndex - 1].flags & SIMULATED_MESSAGE_FLAG_READ) == 0);
+
+        if (!continuesWrite)
+        {
+            if (messageIndex > 0)
+            {
+                // Repeated start condition: SDA is released, then falls again while SCL is high.
+                SimulatedBus_SetSda(false);
+                SimulatedBus_Elapse(halfBitNanoseconds);
+                SimulatedBus_SetSda(true);
+                SimulatedBus_Elapse(halfBitNanoseconds);
+            }
+
+            g_simulatedBusStatistics.numberOfMessages++;
+
+            pDevice = SimulatedBus_FindDevice(pMessage->deviceAddress);
+            bool acknowledged =
+                (pDevice != NULL) && ((pDevice->pOperations->Start == NULL) ||
+                                      pDevice->pOperations->Start(pDevice, read ? EI2cDirection_Read : EI2cDirection_Write));
+
+            SimulatedBus_ClockByte((uint8_t)((pMessage->deviceAddress << 1) | (read ? 1 : 0)), acknowledged);
+
+            if (g_simulatedBusTrace)
+            {
+                EN_PRINTF(" %s%02x%s%s", (messageIndex > 0) ? "Sr " : "S ", pMessage->deviceAddress, read ? "R" : "W",
+                          acknowledged ? "" : " NACK");
+            }
+
+            if (!acknowledged)
+            {
+                g_simulatedBusStatistics.numberOfNacks++;
+                result = EN_ERROR_I2C_SLAVE_NACK;
+                break;
+            }
+
+            pDevice->addressed = true;
+            pDevice->numberOfMessages++;
+        }
+
+        uint32_t byteIndex;
+        for (byteIndex = 0; byteIndex < pMessage->length; byteIndex++)
+        {
+            if (read)
+            {
+                uint8_t data = (pDevice->pOperations->ReadByte != NULL) ? pDevice->pOperations->ReadByte(pDevice) : 0xFF;
+                pMessage->pData[byteIndex] = data;
+
+                // The master acknowledges all bytes but the last.
+                SimulatedBus_ClockByte(data, byteIndex + 1 < pMessage->length);
+
+                if (g_simulatedBusTrace)
+                {
+                    EN_PRINTF(" <%02x", data);
+                }
+            }
+            else
+            {
+                uint8_t data = pMessage->pData[byteIndex];
+                bool acknowledged =
+                    (pDevice->pOperations->WriteByte == NULL) || pDevice->pOperations->WriteByte(pDevice, data);
+
+                SimulatedBus_ClockByte(data, acknowledged);
+
+                if (g_simulatedBusTrace)
+                {
+                    EN_PRINTF(" %02x%s", data, acknowledged ? "" : " NACK");
+                }
+
+                if (!acknowledged)
+                {
+                    g_simulatedBusStatistics.numberOfNacks++;
+                    result = EN_ERROR_I2C_SLAVE_NACK;
+                    break;
+                }
+            }
+
+            g_simulatedBusStatistics.numberOfBytes++;
+        }
+    }
+
+    // Stop condition: SDA rises while SCL is high, followed by the bus free time.
+    SimulatedBus_SetSda(true);
+    SimulatedBus_Elapse(halfBitNanoseconds);
+    SimulatedBus_SetSda(false);
+    SimulatedBus_Elapse(halfBitNanoseconds);
+
+    if (g_simulatedBusTrace)
+    {
+        EN_PRINTF(" P\n");
+    }
+
+    SimulatedDevice_t* pAddressedDevice;
+    for (pAddressedDevice = g_pSimulatedDevices; pAddressedDevice != NULL; pAddressedDevice = pAddressedDevice->pNext)
+    {
+        if (pAddressedDevice->addressed)
+        {
+            pAddressedDevice->addressed = false;
+
+            if (pAddressedDevice->pOperations->Stop != NULL)
+            {
+                pAddressedDevice->pOperations->Stop(pAddressedDevice);
+            }
+        }
+    }
+
+    return result;
+}
+
+uint64_t SimulatedBus_GetTimeNanoseconds()
+{
+    return g_simulatedTimeNanoseconds;
+}
+
+void SimulatedBus_AdvanceTime(uint64_t nanoseconds)
+{
+    g_simulatedTimeNanoseconds += nanoseconds;
+}
+
+void SimulatedBus_GetStatistics(SimulatedBusStatistics_t* pStatistics)
+{
+    *pStatistics = g_simulatedBusStatistics;
+}
+
+void SimulatedBus_ResetStatistics()
+{
+    g_simulatedBusStatistics.numberOfTransfers = 0;
+    g_simulatedBusStatistics.numberOfMessages = 0;
+    g_simulatedBusStatistics.numberOfBytes = 0;
+    g_simulatedBusStatistics.numberOfNacks = 0;
+    g_simulatedBusStatistics.busTimeNanoseconds = 0;
+}
+
+void SimulatedBus_SetTrace(bool enable)
+{
+    g_simulatedBusTrace = enable;
+}
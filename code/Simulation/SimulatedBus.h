@@ -0,0 +1,224 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "StandardIncludes.h"
+#include "I2cInterface.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/// Minimum duration of a low pulse on SDA which is reported to the devices, in nanoseconds
+#define SIMULATED_BUS_MIN_LOW_PULSE_NANOSECONDS 20000
+
+/// Message flag: the master reads data from the device
+#define SIMULATED_MESSAGE_FLAG_READ 0x01
+
+/// Message flag: the data continues the previous write message, without a start condition and address
+#define SIMULATED_MESSAGE_FLAG_NO_START 0x02
+
+
+struct SimulatedDevice_t;
+
+/**
+ * \brief Operations implemented by a simulated device model.
+ *
+ * All operations are called by the bus as the corresponding bus event happens; the current simulated time
+ * is available from SimulatedBus_GetTimeNanoseconds(). Operations which are not needed may be NULL.
+ */
+typedef struct
+{
+    /// Called when the device is addressed; returns true to acknowledge the address
+    bool (*Start)(struct SimulatedDevice_t* pDevice, EI2cDirection_t direction);
+
+    /// Called for each byte written by the master; returns true to acknowledge the byte
+    bool (*WriteByte)(struct SimulatedDevice_t* pDevice, uint8_t data);
+
+    /// Called for each byte read by the master; returns the byte
+    uint8_t (*ReadByte)(struct SimulatedDevice_t* pDevice);
+
+    /// Called at the stop condition ending a transfer in which the device was addressed
+    void (*Stop)(struct SimulatedDevice_t* pDevice);
+
+    /// Called when SDA has been held low for at least SIMULATED_BUS_MIN_LOW_PULSE_NANOSECONDS
+    void (*SdaLowPulse)(struct SimulatedDevice_t* pDevice, uint64_t durationNanoseconds);
+
+    /// For bus multiplexers: returns true if the given downstream channel is connected to the bus
+    bool (*IsChannelConnected)(const struct SimulatedDevice_t* pDevice, uint8_t channel);
+} SimulatedDeviceOperations_t;
+
+
+/**
+ * \brief Simulated device, attached to the bus. Device models embed this as their first member.
+ */
+typedef struct SimulatedDevice_t
+{
+    /// Device name, for traces
+    const char* pName;
+
+    /// I2C device address
+    uint8_t deviceAddress;
+
+    /// Device model operations
+    const SimulatedDeviceOperations_t* pOperations;
+
+    /// Multiplexer the device is connected behind, or NULL if it is connected to the bus directly
+    const struct SimulatedDevice_t* pMultiplexer;
+
+    /// Multiplexer channel the device is connected to
+    uint8_t multiplexerChannel;
+
+    /// Number of messages addressed to the device
+    uint32_t numberOfMessages;
+
+    /// Internal: true while the device is addressed in the current transfer
+    bool addressed;
+
+    /// Internal: next device on the bus
+    struct SimulatedDevice_t* pNext;
+} SimulatedDevice_t;
+
+
+/**
+ * \brief Message of a bus transfer.
+ */
+typedef struct
+{
+    /// Device address
+    uint8_t deviceAddress;
+
+    /// Message flags (SIMULATED_MESSAGE_FLAG_...)
+    uint8_t flags;
+
+    /// Data to write, or buffer to receive read data
+    uint8_t* pData;
+
+    /// Number of data bytes; may be zero
+    uint32_t length;
+} SimulatedMessage_t;
+
+
+/**
+ * \brief Bus statistics.
+ */
+typedef struct
+{
+    /// Number of transfers, each from a start to a stop condition
+    uint32_t numberOfTransfers;
+
+    /// Number of address phases, including those after repeated start conditions
+    uint32_t numberOfMessages;
+
+    /// Number of data bytes transferred, excluding address bytes
+    uint32_t numberOfBytes;
+
+    /// Number of address and data bytes which were not acknowledged
+    uint32_t numberOfNacks;
+
+    /// Time the bus was busy, in nanoseconds
+    uint64_t busTimeNanoseconds;
+} SimulatedBusStatistics_t;
+
+
+//-------------------------------------------------------------------------------------------------
+// Function declarations
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Initialise the simulated bus: detach all devices, and reset the time and the statistics.
+ *
+ * \param	clockFrequencyHz	SCL frequency
+ */
+void SimulatedBus_Initialise(uint32_t clockFrequencyHz);
+
+/**
+ * \brief Set the SCL frequency used for the following transfers.
+ *
+ * \param	clockFrequencyHz	SCL frequency
+ */
+void SimulatedBus_SetClockFrequency(uint32_t clockFrequencyHz);
+
+/**
+ * \brief Get the SCL frequency.
+ *
+ * \returns		SCL frequency in Hz
+ */
+uint32_t SimulatedBus_GetClockFrequency();
+
+/**
+ * \brief Attach a device to the bus.
+ *
+ * \param	pDevice		Device; must remain valid until the bus is initialised again
+ */
+void SimulatedBus_AttachDevice(SimulatedDevice_t* pDevice);
+
+/**
+ * \brief Perform a transfer: a start condition, the messages separated by repeated start conditions, and a
+ * stop condition.
+ *
+ * The transfer is stopped at the first byte which is not acknowledged.
+ *
+ * \param	pMessages			Messages
+ * \param	numberOfMessages	The number of messages
+ * \returns						Result code
+ */
+EN_RESULT SimulatedBus_Transfer(const SimulatedMessage_t* pMessages, uint32_t numberOfMessages);
+
+/**
+ * \brief Get the simulated time, which advances with bus activity and with SimulatedBus_AdvanceTime().
+ *
+ * \returns		Simulated time in nanoseconds
+ */
+uint64_t SimulatedBus_GetTimeNanoseconds();
+
+/**
+ * \brief Advance the simulated time while the bus is idle.
+ *
+ * \param	nanoseconds		Time to advance by
+ */
+void SimulatedBus_AdvanceTime(uint64_t nanoseconds);
+
+/**
+ * \brief Get the bus statistics collected since the last reset.
+ *
+ * \param[out]	pStatistics		Receives the statistics
+ */
+void SimulatedBus_GetStatistics(SimulatedBusStatistics_t* pStatistics);
+
+/**
+ * \brief Reset the bus statistics.
+ */
+void SimulatedBus_ResetStatistics();
+
+/**
+ * \brief Enable or disable printing a trace of the bus activity.
+ *
+ * \param	enable		True to print the trace
+ */
+void SimulatedBus_SetTrace(bool enable);
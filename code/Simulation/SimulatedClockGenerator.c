@@ -0,0 +1,201 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "SimulatedDevices.h"
+
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+
+/// I2C device address
+#define SI5338_DEVICE_ADDRESS 0x70
+
+/// Page register, accessible from both pages
+#define SI5338_REGISTER_ADDRESS_PAGE 255
+
+/// Status register
+#define SI5338_REGISTER_ADDRESS_STATUS 218
+
+/// Soft reset register
+#define SI5338_REGISTER_ADDRESS_SOFT_RESET 246
+
+/// FCAL registers, read-only
+#define SI5338_REGISTER_ADDRESS_FCAL_FIRST 235
+#define SI5338_REGISTER_ADDRESS_FCAL_LAST 237
+
+/// Status bits
+#define SI5338_STATUS_SYS_CAL 0x01
+#define SI5338_STATUS_LOS_CLKIN 0x04
+#define SI5338_STATUS_PLL_LOL 0x10
+
+/// Soft reset bit
+#define SI5338_SOFT_RESET 0x02
+
+/// Time the PLL needs to lock after a soft reset
+#define SI5338_LOCK_TIME_NANOSECONDS 30000000ULL
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Get a register of the current page.
+ *
+ * \param	pClockGenerator		Device
+ * \param	address				Register address
+ * \returns						Pointer to the register
+ */
+uint8_t* SimulatedClockGenerator_GetRegister(SimulatedClockGenerator_t* pClockGenerator, uint8_t address)
+{
+    if (address == SI5338_REGISTER_ADDRESS_PAGE)
+    {
+        return &pClockGenerator->registers[0][SI5338_REGISTER_ADDRESS_PAGE];
+    }
+
+    uint8_t page = pClockGenerator->registers[0][SI5338_REGISTER_ADDRESS_PAGE] & 0x01;
+
+    return &pClockGenerator->registers[page][address];
+}
+
+/**
+ * \brief Get the value of the status register.
+ *
+ * \param	pClockGenerator		Device
+ * \returns						Status
+ */
+uint8_t SimulatedClockGenerator_GetStatus(const SimulatedClockGenerator_t* pClockGenerator)
+{
+    uint8_t status = 0;
+
+    // Without an input clock, the PLL cannot lock either.
+    if (pClockGenerator->inputClockLost)
+    {
+        status |= SI5338_STATUS_LOS_CLKIN | SI5338_STATUS_PLL_LOL;
+    }
+
+    if (SimulatedBus_GetTimeNanoseconds() < pClockGenerator->lockCompleteNanoseconds)
+    {
+        status |= SI5338_STATUS_SYS_CAL | SI5338_STATUS_PLL_LOL;
+    }
+
+    return status;
+}
+
+bool SimulatedClockGenerator_Start(SimulatedDevice_t* pDevice, EI2cDirection_t direction)
+{
+    SimulatedClockGenerator_t* pClockGenerator = (SimulatedClockGenerator_t*)pDevice;
+
+    if (direction == EI2cDirection_Write)
+    {
+        pClockGenerator->addressReceived = false;
+    }
+
+    return true;
+}
+
+bool SimulatedClockGenerator_WriteByte(SimulatedDevice_t* pDevice, uint8_t data)
+{
+    SimulatedClockGenerator_t* pClockGenerator = (SimulatedClockGenerator_t*)pDevice;
+
+    if (!pClockGenerator->addressReceived)
+    {
+        pClockGenerator->address = data;
+        pClockGenerator->addressReceived = true;
+        return true;
+    }
+
+    uint8_t address = pClockGenerator->address++;
+    bool pageZero = ((pClockGenerator->registers[0][SI5338_REGISTER_ADDRESS_PAGE] & 0x01) == 0);
+
+    if (pageZero && (address == SI5338_REGISTER_ADDRESS_SOFT_RESET))
+    {
+        // The soft reset bit clears itself; the PLL then calibrates and locks.
+        if ((data & SI5338_SOFT_RESET) != 0)
+        {
+            pClockGenerator->lockCompleteNanoseconds =
+                SimulatedBus_GetTimeNanoseconds() + pClockGenerator->lockTimeNanoseconds;
+        }
+
+        return true;
+    }
+
+    if (pageZero && ((address == SI5338_REGISTER_ADDRESS_STATUS) ||
+                     ((address >= SI5338_REGISTER_ADDRESS_FCAL_FIRST) && (address <= SI5338_REGISTER_ADDRESS_FCAL_LAST))))
+    {
+        return true;
+    }
+
+    *SimulatedClockGenerator_GetRegister(pClockGenerator, address) = data;
+
+    return true;
+}
+
+uint8_t SimulatedClockGenerator_ReadByte(SimulatedDevice_t* pDevice)
+{
+    SimulatedClockGenerator_t* pClockGenerator = (SimulatedClockGenerator_t*)pDevice;
+
+    uint8_t address = pClockGenerator->address++;
+    bool pageZero = ((pClockGenerator->registers[0][SI5338_REGISTER_ADDRESS_PAGE] & 0x01) == 0);
+
+    if (pageZero && (address == SI5338_REGISTER_ADDRESS_STATUS))
+    {
+        return SimulatedClockGenerator_GetStatus(pClockGenerator);
+    }
+
+    return *SimulatedClockGenerator_GetRegister(pClockGenerator, address);
+}
+
+/// Device model operations
+const SimulatedDeviceOperations_t SIMULATED_CLOCK_GENERATOR_OPERATIONS = {
+    SimulatedClockGenerator_Start,
+    SimulatedClockGenerator_WriteByte,
+    SimulatedClockGenerator_ReadByte,
+    NULL,
+    NULL,
+    NULL
+};
+
+void SimulatedClockGenerator_Initialise(SimulatedClockGenerator_t* pDevice)
+{
+    memset(pDevice, 0, sizeof(*pDevice));
+
+    pDevice->device.pName = "Si5338";
+    pDevice->device.deviceAddress = SI5338_DEVICE_ADDRESS;
+    pDevice->device.pOperations = &SIMULATED_CLOCK_GENERATOR_OPERATIONS;
+    pDevice->lockTimeNanoseconds = SI5338_LOCK_TIME_NANOSECONDS;
+
+    // Frequency calibration results, as found after the PLL has locked.
+    pDevice->registers[0][SI5338_REGISTER_ADDRESS_FCAL_FIRST] = 0x5A;
+    pDevice->registers[0][SI5338_REGISTER_ADDRESS_FCAL_FIRST + 1] = 0x3C;
+    pDevice->registers[0][SI5338_REGISTER_ADDRESS_FCAL_LAST] = 0x01;
+}
+
+void SimulatedClockGenerator_SetInputClockLost(SimulatedClockGenerator_t* pDevice, bool lost)
+{
+    pDevice->inputClockLost = lost;
+}
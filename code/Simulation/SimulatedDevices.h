@@ -0,0 +1,371 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "StandardIncludes.h"
+#include "SimulatedBus.h"
+
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/// Size of the Atmel ATSHA204A configuration zone
+#define SIMULATED_ATSHA204A_CONFIG_ZONE_SIZE_BYTES 88
+
+/// Size of the Atmel ATSHA204A OTP zone
+#define SIMULATED_ATSHA204A_OTP_ZONE_SIZE_BYTES 64
+
+/// Size of the Atmel ATSHA204A data zone
+#define SIMULATED_ATSHA204A_DATA_ZONE_SIZE_BYTES 512
+
+/// Size of the Atmel ATSHA204A I/O buffer, holding a command or a response packet
+#define SIMULATED_ATSHA204A_IO_BUFFER_SIZE_BYTES 84
+
+/// Size of the Maxim DS28CN01 address space: 128 bytes of EEPROM followed by the registers
+#define SIMULATED_DS28CN01_MEMORY_SIZE_BYTES 256
+
+/// Size of the 24AA128 user EEPROM
+#define SIMULATED_USER_EEPROM_SIZE_BYTES 16384
+
+/// Page size of the 24AA128 user EEPROM
+#define SIMULATED_USER_EEPROM_PAGE_SIZE_BYTES 64
+
+/// Number of value registers of the LM96080 system monitor: 7 voltage channels and the temperature
+#define SIMULATED_SYSTEM_MONITOR_NUMBER_OF_CHANNELS 8
+
+/// Channel index of the LM96080 temperature reading
+#define SIMULATED_SYSTEM_MONITOR_TEMPERATURE_CHANNEL 7
+
+
+/**
+ * \brief Power state of the simulated Atmel ATSHA204A.
+ */
+typedef enum
+{
+    ESimulatedAtsha204aState_Asleep,
+    ESimulatedAtsha204aState_Awake
+} ESimulatedAtsha204aState_t;
+
+/**
+ * \brief Simulated Atmel ATSHA204A: wake token, watchdog, command packets with CRC, and the Read, DevRev, Random,
+ * Nonce, MAC and CheckMac commands.
+ */
+typedef struct
+{
+    SimulatedDevice_t device;
+
+    /// Configuration zone
+    uint8_t configZone[SIMULATED_ATSHA204A_CONFIG_ZONE_SIZE_BYTES];
+
+    /// OTP zone
+    uint8_t otpZone[SIMULATED_ATSHA204A_OTP_ZONE_SIZE_BYTES];
+
+    /// Data zone
+    uint8_t dataZone[SIMULATED_ATSHA204A_DATA_ZONE_SIZE_BYTES];
+
+    /// Power state
+    ESimulatedAtsha204aState_t state;
+
+    /// Time at which the device woke up
+    uint64_t wakeTimeNanoseconds;
+
+    /// Time until which the device is executing a command, and does not acknowledge its address
+    uint64_t busyUntilNanoseconds;
+
+    /// Command packet being received
+    uint8_t commandPacket[SIMULATED_ATSHA204A_IO_BUFFER_SIZE_BYTES];
+
+    /// Number of command packet bytes received
+    uint8_t commandLength;
+
+    /// True while the bytes written are part of a command packet, rather than word addresses
+    bool receivingCommand;
+
+    /// True if the sleep word address was received in the current transfer
+    bool sleepRequested;
+
+    /// Response packet
+    uint8_t responsePacket[SIMULATED_ATSHA204A_IO_BUFFER_SIZE_BYTES];
+
+    /// Length of the response packet
+    uint8_t responseLength;
+
+    /// Index of the next response byte to read
+    uint8_t responseIndex;
+
+    /// TempKey, loaded by the Nonce command and cleared by sleep
+    uint8_t tempKey[32];
+
+    /// True while TempKey holds a nonce
+    bool tempKeyValid;
+
+    /// TempKey source flag: true for a pass-through nonce, false for a random nonce
+    bool tempKeySourceInput;
+
+    /// State of the random number generator
+    uint32_t randomState;
+} SimulatedAtmelAtsha204a_t;
+
+/**
+ * \brief Simulated Maxim DS28CN01: EEPROM and registers with an auto-incrementing address.
+ */
+typedef struct
+{
+    SimulatedDevice_t device;
+
+    /// EEPROM (0x00 - 0x7F) and registers (0x80 - 0xFF)
+    uint8_t memory[SIMULATED_DS28CN01_MEMORY_SIZE_BYTES];
+
+    /// Current address
+    uint8_t address;
+
+    /// True once the address has been written in the current transfer
+    bool addressReceived;
+} SimulatedMaximDs28cn01_t;
+
+/**
+ * \brief Type of the simulated realtime clock.
+ */
+typedef enum
+{
+    ESimulatedRtcType_ISL12020,
+    ESimulatedRtcType_NXPPCF85063A
+} ESimulatedRtcType_t;
+
+/**
+ * \brief Simulated realtime clock (Intersil ISL12020 or NXP PCF85063A), running on the simulated time.
+ */
+typedef struct
+{
+    SimulatedDevice_t device;
+
+    /// Device type
+    ESimulatedRtcType_t type;
+
+    /// Register file
+    uint8_t registers[0x30];
+
+    /// Number of registers, after which the address wraps around
+    uint8_t numberOfRegisters;
+
+    /// Current register address
+    uint8_t address;
+
+    /// True once the register address has been written in the current transfer
+    bool addressReceived;
+
+    /// True if a time or date register was written in the current transfer
+    bool timeWritten;
+
+    /// Seconds since 2000-01-01 00:00:00 at the reference time
+    uint32_t secondsAtReference;
+
+    /// Simulated time at which secondsAtReference was set
+    uint64_t referenceTimeNanoseconds;
+
+    /// Die temperature reported by the ISL12020 temperature sensor
+    int temperatureCelsius;
+} SimulatedRealtimeClock_t;
+
+/**
+ * \brief Simulated TI LM96080 system monitor. The value registers are read as 16-bit words, most significant
+ * byte first, with the 10-bit reading left-aligned.
+ */
+typedef struct
+{
+    SimulatedDevice_t device;
+
+    /// Configuration registers
+    uint8_t configRegisters[0x20];
+
+    /// Value registers: left-aligned 10-bit voltage readings (2.5 mV per LSB), then the temperature
+    /// (two's complement, 1/256 degree per LSB)
+    uint16_t valueRegisters[SIMULATED_SYSTEM_MONITOR_NUMBER_OF_CHANNELS];
+
+    /// Current register address
+    uint8_t address;
+
+    /// Byte index within the current value register
+    uint8_t valueByteIndex;
+
+    /// True once the register address has been written in the current transfer
+    bool addressReceived;
+} SimulatedSystemMonitor_t;
+
+/**
+ * \brief Simulated Silicon Labs Si5338 clock generator: two register pages, input clock LOS and PLL lock.
+ */
+typedef struct
+{
+    SimulatedDevice_t device;
+
+    /// Registers of pages 0 and 1; register 255 (the page register) is shared
+    uint8_t registers[2][256];
+
+    /// Current register address
+    uint8_t address;
+
+    /// True once the register address has been written in the current transfer
+    bool addressReceived;
+
+    /// True to simulate a missing input clock (LOS alarm)
+    bool inputClockLost;
+
+    /// Time the PLL needs to lock after a soft reset
+    uint64_t lockTimeNanoseconds;
+
+    /// Time at which the PLL locks, or 0 if it is not locking
+    uint64_t lockCompleteNanoseconds;
+} SimulatedClockGenerator_t;
+
+/**
+ * \brief Simulated NXP PCA9547 8-channel I2C multiplexer.
+ */
+typedef struct
+{
+    SimulatedDevice_t device;
+
+    /// Control register: bit 3 enables the channel selected by bits 2..0
+    uint8_t control;
+} SimulatedMultiplexer_t;
+
+/**
+ * \brief Simulated Microchip 24AA128 user EEPROM: two-byte address, page writes and write cycle time.
+ */
+typedef struct
+{
+    SimulatedDevice_t device;
+
+    /// EEPROM contents
+    uint8_t memory[SIMULATED_USER_EEPROM_SIZE_BYTES];
+
+    /// Current address
+    uint16_t address;
+
+    /// Number of address bytes received in the current transfer
+    uint8_t addressBytesReceived;
+
+    /// True if data was written in the current transfer, starting a write cycle at the stop condition
+    bool dataWritten;
+
+    /// Time until which the device is busy with a write cycle, and does not acknowledge its address
+    uint64_t busyUntilNanoseconds;
+} SimulatedUserEeprom_t;
+
+
+//-------------------------------------------------------------------------------------------------
+// Function declarations
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Initialise a simulated Atmel ATSHA204A. The device is asleep, and the zones are erased (0xFF) apart from
+ * the serial number and revision in the configuration zone.
+ *
+ * \param	pDevice		Device
+ * \param	pOtpZone	OTP zone contents (SIMULATED_ATSHA204A_OTP_ZONE_SIZE_BYTES bytes), or NULL
+ */
+void SimulatedAtmelAtsha204a_Initialise(SimulatedAtmelAtsha204a_t* pDevice, const uint8_t* pOtpZone);
+
+/**
+ * \brief Calculate the CRC-16 of the Atmel ATSHA204A packets (polynomial 0x8005, no reflection of the remainder).
+ *
+ * \param	pData		Data
+ * \param	length		The number of bytes
+ * \returns				The CRC
+ */
+uint16_t SimulatedAtmelAtsha204a_CalculateCrc(const uint8_t* pData, uint32_t length);
+
+/**
+ * \brief Initialise a simulated Maxim DS28CN01.
+ *
+ * \param	pDevice			Device
+ * \param	deviceAddress	I2C device address (0x5C or 0x50)
+ * \param	pEeprom			EEPROM contents (128 bytes), or NULL
+ */
+void SimulatedMaximDs28cn01_Initialise(SimulatedMaximDs28cn01_t* pDevice, uint8_t deviceAddress, const uint8_t* pEeprom);
+
+/**
+ * \brief Initialise a simulated realtime clock, set to 2020-01-01 00:00:00.
+ *
+ * \param	pDevice		Device
+ * \param	type		Device type; selects the device address and the register layout
+ */
+void SimulatedRealtimeClock_Initialise(SimulatedRealtimeClock_t* pDevice, ESimulatedRtcType_t type);
+
+/**
+ * \brief Initialise a simulated system monitor.
+ *
+ * \param	pDevice		Device
+ */
+void SimulatedSystemMonitor_Initialise(SimulatedSystemMonitor_t* pDevice);
+
+/**
+ * \brief Set the voltage measured by a system monitor channel.
+ *
+ * \param	pDevice			Device
+ * \param	channel			Channel index
+ * \param	millivolts		Voltage at the channel input
+ */
+void SimulatedSystemMonitor_SetChannelVoltage(SimulatedSystemMonitor_t* pDevice, uint8_t channel, uint32_t millivolts);
+
+/**
+ * \brief Set the temperature measured by a system monitor.
+ *
+ * \param	pDevice				Device
+ * \param	milliCelsius		Temperature in millidegrees Celsius
+ */
+void SimulatedSystemMonitor_SetTemperature(SimulatedSystemMonitor_t* pDevice, int32_t milliCelsius);
+
+/**
+ * \brief Initialise a simulated clock generator, with a valid input clock.
+ *
+ * \param	pDevice		Device
+ */
+void SimulatedClockGenerator_Initialise(SimulatedClockGenerator_t* pDevice);
+
+/**
+ * \brief Simulate the loss or the return of the input clock.
+ *
+ * \param	pDevice		Device
+ * \param	lost		True if the input clock is lost
+ */
+void SimulatedClockGenerator_SetInputClockLost(SimulatedClockGenerator_t* pDevice, bool lost);
+
+/**
+ * \brief Initialise a simulated I2C multiplexer, with all channels disconnected.
+ *
+ * \param	pDevice		Device
+ */
+void SimulatedMultiplexer_Initialise(SimulatedMultiplexer_t* pDevice);
+
+/**
+ * \brief Initialise a simulated user EEPROM, erased (0xFF).
+ *
+ * \param	pDevice		Device
+ */
+void SimulatedUserEeprom_Initialise(SimulatedUserEeprom_t* pDevice);
@@ -0,0 +1,110 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "SimulatedDevices.h"
+
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+
+/// Size of the EEPROM, at the start of the address space
+#define DS28CN01_EEPROM_SIZE_BYTES 128
+
+/// First register which can be written directly; the EEPROM is written through the SHA-1 scratchpad protocol,
+/// which is not modelled
+#define DS28CN01_FIRST_WRITABLE_REGISTER 0xA0
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+bool SimulatedMaximDs28cn01_Start(SimulatedDevice_t* pDevice, EI2cDirection_t direction)
+{
+    SimulatedMaximDs28cn01_t* pDs28cn01 = (SimulatedMaximDs28cn01_t*)pDevice;
+
+    if (direction == EI2cDirection_Write)
+    {
+        pDs28cn01->addressReceived = false;
+    }
+
+    return true;
+}
+
+bool SimulatedMaximDs28cn01_WriteByte(SimulatedDevice_t* pDevice, uint8_t data)
+{
+    SimulatedMaximDs28cn01_t* pDs28cn01 = (SimulatedMaximDs28cn01_t*)pDevice;
+
+    if (!pDs28cn01->addressReceived)
+    {
+        pDs28cn01->address = data;
+        pDs28cn01->addressReceived = true;
+        return true;
+    }
+
+    if (pDs28cn01->address >= DS28CN01_FIRST_WRITABLE_REGISTER)
+    {
+        pDs28cn01->memory[pDs28cn01->address] = data;
+    }
+
+    pDs28cn01->address++;
+
+    return true;
+}
+
+uint8_t SimulatedMaximDs28cn01_ReadByte(SimulatedDevice_t* pDevice)
+{
+    SimulatedMaximDs28cn01_t* pDs28cn01 = (SimulatedMaximDs28cn01_t*)pDevice;
+
+    // The address wraps around at the end of the address space.
+    return pDs28cn01->memory[pDs28cn01->address++];
+}
+
+/// Device model operations
+const SimulatedDeviceOperations_t SIMULATED_DS28CN01_OPERATIONS = {
+    SimulatedMaximDs28cn01_Start,
+    SimulatedMaximDs28cn01_WriteByte,
+    SimulatedMaximDs28cn01_ReadByte,
+    NULL,
+    NULL,
+    NULL
+};
+
+void SimulatedMaximDs28cn01_Initialise(SimulatedMaximDs28cn01_t* pDevice, uint8_t deviceAddress, const uint8_t* pEeprom)
+{
+    memset(pDevice, 0, sizeof(*pDevice));
+    memset(pDevice->memory, 0xFF, DS28CN01_EEPROM_SIZE_BYTES);
+
+    if (pEeprom != NULL)
+    {
+        memcpy(pDevice->memory, pEeprom, DS28CN01_EEPROM_SIZE_BYTES);
+    }
+
+    pDevice->device.pName = "DS28CN01";
+    pDevice->device.deviceAddress = deviceAddress;
+    pDevice->device.pOperations = &SIMULATED_DS28CN01_OPERATIONS;
+}
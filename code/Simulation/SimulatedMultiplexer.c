@@ -0,0 +1,86 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "SimulatedDevices.h"
+
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+
+/// I2C device address
+#define PCA9547_DEVICE_ADDRESS 0x74
+
+/// Channel enable bit of the control register
+#define PCA9547_CONTROL_ENABLE 0x08
+
+/// Channel select bits of the control register
+#define PCA9547_CONTROL_CHANNEL_MASK 0x07
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+bool SimulatedMultiplexer_WriteByte(SimulatedDevice_t* pDevice, uint8_t data)
+{
+    // The device has a single register, so every byte written replaces the control register; the channel
+    // selection takes effect at the stop condition on the real device, which makes no difference here.
+    ((SimulatedMultiplexer_t*)pDevice)->control = data;
+
+    return true;
+}
+
+uint8_t SimulatedMultiplexer_ReadByte(SimulatedDevice_t* pDevice)
+{
+    return ((SimulatedMultiplexer_t*)pDevice)->control;
+}
+
+bool SimulatedMultiplexer_IsChannelConnected(const SimulatedDevice_t* pDevice, uint8_t channel)
+{
+    uint8_t control = ((const SimulatedMultiplexer_t*)pDevice)->control;
+
+    return ((control & PCA9547_CONTROL_ENABLE) != 0) && ((control & PCA9547_CONTROL_CHANNEL_MASK) == channel);
+}
+
+/// Device model operations
+const SimulatedDeviceOperations_t SIMULATED_MULTIPLEXER_OPERATIONS = {
+    NULL,
+    SimulatedMultiplexer_WriteByte,
+    SimulatedMultiplexer_ReadByte,
+    NULL,
+    NULL,
+    SimulatedMultiplexer_IsChannelConnected
+};
+
+void SimulatedMultiplexer_Initialise(SimulatedMultiplexer_t* pDevice)
+{
+    memset(pDevice, 0, sizeof(*pDevice));
+
+    pDevice->device.pName = "PCA9547";
+    pDevice->device.deviceAddress = PCA9547_DEVICE_ADDRESS;
+    pDevice->device.pOperations = &SIMULATED_MULTIPLEXER_OPERATIONS;
+}
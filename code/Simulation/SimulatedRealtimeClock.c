@@ -0,0 +1,333 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "SimulatedDevices.h"
+
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types, definitions and constants
+//-------------------------------------------------------------------------------------------------
+
+/// I2C device address of the Intersil ISL12020
+#define ISL12020_DEVICE_ADDRESS 0x6F
+
+/// I2C device address of the NXP PCF85063A
+#define PCF85063A_DEVICE_ADDRESS 0x51
+
+/// ISL12020 BETA register, holding the temperature sense enable bit (TSE, bit 7)
+#define ISL12020_REGISTER_ADDRESS_BETA 0x0D
+
+/// ISL12020 temperature registers, in Kelvin * 2
+#define ISL12020_REGISTER_ADDRESS_TEMPERATURE_LOW 0x28
+#define ISL12020_REGISTER_ADDRESS_TEMPERATURE_HIGH 0x29
+
+/// Simulated time of 2020-01-01 00:00:00, in seconds since 2000-01-01 00:00:00
+#define RTC_INITIAL_SECONDS 631152000UL
+
+/**
+ * \brief Addresses of the time and date registers.
+ */
+typedef struct
+{
+    uint8_t seconds;
+    uint8_t minutes;
+    uint8_t hours;
+    uint8_t day;
+    uint8_t weekday;
+    uint8_t month;
+    uint8_t year;
+} RtcRegisterLayout_t;
+
+/// Register layout of the ISL12020
+const RtcRegisterLayout_t ISL12020_REGISTER_LAYOUT = { 0x00, 0x01, 0x02, 0x03, 0x06, 0x04, 0x05 };
+
+/// Register layout of the PCF85063A
+const RtcRegisterLayout_t PCF85063A_REGISTER_LAYOUT = { 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A };
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Get the register layout of a realtime clock.
+ *
+ * \param	pRtc	Device
+ * \returns			Register layout
+ */
+const RtcRegisterLayout_t* SimulatedRealtimeClock_GetLayout(const SimulatedRealtimeClock_t* pRtc)
+{
+    return (pRtc->type == ESimulatedRtcType_ISL12020) ? &ISL12020_REGISTER_LAYOUT : &PCF85063A_REGISTER_LAYOUT;
+}
+
+/**
+ * \brief Get the number of days in a month.
+ *
+ * \param	year	Year since 2000
+ * \param	month	Month, 1 to 12
+ * \returns			The number of days
+ */
+uint32_t SimulatedRealtimeClock_GetDaysInMonth(uint32_t year, uint32_t month)
+{
+    static const uint8_t DAYS_IN_MONTH[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    // Both devices cover the years 2000 to 2099, in which every fourth year is a leap year.
+    if ((month == 2) && ((year % 4) == 0))
+    {
+        return 29;
+    }
+
+    return DAYS_IN_MONTH[month - 1];
+}
+
+/**
+ * \brief Convert a binary value to BCD.
+ */
+uint8_t SimulatedRealtimeClock_ToBcd(uint32_t value)
+{
+    return (uint8_t)(((value / 10) << 4) | (value % 10));
+}
+
+/**
+ * \brief Convert a BCD value to binary.
+ */
+uint32_t SimulatedRealtimeClock_FromBcd(uint8_t value)
+{
+    return (value >> 4) * 10 + (value & 0x0F);
+}
+
+/**
+ * \brief Get the current time of a realtime clock.
+ *
+ * \param	pRtc	Device
+ * \returns			Seconds since 2000-01-01 00:00:00
+ */
+uint32_t SimulatedRealtimeClock_GetSeconds(const SimulatedRealtimeClock_t* pRtc)
+{
+    uint64_t elapsedNanoseconds = SimulatedBus_GetTimeNanoseconds() - pRtc->referenceTimeNanoseconds;
+
+    return pRtc->secondsAtReference + (uint32_t)(elapsedNanoseconds / 1000000000ULL);
+}
+
+/**
+ * \brief Latch the current time into the time and date registers, as the devices do at the start of a transfer.
+ *
+ * \param	pRtc	Device
+ */
+void SimulatedRealtimeClock_LatchTime(SimulatedRealtimeClock_t* pRtc)
+{
+    const RtcRegisterLayout_t* pLayout = SimulatedRealtimeClock_GetLayout(pRtc);
+    uint32_t seconds = SimulatedRealtimeClock_GetSeconds(pRtc);
+    uint32_t days = seconds / 86400;
+
+    // Bit 7 of the seconds and hours registers holds a flag (PCF85063A oscillator stop, ISL12020 24-hour mode).
+    pRtc->registers[pLayout->seconds] = (pRtc->registers[pLayout->seconds] & 0x80) |
+                                        SimulatedRealtimeClock_ToBcd(seconds % 60);
+    pRtc->registers[pLayout->minutes] = SimulatedRealtimeClock_ToBcd((seconds / 60) % 60);
+    pRtc->registers[pLayout->hours] = (pRtc->registers[pLayout->hours] & 0x80) |
+                                      SimulatedRealtimeClock_ToBcd((seconds / 3600) % 24);
+
+    // 2000-01-01 was a Saturday.
+    pRtc->registers[pLayout->weekday] = (uint8_t)((days + 6) % 7);
+
+    uint32_t year = 0;
+    while (days >= (((year % 4) == 0) ? 366U : 365U))
+    {
+        days -= ((year % 4) == 0) ? 366 : 365;
+        year++;
+    }
+
+    uint32_t month = 1;
+    while (days >= SimulatedRealtimeClock_GetDaysInMonth(year, month))
+    {
+        days -= SimulatedRealtimeClock_GetDaysInMonth(year, month);
+        month++;
+    }
+
+    pRtc->registers[pLayout->day] = SimulatedRealtimeClock_ToBcd(days + 1);
+    pRtc->registers[pLayout->month] = SimulatedRealtimeClock_ToBcd(month);
+    pRtc->registers[pLayout->year] = SimulatedRealtimeClock_ToBcd(year);
+
+    if (pRtc->type == ESimulatedRtcType_ISL12020)
+    {
+        // The temperature is only measured while temperature sensing is enabled.
+        uint32_t temperature = 0;
+        if ((pRtc->registers[ISL12020_REGISTER_ADDRESS_BETA] & 0x80) != 0)
+        {
+            temperature = (uint32_t)((pRtc->temperatureCelsius + 273) * 2);
+        }
+
+        pRtc->registers[ISL12020_REGISTER_ADDRESS_TEMPERATURE_LOW] = (uint8_t)temperature;
+        pRtc->registers[ISL12020_REGISTER_ADDRESS_TEMPERATURE_HIGH] = (uint8_t)((temperature >> 8) & 0x03);
+    }
+}
+
+/**
+ * \brief Set the time of a realtime clock from its time and date registers, after they were written.
+ *
+ * \param	pRtc	Device
+ */
+void SimulatedRealtimeClock_SetTimeFromRegisters(SimulatedRealtimeClock_t* pRtc)
+{
+    const RtcRegisterLayout_t* pLayout = SimulatedRealtimeClock_GetLayout(pRtc);
+
+    uint32_t year = SimulatedRealtimeClock_FromBcd(pRtc->registers[pLayout->year]) % 100;
+    uint32_t month = SimulatedRealtimeClock_FromBcd(pRtc->registers[pLayout->month] & 0x1F);
+    uint32_t day = SimulatedRealtimeClock_FromBcd(pRtc->registers[pLayout->day] & 0x3F);
+
+    if ((month < 1) || (month > 12))
+    {
+        month = 1;
+    }
+
+    if ((day < 1) || (day > SimulatedRealtimeClock_GetDaysInMonth(year, month)))
+    {
+        day = 1;
+    }
+
+    uint32_t days = year * 365 + (year + 3) / 4 + (day - 1);
+
+    uint32_t monthIndex;
+    for (monthIndex = 1; monthIndex < month; monthIndex++)
+    {
+        days += SimulatedRealtimeClock_GetDaysInMonth(year, monthIndex);
+    }
+
+    uint32_t hours = SimulatedRealtimeClock_FromBcd(pRtc->registers[pLayout->hours] & 0x3F) % 24;
+    uint32_t minutes = SimulatedRealtimeClock_FromBcd(pRtc->registers[pLayout->minutes] & 0x7F) % 60;
+    uint32_t seconds = SimulatedRealtimeClock_FromBcd(pRtc->registers[pLayout->seconds] & 0x7F) % 60;
+
+    pRtc->secondsAtReference = ((days * 24 + hours) * 60 + minutes) * 60 + seconds;
+    pRtc->referenceTimeNanoseconds = SimulatedBus_GetTimeNanoseconds();
+}
+
+/**
+ * \brief Check whether a register is a time or date register.
+ *
+ * \param	pRtc		Device
+ * \param	address		Register address
+ * \returns				True for a time or date register
+ */
+bool SimulatedRealtimeClock_IsTimeRegister(const SimulatedRealtimeClock_t* pRtc, uint8_t address)
+{
+    const RtcRegisterLayout_t* pLayout = SimulatedRealtimeClock_GetLayout(pRtc);
+
+    return (address == pLayout->seconds) || (address == pLayout->minutes) || (address == pLayout->hours) ||
+           (address == pLayout->day) || (address == pLayout->month) || (address == pLayout->year);
+}
+
+bool SimulatedRealtimeClock_Start(SimulatedDevice_t* pDevice, EI2cDirection_t direction)
+{
+    SimulatedRealtimeClock_t* pRtc = (SimulatedRealtimeClock_t*)pDevice;
+
+    if (direction == EI2cDirection_Write)
+    {
+        pRtc->addressReceived = false;
+    }
+
+    SimulatedRealtimeClock_LatchTime(pRtc);
+
+    return true;
+}
+
+bool SimulatedRealtimeClock_WriteByte(SimulatedDevice_t* pDevice, uint8_t data)
+{
+    SimulatedRealtimeClock_t* pRtc = (SimulatedRealtimeClock_t*)pDevice;
+
+    if (!pRtc->addressReceived)
+    {
+        pRtc->address = data % pRtc->numberOfRegisters;
+        pRtc->addressReceived = true;
+        return true;
+    }
+
+    pRtc->registers[pRtc->address] = data;
+
+    if (SimulatedRealtimeClock_IsTimeRegister(pRtc, pRtc->address))
+    {
+        pRtc->timeWritten = true;
+    }
+
+    pRtc->address = (pRtc->address + 1) % pRtc->numberOfRegisters;
+
+    return true;
+}
+
+uint8_t SimulatedRealtimeClock_ReadByte(SimulatedDevice_t* pDevice)
+{
+    SimulatedRealtimeClock_t* pRtc = (SimulatedRealtimeClock_t*)pDevice;
+
+    uint8_t data = pRtc->registers[pRtc->address];
+    pRtc->address = (pRtc->address + 1) % pRtc->numberOfRegisters;
+
+    return data;
+}
+
+void SimulatedRealtimeClock_Stop(SimulatedDevice_t* pDevice)
+{
+    SimulatedRealtimeClock_t* pRtc = (SimulatedRealtimeClock_t*)pDevice;
+
+    if (pRtc->timeWritten)
+    {
+        pRtc->timeWritten = false;
+        SimulatedRealtimeClock_SetTimeFromRegisters(pRtc);
+    }
+}
+
+/// Device model operations
+const SimulatedDeviceOperations_t SIMULATED_REALTIME_CLOCK_OPERATIONS = {
+    SimulatedRealtimeClock_Start,
+    SimulatedRealtimeClock_WriteByte,
+    SimulatedRealtimeClock_ReadByte,
+    SimulatedRealtimeClock_Stop,
+    NULL,
+    NULL
+};
+
+void SimulatedRealtimeClock_Initialise(SimulatedRealtimeClock_t* pDevice, ESimulatedRtcType_t type)
+{
+    memset(pDevice, 0, sizeof(*pDevice));
+
+    pDevice->type = type;
+    pDevice->device.pOperations = &SIMULATED_REALTIME_CLOCK_OPERATIONS;
+
+    if (type == ESimulatedRtcType_ISL12020)
+    {
+        pDevice->device.pName = "ISL12020";
+        pDevice->device.deviceAddress = ISL12020_DEVICE_ADDRESS;
+        pDevice->numberOfRegisters = 0x30;
+    }
+    else
+    {
+        pDevice->device.pName = "PCF85063A";
+        pDevice->device.deviceAddress = PCF85063A_DEVICE_ADDRESS;
+        pDevice->numberOfRegisters = 0x11;
+    }
+
+    pDevice->secondsAtReference = RTC_INITIAL_SECONDS;
+    pDevice->referenceTimeNanoseconds = SimulatedBus_GetTimeNanoseconds();
+    pDevice->temperatureCelsius = 35;
+}
@@ -0,0 +1,164 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "SimulatedDevices.h"
+
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+
+/// I2C device address
+#define LM96080_DEVICE_ADDRESS 0x2F
+
+/// Address of the first value register
+#define LM96080_REGISTER_ADDRESS_VALUE_BASE 0x20
+
+/// Millivolts per LSB of a reading, times 10
+#define LM96080_MILLIVOLTS_PER_LSB_TIMES_10 25
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Check whether the current address is a value register.
+ *
+ * \param	pMonitor	Device
+ * \returns				True for a value register
+ */
+bool SimulatedSystemMonitor_IsValueRegister(const SimulatedSystemMonitor_t* pMonitor)
+{
+    return (pMonitor->address >= LM96080_REGISTER_ADDRESS_VALUE_BASE) &&
+           (pMonitor->address < LM96080_REGISTER_ADDRESS_VALUE_BASE + SIMULATED_SYSTEM_MONITOR_NUMBER_OF_CHANNELS);
+}
+
+bool SimulatedSystemMonitor_Start(SimulatedDevice_t* pDevice, EI2cDirection_t direction)
+{
+    SimulatedSystemMonitor_t* pMonitor = (SimulatedSystemMonitor_t*)pDevice;
+
+    if (direction == EI2cDirection_Write)
+    {
+        pMonitor->addressReceived = false;
+    }
+
+    pMonitor->valueByteIndex = 0;
+
+    return true;
+}
+
+bool SimulatedSystemMonitor_WriteByte(SimulatedDevice_t* pDevice, uint8_t data)
+{
+    SimulatedSystemMonitor_t* pMonitor = (SimulatedSystemMonitor_t*)pDevice;
+
+    if (!pMonitor->addressReceived)
+    {
+        pMonitor->address = data;
+        pMonitor->addressReceived = true;
+        return true;
+    }
+
+    // The value registers are read-only.
+    if (pMonitor->address < sizeof(pMonitor->configRegisters))
+    {
+        pMonitor->configRegisters[pMonitor->address] = data;
+    }
+
+    pMonitor->address++;
+
+    return true;
+}
+
+uint8_t SimulatedSystemMonitor_ReadByte(SimulatedDevice_t* pDevice)
+{
+    SimulatedSystemMonitor_t* pMonitor = (SimulatedSystemMonitor_t*)pDevice;
+
+    if (SimulatedSystemMonitor_IsValueRegister(pMonitor))
+    {
+        uint16_t value = pMonitor->valueRegisters[pMonitor->address - LM96080_REGISTER_ADDRESS_VALUE_BASE];
+
+        if (pMonitor->valueByteIndex == 0)
+        {
+            pMonitor->valueByteIndex = 1;
+            return (uint8_t)(value >> 8);
+        }
+
+        pMonitor->valueByteIndex = 0;
+        pMonitor->address++;
+        return (uint8_t)value;
+    }
+
+    uint8_t data = 0;
+    if (pMonitor->address < sizeof(pMonitor->configRegisters))
+    {
+        data = pMonitor->configRegisters[pMonitor->address];
+    }
+
+    pMonitor->address++;
+
+    return data;
+}
+
+/// Device model operations
+const SimulatedDeviceOperations_t SIMULATED_SYSTEM_MONITOR_OPERATIONS = {
+    SimulatedSystemMonitor_Start,
+    SimulatedSystemMonitor_WriteByte,
+    SimulatedSystemMonitor_ReadByte,
+    NULL,
+    NULL,
+    NULL
+};
+
+void SimulatedSystemMonitor_Initialise(SimulatedSystemMonitor_t* pDevice)
+{
+    memset(pDevice, 0, sizeof(*pDevice));
+
+    pDevice->device.pName = "LM96080";
+    pDevice->device.deviceAddress = LM96080_DEVICE_ADDRESS;
+    pDevice->device.pOperations = &SIMULATED_SYSTEM_MONITOR_OPERATIONS;
+
+    // Power-on default of the configuration register: interrupt clear bit set, monitoring stopped.
+    pDevice->configRegisters[0] = 0x08;
+}
+
+void SimulatedSystemMonitor_SetChannelVoltage(SimulatedSystemMonitor_t* pDevice, uint8_t channel, uint32_t millivolts)
+{
+    if (channel >= SIMULATED_SYSTEM_MONITOR_TEMPERATURE_CHANNEL)
+    {
+        return;
+    }
+
+    uint32_t value = (millivolts * 10) / LM96080_MILLIVOLTS_PER_LSB_TIMES_10;
+    pDevice->valueRegisters[channel] = (uint16_t)(((value > 0x3FF) ? 0x3FF : value) << 6);
+}
+
+void SimulatedSystemMonitor_SetTemperature(SimulatedSystemMonitor_t* pDevice, int32_t milliCelsius)
+{
+    // 12-bit resolution (0.0625 degrees), left-aligned
+    int32_t value = ((milliCelsius * 16) / 1000) << 4;
+    pDevice->valueRegisters[SIMULATED_SYSTEM_MONITOR_TEMPERATURE_CHANNEL] = (uint16_t)(int16_t)value;
+}
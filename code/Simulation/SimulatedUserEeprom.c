@@ -0,0 +1,130 @@
+/**---------------------------------------------------------------------------------------------------
+-- Copyright (c) 2020 by Enclustra GmbH, Switzerland.
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy of
+-- this hardware, software, firmware, and associated documentation files (the
+-- "Product"), to deal in the Product without restriction, including without
+-- limitation the rights to use, copy, modify, merge, publish, distribute,
+-- sublicense, and/or sell copies of the Product, and to permit persons to whom the
+-- Product is furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Product.
+--
+-- THE PRODUCT IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+-- INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+-- PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+-- HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+-- OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+-- PRODUCT OR THE USE OR OTHER DEALINGS IN THE PRODUCT.
+---------------------------------------------------------------------------------------------------
+*/
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//-------------------------------------------------------------------------------------------------
+
+#include "SimulatedDevices.h"
+
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+
+/// I2C device address
+#define USER_EEPROM_DEVICE_ADDRESS 0x56
+
+/// Write cycle time (tWC), during which the device does not acknowledge its address
+#define USER_EEPROM_WRITE_CYCLE_NANOSECONDS 5000000ULL
+
+//-------------------------------------------------------------------------------------------------
+// Function definitions
+//-------------------------------------------------------------------------------------------------
+
+bool SimulatedUserEeprom_Start(SimulatedDevice_t* pDevice, EI2cDirection_t direction)
+{
+    SimulatedUserEeprom_t* pEeprom = (SimulatedUserEeprom_t*)pDevice;
+
+    if (SimulatedBus_GetTimeNanoseconds() < pEeprom->busyUntilNanoseconds)
+    {
+        return false;
+    }
+
+    if (direction == EI2cDirection_Write)
+    {
+        pEeprom->addressBytesReceived = 0;
+    }
+
+    return true;
+}
+
+bool SimulatedUserEeprom_WriteByte(SimulatedDevice_t* pDevice, uint8_t data)
+{
+    SimulatedUserEeprom_t* pEeprom = (SimulatedUserEeprom_t*)pDevice;
+
+    // The address is sent most significant byte first, and only takes effect once both bytes are received.
+    if (pEeprom->addressBytesReceived == 0)
+    {
+        pEeprom->addressBytesReceived = 1;
+        pEeprom->address = (uint16_t)(data << 8);
+        return true;
+    }
+
+    if (pEeprom->addressBytesReceived == 1)
+    {
+        pEeprom->addressBytesReceived = 2;
+        pEeprom->address = (pEeprom->address | data) % SIMULATED_USER_EEPROM_SIZE_BYTES;
+        return true;
+    }
+
+    // Page writes wrap around at the end of the page.
+    uint16_t pageStart = pEeprom->address & ~(SIMULATED_USER_EEPROM_PAGE_SIZE_BYTES - 1);
+
+    pEeprom->memory[pEeprom->address] = data;
+    pEeprom->address = pageStart | ((pEeprom->address + 1) & (SIMULATED_USER_EEPROM_PAGE_SIZE_BYTES - 1));
+    pEeprom->dataWritten = true;
+
+    return true;
+}
+
+uint8_t SimulatedUserEeprom_ReadByte(SimulatedDevice_t* pDevice)
+{
+    SimulatedUserEeprom_t* pEeprom = (SimulatedUserEeprom_t*)pDevice;
+
+    uint8_t data = pEeprom->memory[pEeprom->address];
+    pEeprom->address = (pEeprom->address + 1) % SIMULATED_USER_EEPROM_SIZE_BYTES;
+
+    return data;
+}
+
+void SimulatedUserEeprom_Stop(SimulatedDevice_t* pDevice)
+{
+    SimulatedUserEeprom_t* pEeprom = (SimulatedUserEeprom_t*)pDevice;
+
+    if (pEeprom->dataWritten)
+    {
+        pEeprom->dataWritten = false;
+        pEeprom->busyUntilNanoseconds = SimulatedBus_GetTimeNanoseconds() + USER_EEPROM_WRITE_CYCLE_NANOSECONDS;
+    }
+}
+
+/// Device model operations
+const SimulatedDeviceOperations_t SIMULATED_USER_EEPROM_OPERATIONS = {
+    SimulatedUserEeprom_Start,
+    SimulatedUserEeprom_WriteByte,
+    SimulatedUserEeprom_ReadByte,
+    SimulatedUserEeprom_Stop,
+    NULL,
+    NULL
+};
+
+void SimulatedUserEeprom_Initialise(SimulatedUserEeprom_t* pDevice)
+{
+    memset(pDevice, 0, sizeof(*pDevice));
+    memset(pDevice->memory, 0xFF, sizeof(pDevice->memory));
+
+    pDevice->device.pName = "24AA128";
+    pDevice->device.deviceAddress = USER_EEPROM_DEVICE_ADDRESS;
+    pDevice->device.pOperations = &SIMULATED_USER_EEPROM_OPERATIONS;
+}